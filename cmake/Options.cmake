@@ -61,6 +61,7 @@ function(set_options)
     option(OPTION_TOOLS_ONLY "Build only tools target" OFF)
     option(OPTION_DOCS_ONLY "Build only docs target" OFF)
     option(OPTION_ALLOW_INVALID_SIGNATURE "Allow loading of content with invalid signatures" OFF)
+    option(OPTION_REPLAY_COMMANDS "Replay commands.log from the save folder; see docs/desync.md" OFF)
 
     if (OPTION_DOCS_ONLY)
         set(OPTION_TOOLS_ONLY ON PARENT_SCOPE)
@@ -90,6 +91,11 @@ function(show_options)
         message(STATUS "Option Allow Invalid Signature - USED")
         message(WARNING "Ignoring invalid signatures is a security risk! Use with care!")
     endif()
+
+    if(OPTION_REPLAY_COMMANDS)
+        message(STATUS "Option Replay Commands - USED")
+        message(WARNING "This build replays commands.log and is only meant for debugging and benchmarking!")
+    endif()
 endfunction()
 
 # Add the definitions for the options that are selected.
@@ -114,4 +120,8 @@ function(add_definitions_based_on_options)
     if(OPTION_ALLOW_INVALID_SIGNATURE)
         add_definitions(-DALLOW_INVALID_SIGNATURE)
     endif()
+
+    if(OPTION_REPLAY_COMMANDS)
+        add_definitions(-DDEBUG_DUMP_COMMANDS)
+    endif()
 endfunction()
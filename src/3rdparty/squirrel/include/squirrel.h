@@ -173,6 +173,7 @@ typedef struct SQVM* HSQUIRRELVM;
 typedef SQObject HSQOBJECT;
 typedef SQInteger (*SQFUNCTION)(HSQUIRRELVM);
 typedef SQInteger (*SQRELEASEHOOK)(SQUserPointer,SQInteger size);
+typedef void (*SQPROFILEHOOK)(HSQUIRRELVM,SQInteger /*ops*/);
 typedef void (*SQCOMPILERERROR)(HSQUIRRELVM,const SQChar * /*desc*/,const SQChar * /*source*/,SQInteger /*line*/,SQInteger /*column*/);
 typedef void (*SQPRINTFUNCTION)(HSQUIRRELVM,const std::string &);
 
@@ -339,6 +340,7 @@ void sq_free(void *p,SQUnsignedInteger size);
 /*debug*/
 SQRESULT sq_stackinfos(HSQUIRRELVM v,SQInteger level,SQStackInfos *si);
 void sq_setdebughook(HSQUIRRELVM v);
+void sq_setprofilehook(HSQUIRRELVM v,SQPROFILEHOOK hook,SQInteger interval);
 
 /*UTILITY MACRO*/
 #define sq_isnumeric(o) ((o)._type&SQOBJECT_NUMERIC)
@@ -124,6 +124,13 @@ void sq_setdebughook(HSQUIRRELVM v)
 	}
 }
 
+void sq_setprofilehook(HSQUIRRELVM v,SQPROFILEHOOK hook,SQInteger interval)
+{
+	v->_profilehook = hook;
+	v->_profilehook_interval = interval;
+	if (v->_profilehook_countdown <= 0 || v->_profilehook_countdown > interval) v->_profilehook_countdown = interval;
+}
+
 void sq_close(HSQUIRRELVM v)
 {
 	SQSharedState *ss = _ss(v);
@@ -113,6 +113,9 @@ SQVM::SQVM(SQSharedState *ss)
 	_lasterror = _null_;
 	_errorhandler = _null_;
 	_debughook = _null_;
+	_profilehook = nullptr;
+	_profilehook_interval = 0;
+	_profilehook_countdown = 0;
 	_can_suspend = false;
 	_in_stackoverflow = false;
 	_ops_till_suspend = 0;
@@ -745,6 +748,10 @@ exception_restore:
 		for(;;)
 		{
 			DecreaseOps(1);
+			if (_profilehook != nullptr && --_profilehook_countdown <= 0) {
+				_profilehook_countdown = _profilehook_interval;
+				_profilehook(this, _profilehook_interval);
+			}
 			if (ShouldSuspend()) { _suspended = SQTrue; _suspended_traps = traps; return true; }
 			if (IsOpsTillSuspendError()) {
 				Raise_Error(fmt::format("excessive CPU usage in {}", _ops_till_suspend_error_label));
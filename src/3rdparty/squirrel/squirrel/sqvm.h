@@ -144,6 +144,9 @@ public:
 	SQObjectPtr _lasterror;
 	SQObjectPtr _errorhandler;
 	SQObjectPtr _debughook;
+	SQPROFILEHOOK _profilehook;
+	SQInteger _profilehook_interval;
+	SQInteger _profilehook_countdown;
 
 	SQObjectPtr temp_reg;
 
@@ -8,7 +8,7 @@
 /** @file animated_tile.cpp Everything related to animated tiles. */
 
 #include "stdafx.h"
-#include "core/container_func.hpp"
+#include "map_func.h"
 #include "tile_cmd.h"
 #include "viewport_func.h"
 #include "framerate_type.h"
@@ -18,16 +18,51 @@
 /** The table/list with animated tiles. */
 std::vector<TileIndex> _animated_tiles;
 
+/**
+ * State of a tile with respect to the animated tile list.
+ * A tile that is deleted and added again gets a new entry at the end of the list, exactly as if
+ * it had been removed right away; its old entry is then set to INVALID_TILE.
+ */
+enum class AnimatedTileState : uint8_t {
+	None,     ///< The tile is not in the list.
+	Animated, ///< The tile is in the list, and is animated.
+	Deleted,  ///< The tile is still in the list, but is not animated anymore; it is removed when the list is compacted.
+};
+
+/** State of every tile, so finding a tile in the list is not needed. Empty when it has to be rebuilt from the list. */
+static std::vector<AnimatedTileState> _animated_tile_states;
+
+/**
+ * Get the states of all tiles, rebuilding them from the list after it has been replaced, e.g. by loading a game.
+ * When rebuilding, duplicates in the list are removed as well.
+ * @return The states, indexed by tile.
+ */
+static std::vector<AnimatedTileState> &GetAnimatedTileStates()
+{
+	if (_animated_tile_states.size() != Map::Size()) {
+		_animated_tile_states.assign(Map::Size(), AnimatedTileState::None);
+		std::erase_if(_animated_tiles, [](TileIndex tile) {
+			if (tile == INVALID_TILE) return true;
+			AnimatedTileState &state = _animated_tile_states[tile.base()];
+			if (state == AnimatedTileState::Animated) return true;
+			state = AnimatedTileState::Animated;
+			return false;
+		});
+	}
+	return _animated_tile_states;
+}
+
 /**
  * Removes the given tile from the animated tile table.
  * @param tile the tile to remove
  */
 void DeleteAnimatedTile(TileIndex tile)
 {
-	auto to_remove = std::find(_animated_tiles.begin(), _animated_tiles.end(), tile);
-	if (to_remove != _animated_tiles.end()) {
-		/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile. */
-		_animated_tiles.erase(to_remove);
+	AnimatedTileState &state = GetAnimatedTileStates()[tile.base()];
+	if (state == AnimatedTileState::Animated) {
+		/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile.
+		 * So only mark it as deleted, it is removed from the list when that is compacted. */
+		state = AnimatedTileState::Deleted;
 		MarkTileDirtyByTile(tile);
 	}
 }
@@ -40,7 +75,46 @@ void DeleteAnimatedTile(TileIndex tile)
 void AddAnimatedTile(TileIndex tile)
 {
 	MarkTileDirtyByTile(tile);
-	include(_animated_tiles, tile);
+
+	AnimatedTileState &state = GetAnimatedTileStates()[tile.base()];
+	if (state == AnimatedTileState::Animated) return;
+
+	if (state == AnimatedTileState::Deleted) {
+		/* The tile has to end up at the end of the list, just like when it had been removed
+		 * right away. That happens rarely, so searching the old entry does not matter. */
+		*std::find(_animated_tiles.begin(), _animated_tiles.end(), tile) = INVALID_TILE;
+	}
+	_animated_tiles.push_back(tile);
+	state = AnimatedTileState::Animated;
+}
+
+/**
+ * Get the tiles in the animated tile list that are still animated, in their order in the list.
+ * @return The animated tiles.
+ */
+std::vector<TileIndex> GetAnimatedTiles()
+{
+	const std::vector<AnimatedTileState> &states = GetAnimatedTileStates();
+	std::vector<TileIndex> tiles;
+	std::copy_if(_animated_tiles.begin(), _animated_tiles.end(), std::back_inserter(tiles), [&states](TileIndex tile) {
+		return tile != INVALID_TILE && states[tile.base()] == AnimatedTileState::Animated;
+	});
+	return tiles;
+}
+
+/**
+ * Remove the tiles that have been deleted from the animated tile list, keeping the order of the others.
+ */
+void CompactAnimatedTiles()
+{
+	std::vector<AnimatedTileState> &states = GetAnimatedTileStates();
+	std::erase_if(_animated_tiles, [&states](TileIndex tile) {
+		if (tile == INVALID_TILE) return true;
+		AnimatedTileState &state = states[tile.base()];
+		if (state != AnimatedTileState::Deleted) return false;
+		state = AnimatedTileState::None;
+		return true;
+	});
 }
 
 /**
@@ -50,21 +124,15 @@ void AnimateAnimatedTiles()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-	const TileIndex *ti = _animated_tiles.data();
-	while (ti < _animated_tiles.data() + _animated_tiles.size()) {
-		const TileIndex curr = *ti;
-		AnimateTile(curr);
-		/* During the AnimateTile call, DeleteAnimatedTile could have been called,
-		 * deleting an element we've already processed and pushing the rest one
-		 * slot to the left. We can detect this by checking whether the index
-		 * in the current slot has changed - if it has, an element has been deleted,
-		 * and we should process the current slot again instead of going forward.
-		 * NOTE: this will still break if more than one animated tile is being
-		 *       deleted during the same AnimateTile call, but no code seems to
-		 *       be doing this anyway.
-		 */
-		if (*ti == curr) ++ti;
+	const std::vector<AnimatedTileState> &states = GetAnimatedTileStates();
+	/* Tiles may be added to the list while animating, and those are animated right away.
+	 * As deleted tiles are only marked, the positions of the tiles do not change. */
+	for (size_t i = 0; i < _animated_tiles.size(); i++) {
+		const TileIndex curr = _animated_tiles[i];
+		if (curr != INVALID_TILE && states[curr.base()] == AnimatedTileState::Animated) AnimateTile(curr);
 	}
+
+	CompactAnimatedTiles();
 }
 
 /**
@@ -73,4 +141,5 @@ void AnimateAnimatedTiles()
 void InitializeAnimatedTiles()
 {
 	_animated_tiles.clear();
+	_animated_tile_states.clear();
 }
@@ -14,6 +14,8 @@
 
 void AddAnimatedTile(TileIndex tile);
 void DeleteAnimatedTile(TileIndex tile);
+void CompactAnimatedTiles();
+std::vector<TileIndex> GetAnimatedTiles();
 void AnimateAnimatedTiles();
 void InitializeAnimatedTiles();
 
@@ -95,7 +95,7 @@ INTERNAL_LINKAGE inline __m128i AlphaBlendTwoPixels(__m128i src, __m128i dst, co
 	srcAB = _mm_add_epi16(srcAB, dstAB);     // PADDW,  a*(r - Cr)/256 + Cr
 
 	alphaMaskAB = _mm_and_si128(alphaMaskAB, alpha_mask); // PAND, set non alpha fields to 0
-	srcAB = _mm_or_si128(srcAB, alphaMaskAB);             // POR, set alpha fields to 0xFFFF is src alpha was > 0
+	srcAB = _mm_or_si128(srcAB, alphaMaskAB);             // POR, set alpha fields to 0xFFFF if src alpha was > 0
 
 	return PackUnsaturated(srcAB, pack_mask);
 }
@@ -116,6 +116,57 @@ INTERNAL_LINKAGE inline __m128i DarkenTwoPixels(__m128i src, __m128i dst, const
 	return _mm_packus_epi16(dstAB, dstAB);
 }
 
+#if (SSE_VERSION >= 5)
+/* Alpha blend the pixels whose colours are expanded into 16 bits, like AlphaBlendTwoPixels does. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i AlphaBlendExpandedPixels(__m256i srcAB, __m256i dstAB, const __m256i &distribution_mask, const __m256i &alpha_mask)
+{
+	__m256i alphaMaskAB = _mm256_cmpgt_epi16(srcAB, _mm256_setzero_si256()); // (alpha > 0) ? 0xFFFF : 0
+	__m256i alphaAB = _mm256_sub_epi16(srcAB, alphaMaskAB);                   // if (alpha > 0) a++;
+	alphaAB = _mm256_shuffle_epi8(alphaAB, distribution_mask);
+
+	srcAB = _mm256_sub_epi16(srcAB, dstAB);     //    (r - Cr)
+	srcAB = _mm256_mullo_epi16(srcAB, alphaAB); //  a*(r - Cr)
+	srcAB = _mm256_srli_epi16(srcAB, 8);        //  a*(r - Cr)/256
+	srcAB = _mm256_add_epi16(srcAB, dstAB);     //  a*(r - Cr)/256 + Cr
+
+	alphaMaskAB = _mm256_and_si256(alphaMaskAB, alpha_mask); // set non alpha fields to 0
+	srcAB = _mm256_or_si256(srcAB, alphaMaskAB);             // set alpha fields to 0xFFFF if src alpha was > 0
+
+	/* Only the low bytes are valid; wipe the high bytes so packing does not saturate. */
+	return _mm256_and_si256(srcAB, _mm256_set1_epi16(0xFF));
+}
+
+/* Alpha blend 8 pixels. Unpacking and packing work per 128 bits lane, so the pixels stay in order. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i AlphaBlendEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &alpha_mask)
+{
+	__m256i low = AlphaBlendExpandedPixels(_mm256_unpacklo_epi8(src, _mm256_setzero_si256()), _mm256_unpacklo_epi8(dst, _mm256_setzero_si256()), distribution_mask, alpha_mask);
+	__m256i high = AlphaBlendExpandedPixels(_mm256_unpackhi_epi8(src, _mm256_setzero_si256()), _mm256_unpackhi_epi8(dst, _mm256_setzero_si256()), distribution_mask, alpha_mask);
+	return _mm256_packus_epi16(low, high);
+}
+
+/* Darken the pixels whose colours are expanded into 16 bits, like DarkenTwoPixels does. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i DarkenExpandedPixels(__m256i srcAB, __m256i dstAB, const __m256i &distribution_mask, const __m256i &tr_nom_base)
+{
+	__m256i alphaAB = _mm256_shuffle_epi8(srcAB, distribution_mask);
+	alphaAB = _mm256_srli_epi16(alphaAB, 2); // Reduce to 64 levels of shades so the max value fits in 16 bits.
+	__m256i nom = _mm256_sub_epi16(tr_nom_base, alphaAB);
+	dstAB = _mm256_mullo_epi16(dstAB, nom);
+	return _mm256_srli_epi16(dstAB, 8);
+}
+
+/* Darken 8 pixels. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i DarkenEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &tr_nom_base)
+{
+	__m256i low = DarkenExpandedPixels(_mm256_unpacklo_epi8(src, _mm256_setzero_si256()), _mm256_unpacklo_epi8(dst, _mm256_setzero_si256()), distribution_mask, tr_nom_base);
+	__m256i high = DarkenExpandedPixels(_mm256_unpackhi_epi8(src, _mm256_setzero_si256()), _mm256_unpackhi_epi8(dst, _mm256_setzero_si256()), distribution_mask, tr_nom_base);
+	return _mm256_packus_epi16(low, high);
+}
+#endif
+
 IGNORE_UNINITIALIZED_WARNING_START
 GNU_TARGET(SSE_TARGET)
 INTERNAL_LINKAGE Colour ReallyAdjustBrightness(Colour colour, uint8_t brightness)
@@ -219,6 +270,8 @@ inline void Blitter_32bppSSE2::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 inline void Blitter_32bppSSSE3::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
 #elif (SSE_VERSION == 4)
 inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
+#elif (SSE_VERSION == 5)
+inline void Blitter_32bppAVX2::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
 #endif
 {
 	const uint8_t * const remap = bp->remap;
@@ -255,6 +308,11 @@ inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 	#define DARKEN_PARAM_2      tr_nom_base
 #endif
 	const __m128i tr_nom_base = TRANSPARENT_NOM_BASE;
+#if (SSE_VERSION >= 5)
+	const __m256i a_cm_256        = _mm256_broadcastsi128_si256(ALPHA_CONTROL_MASK);
+	const __m256i alpha_and_256   = _mm256_broadcastsi128_si256(ALPHA_AND_MASK);
+	const __m256i tr_nom_base_256 = _mm256_broadcastsi128_si256(TRANSPARENT_NOM_BASE);
+#endif
 
 	for (int y = bp->height; y != 0; y--) {
 		Colour *dst = dst_line;
@@ -285,7 +343,19 @@ inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 					break;
 				}
 
+#if (SSE_VERSION >= 5)
+				for (uint x = (uint) effective_width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+					__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+					_mm256_storeu_si256((__m256i*) dst, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm_256, alpha_and_256));
+					src += 8;
+					dst += 8;
+				}
+
+				for (uint x = ((uint) effective_width % 8) / 2; x > 0; x--) {
+#else
 				for (uint x = (uint) effective_width / 2; x > 0; x--) {
+#endif
 					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
 					__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
 					_mm_storel_epi64((__m128i*) dst, AlphaBlendTwoPixels(srcABCD, dstABCD, ALPHA_BLEND_PARAM_1, ALPHA_BLEND_PARAM_2, ALPHA_BLEND_PARAM_3));
@@ -384,7 +454,19 @@ bmcr_alpha_blend_single:
 
 			case BM_TRANSPARENT:
 				/* Make the current colour a bit more black, so it looks like this image is transparent. */
+#if (SSE_VERSION >= 5)
+				for (uint x = (uint) bp->width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+					__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+					_mm256_storeu_si256((__m256i*) dst, DarkenEightPixels(srcABCD, dstABCD, a_cm_256, tr_nom_base_256));
+					src += 8;
+					dst += 8;
+				}
+
+				for (uint x = ((uint) bp->width % 8) / 2; x > 0; x--) {
+#else
 				for (uint x = (uint) bp->width / 2; x > 0; x--) {
+#endif
 					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
 					__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
 					_mm_storel_epi64((__m128i *) dst, DarkenTwoPixels(srcABCD, dstABCD, DARKEN_PARAM_1, DARKEN_PARAM_2));
@@ -461,6 +543,8 @@ void Blitter_32bppSSE2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomL
 void Blitter_32bppSSSE3::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
 #elif (SSE_VERSION == 4)
 void Blitter_32bppSSE4::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+#elif (SSE_VERSION == 5)
+void Blitter_32bppAVX2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
 #endif
 {
 	switch (mode) {
@@ -19,6 +19,7 @@
 #include "station_map.h"
 #include "subsidy_func.h"
 #include "town.h"
+#include "timer/timer_game_economy.h"
 #include "train.h"
 #include "vehicle_base.h"
 
@@ -27,17 +28,161 @@
 extern void AfterLoadCompanyStats();
 extern void RebuildTownCaches();
 
+/**
+ * Check the caches of a vehicle chain, by recalculating them and comparing them with the old values.
+ * @param v The primary vehicle at the front of the chain.
+ */
+static void CheckVehicleCaches(Vehicle *v)
+{
+	std::vector<NewGRFCache> grf_cache;
+	std::vector<VehicleCache> veh_cache;
+	std::vector<GroundVehicleCache> gro_cache;
+	std::vector<TrainCache> tra_cache;
+
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		grf_cache.emplace_back(u->grf_cache);
+		veh_cache.emplace_back(u->vcache);
+		switch (u->type) {
+			case VEH_TRAIN:
+				gro_cache.emplace_back(Train::From(u)->gcache);
+				tra_cache.emplace_back(Train::From(u)->tcache);
+				break;
+			case VEH_ROAD:
+				gro_cache.emplace_back(RoadVehicle::From(u)->gcache);
+				break;
+			default:
+				break;
+		}
+	}
+
+	switch (v->type) {
+		case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
+		case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
+		case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
+		case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
+		default: break;
+	}
+
+	uint length = 0;
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
+		FillNewGRFVehicleCache(u);
+		if (grf_cache[length] != u->grf_cache) {
+			Debug(desync, 1, "warning: newgrf cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
+		}
+		if (veh_cache[length] != u->vcache) {
+			Debug(desync, 1, "warning: vehicle cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
+		}
+		switch (u->type) {
+			case VEH_TRAIN:
+				if (gro_cache[length] != Train::From(u)->gcache) {
+					Debug(desync, 1, "warning: train ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
+				}
+				if (tra_cache[length] != Train::From(u)->tcache) {
+					Debug(desync, 1, "warning: train cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
+				}
+				break;
+			case VEH_ROAD:
+				if (gro_cache[length] != RoadVehicle::From(u)->gcache) {
+					Debug(desync, 1, "warning: road vehicle ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
+				}
+				break;
+			default:
+				break;
+		}
+		length++;
+	}
+}
+
+/**
+ * Check whether the cargo cache of a vehicle is still valid.
+ * @param v The vehicle to check.
+ */
+static void CheckVehicleCargoCache(Vehicle *v)
+{
+	const auto a = v->cargo.PeriodsInTransit();
+	const auto b = v->cargo.TotalCount();
+	const auto c = v->cargo.GetFeederShare();
+	v->cargo.InvalidateCache();
+	if (a != v->cargo.PeriodsInTransit() || b != v->cargo.TotalCount() || c != v->cargo.GetFeederShare()) {
+		Debug(desync, 1, "warning: vehicle cargo cache mismatch: type {}, vehicle {}, company {}, unit number {}", v->type, v->index, v->owner, v->unitnumber);
+	}
+}
+
+/**
+ * Check whether the cargo caches of a station are still valid.
+ * @param st The station to check.
+ */
+static void CheckStationCargoCaches(Station *st)
+{
+	for (CargoID cargo = 0; cargo < NUM_CARGO; cargo++) {
+		GoodsEntry &ge = st->goods[cargo];
+		const auto a = ge.cargo.PeriodsInTransit();
+		const auto b = ge.cargo.TotalCount();
+		ge.cargo.InvalidateCache();
+		if (a != ge.cargo.PeriodsInTransit() || b != ge.cargo.TotalCount()) {
+			Debug(desync, 1, "warning: station cargo cache mismatch: station {}, cargo {}", st->index, cargo);
+		}
+	}
+}
+
+/** Number of ticks in which the sampled check visits every vehicle and station once. */
+static const uint CACHE_CHECK_SAMPLE_PERIOD = Ticks::DAY_TICKS * 30;
+
+/**
+ * Check a few items of a pool, such that all items are checked once every #CACHE_CHECK_SAMPLE_PERIOD ticks.
+ * @tparam T The type of the items.
+ * @param cursor The index of the next item to check; advanced past the checked items.
+ * @param check The check to perform on an item.
+ */
+template <class T, class F>
+static void CheckCacheSample(size_t &cursor, F check)
+{
+	size_t pool_size = T::GetPoolSize();
+	size_t count = CeilDiv(pool_size, CACHE_CHECK_SAMPLE_PERIOD);
+	for (size_t i = 0; i < count; i++) {
+		if (cursor >= pool_size) cursor = 0;
+		if (T::IsValidID(cursor)) check(T::Get(cursor));
+		cursor++;
+	}
+}
+
+/**
+ * Check the caches of a small part of the vehicles and stations. This is cheap enough
+ * to be done every tick on a busy server, and still checks everything once in a while.
+ */
+static void CheckCachesSampled()
+{
+	static size_t vehicle_cursor = 0;
+	static size_t station_cursor = 0;
+
+	CheckCacheSample<Vehicle>(vehicle_cursor, [](Vehicle *v) {
+		CheckVehicleCargoCache(v);
+		if (v == v->First() && !(v->vehstatus & VS_CRASHED) && v->IsPrimaryVehicle()) CheckVehicleCaches(v);
+	});
+	CheckCacheSample<Station>(station_cursor, [](Station *st) {
+		CheckStationCargoCaches(st);
+	});
+}
+
 /**
  * Check the validity of some of the caches.
  * Especially in the sense of desyncs between
  * the cached value and what the value would
  * be when calculated from the 'base' data.
+ * At \c -d desync=1 only a sample of the vehicles and stations is checked each tick.
  */
 void CheckCaches()
 {
 	/* Return here so it is easy to add checks that are run
 	 * always to aid testing of caches. */
-	if (_debug_desync_level <= 1) return;
+	if (_debug_desync_level < 1) return;
+
+	/* Checking everything every tick is too slow for anything but debugging. */
+	if (_debug_desync_level == 1) {
+		CheckCachesSampled();
+		return;
+	}
 
 	/* Check the town caches. */
 	std::vector<TownCache> old_town_caches;
@@ -79,84 +224,13 @@ void CheckCaches()
 		rs->GetEntry(DIAGDIR_NW)->CheckIntegrity(rs);
 	}
 
-	std::vector<NewGRFCache> grf_cache;
-	std::vector<VehicleCache> veh_cache;
-	std::vector<GroundVehicleCache> gro_cache;
-	std::vector<TrainCache> tra_cache;
-
 	for (Vehicle *v : Vehicle::Iterate()) {
 		if (v != v->First() || v->vehstatus & VS_CRASHED || !v->IsPrimaryVehicle()) continue;
-
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			grf_cache.emplace_back(u->grf_cache);
-			veh_cache.emplace_back(u->vcache);
-			switch (u->type) {
-				case VEH_TRAIN:
-					gro_cache.emplace_back(Train::From(u)->gcache);
-					tra_cache.emplace_back(Train::From(u)->tcache);
-					break;
-				case VEH_ROAD:
-					gro_cache.emplace_back(RoadVehicle::From(u)->gcache);
-					break;
-				default:
-					break;
-			}
-		}
-
-		switch (v->type) {
-			case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
-			case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
-			case VEH_AIRCRAFT: UpdateAircraftCache(Aircraft::From(v));   break;
-			case VEH_SHIP:     Ship::From(v)->UpdateCache();             break;
-			default: break;
-		}
-
-		uint length = 0;
-		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
-			FillNewGRFVehicleCache(u);
-			if (grf_cache[length] != u->grf_cache) {
-				Debug(desync, 2, "warning: newgrf cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
-			}
-			if (veh_cache[length] != u->vcache) {
-				Debug(desync, 2, "warning: vehicle cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
-			}
-			switch (u->type) {
-				case VEH_TRAIN:
-					if (gro_cache[length] != Train::From(u)->gcache) {
-						Debug(desync, 2, "warning: train ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					if (tra_cache[length] != Train::From(u)->tcache) {
-						Debug(desync, 2, "warning: train cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					break;
-				case VEH_ROAD:
-					if (gro_cache[length] != RoadVehicle::From(u)->gcache) {
-						Debug(desync, 2, "warning: road vehicle ground vehicle cache mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, length);
-					}
-					break;
-				default:
-					break;
-			}
-			length++;
-		}
-
-		grf_cache.clear();
-		veh_cache.clear();
-		gro_cache.clear();
-		tra_cache.clear();
+		CheckVehicleCaches(v);
 	}
 
 	/* Check whether the caches are still valid */
-	for (Vehicle *v : Vehicle::Iterate()) {
-		[[maybe_unused]] const auto a = v->cargo.PeriodsInTransit();
-		[[maybe_unused]] const auto b = v->cargo.TotalCount();
-		[[maybe_unused]] const auto c = v->cargo.GetFeederShare();
-		v->cargo.InvalidateCache();
-		assert(a == v->cargo.PeriodsInTransit());
-		assert(b == v->cargo.TotalCount());
-		assert(c == v->cargo.GetFeederShare());
-	}
+	for (Vehicle *v : Vehicle::Iterate()) CheckVehicleCargoCache(v);
 
 	/* Backup stations_near */
 	std::vector<StationList> old_town_stations_near;
@@ -169,13 +243,7 @@ void CheckCaches()
 	for (Station *st : Station::Iterate()) old_station_industries_near.push_back(st->industries_near);
 
 	for (Station *st : Station::Iterate()) {
-		for (GoodsEntry &ge : st->goods) {
-			[[maybe_unused]] const auto a = ge.cargo.PeriodsInTransit();
-			[[maybe_unused]] const auto b = ge.cargo.TotalCount();
-			ge.cargo.InvalidateCache();
-			assert(a == ge.cargo.PeriodsInTransit());
-			assert(b == ge.cargo.TotalCount());
-		}
+		CheckStationCargoCaches(st);
 
 		/* Check docking tiles */
 		TileArea ta;
@@ -222,3 +290,64 @@ void CheckCaches()
 		i++;
 	}
 }
+
+/**
+ * Mix a value into a hash of the game state.
+ * @param hash The hash so far.
+ * @param value The value to add.
+ * @return The new hash.
+ */
+static inline uint64_t MixStateHash(uint64_t hash, uint64_t value)
+{
+	/* FNV-1a style mixing of the whole value at once; good enough to notice differences. */
+	return (hash ^ value) * 0x100000001B3ULL;
+}
+
+/**
+ * Log hashes of parts of the game state, so the log of a client can be compared
+ * with the log of the server to find out where they started to differ.
+ * The hashes are logged daily at \c -d desync=1; the map is only hashed from
+ * \c -d desync=2 because walking all tiles is slow on large maps.
+ */
+void LogStateHashes()
+{
+	if (_debug_desync_level < 1 || TimerGameEconomy::date_fract != 0) return;
+
+	const uint64_t SEED = 0xCBF29CE484222325ULL;
+
+	uint64_t companies = SEED;
+	for (const Company *c : Company::Iterate()) {
+		companies = MixStateHash(companies, c->index);
+		companies = MixStateHash(companies, (int64_t)c->money);
+		companies = MixStateHash(companies, (int64_t)c->current_loan);
+	}
+
+	uint64_t vehicles = SEED;
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		vehicles = MixStateHash(vehicles, v->index);
+		vehicles = MixStateHash(vehicles, v->tile.base());
+		vehicles = MixStateHash(vehicles, (uint64_t)v->x_pos << 32 | (uint32_t)v->y_pos);
+		vehicles = MixStateHash(vehicles, (uint64_t)v->z_pos << 32 | v->cur_speed << 16 | v->progress << 8 | v->direction);
+		vehicles = MixStateHash(vehicles, (uint64_t)v->vehstatus << 32 | v->cargo.TotalCount());
+	}
+
+	uint64_t cargo = SEED;
+	for (const Station *st : Station::Iterate()) {
+		cargo = MixStateHash(cargo, st->index);
+		for (const GoodsEntry &ge : st->goods) {
+			cargo = MixStateHash(cargo, (uint64_t)ge.cargo.TotalCount() << 32 | ge.rating);
+		}
+	}
+
+	Debug(desync, 1, "state: {:08x}; {:02x}; companies {:016x}; vehicles {:016x}; cargo {:016x}", TimerGameEconomy::date, TimerGameEconomy::date_fract, companies, vehicles, cargo);
+
+	if (_debug_desync_level < 2) return;
+
+	uint64_t map = SEED;
+	for (uint i = 0; i < Map::Size(); i++) {
+		Tile tile(i);
+		map = MixStateHash(map, (uint64_t)tile.type() << 56 | (uint64_t)tile.height() << 48 | (uint64_t)tile.m1() << 40 | (uint64_t)tile.m2() << 24 | tile.m3() << 16 | tile.m4() << 8 | tile.m5());
+		map = MixStateHash(map, tile.m6() << 24 | tile.m7() << 16 | tile.m8());
+	}
+	Debug(desync, 2, "state: {:08x}; {:02x}; map {:016x}", TimerGameEconomy::date, TimerGameEconomy::date_fract, map);
+}
@@ -119,6 +119,9 @@ void AddCargoDelivery(CargoID cargo_type, CompanyID company, uint32_t amount, So
 {
 	if (amount == 0) return;
 
+	/* Most of the time nothing is monitored at all. */
+	if (_cargo_pickups.empty() && _cargo_deliveries.empty()) return;
+
 	if (src != INVALID_SOURCE) {
 		/* Handle pickup update. */
 		switch (src_type) {
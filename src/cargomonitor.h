@@ -15,6 +15,7 @@
 #include "industry.h"
 #include "town.h"
 #include "core/overflowsafe_type.hpp"
+#include "core/flatmap_type.hpp"
 
 struct Station;
 
@@ -29,7 +30,7 @@ struct Station;
 typedef uint32_t CargoMonitorID; ///< Type of the cargo monitor number.
 
 /** Map type for storing and updating active cargo monitor numbers and their amounts. */
-typedef std::map<CargoMonitorID, OverflowSafeInt32> CargoMonitorMap;
+typedef FlatMap<CargoMonitorID, OverflowSafeInt32> CargoMonitorMap;
 
 extern CargoMonitorMap _cargo_pickups;
 extern CargoMonitorMap _cargo_deliveries;
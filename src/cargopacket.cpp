@@ -686,16 +686,48 @@ void StationCargoList::Append(CargoPacket *cp, StationID next)
 	assert(cp != nullptr);
 	this->AddToCache(cp);
 
+	uint tolerance = _settings_game.station.cargo_merge_tolerance;
 	StationCargoPacketMap::List &list = this->packets[next];
 	for (StationCargoPacketMap::List::reverse_iterator it(list.rbegin());
 			it != list.rend(); it++) {
 		if (StationCargoList::TryMerge(*it, cp)) return;
+		if (tolerance != 0 && this->TryMergeApproximately(*it, cp, tolerance)) return;
 	}
 
 	/* The packet could not be merged with another one */
 	list.push_back(cp);
 }
 
+/**
+ * Tries to merge the second packet into the first even if their time in
+ * transit differs a bit. The merged packet gets the average time in transit of
+ * both, so the income on delivery is off by at most the tolerance.
+ * @param icp Packet in this list to be merged into.
+ * @param cp Packet to be eliminated; it has already been added to the cache.
+ * @param tolerance Maximum difference in cargo aging periods in transit.
+ * @return If the packets could be merged.
+ */
+bool StationCargoList::TryMergeApproximately(CargoPacket *icp, CargoPacket *cp, uint tolerance)
+{
+	if (icp->source_xy != cp->source_xy || icp->source_type != cp->source_type ||
+			icp->first_station != cp->first_station || icp->source_id != cp->source_id) {
+		return false;
+	}
+	if (Delta(icp->periods_in_transit, cp->periods_in_transit) > tolerance) return false;
+
+	uint total = icp->count + cp->count;
+	if (total > CargoPacket::MAX_COUNT) return false;
+
+	/* The time in transit of the packet changes, so the cache has to be told about both. */
+	this->RemoveFromCache(icp, icp->count);
+	this->RemoveFromCache(cp, cp->count);
+	icp->periods_in_transit = static_cast<uint16_t>((static_cast<uint>(icp->periods_in_transit) * icp->count +
+			static_cast<uint>(cp->periods_in_transit) * cp->count + total / 2) / total);
+	icp->Merge(cp);
+	this->AddToCache(icp);
+	return true;
+}
+
 /**
  * Shifts cargo from the front of the packet list for a specific station and
  * applies some action to it.
@@ -549,6 +549,8 @@ public:
 
 	static void InvalidateAllFrom(SourceType src_type, SourceID src);
 
+	bool TryMergeApproximately(CargoPacket *icp, CargoPacket *cp, uint tolerance);
+
 	template<class Taction>
 	bool ShiftCargo(Taction &action, StationID next);
 
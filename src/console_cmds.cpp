@@ -41,6 +41,12 @@
 #include "road.h"
 #include "rail.h"
 #include "game/game.hpp"
+#include "game/game_instance.hpp"
+#include "ai/ai_instance.hpp"
+#include "company_base.h"
+#include "spritecache.h"
+#include "script/script_profiler.hpp"
+#include "trace.h"
 #include "table/strings.h"
 #include "3rdparty/fmt/chrono.h"
 #include "company_cmd.h"
@@ -2551,6 +2557,144 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 	return false;
 }
 
+DEF_CONSOLE_CMD(ConNewGRFStats)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Aggregate the number of and time spent in NewGRF sprite requests and callbacks, per GRF, feature and callback. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_stats start':");
+		IConsolePrint(CC_HELP, "  Begin aggregating. This is cheap enough to leave running.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_stats stop':");
+		IConsolePrint(CC_HELP, "  Stop aggregating, keeping the data collected so far.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_stats reset':");
+		IConsolePrint(CC_HELP, "  Discard the data collected so far.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_stats [show] [<count>]':");
+		IConsolePrint(CC_HELP, "  Show the GRFs and the callbacks that took the most time; 10 of each unless a count is given.");
+		return true;
+	}
+
+	/* 'newgrf_stats <count>' is short for 'newgrf_stats show <count>'. */
+	uint32_t value;
+	bool count_only = argc == 2 && GetArgumentInteger(&value, argv[1]);
+	if (argc == 1 || count_only || StrStartsWithIgnoreCase(argv[1], "sho")) {
+		uint32_t count = 10;
+		if (count_only) {
+			count = value;
+		} else if (argc >= 3 && !GetArgumentInteger(&count, argv[2])) {
+			return false;
+		}
+		IConsolePrint(CC_INFO, "NewGRF statistics are {}.", _newgrf_aggregate_profiling ? "being collected" : "not being collected");
+		NewGRFAggregateProfiler::Print(std::max<uint32_t>(count, 1));
+		return true;
+	}
+
+	if (StrStartsWithIgnoreCase(argv[1], "sta")) {
+		_newgrf_aggregate_profiling = true;
+		return true;
+	}
+
+	if (StrStartsWithIgnoreCase(argv[1], "sto")) {
+		_newgrf_aggregate_profiling = false;
+		return true;
+	}
+
+	if (StrStartsWithIgnoreCase(argv[1], "res")) {
+		NewGRFAggregateProfiler::Reset();
+		return true;
+	}
+
+	return false;
+}
+
+DEF_CONSOLE_CMD(ConScriptProfile)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Collect performance data about the AIs and the game script. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'script_profile start':");
+		IConsolePrint(CC_HELP, "  Begin sampling which script functions and lines the opcodes and time are spent in.");
+		IConsolePrint(CC_HELP, "Usage: 'script_profile stop':");
+		IConsolePrint(CC_HELP, "  End profiling and write the collected data as folded stacks for flame graph tools.");
+		IConsolePrint(CC_HELP, "Usage: 'script_profile abort':");
+		IConsolePrint(CC_HELP, "  End profiling and discard all collected data.");
+		return true;
+	}
+
+	if (argc != 2) return false;
+
+	/* "start" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sta")) {
+		if (ScriptProfiler::IsActive()) {
+			IConsolePrint(CC_ERROR, "Script profiling is already active.");
+		} else {
+			ScriptProfiler::Start();
+			IConsolePrint(CC_DEBUG, "Started script profiling.");
+		}
+		return true;
+	}
+
+	/* "stop" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sto")) {
+		if (!ScriptProfiler::IsActive()) {
+			IConsolePrint(CC_ERROR, "Script profiling is not active.");
+		} else {
+			ScriptProfiler::Finish();
+		}
+		return true;
+	}
+
+	/* "abort" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "abo")) {
+		ScriptProfiler::Abort();
+		return true;
+	}
+
+	return false;
+}
+
+DEF_CONSOLE_CMD(ConTrace)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Trace the time spent in parts of the game loop, for viewing in chrome://tracing or Perfetto. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'trace start':");
+		IConsolePrint(CC_HELP, "  Begin recording; only the last {} zones are kept.", Tracer::MAX_EVENTS);
+		IConsolePrint(CC_HELP, "Usage: 'trace dump [<num-ticks>]':");
+		IConsolePrint(CC_HELP, "  Write the recorded zones of the last ticks, or all of them, to a JSON file. Recording continues.");
+		IConsolePrint(CC_HELP, "Usage: 'trace stop':");
+		IConsolePrint(CC_HELP, "  End recording and discard all recorded zones.");
+		return true;
+	}
+
+	if (argc < 2 || argc > 3) return false;
+
+	/* "start" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sta")) {
+		if (Tracer::IsActive()) {
+			IConsolePrint(CC_ERROR, "Tracing is already active.");
+		} else {
+			Tracer::Start();
+			IConsolePrint(CC_DEBUG, "Started tracing.");
+		}
+		return true;
+	}
+
+	/* "dump" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "dum")) {
+		if (!Tracer::IsActive()) {
+			IConsolePrint(CC_ERROR, "Tracing is not active.");
+		} else {
+			Tracer::Dump(argc == 3 ? std::max(atoi(argv[2]), 0) : 0);
+		}
+		return true;
+	}
+
+	/* "stop" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sto")) {
+		Tracer::Stop();
+		return true;
+	}
+
+	return false;
+}
+
 #ifdef _DEBUG
 /******************
  *  debug commands
@@ -2575,6 +2719,47 @@ DEF_CONSOLE_CMD(ConFramerate)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConMemory)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Show the memory used by the pools, the map, the sprite cache and the scripts.");
+		return true;
+	}
+
+	auto print = [](std::string_view name, size_t items, size_t used, size_t allocated) {
+		IConsolePrint(CC_DEFAULT, "{:<24} {:>9} items  {:>9} KiB used  {:>9} KiB allocated", name, items, used / 1024, allocated / 1024);
+	};
+
+	size_t total = 0;
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		PoolMemoryUsage usage = pool->GetMemoryUsage();
+		print(pool->GetName(), usage.items, usage.used_bytes, usage.allocated_bytes);
+		total += usage.allocated_bytes;
+	}
+
+	size_t map_bytes = Map::GetMemoryUsage();
+	print("Map", Map::Size(), map_bytes, map_bytes);
+	total += map_bytes;
+
+	print("Sprite cache", 0, GetSpriteCacheUsage(), GetSpriteCacheBudget());
+	total += GetSpriteCacheUsage();
+
+	if (Game::GetInstance() != nullptr) {
+		size_t bytes = Game::GetInstance()->GetAllocatedMemory();
+		print("Game script", 0, bytes, bytes);
+		total += bytes;
+	}
+	for (const Company *c : Company::Iterate()) {
+		if (c->ai_instance == nullptr) continue;
+		size_t bytes = c->ai_instance->GetAllocatedMemory();
+		print(fmt::format("AI company {}", c->index + 1), 0, bytes, bytes);
+		total += bytes;
+	}
+
+	IConsolePrint(CC_INFO, "Total of the above: {} KiB", total / 1024);
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConFramerateWindow)
 {
 	if (argc == 0) {
@@ -2832,6 +3017,8 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("list_game",               ConListGame);
 	IConsole::CmdRegister("list_game_libs",          ConListGameLibs);
 	IConsole::CmdRegister("rescan_game",             ConRescanGame);
+	IConsole::CmdRegister("script_profile",          ConScriptProfile);
+	IConsole::CmdRegister("trace",                   ConTrace);
 
 	IConsole::CmdRegister("companies",               ConCompanies);
 	IConsole::AliasRegister("players",               "companies");
@@ -2899,10 +3086,12 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("memory",                  ConMemory);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
 	IConsole::CmdRegister("newgrf_profile",          ConNewGRFProfile,    ConHookNewGRFDeveloperTool);
+	IConsole::CmdRegister("newgrf_stats",            ConNewGRFStats);
 
 	IConsole::CmdRegister("dump_info",               ConDumpInfo);
 }
@@ -0,0 +1,175 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file flatmap_type.hpp Map with its items stored in a sorted vector. */
+
+#ifndef FLATMAP_TYPE_HPP
+#define FLATMAP_TYPE_HPP
+
+/**
+ * Map that stores its items in one sorted vector instead of a tree of nodes.
+ * For the small maps that are iterated much more often than they are changed
+ * this is a lot cheaper in memory and in cache misses than std::map, while the
+ * order of iteration is exactly the same.
+ *
+ * Mind that unlike std::map, inserting or erasing invalidates all iterators,
+ * pointers and references into the map.
+ * @tparam Tkey Type of the keys.
+ * @tparam Tvalue Type of the values.
+ * @tparam Tcompare Comparator for the keys.
+ */
+template <typename Tkey, typename Tvalue, typename Tcompare = std::less<Tkey>>
+class FlatMap {
+public:
+	using key_type = Tkey;
+	using mapped_type = Tvalue;
+	using value_type = std::pair<Tkey, Tvalue>;
+	using size_type = size_t;
+	using iterator = typename std::vector<value_type>::iterator;
+	using const_iterator = typename std::vector<value_type>::const_iterator;
+	using reverse_iterator = typename std::vector<value_type>::reverse_iterator;
+	using const_reverse_iterator = typename std::vector<value_type>::const_reverse_iterator;
+
+	inline iterator begin() { return this->items.begin(); }
+	inline iterator end() { return this->items.end(); }
+	inline const_iterator begin() const { return this->items.begin(); }
+	inline const_iterator end() const { return this->items.end(); }
+	inline const_iterator cbegin() const { return this->items.cbegin(); }
+	inline const_iterator cend() const { return this->items.cend(); }
+	inline reverse_iterator rbegin() { return this->items.rbegin(); }
+	inline reverse_iterator rend() { return this->items.rend(); }
+	inline const_reverse_iterator rbegin() const { return this->items.rbegin(); }
+	inline const_reverse_iterator rend() const { return this->items.rend(); }
+
+	inline size_t size() const { return this->items.size(); }
+	inline bool empty() const { return this->items.empty(); }
+	inline void clear() { this->items.clear(); }
+	inline void swap(FlatMap &other) { this->items.swap(other.items); }
+
+	/**
+	 * Get the first item whose key is not less than the given key.
+	 * @param key Key to look for.
+	 * @return Iterator to the item, or end().
+	 */
+	inline iterator lower_bound(const Tkey &key)
+	{
+		return std::lower_bound(this->items.begin(), this->items.end(), key, KeyCompare());
+	}
+
+	inline const_iterator lower_bound(const Tkey &key) const
+	{
+		return std::lower_bound(this->items.begin(), this->items.end(), key, KeyCompare());
+	}
+
+	/**
+	 * Get the first item whose key is greater than the given key.
+	 * @param key Key to look for.
+	 * @return Iterator to the item, or end().
+	 */
+	inline iterator upper_bound(const Tkey &key)
+	{
+		return std::upper_bound(this->items.begin(), this->items.end(), key, KeyCompare());
+	}
+
+	inline const_iterator upper_bound(const Tkey &key) const
+	{
+		return std::upper_bound(this->items.begin(), this->items.end(), key, KeyCompare());
+	}
+
+	/**
+	 * Find the item with the given key.
+	 * @param key Key to look for.
+	 * @return Iterator to the item, or end() if there is no such item.
+	 */
+	inline iterator find(const Tkey &key)
+	{
+		iterator it = this->lower_bound(key);
+		return (it != this->items.end() && !Tcompare()(key, it->first)) ? it : this->items.end();
+	}
+
+	inline const_iterator find(const Tkey &key) const
+	{
+		const_iterator it = this->lower_bound(key);
+		return (it != this->items.end() && !Tcompare()(key, it->first)) ? it : this->items.end();
+	}
+
+	inline bool contains(const Tkey &key) const { return this->find(key) != this->end(); }
+
+	/**
+	 * Insert an item constructed from the given arguments, unless an item with
+	 * the same key already exists.
+	 * @param key Key of the item.
+	 * @param args Arguments for the constructor of the value.
+	 * @return Iterator to the item with the key and whether it was inserted.
+	 */
+	template <typename... Targs>
+	std::pair<iterator, bool> emplace(const Tkey &key, Targs &&... args)
+	{
+		/* Maps are mostly filled in order, so check for appending first. */
+		if (this->items.empty() || Tcompare()(this->items.back().first, key)) {
+			this->items.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Targs>(args)...));
+			return {std::prev(this->items.end()), true};
+		}
+
+		iterator it = this->lower_bound(key);
+		if (!Tcompare()(key, it->first)) return {it, false};
+		return {this->items.emplace(it, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Targs>(args)...)), true};
+	}
+
+	inline std::pair<iterator, bool> insert(const value_type &value) { return this->emplace(value.first, value.second); }
+
+	/**
+	 * Insert a range of items, skipping those whose key already exists.
+	 * @param first First item to insert.
+	 * @param last Item after the last one to insert.
+	 */
+	template <typename Titer>
+	void insert(Titer first, Titer last)
+	{
+		for (; first != last; ++first) this->emplace(first->first, first->second);
+	}
+
+	/**
+	 * Get the value for a key, inserting a default constructed one if there is none.
+	 * @param key Key to look for.
+	 * @return Reference to the value.
+	 */
+	inline Tvalue &operator[](const Tkey &key) { return this->emplace(key).first->second; }
+
+	/**
+	 * Erase an item.
+	 * @param it Iterator to the item.
+	 * @return Iterator to the item after the erased one.
+	 */
+	inline iterator erase(const_iterator it) { return this->items.erase(it); }
+
+	/**
+	 * Erase the item with the given key, if there is one.
+	 * @param key Key of the item.
+	 * @return Number of erased items.
+	 */
+	size_t erase(const Tkey &key)
+	{
+		iterator it = this->find(key);
+		if (it == this->items.end()) return 0;
+		this->items.erase(it);
+		return 1;
+	}
+
+	inline bool operator==(const FlatMap &other) const { return this->items == other.items; }
+
+private:
+	/** Comparator of items against bare keys, for the binary searches. */
+	struct KeyCompare {
+		inline bool operator()(const value_type &a, const Tkey &b) const { return Tcompare()(a.first, b); }
+		inline bool operator()(const Tkey &a, const value_type &b) const { return Tcompare()(a, b.first); }
+	};
+
+	std::vector<value_type> items; ///< The items, sorted by key.
+};
+
+#endif /* FLATMAP_TYPE_HPP */
@@ -251,11 +251,13 @@ class Kdtree {
 		/* Assume this node is the best choice for now */
 		node_distance best = std::make_pair(n.element, thisdist);
 
+		limit = std::min(best.second, limit);
+
 		/* Next node to visit */
 		size_t next = (xy[dim] < c) ? n.left : n.right;
 		if (next != INVALID_NODE) {
-			/* Check if there is a better node down the tree */
-			best = SelectNearestNodeDistance(best, this->FindNearestRecursive(xy, next, level + 1));
+			/* Check if there is a better node down the tree; anything further away than the best so far can be skipped there too. */
+			best = SelectNearestNodeDistance(best, this->FindNearestRecursive(xy, next, level + 1, limit));
 		}
 
 		limit = std::min(best.second, limit);
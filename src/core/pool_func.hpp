@@ -41,8 +41,7 @@ DEFINE_POOL_METHOD(inline)::Pool(const char *name) :
 		checked(0),
 #endif /* WITH_ASSERT */
 		cleaning(false),
-		data(nullptr),
-		alloc_cache(nullptr)
+		data(nullptr)
 { }
 
 /**
@@ -98,6 +97,21 @@ DEFINE_POOL_METHOD(inline size_t)::FindFirstFree()
 	return NO_FREE_ITEM;
 }
 
+/**
+ * Get the memory for the item with the given index from its chunk, allocating
+ * the chunk if needed. Items that are allocated shortly after each other get
+ * the lowest free indices, so this keeps them close together in memory.
+ * @param index Index of the item.
+ * @return Memory for the item; not initialised.
+ */
+DEFINE_POOL_METHOD(inline void *)::GetCachedItem(size_t index)
+{
+	size_t chunk = index / Tgrowth_step;
+	if (chunk >= this->alloc_chunks.size()) this->alloc_chunks.resize(chunk + 1, nullptr);
+	if (this->alloc_chunks[chunk] == nullptr) this->alloc_chunks[chunk] = MallocT<uint8_t>(Tgrowth_step * sizeof(Titem));
+	return this->alloc_chunks[chunk] + (index % Tgrowth_step) * sizeof(Titem);
+}
+
 /**
  * Makes given index valid
  * @param size size of item
@@ -113,10 +127,9 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 	this->items++;
 
 	Titem *item;
-	if (Tcache && this->alloc_cache != nullptr) {
+	if (Tcache) {
 		assert(sizeof(Titem) == size);
-		item = reinterpret_cast<Titem *>(this->alloc_cache);
-		this->alloc_cache = this->alloc_cache->next;
+		item = reinterpret_cast<Titem *>(this->GetCachedItem(index));
 		if (Tzero) {
 			/* Explicitly casting to (void *) prevents a clang warning -
 			 * we are actually memsetting a (not-yet-constructed) object */
@@ -187,13 +200,8 @@ DEFINE_POOL_METHOD(void)::FreeItem(size_t index)
 {
 	assert(index < this->size);
 	assert(this->data[index] != nullptr);
-	if (Tcache) {
-		AllocCache *ac = reinterpret_cast<AllocCache *>(this->data[index]);
-		ac->next = this->alloc_cache;
-		this->alloc_cache = ac;
-	} else {
-		free(this->data[index]);
-	}
+	/* With Tcache the memory stays in its chunk to be reused for the same index. */
+	if (!Tcache) free(this->data[index]);
 	this->data[index] = nullptr;
 	this->first_free = std::min(this->first_free, index);
 	this->items--;
@@ -219,12 +227,32 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	this->cleaning = false;
 
 	if (Tcache) {
-		while (this->alloc_cache != nullptr) {
-			AllocCache *ac = this->alloc_cache;
-			this->alloc_cache = ac->next;
-			free(ac);
+		for (uint8_t *chunk : this->alloc_chunks) free(chunk);
+		this->alloc_chunks.clear();
+		this->alloc_chunks.shrink_to_fit();
+	}
+}
+
+/**
+ * Get the memory used by the pool. Items of subclasses that are larger than
+ * \c Titem are only counted with the size of \c Titem.
+ * @return the memory usage
+ */
+DEFINE_POOL_METHOD(PoolMemoryUsage)::GetMemoryUsage() const
+{
+	PoolMemoryUsage usage;
+	usage.items = this->items;
+	usage.used_bytes = this->items * sizeof(Titem);
+	usage.allocated_bytes = this->size * sizeof(Titem *) + this->used_bitmap.capacity() * sizeof(BitmapStorage);
+	if (Tcache) {
+		usage.allocated_bytes += this->alloc_chunks.capacity() * sizeof(uint8_t *);
+		for (const uint8_t *chunk : this->alloc_chunks) {
+			if (chunk != nullptr) usage.allocated_bytes += Tgrowth_step * sizeof(Titem);
 		}
+	} else {
+		usage.allocated_bytes += usage.used_bytes;
 	}
+	return usage;
 }
 
 #undef DEFINE_POOL_METHOD
@@ -238,6 +266,7 @@ DEFINE_POOL_METHOD(void)::CleanPool()
 	template void * name ## Pool::GetNew(size_t size); \
 	template void * name ## Pool::GetNew(size_t size, size_t index); \
 	template void name ## Pool::FreeItem(size_t index); \
-	template void name ## Pool::CleanPool();
+	template void name ## Pool::CleanPool(); \
+	template PoolMemoryUsage name ## Pool::GetMemoryUsage() const;
 
 #endif /* POOL_FUNC_HPP */
@@ -10,6 +10,7 @@
 #ifndef POOL_TYPE_HPP
 #define POOL_TYPE_HPP
 
+#include "bitmath_func.hpp"
 #include "enum_type.hpp"
 
 /** Various types of a pool. */
@@ -25,6 +26,13 @@ DECLARE_ENUM_AS_BIT_SET(PoolType)
 
 typedef std::vector<struct PoolBase *> PoolVector; ///< Vector of pointers to PoolBase
 
+/** Memory used by a pool. */
+struct PoolMemoryUsage {
+	size_t items;           ///< Number of items in the pool.
+	size_t used_bytes;      ///< Bytes used by the items themselves.
+	size_t allocated_bytes; ///< Bytes allocated by the pool, including its index and the memory kept for free items.
+};
+
 /** Base class for base of all pools. */
 struct PoolBase {
 	const PoolType type; ///< Type of this pool.
@@ -57,6 +65,18 @@ struct PoolBase {
 	 */
 	virtual void CleanPool() = 0;
 
+	/**
+	 * Get the name of the pool, for reporting.
+	 * @return the name
+	 */
+	virtual const char *GetName() const = 0;
+
+	/**
+	 * Get the memory used by the pool.
+	 * @return the memory usage
+	 */
+	virtual PoolMemoryUsage GetMemoryUsage() const = 0;
+
 private:
 	/**
 	 * Dummy private copy constructor to prevent compilers from
@@ -73,6 +93,8 @@ private:
  * @tparam Tmax_size    Maximum size of the pool
  * @tparam Tpool_type   Type of this pool
  * @tparam Tcache       Whether to perform 'alloc' caching, i.e. don't actually free/malloc just reuse the memory
+ *                      The memory is then allocated in chunks of Tgrowth_step items, and each index always
+ *                      uses the same slot in its chunk, so items with nearby indices are nearby in memory.
  * @tparam Tzero        Whether to zero the memory
  * @warning when Tcache is enabled *all* instances of this pool's item must be of the same size.
  */
@@ -102,6 +124,8 @@ struct Pool : PoolBase {
 
 	Pool(const char *name);
 	void CleanPool() override;
+	const char *GetName() const override { return this->name; }
+	PoolMemoryUsage GetMemoryUsage() const override;
 
 	/**
 	 * Returns Titem with given index
@@ -125,6 +149,25 @@ struct Pool : PoolBase {
 		return index < this->first_unused && this->Get(index) != nullptr;
 	}
 
+	/**
+	 * Get the first used index at or after the given index. The bitmap of used
+	 * indices is used to skip over the free indices a whole word at a time.
+	 * @param index index to start looking at
+	 * @return the first used index, or first_unused if there is none
+	 */
+	inline size_t GetNextUsedIndex(size_t index) const
+	{
+		if (index >= this->first_unused) return this->first_unused;
+
+		size_t word = index / BITMAP_SIZE;
+		BitmapStorage used = this->used_bitmap[word] & ((~static_cast<BitmapStorage>(0)) << (index % BITMAP_SIZE));
+		while (used == 0) {
+			if (++word * BITMAP_SIZE >= this->first_unused) return this->first_unused;
+			used = this->used_bitmap[word];
+		}
+		return std::min<size_t>(word * BITMAP_SIZE + FindFirstBit(used), this->first_unused);
+	}
+
 	/**
 	 * Tests whether we can allocate 'n' items
 	 * @param n number of items we want to allocate
@@ -165,8 +208,13 @@ struct Pool : PoolBase {
 		size_t index;
 		void ValidateIndex()
 		{
-			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index))) this->index++;
-			if (this->index >= T::GetPoolSize()) this->index = T::Pool::MAX_SIZE;
+			for (;;) {
+				this->index = T::GetNextUsedIndex(this->index);
+				if (this->index >= T::GetPoolSize()) break;
+				if (T::IsValidID(this->index)) return;
+				this->index++;
+			}
+			this->index = T::Pool::MAX_SIZE;
 		}
 	};
 
@@ -210,8 +258,13 @@ struct Pool : PoolBase {
 		F filter;
 		void ValidateIndex()
 		{
-			while (this->index < T::GetPoolSize() && !(T::IsValidID(this->index) && this->filter(this->index))) this->index++;
-			if (this->index >= T::GetPoolSize()) this->index = T::Pool::MAX_SIZE;
+			for (;;) {
+				this->index = T::GetNextUsedIndex(this->index);
+				if (this->index >= T::GetPoolSize()) break;
+				if (T::IsValidID(this->index) && this->filter(this->index)) return;
+				this->index++;
+			}
+			this->index = T::Pool::MAX_SIZE;
 		}
 	};
 
@@ -352,6 +405,17 @@ struct Pool : PoolBase {
 			return index < Tpool->first_unused ? Tpool->Get(index) : nullptr;
 		}
 
+		/**
+		 * Returns the first used index at or after the given index.
+		 * Useful when iterating over all pool items.
+		 * @param index index to start looking at
+		 * @return the first used index, or GetPoolSize() if there is none
+		 */
+		static inline size_t GetNextUsedIndex(size_t index)
+		{
+			return Tpool->GetNextUsedIndex(index);
+		}
+
 		/**
 		 * Returns first unused index. Useful when iterating over
 		 * all pool items.
@@ -391,18 +455,10 @@ struct Pool : PoolBase {
 private:
 	static const size_t NO_FREE_ITEM = MAX_UVALUE(size_t); ///< Constant to indicate we can't allocate any more items
 
-	/**
-	 * Helper struct to cache 'freed' PoolItems so we
-	 * do not need to allocate them again.
-	 */
-	struct AllocCache {
-		/** The next in our 'cache' */
-		AllocCache *next;
-	};
-
-	/** Cache of freed pointers */
-	AllocCache *alloc_cache;
+	/** Chunks of memory for Tgrowth_step items each, used when Tcache is enabled. */
+	std::vector<uint8_t *> alloc_chunks;
 
+	void *GetCachedItem(size_t index);
 	void *AllocateItem(size_t size, size_t index);
 	void ResizeFor(size_t index);
 	size_t FindFirstFree();
@@ -10,6 +10,10 @@
 #include "stdafx.h"
 #include "core/bitmath_func.hpp"
 
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
 #include "safeguards.h"
 
 /**
@@ -26,7 +30,16 @@
 #if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
 void ottd_cpuid(int info[4], int type)
 {
-	__cpuid(info, type);
+	__cpuidex(info, type, 0);
+}
+
+/**
+ * Get the state components the operating system saves on context switches.
+ * @return The lower 32 bits of extended control register 0.
+ */
+static uint32_t ottd_xgetbv0()
+{
+	return static_cast<uint32_t>(_xgetbv(0));
 }
 #elif defined(__x86_64__) || defined(__i386)
 void ottd_cpuid(int info[4], int type)
@@ -46,16 +59,27 @@ void ottd_cpuid(int info[4], int type)
 			/* It is safe to write "=r" for (info[1]) as in case that PIC is enabled for i386,
 			 * the compiler will not choose EBX as target register (but something else).
 			 */
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #else
 	__asm__ __volatile__ (
 			"cpuid           \n\t"
 			: "=a" (info[0]), "=b" (info[1]), "=c" (info[2]), "=d" (info[3])
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #endif /* i386 PIC */
 }
+
+/**
+ * Get the state components the operating system saves on context switches.
+ * @return The lower 32 bits of extended control register 0.
+ */
+static uint32_t ottd_xgetbv0()
+{
+	uint32_t eax, edx;
+	__asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+	return eax;
+}
 #elif defined(__e2k__) /* MCST Elbrus 2000*/
 void ottd_cpuid(int info[4], int type)
 {
@@ -91,3 +115,22 @@ bool HasCPUIDFlag(uint type, uint index, uint bit)
 	ottd_cpuid(cpu_info, type);
 	return HasBit(cpu_info[index], bit);
 }
+
+/**
+ * Check whether AVX2 instructions can be used. Next to the CPU supporting
+ * them, the operating system has to save the AVX registers on context switches.
+ * @return True iff AVX2 instructions can be used.
+ */
+bool HasCPUAVX2Support()
+{
+#if (defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))) || defined(__x86_64__) || defined(__i386)
+	/* OSXSAVE and AVX. */
+	if (!HasCPUIDFlag(1, 2, 27) || !HasCPUIDFlag(1, 2, 28)) return false;
+	/* AVX2. */
+	if (!HasCPUIDFlag(7, 1, 5)) return false;
+	/* The XMM and the YMM state are saved by the operating system. */
+	return (ottd_xgetbv0() & 0x6) == 0x6;
+#else
+	return false;
+#endif
+}
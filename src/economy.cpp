@@ -49,6 +49,7 @@
 #include "goal_base.h"
 #include "story_base.h"
 #include "linkgraph/refresh.h"
+#include "pathfinder/yapf/yapf_cache.h"
 #include "company_cmd.h"
 #include "economy_cmd.h"
 #include "vehicle_cmd.h"
@@ -105,50 +106,98 @@ Economy _economy;
 Prices _price;
 static PriceMultipliers _price_base_multiplier;
 
+/** What the companies own in the vehicle and station pools, as used for their rating and value. */
+struct CompanyPoolStats {
+	uint station_facilities = 0;          ///< Number of facilities of all stations.
+	uint serviced_station_facilities = 0; ///< Number of facilities of the stations that were serviced recently.
+	Money vehicle_value = 0;              ///< Value of the vehicles that count for the company value.
+	uint profitable_vehicles = 0;         ///< Number of primary vehicles that made a profit last year.
+	Money min_profit = 0;                 ///< Lowest profit last year of the primary vehicles that are old enough.
+	bool has_min_profit = false;          ///< Whether any primary vehicle is old enough to have a minimum profit.
+};
+
+/** The pool statistics for all companies. */
+using CompanyPoolStatsArray = std::array<CompanyPoolStats, MAX_COMPANIES>;
+
 /**
- * Calculate the value of the assets of a company.
- *
- * @param c The company to calculate the value of.
- * @return The value of the assets of the company.
+ * Gather the pool statistics of all companies at once, so the vehicle and
+ * station pools are walked once instead of once for every company.
+ * @param[out] stats The statistics for all companies.
  */
-static Money CalculateCompanyAssetValue(const Company *c)
+static void GatherCompanyPoolStats(CompanyPoolStatsArray &stats)
 {
-	Owner owner = c->index;
-
-	uint num = 0;
+	stats = {};
 
 	for (const Station *st : Station::Iterate()) {
-		if (st->owner == owner) num += CountBits((uint8_t)st->facilities);
-	}
+		if (st->owner >= MAX_COMPANIES) continue;
 
-	Money value = num * _price[PR_STATION_VALUE] * 25;
+		CompanyPoolStats &cs = stats[st->owner];
+		uint facilities = CountBits((uint8_t)st->facilities);
+		cs.station_facilities += facilities;
+		/* Only count stations that are actually serviced */
+		if (st->time_since_load <= 20 || st->time_since_unload <= 20) cs.serviced_station_facilities += facilities;
+	}
 
 	for (const Vehicle *v : Vehicle::Iterate()) {
-		if (v->owner != owner) continue;
+		if (v->owner >= MAX_COMPANIES) continue;
 
+		CompanyPoolStats &cs = stats[v->owner];
 		if (v->type == VEH_TRAIN ||
 				v->type == VEH_ROAD ||
 				(v->type == VEH_AIRCRAFT && Aircraft::From(v)->IsNormalAircraft()) ||
 				v->type == VEH_SHIP) {
-			value += v->value * 3 >> 1;
+			cs.vehicle_value += v->value * 3 >> 1;
+		}
+
+		if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
+			if (v->profit_last_year > 0) cs.profitable_vehicles++; // For the vehicle score only count profitable vehicles
+			if (v->economy_age > VEHICLE_PROFIT_MIN_AGE) {
+				/* Find the vehicle with the lowest amount of profit */
+				if (!cs.has_min_profit || cs.min_profit > v->profit_last_year) {
+					cs.min_profit = v->profit_last_year;
+					cs.has_min_profit = true;
+				}
+			}
 		}
 	}
+}
 
+/**
+ * Calculate the value of the assets of a company.
+ *
+ * @param stats The pool statistics of the company.
+ * @return The value of the assets of the company.
+ */
+static Money CalculateCompanyAssetValue(const CompanyPoolStats &stats)
+{
+	Money value = stats.station_facilities * _price[PR_STATION_VALUE] * 25;
+	value += stats.vehicle_value;
 	return value;
 }
 
 /**
- * Calculate the value of the company. That is the value of all
- * assets (vehicles, stations) and money (including loan),
- * except when including_loan is \c false which is useful when
- * we want to calculate the value for bankruptcy.
+ * Calculate the value of the assets of a company.
+ *
+ * @param c The company to calculate the value of.
+ * @return The value of the assets of the company.
+ */
+static Money CalculateCompanyAssetValue(const Company *c)
+{
+	CompanyPoolStatsArray stats;
+	GatherCompanyPoolStats(stats);
+	return CalculateCompanyAssetValue(stats[c->index]);
+}
+
+/**
+ * Calculate the value of the company, given its pool statistics.
  * @param c the company to get the value of.
+ * @param stats The pool statistics of the company.
  * @param including_loan include the loan in the company value.
  * @return the value of the company.
  */
-Money CalculateCompanyValue(const Company *c, bool including_loan)
+static Money CalculateCompanyValue(const Company *c, const CompanyPoolStats &stats, bool including_loan)
 {
-	Money value = CalculateCompanyAssetValue(c);
+	Money value = CalculateCompanyAssetValue(stats);
 
 	/* Add real money value */
 	if (including_loan) value -= c->current_loan;
@@ -157,6 +206,22 @@ Money CalculateCompanyValue(const Company *c, bool including_loan)
 	return std::max<Money>(value, 1);
 }
 
+/**
+ * Calculate the value of the company. That is the value of all
+ * assets (vehicles, stations) and money (including loan),
+ * except when including_loan is \c false which is useful when
+ * we want to calculate the value for bankruptcy.
+ * @param c the company to get the value of.
+ * @param including_loan include the loan in the company value.
+ * @return the value of the company.
+ */
+Money CalculateCompanyValue(const Company *c, bool including_loan)
+{
+	CompanyPoolStatsArray stats;
+	GatherCompanyPoolStats(stats);
+	return CalculateCompanyValue(c, stats[c->index], including_loan);
+}
+
 /**
  * Calculate what you have to pay to take over a company.
  *
@@ -193,12 +258,13 @@ Money CalculateHostileTakeoverValue(const Company *c)
 /**
  * if update is set to true, the economy is updated with this score
  *  (also the house is updated, should only be true in the on-tick event)
- * @param update the economy with calculated score
  * @param c company been evaluated
+ * @param stats The pool statistics of the company.
+ * @param update the economy with calculated score
  * @return actual score of this company
  *
  */
-int UpdateCompanyRatingAndValue(Company *c, bool update)
+static int UpdateCompanyRatingAndValue(Company *c, const CompanyPoolStats &stats, bool update)
 {
 	Owner owner = c->index;
 	int score = 0;
@@ -207,27 +273,9 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 
 	/* Count vehicles */
 	{
-		Money min_profit = 0;
-		bool min_profit_first = true;
-		uint num = 0;
-
-		for (const Vehicle *v : Vehicle::Iterate()) {
-			if (v->owner != owner) continue;
-			if (IsCompanyBuildableVehicleType(v->type) && v->IsPrimaryVehicle()) {
-				if (v->profit_last_year > 0) num++; // For the vehicle score only count profitable vehicles
-				if (v->economy_age > VEHICLE_PROFIT_MIN_AGE) {
-					/* Find the vehicle with the lowest amount of profit */
-					if (min_profit_first || min_profit > v->profit_last_year) {
-						min_profit = v->profit_last_year;
-						min_profit_first = false;
-					}
-				}
-			}
-		}
-
-		min_profit >>= 8; // remove the fract part
+		Money min_profit = stats.min_profit >> 8; // remove the fract part
 
-		_score_part[owner][SCORE_VEHICLES] = num;
+		_score_part[owner][SCORE_VEHICLES] = stats.profitable_vehicles;
 		/* Don't allow negative min_profit to show */
 		if (min_profit > 0) {
 			_score_part[owner][SCORE_MIN_PROFIT] = min_profit;
@@ -235,14 +283,7 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 	}
 
 	/* Count stations */
-	{
-		uint num = 0;
-		for (const Station *st : Station::Iterate()) {
-			/* Only count stations that are actually serviced */
-			if (st->owner == owner && (st->time_since_load <= 20 || st->time_since_unload <= 20)) num += CountBits((uint8_t)st->facilities);
-		}
-		_score_part[owner][SCORE_STATIONS] = num;
-	}
+	_score_part[owner][SCORE_STATIONS] = stats.serviced_station_facilities;
 
 	/* Generate statistics depending on recent income statistics */
 	{
@@ -319,13 +360,28 @@ int UpdateCompanyRatingAndValue(Company *c, bool update)
 	if (update) {
 		c->old_economy[0].performance_history = score;
 		UpdateCompanyHQ(c->location_of_HQ, score);
-		c->old_economy[0].company_value = CalculateCompanyValue(c);
+		c->old_economy[0].company_value = CalculateCompanyValue(c, stats, true);
 	}
 
 	SetWindowDirty(WC_PERFORMANCE_DETAIL, 0);
 	return score;
 }
 
+/**
+ * if update is set to true, the economy is updated with this score
+ *  (also the house is updated, should only be true in the on-tick event)
+ * @param update the economy with calculated score
+ * @param c company been evaluated
+ * @return actual score of this company
+ *
+ */
+int UpdateCompanyRatingAndValue(Company *c, bool update)
+{
+	CompanyPoolStatsArray stats;
+	GatherCompanyPoolStats(stats);
+	return UpdateCompanyRatingAndValue(c, stats[c->index], update);
+}
+
 /**
  * Change the ownership of all the items of a company.
  * @param old_owner The company that gets removed.
@@ -516,6 +572,9 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 
 		/* update signals in buffer */
 		UpdateSignalsInBuffer();
+
+		/* The cached rail segments may end at a border between the two companies' tracks. */
+		YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
 	}
 
 	/* Add airport infrastructure count of the old company to the new one. */
@@ -696,6 +755,9 @@ static void CompaniesGenStatistics()
 	/* Only run the economic statics and update company stats every 3rd economy month (1st of quarter). */
 	if (!HasBit(1 << 0 | 1 << 3 | 1 << 6 | 1 << 9, TimerGameEconomy::month)) return;
 
+	CompanyPoolStatsArray stats;
+	GatherCompanyPoolStats(stats);
+
 	for (Company *c : Company::Iterate()) {
 		/* Drop the oldest history off the end */
 		std::copy_backward(c->old_economy, c->old_economy + MAX_HISTORY_QUARTERS - 1, c->old_economy + MAX_HISTORY_QUARTERS);
@@ -704,7 +766,7 @@ static void CompaniesGenStatistics()
 
 		if (c->num_valid_stat_ent != MAX_HISTORY_QUARTERS) c->num_valid_stat_ent++;
 
-		UpdateCompanyRatingAndValue(c, true);
+		UpdateCompanyRatingAndValue(c, stats[c->index], true);
 		if (c->block_preview != 0) c->block_preview--;
 	}
 
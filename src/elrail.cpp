@@ -313,8 +313,17 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 
 	AdjustTileh(ti->tile, &tileh[TS_HOME]);
 
-	SpriteID pylon_normal = GetPylonBase(ti->tile);
-	SpriteID pylon_halftile = (halftile_corner != CORNER_INVALID) ? GetPylonBase(ti->tile, TCX_UPPER_HALFTILE) : pylon_normal;
+	/* The pylon sprites can come from a NewGRF callback, so only resolve them when a pylon is drawn. */
+	SpriteID pylon_normal = 0;
+	SpriteID pylon_halftile = 0;
+
+	/* Finding the height of a bridge means walking to its end, so do it once instead of for each PCP. */
+	bool low_bridge_above = false;
+	Track bridge_track = INVALID_TRACK;
+	if (IsBridgeAbove(ti->tile)) {
+		low_bridge_above = GetBridgeHeight(GetNorthernBridgeEnd(ti->tile)) <= GetTileMaxZ(ti->tile) + 1;
+		bridge_track = GetBridgeAxis(ti->tile) == AXIS_X ? TRACK_X : TRACK_Y;
+	}
 
 	for (DiagDirection i = DIAGDIR_BEGIN; i < DIAGDIR_END; i++) {
 		static const uint edge_corners[] = {
@@ -323,7 +332,7 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 			1 << CORNER_S | 1 << CORNER_W, // DIAGDIR_SW
 			1 << CORNER_N | 1 << CORNER_W, // DIAGDIR_NW
 		};
-		SpriteID pylon_base = (halftile_corner != CORNER_INVALID && HasBit(edge_corners[i], halftile_corner)) ? pylon_halftile : pylon_normal;
+		bool pylon_on_halftile = halftile_corner != CORNER_INVALID && HasBit(edge_corners[i], halftile_corner);
 		TileIndex neighbour = ti->tile + TileOffsByDiagDir(i);
 		int elevation = GetPCPElevation(ti->tile, i);
 
@@ -412,20 +421,14 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 		 * Remove those (simply by ANDing with allowed, since these markers are never allowed) */
 		if ((PPPallowed[i] & PPPpreferred[i]) != 0) PPPallowed[i] &= PPPpreferred[i];
 
-		if (IsBridgeAbove(ti->tile)) {
-			Track bridgetrack = GetBridgeAxis(ti->tile) == AXIS_X ? TRACK_X : TRACK_Y;
-			int height = GetBridgeHeight(GetNorthernBridgeEnd(ti->tile));
-
-			if ((height <= GetTileMaxZ(ti->tile) + 1) &&
-					(i == PCPpositions[bridgetrack][0] || i == PCPpositions[bridgetrack][1])) {
-				SetBit(OverridePCP, i);
-			}
+		if (low_bridge_above && (i == PCPpositions[bridge_track][0] || i == PCPpositions[bridge_track][1])) {
+			SetBit(OverridePCP, i);
 		}
 
 		if (PPPallowed[i] != 0 && HasBit(PCPstatus, i) && !HasBit(OverridePCP, i) &&
 				(!IsRailStationTile(ti->tile) || CanStationTileHavePylons(ti->tile))) {
 			for (Direction k = DIR_BEGIN; k < DIR_END; k++) {
-				uint8_t temp = PPPorder[i][GetTLG(ti->tile)][k];
+				uint8_t temp = PPPorder[i][tlg][k];
 
 				if (HasBit(PPPallowed[i], temp)) {
 					uint x  = ti->x + x_pcp_offsets[i] + x_ppp_offsets[temp];
@@ -438,6 +441,9 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 						continue; // No neighbour, go looking for a better position
 					}
 
+					SpriteID &pylon_base = pylon_on_halftile ? pylon_halftile : pylon_normal;
+					if (pylon_base == 0) pylon_base = GetPylonBase(ti->tile, pylon_on_halftile ? TCX_UPPER_HALFTILE : TCX_NORMAL);
+
 					AddSortableSpriteToDraw(pylon_base + pylon_sprites[temp], PAL_NONE, x, y, 1, 1, BB_HEIGHT_UNDER_BRIDGE,
 						elevation, IsTransparencySet(TO_CATENARY), -1, -1);
 
@@ -451,11 +457,7 @@ static void DrawRailCatenaryRailway(const TileInfo *ti)
 	if (IsTunnelTile(ti->tile)) return;
 
 	/* Don't draw a wire under a low bridge */
-	if (IsBridgeAbove(ti->tile) && !IsTransparencySet(TO_BRIDGES)) {
-		int height = GetBridgeHeight(GetNorthernBridgeEnd(ti->tile));
-
-		if (height <= GetTileMaxZ(ti->tile) + 1) return;
-	}
+	if (low_bridge_above && !IsTransparencySet(TO_BRIDGES)) return;
 
 	/* Don't draw a wire if the station tile does not want any */
 	if (IsRailStationTile(ti->tile) && !CanStationTileHaveWires(ti->tile)) return;
@@ -961,6 +961,8 @@ void DeterminePaths(const char *exe, bool only_local_path)
 	_secrets_file = config_dir + "secrets.cfg";
 	extern std::string _favs_file;
 	_favs_file = config_dir + "favs.cfg";
+	extern std::string _newgrf_md5_file;
+	_newgrf_md5_file = config_dir + "newgrf_md5.cfg";
 
 #ifdef USE_XDG
 	if (config_dir == config_home) {
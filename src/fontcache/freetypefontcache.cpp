@@ -35,6 +35,7 @@ private:
 
 	void SetFontSize(int pixels);
 	const Sprite *InternalGetGlyph(GlyphID key, bool aa) override;
+	uint InternalGetGlyphWidth(GlyphID key, bool aa) override;
 
 public:
 	FreeTypeFontCache(FontSize fs, FT_Face face, int pixels);
@@ -284,6 +285,16 @@ const Sprite *FreeTypeFontCache::InternalGetGlyph(GlyphID key, bool aa)
 }
 
 
+uint FreeTypeFontCache::InternalGetGlyphWidth(GlyphID key, bool aa)
+{
+	/* Loading the glyph is enough to know its advance, rendering it can wait until it is drawn. */
+	FT_Load_Glyph(this->face, key, aa ? FT_LOAD_TARGET_NORMAL : FT_LOAD_TARGET_MONO);
+
+	GlyphEntry new_glyph;
+	new_glyph.width = this->face->glyph->advance.x >> 6;
+	return this->SetGlyphPtr(key, std::move(new_glyph)).width;
+}
+
 GlyphID FreeTypeFontCache::MapCharToGlyph(char32_t key, bool allow_fallback)
 {
 	assert(IsPrintable(key));
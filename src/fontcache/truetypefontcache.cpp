@@ -62,17 +62,28 @@ bool TrueTypeFontCache::GetDrawGlyphShadow()
 	return this->fs == FS_NORMAL && GetFontAAState();
 }
 
+/**
+ * Get the width of a glyph that is not in the cache yet.
+ * This renders the glyph; font caches that can get the width without rendering should override it.
+ * @param key The glyph.
+ * @param aa Whether to use anti aliasing.
+ * @return The width of the glyph.
+ */
+uint TrueTypeFontCache::InternalGetGlyphWidth(GlyphID key, bool aa)
+{
+	this->InternalGetGlyph(key, aa);
+	return this->GetGlyphPtr(key)->width;
+}
+
 uint TrueTypeFontCache::GetGlyphWidth(GlyphID key)
 {
 	if ((key & SPRITE_GLYPH) != 0) return this->parent->GetGlyphWidth(key);
 
+	/* Glyphs that were only measured are in the cache without sprite, but with their width. */
 	GlyphEntry *glyph = this->GetGlyphPtr(key);
-	if (glyph == nullptr || glyph->data == nullptr) {
-		this->GetGlyph(key);
-		glyph = this->GetGlyphPtr(key);
-	}
+	if (glyph != nullptr) return glyph->width;
 
-	return glyph->width;
+	return this->InternalGetGlyphWidth(key, GetFontAAState());
 }
 
 const Sprite *TrueTypeFontCache::GetGlyph(GlyphID key)
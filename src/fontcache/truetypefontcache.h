@@ -41,6 +41,7 @@ protected:
 	GlyphEntry &SetGlyphPtr(GlyphID key, GlyphEntry &&glyph);
 
 	virtual const Sprite *InternalGetGlyph(GlyphID key, bool aa) = 0;
+	virtual uint InternalGetGlyphWidth(GlyphID key, bool aa);
 
 public:
 	TrueTypeFontCache(FontSize fs, int pixels);
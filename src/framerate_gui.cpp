@@ -68,6 +68,11 @@ namespace {
 		/** Start time for current accumulation cycle */
 		TimingMeasurement acc_timestamp;
 
+		/** Sum of all valid durations ever recorded, not limited to the circular buffer */
+		TimingMeasurement total_duration = 0;
+		/** Number of valid durations ever recorded */
+		uint64_t total_count = 0;
+
 		/**
 		 * Initialize a data element with an expected collection rate
 		 * @param expected_rate
@@ -81,6 +86,8 @@ namespace {
 		{
 			this->durations[this->next_index] = end_time - start_time;
 			this->timestamps[this->next_index] = start_time;
+			this->total_duration += end_time - start_time;
+			this->total_count++;
 			this->prev_index = this->next_index;
 			this->next_index += 1;
 			if (this->next_index >= NUM_FRAMERATE_POINTS) this->next_index = 0;
@@ -92,6 +99,8 @@ namespace {
 		{
 			this->timestamps[this->next_index] = this->acc_timestamp;
 			this->durations[this->next_index] = this->acc_duration;
+			this->total_duration += this->acc_duration;
+			this->total_count++;
 			this->prev_index = this->next_index;
 			this->next_index += 1;
 			if (this->next_index >= NUM_FRAMERATE_POINTS) this->next_index = 0;
@@ -1101,6 +1110,72 @@ void ConPrintFramerate()
 	}
 }
 
+/** Start time of the current benchmark run, see #StartPerformanceBenchmark. */
+static TimingMeasurement _benchmark_start_time = 0;
+
+/** Discard the totals of all performance elements and start timing a benchmark run. */
+void StartPerformanceBenchmark()
+{
+	for (auto &pf : _pf_data) {
+		pf.total_duration = 0;
+		pf.total_count = 0;
+	}
+	_benchmark_start_time = GetPerformanceTimer();
+}
+
+/**
+ * Print the results of a benchmark run as JSON to stdout.
+ * The totals are taken over the whole run, not only over the points kept for the framerate window.
+ * @param ticks Number of game ticks that were run since #StartPerformanceBenchmark.
+ */
+void PrintPerformanceBenchmark(uint ticks)
+{
+	static const std::array<std::string_view, PFE_AI0> BENCHMARK_NAMES = {
+		"gameloop",
+		"gl_economy",
+		"gl_trains",
+		"gl_roadvehs",
+		"gl_ships",
+		"gl_aircraft",
+		"gl_landscape",
+		"gl_linkgraph",
+		"drawing",
+		"drawworld",
+		"video",
+		"sound",
+		"allscripts",
+		"gamescript",
+	};
+
+	TimingMeasurement wall_time = GetPerformanceTimer() - _benchmark_start_time;
+	double seconds = (double)wall_time / TIMESTAMP_PRECISION;
+
+	fmt::print("{{\n\t\"ticks\": {},\n\t\"seconds\": {:.3f},\n\t\"ticks_per_second\": {:.2f},\n\t\"elements\": {{",
+		ticks, seconds, seconds > 0 ? ticks / seconds : 0.0);
+
+	std::string ai_name_buf;
+	bool first = true;
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		const auto &pf = _pf_data[e];
+		if (pf.total_count == 0) continue;
+		std::string_view name;
+		if (e < PFE_AI0) {
+			name = BENCHMARK_NAMES[e];
+		} else {
+			ai_name_buf = fmt::format("ai{}", e - PFE_AI0 + 1);
+			name = ai_name_buf;
+		}
+		fmt::print("{}\n\t\t\"{}\": {{ \"count\": {}, \"total_ms\": {:.3f}, \"average_ms\": {:.4f} }}",
+			first ? "" : ",",
+			name,
+			pf.total_count,
+			(double)pf.total_duration * 1000 / TIMESTAMP_PRECISION,
+			(double)pf.total_duration * 1000 / TIMESTAMP_PRECISION / pf.total_count);
+		first = false;
+	}
+	fmt::print("\n\t}}\n}}\n");
+}
+
 /**
  * This drains the PFE_SOUND measurement data queue into _pf_data.
  * PFE_SOUND measurements are made by the mixer thread and so cannot be stored
@@ -122,5 +122,7 @@ public:
 
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
+void StartPerformanceBenchmark();
+void PrintPerformanceBenchmark(uint ticks);
 
 #endif /* FRAMERATE_TYPE_H */
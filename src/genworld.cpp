@@ -195,6 +195,7 @@ static void _GenerateWorld()
 		if (_gw.proc != nullptr) _gw.proc();
 		IncreaseGeneratingWorldProgress(GWP_GAME_START);
 
+		ReportGenerateWorldProgressTimes();
 		CleanupGeneration();
 
 		ShowNewGRFError();
@@ -282,6 +283,16 @@ void HandleGeneratingWorldAbortion()
 void GenerateWorld(GenWorldMode mode, uint size_x, uint size_y, bool reset_settings)
 {
 	if (HasModalProgress()) return;
+
+	/* The axes can each be set up to MAX_MAP_SIZE, but not both at the same time; shrink the longest one until the map fits. */
+	while (size_x * size_y > MAX_MAP_TILES) {
+		if (size_x >= size_y) {
+			size_x /= 2;
+		} else {
+			size_y /= 2;
+		}
+	}
+
 	_gw.mode   = mode;
 	_gw.size_x = size_x;
 	_gw.size_y = size_y;
@@ -95,6 +95,7 @@ void SetNewLandscapeType(uint8_t landscape);
 void SetGeneratingWorldProgress(GenWorldProgress cls, uint total);
 void IncreaseGeneratingWorldProgress(GenWorldProgress cls);
 void PrepareGenerateWorldProgress();
+void ReportGenerateWorldProgressTimes();
 void ShowGenerateWorldProgress();
 void StartNewGameWithoutGUI(uint32_t seed);
 void ShowCreateScenario();
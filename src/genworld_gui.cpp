@@ -333,13 +333,18 @@ static void LandscapeGenerationCallback(Window *w, bool confirmed)
 	if (confirmed) StartGeneratingLandscape((GenerateLandscapeWindowMode)w->window_number);
 }
 
-static DropDownList BuildMapsizeDropDown()
+/**
+ * Build the dropdown with the sizes for one axis of the map.
+ * @param other_axis_bits The size of the other axis, as power of 2.
+ * @return The dropdown list; sizes exceeding #MAX_MAP_TILES together with the other axis are disabled.
+ */
+static DropDownList BuildMapsizeDropDown(uint other_axis_bits)
 {
 	DropDownList list;
 
 	for (uint i = MIN_MAP_SIZE_BITS; i <= MAX_MAP_SIZE_BITS; i++) {
 		SetDParam(0, 1LL << i);
-		list.push_back(MakeDropDownListStringItem(STR_JUST_INT, i));
+		list.push_back(MakeDropDownListStringItem(STR_JUST_INT, i, i + other_axis_bits > MAX_MAP_TILES_BITS));
 	}
 
 	return list;
@@ -677,11 +682,11 @@ struct GenerateLandscapeWindow : public Window {
 				break;
 
 			case WID_GL_MAPSIZE_X_PULLDOWN: // Mapsize X
-				ShowDropDownList(this, BuildMapsizeDropDown(), _settings_newgame.game_creation.map_x, WID_GL_MAPSIZE_X_PULLDOWN);
+				ShowDropDownList(this, BuildMapsizeDropDown(_settings_newgame.game_creation.map_y), _settings_newgame.game_creation.map_x, WID_GL_MAPSIZE_X_PULLDOWN);
 				break;
 
 			case WID_GL_MAPSIZE_Y_PULLDOWN: // Mapsize Y
-				ShowDropDownList(this, BuildMapsizeDropDown(), _settings_newgame.game_creation.map_y, WID_GL_MAPSIZE_Y_PULLDOWN);
+				ShowDropDownList(this, BuildMapsizeDropDown(_settings_newgame.game_creation.map_x), _settings_newgame.game_creation.map_y, WID_GL_MAPSIZE_Y_PULLDOWN);
 				break;
 
 			case WID_GL_TOWN_PULLDOWN: // Number of towns
@@ -1162,11 +1167,11 @@ struct CreateScenarioWindow : public Window
 				break;
 
 			case WID_CS_MAPSIZE_X_PULLDOWN: // Mapsize X
-				ShowDropDownList(this, BuildMapsizeDropDown(), _settings_newgame.game_creation.map_x, WID_CS_MAPSIZE_X_PULLDOWN);
+				ShowDropDownList(this, BuildMapsizeDropDown(_settings_newgame.game_creation.map_y), _settings_newgame.game_creation.map_x, WID_CS_MAPSIZE_X_PULLDOWN);
 				break;
 
 			case WID_CS_MAPSIZE_Y_PULLDOWN: // Mapsize Y
-				ShowDropDownList(this, BuildMapsizeDropDown(), _settings_newgame.game_creation.map_y, WID_CS_MAPSIZE_Y_PULLDOWN);
+				ShowDropDownList(this, BuildMapsizeDropDown(_settings_newgame.game_creation.map_x), _settings_newgame.game_creation.map_y, WID_CS_MAPSIZE_Y_PULLDOWN);
 				break;
 
 			case WID_CS_EMPTY_WORLD: // Empty world / flat world
@@ -1349,6 +1354,10 @@ struct GenWorldStatus {
 	uint current;
 	uint total;
 	std::chrono::steady_clock::time_point next_update;
+
+	GenWorldProgress timed_cls;                                               ///< Class whose time is currently being measured, or GWP_CLASS_COUNT.
+	std::chrono::steady_clock::time_point timed_cls_start;                    ///< Moment #timed_cls started.
+	std::array<std::chrono::steady_clock::duration, GWP_CLASS_COUNT> cls_time; ///< Wall time spent in each class.
 };
 
 static GenWorldStatus _gws;
@@ -1369,6 +1378,23 @@ static const StringID _generation_class_table[]  = {
 };
 static_assert(lengthof(_generation_class_table) == GWP_CLASS_COUNT);
 
+/** Names of the classes for the timing in the debug output. */
+static const char * const _generation_class_names[] = {
+	"map init",
+	"landscape",
+	"rivers",
+	"rough/rocky",
+	"towns",
+	"industries",
+	"objects",
+	"trees",
+	"game init",
+	"tile loop",
+	"game script",
+	"game start",
+};
+static_assert(lengthof(_generation_class_names) == GWP_CLASS_COUNT);
+
 
 static void AbortGeneratingWorldCallback(Window *, bool confirmed)
 {
@@ -1457,6 +1483,33 @@ void PrepareGenerateWorldProgress()
 	_gws.total = 0;
 	_gws.percent = 0;
 	_gws.next_update = std::chrono::steady_clock::now();
+	_gws.timed_cls = GWP_CLASS_COUNT;
+	_gws.cls_time = {};
+}
+
+/**
+ * Attribute the time since the start of the previous class to that class, and start timing the given class.
+ * @param cls The class that starts now, or GWP_CLASS_COUNT to just stop timing.
+ */
+static void TimeGeneratingWorldClass(GenWorldProgress cls)
+{
+	auto now = std::chrono::steady_clock::now();
+	if (_gws.timed_cls != GWP_CLASS_COUNT) _gws.cls_time[_gws.timed_cls] += now - _gws.timed_cls_start;
+	_gws.timed_cls = cls;
+	_gws.timed_cls_start = now;
+}
+
+/** Write the wall time spent in each class of the world generation to the debug output. */
+void ReportGenerateWorldProgressTimes()
+{
+	TimeGeneratingWorldClass(GWP_CLASS_COUNT);
+
+	std::chrono::steady_clock::duration total{};
+	for (uint cls = 0; cls < GWP_CLASS_COUNT; cls++) {
+		total += _gws.cls_time[cls];
+		Debug(map, 1, "World generation: {:<12} {:>6} ms", _generation_class_names[cls], std::chrono::duration_cast<std::chrono::milliseconds>(_gws.cls_time[cls]).count());
+	}
+	Debug(map, 1, "World generation: {:<12} {:>6} ms", "total", std::chrono::duration_cast<std::chrono::milliseconds>(total).count());
 }
 
 /**
@@ -1490,6 +1543,7 @@ static void _SetGeneratingWorldProgress(GenWorldProgress cls, uint progress, uin
 		_gws.current += progress;
 		assert(_gws.current <= _gws.total);
 	} else {
+		if (cls != _gws.timed_cls) TimeGeneratingWorldClass(cls);
 		_gws.cls     = _generation_class_table[cls];
 		_gws.current = progress;
 		_gws.total   = total;
@@ -35,6 +35,12 @@
 
 /** Cache of ParagraphLayout lines. */
 Layouter::LineCache *Layouter::linecache;
+uint64_t Layouter::linecache_clock = 0; ///< Number of lookups in the linecache, to find the least recently used lines.
+
+/** Number of lines the linecache may hold between frames. */
+static const size_t MAX_LINE_CACHE_SIZE = 4096;
+/** Number of lines the linecache is reduced to once it holds too many. */
+static const size_t REDUCED_LINE_CACHE_SIZE = MAX_LINE_CACHE_SIZE * 3 / 4;
 
 /** Cache of Font instances. */
 Layouter::FontColourMap Layouter::fonts[FS_END];
@@ -381,6 +387,7 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str
 
 	if (auto match = linecache->find(LineCacheQuery{state, str});
 		match != linecache->end()) {
+		match->second.last_used = ++linecache_clock;
 		return match->second;
 	}
 
@@ -388,7 +395,9 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str
 	LineCacheKey key;
 	key.state_before = state;
 	key.str.assign(str);
-	return (*linecache)[std::move(key)];
+	LineCacheItem &item = (*linecache)[std::move(key)];
+	item.last_used = ++linecache_clock;
+	return item;
 }
 
 /**
@@ -401,13 +410,23 @@ void Layouter::ResetLineCache()
 
 /**
  * Reduce the size of linecache if necessary to prevent infinite growth.
+ * The least recently used lines are removed, so the lines of windows that are
+ * still open do not need to be laid out again.
+ * @note Lines must not be in use by a Layouter, so only call this between drawing.
  */
 void Layouter::ReduceLineCache()
 {
-	if (linecache != nullptr) {
-		/* TODO LRU cache would be fancy, but not exactly necessary */
-		if (linecache->size() > 4096) ResetLineCache();
-	}
+	if (linecache == nullptr || linecache->size() <= MAX_LINE_CACHE_SIZE) return;
+
+	/* Find the moment of last use from which on lines are kept. */
+	std::vector<uint64_t> last_used;
+	last_used.reserve(linecache->size());
+	for (const auto &[key, item] : *linecache) last_used.push_back(item.last_used);
+
+	auto threshold = last_used.end() - REDUCED_LINE_CACHE_SIZE;
+	std::nth_element(last_used.begin(), threshold, last_used.end());
+
+	std::erase_if(*linecache, [threshold = *threshold](const auto &entry) { return entry.second.last_used < threshold; });
 }
 
 /**
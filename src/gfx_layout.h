@@ -172,13 +172,15 @@ public:
 
 		FontState state_after;     ///< Font state after the line.
 		ParagraphLayouter *layout; ///< Layout of the line.
+		uint64_t last_used;        ///< Value of #Layouter::linecache_clock when the line was last used.
 
-		LineCacheItem() : buffer(nullptr), layout(nullptr) {}
+		LineCacheItem() : buffer(nullptr), layout(nullptr), last_used(0) {}
 		~LineCacheItem() { delete layout; free(buffer); }
 	};
 private:
 	typedef std::map<LineCacheKey, LineCacheItem, LineCacheCompare> LineCache;
 	static LineCache *linecache;
+	static uint64_t linecache_clock;
 
 	static LineCacheItem &GetCachedParagraphLayout(std::string_view str, const FontState &state);
 
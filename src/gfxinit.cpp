@@ -277,6 +277,7 @@ static bool SwitchNewGRFBlitter()
 		{ "8bpp-optimized",  2,  8,  8,  8,  8 },
 		{ "40bpp-anim",      2,  8, 32,  8, 32 },
 #ifdef WITH_SSE
+		{ "32bpp-avx2",      0, 32, 32,  8, 32 },
 		{ "32bpp-sse4",      0, 32, 32,  8, 32 },
 		{ "32bpp-ssse3",     0, 32, 32,  8, 32 },
 		{ "32bpp-sse2",      0, 32, 32,  8, 32 },
@@ -440,6 +441,10 @@ void GraphicsSet::CopyCompatibleConfig(const GraphicsSet &src)
  */
 MD5File::ChecksumResult MD5File::CheckMD5(Subdirectory subdir, size_t max_size) const
 {
+	/* The part of the file to hash only depends on its contents, so an earlier result can be reused as long as the file did not change. */
+	MD5Hash digest;
+	if (GetCachedMD5Sum(this->filename, subdir, digest)) return this->hash == digest ? CR_MATCH : CR_MISMATCH;
+
 	size_t size;
 	FILE *f = FioFOpenFile(this->filename, "rb", subdir, &size);
 
@@ -449,7 +454,6 @@ MD5File::ChecksumResult MD5File::CheckMD5(Subdirectory subdir, size_t max_size)
 
 	Md5 checksum;
 	uint8_t buffer[1024];
-	MD5Hash digest;
 	size_t len;
 
 	while ((len = fread(buffer, 1, (size > sizeof(buffer)) ? sizeof(buffer) : size, f)) != 0 && size != 0) {
@@ -460,6 +464,7 @@ MD5File::ChecksumResult MD5File::CheckMD5(Subdirectory subdir, size_t max_size)
 	FioFCloseFile(f);
 
 	checksum.Finish(digest);
+	CacheMD5Sum(this->filename, subdir, digest);
 	return this->hash == digest ? CR_MATCH : CR_MISMATCH;
 }
 
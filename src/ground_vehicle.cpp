@@ -93,6 +93,8 @@ void GroundVehicle<T, Type>::CargoChanged()
 	/* Friction in bearings and other mechanical parts is 0.1% of the weight (result in N). */
 	this->gcache.cached_axle_resistance = 10 * weight;
 
+	this->UpdateSlopeResistance();
+
 	/* Now update vehicle power (tractive effort is dependent on weight). */
 	this->PowerChanged();
 }
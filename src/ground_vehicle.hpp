@@ -33,6 +33,7 @@ struct GroundVehicleCache {
 	uint32_t cached_slope_resistance; ///< Resistance caused by weight when this vehicle part is at a slope.
 	uint32_t cached_max_te;           ///< Maximum tractive effort of consist (valid only for the first engine).
 	uint16_t cached_axle_resistance;  ///< Resistance caused by the axles of the vehicle (valid only for the first engine).
+	int64_t cached_total_slope_resistance; ///< Resistance caused by all parts that are on a slope, also kept up to date while moving (valid only for the first engine).
 
 	/* Cached acceleration values, recalculated on load and each time a vehicle is added to/removed from the consist. */
 	uint16_t cached_max_track_speed;  ///< Maximum consist speed (in internal units) limited by track type (valid only for the first engine).
@@ -107,26 +108,46 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 			ClrBit(v->gv_flags, GVF_GOINGUP_BIT);
 			ClrBit(v->gv_flags, GVF_GOINGDOWN_BIT);
 		}
+		T::From(this)->First()->UpdateSlopeResistance();
 		return this->Vehicle::Crash(flooded);
 	}
 
 	/**
-	 * Calculates the total slope resistance for this vehicle.
-	 * @return Slope resistance.
+	 * Calculates the slope resistance of this part of the vehicle on its own.
+	 * @return Slope resistance of this part.
 	 */
-	inline int64_t GetSlopeResistance() const
+	inline int64_t GetPartSlopeResistance() const
 	{
+		if (HasBit(this->gv_flags, GVF_GOINGUP_BIT)) return this->gcache.cached_slope_resistance;
+		if (HasBit(this->gv_flags, GVF_GOINGDOWN_BIT)) return -static_cast<int64_t>(this->gcache.cached_slope_resistance);
+		return 0;
+	}
+
+	/**
+	 * Recalculates the cached total slope resistance of the consist.
+	 * Should be called when the consist changed, or when the up/down flags of
+	 * parts are changed in another way than by moving onto a new tile.
+	 */
+	inline void UpdateSlopeResistance()
+	{
+		assert(this->First() == this);
 		int64_t incl = 0;
 
 		for (const T *u = T::From(this); u != nullptr; u = u->Next()) {
-			if (HasBit(u->gv_flags, GVF_GOINGUP_BIT)) {
-				incl += u->gcache.cached_slope_resistance;
-			} else if (HasBit(u->gv_flags, GVF_GOINGDOWN_BIT)) {
-				incl -= u->gcache.cached_slope_resistance;
-			}
+			incl += u->GetPartSlopeResistance();
 		}
 
-		return incl;
+		this->gcache.cached_total_slope_resistance = incl;
+	}
+
+	/**
+	 * Gets the total slope resistance for this vehicle.
+	 * This is kept up to date while moving, so the parts of the consist do not have to be visited every tick.
+	 * @return Slope resistance.
+	 */
+	inline int64_t GetSlopeResistance() const
+	{
+		return this->gcache.cached_total_slope_resistance;
 	}
 
 	/**
@@ -137,6 +158,8 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	 */
 	inline void UpdateZPositionAndInclination()
 	{
+		int64_t old_slope_resistance = this->GetPartSlopeResistance();
+
 		this->z_pos = GetSlopePixelZ(this->x_pos, this->y_pos, true);
 		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
 		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
@@ -152,6 +175,8 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 				SetBit(this->gv_flags, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
 			}
 		}
+
+		this->First()->gcache.cached_total_slope_resistance += this->GetPartSlopeResistance() - old_slope_resistance;
 	}
 
 	/**
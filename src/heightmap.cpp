@@ -29,6 +29,13 @@
  */
 static const uint MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS = 2 * MAX_MAP_SIZE;
 
+/*
+ * Maximum number of pixels for one dimension of a heightmap image that is read
+ * row by row. Only the pixels that end up on the map are kept in memory, so
+ * the image itself can be much larger.
+ */
+static const uint MAX_STREAMED_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS = 8 * MAX_MAP_SIZE;
+
 /*
  * Maximum size in pixels of the heightmap image.
  */
@@ -45,12 +52,19 @@ static_assert(MAX_HEIGHTMAP_SIZE_PIXELS < UINT32_MAX / 8);
  * to attempt to load the image. In other words, the width and height are not beyond the
  * #MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS limit and the total number of pixels does not
  * exceed #MAX_HEIGHTMAP_SIZE_PIXELS. A width or height less than 1 are disallowed too.
+ * Images that are read row by row only need to be within #MAX_STREAMED_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS.
  * @param width The width of the to be loaded height map.
  * @param height The height of the to be loaded height map.
+ * @param streamed Whether the image is read row by row, instead of as a whole.
  * @return True iff the dimensions are within the limits.
  */
-static inline bool IsValidHeightmapDimension(size_t width, size_t height)
+static inline bool IsValidHeightmapDimension(size_t width, size_t height, bool streamed = false)
 {
+	if (streamed) {
+		return width > 0 && width <= MAX_STREAMED_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS &&
+			height > 0 && height <= MAX_STREAMED_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS;
+	}
+
 	return (uint64_t)width * height <= MAX_HEIGHTMAP_SIZE_PIXELS &&
 		width > 0 && width <= MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS &&
 		height > 0 && height <= MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS;
@@ -67,6 +81,127 @@ static inline uint8_t RGBToGrayscale(uint8_t red, uint8_t green, uint8_t blue)
 	return ((red * 19595) + (green * 38470) + (blue * 7471)) / 65536;
 }
 
+/**
+ * The pixels of a heightmap image that are used for the map, in grayscale.
+ * The map is made with nearest neighbour scaling, so for a large image many
+ * rows and columns are never looked at; those are not stored at all.
+ */
+struct HeightmapSamples {
+	/** Defines the detail of the aspect ratio (to avoid doubles) */
+	static const uint NUM_DIV = 16384;
+	/* Ensure multiplication with NUM_DIV does not cause overflows. */
+	static_assert(NUM_DIV <= std::numeric_limits<uint>::max() / MAX_STREAMED_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS);
+
+	uint width = 0;     ///< Width of the map in tiles, along the rotated image.
+	uint height = 0;    ///< Height of the map in tiles, along the rotated image.
+	uint row_pad = 0;   ///< Number of padding rows at either side of the map.
+	uint col_pad = 0;   ///< Number of padding columns at either side of the map.
+	uint img_scale = 0; ///< Number of tiles per pixel, times #NUM_DIV.
+
+	std::vector<uint> row_slots; ///< For every image row its row in #data, or \c UINT_MAX when it is not used.
+	std::vector<uint> col_slots; ///< For every image column its column in #data, or \c UINT_MAX when it is not used.
+	uint data_width = 0;         ///< Number of used columns.
+	std::vector<uint8_t> data;   ///< The grayscale values of the used pixels.
+
+	/**
+	 * Get the image row used for a row of the map.
+	 * @param row The row of the map, outside of the padding.
+	 * @return The row of the image.
+	 */
+	inline uint ImageRow(uint row) const
+	{
+		return ((row - this->row_pad) * NUM_DIV) / this->img_scale;
+	}
+
+	/**
+	 * Get the image column used for a column of the map.
+	 * We rotate the map 45 degrees (counter)clockwise.
+	 * @param col The column of the map, outside of the padding.
+	 * @return The column of the image.
+	 */
+	inline uint ImageCol(uint col) const
+	{
+		switch (_settings_game.game_creation.heightmap_rotation) {
+			default: NOT_REACHED();
+			case HM_COUNTER_CLOCKWISE: return ((this->width - 1 - col - this->col_pad) * NUM_DIV) / this->img_scale;
+			case HM_CLOCKWISE:         return ((col - this->col_pad) * NUM_DIV) / this->img_scale;
+		}
+	}
+
+	/**
+	 * Get where to store the used pixels of an image row.
+	 * @param img_row The row of the image.
+	 * @return Pointer to the pixels of the row, indexed by #col_slots, or \c nullptr when the row is not used.
+	 */
+	inline uint8_t *GetRow(uint img_row)
+	{
+		uint slot = this->row_slots[img_row];
+		return slot == UINT_MAX ? nullptr : &this->data[static_cast<size_t>(slot) * this->data_width];
+	}
+
+	/**
+	 * Get the grayscale value of a used pixel.
+	 * @param img_col The column of the image.
+	 * @param img_row The row of the image.
+	 * @return The grayscale value.
+	 */
+	inline uint8_t GetPixel(uint img_col, uint img_row) const
+	{
+		assert(this->row_slots[img_row] != UINT_MAX && this->col_slots[img_col] != UINT_MAX);
+		return this->data[static_cast<size_t>(this->row_slots[img_row]) * this->data_width + this->col_slots[img_col]];
+	}
+
+	void Initialize(uint img_width, uint img_height);
+};
+
+/**
+ * Calculate the scale and padding for the current map, and determine which
+ * pixels of the image are going to be used.
+ * @param img_width The width of the image in pixels.
+ * @param img_height The height of the image in pixels.
+ */
+void HeightmapSamples::Initialize(uint img_width, uint img_height)
+{
+	/* Get map size and calculate scale and padding values */
+	switch (_settings_game.game_creation.heightmap_rotation) {
+		default: NOT_REACHED();
+		case HM_COUNTER_CLOCKWISE:
+			this->width  = Map::SizeX();
+			this->height = Map::SizeY();
+			break;
+		case HM_CLOCKWISE:
+			this->width  = Map::SizeY();
+			this->height = Map::SizeX();
+			break;
+	}
+
+	if ((img_width * NUM_DIV) / img_height > ((this->width * NUM_DIV) / this->height)) {
+		/* Image is wider than map - center vertically */
+		this->img_scale = (this->width * NUM_DIV) / img_width;
+		this->row_pad = (1 + this->height - ((img_height * this->img_scale) / NUM_DIV)) / 2;
+	} else {
+		/* Image is taller than map - center horizontally */
+		this->img_scale = (this->height * NUM_DIV) / img_height;
+		this->col_pad = (1 + this->width - ((img_width * this->img_scale) / NUM_DIV)) / 2;
+	}
+
+	uint rows = 0;
+	this->row_slots.assign(img_height, UINT_MAX);
+	for (uint row = this->row_pad; row < this->height - this->row_pad; row++) {
+		uint img_row = this->ImageRow(row);
+		if (img_row < img_height && this->row_slots[img_row] == UINT_MAX) this->row_slots[img_row] = rows++;
+	}
+
+	this->data_width = 0;
+	this->col_slots.assign(img_width, UINT_MAX);
+	for (uint col = this->col_pad; col < this->width - this->col_pad; col++) {
+		uint img_col = this->ImageCol(col);
+		if (img_col < img_width && this->col_slots[img_col] == UINT_MAX) this->col_slots[img_col] = this->data_width++;
+	}
+
+	this->data.assign(static_cast<size_t>(rows) * this->data_width, 0);
+}
+
 
 #ifdef WITH_PNG
 
@@ -74,14 +209,16 @@ static inline uint8_t RGBToGrayscale(uint8_t red, uint8_t green, uint8_t blue)
 
 /**
  * The PNG Heightmap loader.
+ * Images are read row by row, unless they are interlaced.
+ * The buffers are owned by the caller, as libpng reports errors with a longjmp past this function.
  */
-static void ReadHeightmapPNGImageData(uint8_t *map, png_structp png_ptr, png_infop info_ptr)
+static void ReadHeightmapPNGImageData(HeightmapSamples &samples, png_structp png_ptr, png_infop info_ptr, int passes, std::vector<png_byte> &buffer, std::vector<png_bytep> &row_pointers)
 {
-	uint x, y;
 	uint8_t gray_palette[256];
-	png_bytep *row_pointers = nullptr;
 	bool has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
 	uint channels = png_get_channels(png_ptr, info_ptr);
+	uint width = png_get_image_width(png_ptr, info_ptr);
+	uint height = png_get_image_height(png_ptr, info_ptr);
 
 	/* Get palette and convert it to grayscale */
 	if (has_palette) {
@@ -109,36 +246,55 @@ static void ReadHeightmapPNGImageData(uint8_t *map, png_structp png_ptr, png_inf
 		}
 	}
 
-	row_pointers = png_get_rows(png_ptr, info_ptr);
+	/* Convert the used pixels of a row of raw image data into 8-bit grayscale */
+	auto convert_row = [&](uint y, png_const_bytep row) {
+		uint8_t *pixels = samples.GetRow(y);
+		if (pixels == nullptr) return;
 
-	/* Read the raw image data and convert in 8-bit grayscale */
-	for (x = 0; x < png_get_image_width(png_ptr, info_ptr); x++) {
-		for (y = 0; y < png_get_image_height(png_ptr, info_ptr); y++) {
-			uint8_t *pixel = &map[y * png_get_image_width(png_ptr, info_ptr) + x];
-			uint x_offset = x * channels;
+		for (uint x = 0; x < width; x++) {
+			uint slot = samples.col_slots[x];
+			if (slot == UINT_MAX) continue;
 
+			uint x_offset = x * channels;
 			if (has_palette) {
-				*pixel = gray_palette[row_pointers[y][x_offset]];
+				pixels[slot] = gray_palette[row[x_offset]];
 			} else if (channels == 3) {
-				*pixel = RGBToGrayscale(row_pointers[y][x_offset + 0],
-						row_pointers[y][x_offset + 1], row_pointers[y][x_offset + 2]);
+				pixels[slot] = RGBToGrayscale(row[x_offset + 0], row[x_offset + 1], row[x_offset + 2]);
 			} else {
-				*pixel = row_pointers[y][x_offset];
+				pixels[slot] = row[x_offset];
 			}
 		}
+	};
+
+	size_t row_bytes = png_get_rowbytes(png_ptr, info_ptr);
+	if (passes > 1) {
+		/* Rows of interlaced images are only complete after the last pass, so read the whole image. */
+		buffer.resize(row_bytes * height);
+		row_pointers.resize(height);
+		for (uint y = 0; y < height; y++) row_pointers[y] = &buffer[y * row_bytes];
+		png_read_image(png_ptr, row_pointers.data());
+		for (uint y = 0; y < height; y++) convert_row(y, row_pointers[y]);
+	} else {
+		buffer.resize(row_bytes);
+		for (uint y = 0; y < height; y++) {
+			png_read_row(png_ptr, buffer.data(), nullptr);
+			convert_row(y, buffer.data());
+		}
 	}
 }
 
 /**
  * Reads the heightmap and/or size of the heightmap from a PNG file.
- * If map == nullptr only the size of the PNG is read, otherwise a map
- * with grayscale pixels is allocated and assigned to *map.
+ * If samples == nullptr only the size of the PNG is read, otherwise the
+ * pixels used for the map are read into samples.
  */
-static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, uint8_t **map)
+static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, HeightmapSamples *samples)
 {
 	FILE *fp;
 	png_structp png_ptr = nullptr;
 	png_infop info_ptr  = nullptr;
+	std::vector<png_byte> buffer;
+	std::vector<png_bytep> row_pointers;
 
 	fp = FioFOpenFile(filename, "rb", HEIGHTMAP_DIR);
 	if (fp == nullptr) {
@@ -162,11 +318,15 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, uint8_t **m
 	}
 
 	png_init_io(png_ptr, fp);
+	png_read_info(png_ptr, info_ptr);
 
-	/* Allocate memory and read image, without alpha or 16-bit samples
+	/* Read the image without alpha or 16-bit samples
 	 * (result is either 8-bit indexed/grayscale or 24-bit RGB) */
 	png_set_packing(png_ptr);
-	png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_PACKING | PNG_TRANSFORM_STRIP_ALPHA | PNG_TRANSFORM_STRIP_16, nullptr);
+	png_set_strip_alpha(png_ptr);
+	png_set_strip_16(png_ptr);
+	int passes = png_set_interlace_handling(png_ptr);
+	png_read_update_info(png_ptr, info_ptr);
 
 	/* Maps of wrong colour-depth are not used.
 	 * (this should have been taken care of by stripping alpha and 16-bit samples on load) */
@@ -180,16 +340,16 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, uint8_t **m
 	uint width = png_get_image_width(png_ptr, info_ptr);
 	uint height = png_get_image_height(png_ptr, info_ptr);
 
-	if (!IsValidHeightmapDimension(width, height)) {
+	if (!IsValidHeightmapDimension(width, height, passes == 1)) {
 		ShowErrorMessage(STR_ERROR_PNGMAP, STR_ERROR_HEIGHTMAP_TOO_LARGE, WL_ERROR);
 		fclose(fp);
 		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
 		return false;
 	}
 
-	if (map != nullptr) {
-		*map = MallocT<uint8_t>(static_cast<size_t>(width) * height);
-		ReadHeightmapPNGImageData(*map, png_ptr, info_ptr);
+	if (samples != nullptr) {
+		samples->Initialize(width, height);
+		ReadHeightmapPNGImageData(*samples, png_ptr, info_ptr, passes, buffer, row_pointers);
 	}
 
 	*x = width;
@@ -206,7 +366,7 @@ static bool ReadHeightmapPNG(const char *filename, uint *x, uint *y, uint8_t **m
 /**
  * The BMP Heightmap loader.
  */
-static void ReadHeightmapBMPImageData(uint8_t *map, BmpInfo *info, BmpData *data)
+static void ReadHeightmapBMPImageData(HeightmapSamples &samples, BmpInfo *info, BmpData *data)
 {
 	uint x, y;
 	uint8_t gray_palette[256];
@@ -242,17 +402,23 @@ static void ReadHeightmapBMPImageData(uint8_t *map, BmpInfo *info, BmpData *data
 		}
 	}
 
-	/* Read the raw image data and convert in 8-bit grayscale */
+	/* Convert the used pixels of the raw image data in 8-bit grayscale */
 	for (y = 0; y < info->height; y++) {
-		uint8_t *pixel = &map[y * info->width];
-		uint8_t *bitmap = &data->bitmap[y * info->width * (info->bpp == 24 ? 3 : 1)];
+		uint8_t *pixels = samples.GetRow(y);
+		if (pixels == nullptr) continue;
+
+		uint bytes_per_pixel = info->bpp == 24 ? 3 : 1;
+		const uint8_t *bitmap = &data->bitmap[static_cast<size_t>(y) * info->width * bytes_per_pixel];
 
 		for (x = 0; x < info->width; x++) {
+			uint slot = samples.col_slots[x];
+			if (slot == UINT_MAX) continue;
+
+			const uint8_t *pixel = bitmap + x * bytes_per_pixel;
 			if (info->bpp != 24) {
-				*pixel++ = gray_palette[*bitmap++];
+				pixels[slot] = gray_palette[*pixel];
 			} else {
-				*pixel++ = RGBToGrayscale(*bitmap, *(bitmap + 1), *(bitmap + 2));
-				bitmap += 3;
+				pixels[slot] = RGBToGrayscale(*pixel, *(pixel + 1), *(pixel + 2));
 			}
 		}
 	}
@@ -260,10 +426,10 @@ static void ReadHeightmapBMPImageData(uint8_t *map, BmpInfo *info, BmpData *data
 
 /**
  * Reads the heightmap and/or size of the heightmap from a BMP file.
- * If map == nullptr only the size of the BMP is read, otherwise a map
- * with grayscale pixels is allocated and assigned to *map.
+ * If samples == nullptr only the size of the BMP is read, otherwise the
+ * pixels used for the map are read into samples.
  */
-static bool ReadHeightmapBMP(const char *filename, uint *x, uint *y, uint8_t **map)
+static bool ReadHeightmapBMP(const char *filename, uint *x, uint *y, HeightmapSamples *samples)
 {
 	FILE *f;
 	BmpInfo info;
@@ -295,7 +461,7 @@ static bool ReadHeightmapBMP(const char *filename, uint *x, uint *y, uint8_t **m
 		return false;
 	}
 
-	if (map != nullptr) {
+	if (samples != nullptr) {
 		if (!BmpReadBitmap(&buffer, &info, &data)) {
 			ShowErrorMessage(STR_ERROR_BMPMAP, STR_ERROR_BMPMAP_IMAGE_TYPE, WL_ERROR);
 			fclose(f);
@@ -303,8 +469,8 @@ static bool ReadHeightmapBMP(const char *filename, uint *x, uint *y, uint8_t **m
 			return false;
 		}
 
-		*map = MallocT<uint8_t>(static_cast<size_t>(info.width) * info.height);
-		ReadHeightmapBMPImageData(*map, &info, &data);
+		samples->Initialize(info.width, info.height);
+		ReadHeightmapBMPImageData(*samples, &info, &data);
 	}
 
 	BmpDestroyData(&data);
@@ -319,47 +485,17 @@ static bool ReadHeightmapBMP(const char *filename, uint *x, uint *y, uint8_t **m
 /**
  * Converts a given grayscale map to something that fits in OTTD map system
  * and create a map of that data.
- * @param img_width  the with of the image in pixels/tiles
- * @param img_height the height of the image in pixels/tiles
- * @param map        the input map
+ * @param samples The used pixels of the image.
  */
-static void GrayscaleToMapHeights(uint img_width, uint img_height, uint8_t *map)
+static void GrayscaleToMapHeights(const HeightmapSamples &samples)
 {
-	/* Defines the detail of the aspect ratio (to avoid doubles) */
-	const uint num_div = 16384;
-	/* Ensure multiplication with num_div does not cause overflows. */
-	static_assert(num_div <= std::numeric_limits<uint>::max() / MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS);
-
-	uint width, height;
+	uint width = samples.width;
+	uint height = samples.height;
+	uint row_pad = samples.row_pad;
+	uint col_pad = samples.col_pad;
 	uint row, col;
-	uint row_pad = 0, col_pad = 0;
-	uint img_scale;
-	uint img_row, img_col;
 	TileIndex tile;
 
-	/* Get map size and calculate scale and padding values */
-	switch (_settings_game.game_creation.heightmap_rotation) {
-		default: NOT_REACHED();
-		case HM_COUNTER_CLOCKWISE:
-			width   = Map::SizeX();
-			height  = Map::SizeY();
-			break;
-		case HM_CLOCKWISE:
-			width   = Map::SizeY();
-			height  = Map::SizeX();
-			break;
-	}
-
-	if ((img_width * num_div) / img_height > ((width * num_div) / height)) {
-		/* Image is wider than map - center vertically */
-		img_scale = (width * num_div) / img_width;
-		row_pad = (1 + height - ((img_height * img_scale) / num_div)) / 2;
-	} else {
-		/* Image is taller than map - center horizontally */
-		img_scale = (height * num_div) / img_height;
-		col_pad = (1 + width - ((img_width * img_scale) / num_div)) / 2;
-	}
-
 	if (_settings_game.construction.freeform_edges) {
 		for (uint x = 0; x < Map::SizeX(); x++) MakeVoid(TileXY(x, 0));
 		for (uint y = 0; y < Map::SizeY(); y++) MakeVoid(TileXY(0, y));
@@ -380,23 +516,8 @@ static void GrayscaleToMapHeights(uint img_width, uint img_height, uint8_t *map)
 					(col < col_pad) || (col >= (width  - col_pad - (_settings_game.construction.freeform_edges ? 0 : 1)))) {
 				SetTileHeight(tile, 0);
 			} else {
-				/* Use nearest neighbour resizing to scale map data.
-				 *  We rotate the map 45 degrees (counter)clockwise */
-				img_row = (((row - row_pad) * num_div) / img_scale);
-				switch (_settings_game.game_creation.heightmap_rotation) {
-					default: NOT_REACHED();
-					case HM_COUNTER_CLOCKWISE:
-						img_col = (((width - 1 - col - col_pad) * num_div) / img_scale);
-						break;
-					case HM_CLOCKWISE:
-						img_col = (((col - col_pad) * num_div) / img_scale);
-						break;
-				}
-
-				assert(img_row < img_height);
-				assert(img_col < img_width);
-
-				uint heightmap_height = map[img_row * img_width + img_col];
+				/* Use nearest neighbour resizing to scale map data. */
+				uint heightmap_height = samples.GetPixel(samples.ImageCol(col), samples.ImageRow(row));
 
 				if (heightmap_height > 0) {
 					/* 0 is sea level.
@@ -481,10 +602,10 @@ void FixSlopes()
  * @param filename Name of the file to load.
  * @param[out] x Length of the image.
  * @param[out] y Height of the image.
- * @param[in,out] map If not \c nullptr, destination to store the loaded block of image data.
+ * @param[in,out] samples If not \c nullptr, destination to store the image data used for the map.
  * @return Whether loading was successful.
  */
-static bool ReadHeightMap(DetailedFileType dft, const char *filename, uint *x, uint *y, uint8_t **map)
+static bool ReadHeightMap(DetailedFileType dft, const char *filename, uint *x, uint *y, HeightmapSamples *samples)
 {
 	switch (dft) {
 		default:
@@ -492,11 +613,11 @@ static bool ReadHeightMap(DetailedFileType dft, const char *filename, uint *x, u
 
 #ifdef WITH_PNG
 		case DFT_HEIGHTMAP_PNG:
-			return ReadHeightmapPNG(filename, x, y, map);
+			return ReadHeightmapPNG(filename, x, y, samples);
 #endif /* WITH_PNG */
 
 		case DFT_HEIGHTMAP_BMP:
-			return ReadHeightmapBMP(filename, x, y, map);
+			return ReadHeightmapBMP(filename, x, y, samples);
 	}
 }
 
@@ -523,15 +644,11 @@ bool GetHeightmapDimensions(DetailedFileType dft, const char *filename, uint *x,
 bool LoadHeightmap(DetailedFileType dft, const char *filename)
 {
 	uint x, y;
-	uint8_t *map = nullptr;
+	HeightmapSamples samples;
 
-	if (!ReadHeightMap(dft, filename, &x, &y, &map)) {
-		free(map);
-		return false;
-	}
+	if (!ReadHeightMap(dft, filename, &x, &y, &samples)) return false;
 
-	GrayscaleToMapHeights(x, y, map);
-	free(map);
+	GrayscaleToMapHeights(samples);
 
 	FixSlopes();
 	MarkWholeScreenDirty();
@@ -1692,6 +1692,11 @@ static CommandCost CheckIfFarEnoughFromConflictingIndustry(TileIndex tile, int t
 {
 	const IndustrySpec *indspec = GetIndustrySpec(type);
 
+	/* Nothing can be too close when none of the conflicting industries exist; this saves a lot of searching when placing industries. */
+	if (std::none_of(std::begin(indspec->conflicting), std::end(indspec->conflicting), [](IndustryType ct) { return ct < NUM_INDUSTRYTYPES && Industry::GetIndustryTypeCount(ct) > 0; })) {
+		return CommandCost();
+	}
+
 	/* On a large map with many industries, it may be faster to check an area. */
 	static const int dmax = 14;
 	if (Industry::GetNumItems() > static_cast<size_t>(dmax * dmax * 2)) {
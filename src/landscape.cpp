@@ -38,10 +38,13 @@
 #include "terraform_cmd.h"
 #include "station_func.h"
 #include "pathfinder/water_regions.h"
+#include "trace.h"
 
 #include "table/strings.h"
 #include "table/sprites.h"
 
+#include <unordered_set>
+
 #include "safeguards.h"
 
 extern const TileTypeProcs
@@ -538,6 +541,7 @@ void DoClearSquare(TileIndex tile)
 	if (remove) RemoveDockingTile(tile);
 
 	InvalidateWaterRegion(tile);
+	ClearNeighbourNonFloodingStates(tile);
 }
 
 /**
@@ -767,15 +771,17 @@ TileIndex _cur_tileloop_tile;
 void RunTileLoop()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	TraceZone trace("RunTileLoop");
 
 	/* The pseudorandom sequence of tiles is generated using a Galois linear feedback
 	 * shift register (LFSR). This allows a deterministic pseudorandom ordering, but
 	 * still with minimal state and fast iteration. */
 
-	/* Maximal length LFSR feedback terms, from 12-bit (for 64x64 maps) to 24-bit (for 4096x4096 maps).
+	/* Maximal length LFSR feedback terms, from 12-bit (for 64x64 maps) to 28-bit (for 16384x16384 maps).
 	 * Extracted from http://www.ece.cmu.edu/~koopman/lfsr/ */
 	static const uint32_t feedbacks[] = {
-		0xD8F, 0x1296, 0x2496, 0x4357, 0x8679, 0x1030E, 0x206CD, 0x403FE, 0x807B8, 0x1004B2, 0x2006A8, 0x4004B2, 0x800B87
+		0xD8F, 0x1296, 0x2496, 0x4357, 0x8679, 0x1030E, 0x206CD, 0x403FE, 0x807B8, 0x1004B2, 0x2006A8, 0x4004B2, 0x800B87,
+		0x1000004, 0x2000023, 0x4000013, 0x8000004
 	};
 	static_assert(lengthof(feedbacks) == 2 * MAX_MAP_SIZE_BITS - 2 * MIN_MAP_SIZE_BITS + 1);
 	const uint32_t feedback = feedbacks[Map::LogX() + Map::LogY() - 2 * MIN_MAP_SIZE_BITS];
@@ -795,10 +801,15 @@ void RunTileLoop()
 	}
 
 	while (count--) {
+		/* Get the next tile in sequence using a Galois LFSR. */
+		TileIndex next = (tile.base() >> 1) ^ (-(int32_t)(tile.base() & 1) & feedback);
+
+		/* Tiles are visited in a random order, so their data is hardly ever cached.
+		 * Start loading the next one while this one is being processed. */
+		Tile(next).Prefetch();
 		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
 
-		/* Get the next tile in sequence using a Galois LFSR. */
-		tile = (tile.base() >> 1) ^ (-(int32_t)(tile.base() & 1) & feedback);
+		tile = next;
 	}
 
 	_cur_tileloop_tile = tile;
@@ -1319,8 +1330,8 @@ static void BuildRiver(TileIndex begin, TileIndex end, TileIndex spring, bool ma
  */
 static std::tuple<bool, bool> FlowRiver(TileIndex spring, TileIndex begin, uint min_river_length)
 {
-#	define SET_MARK(x) marks.insert(x)
-#	define IS_MARKED(x) (marks.find(x) != marks.end())
+#	define SET_MARK(x) marks.insert(x.base())
+#	define IS_MARKED(x) (marks.find(x.base()) != marks.end())
 
 	uint height = TileHeight(begin);
 
@@ -1328,19 +1339,22 @@ static std::tuple<bool, bool> FlowRiver(TileIndex spring, TileIndex begin, uint
 		return { DistanceManhattan(spring, begin) > min_river_length, GetTileZ(begin) == 0 };
 	}
 
-	std::set<TileIndex> marks;
+	/* The search can cover large flat areas, so use a hash set for the marks and
+	 * a vector for the queue. Every marked tile is queued exactly once, so the
+	 * queue doubles as the list of marked tiles for the lake guessing. */
+	std::unordered_set<uint32_t> marks;
 	SET_MARK(begin);
 
 	/* Breadth first search for the closest tile we can flow down to. */
-	std::list<TileIndex> queue;
+	std::vector<TileIndex> queue;
 	queue.push_back(begin);
+	size_t queue_head = 0;
 
 	bool found = false;
 	uint count = 0; // Number of tiles considered; to be used for lake location guessing.
 	TileIndex end;
 	do {
-		end = queue.front();
-		queue.pop_front();
+		end = queue[queue_head++];
 
 		uint height2 = TileHeight(end);
 		if (IsTileFlat(end) && (height2 < height || (height2 == height && IsWaterTile(end)))) {
@@ -1356,17 +1370,17 @@ static std::tuple<bool, bool> FlowRiver(TileIndex spring, TileIndex begin, uint
 				queue.push_back(t2);
 			}
 		}
-	} while (!queue.empty());
+	} while (queue_head != queue.size());
 
 	bool main_river = false;
 	if (found) {
 		/* Flow further down hill. */
 		std::tie(found, main_river) = FlowRiver(spring, end, min_river_length);
 	} else if (count > 32) {
-		/* Maybe we can make a lake. Find the Nth of the considered tiles. */
-		std::set<TileIndex>::const_iterator cit = marks.cbegin();
-		std::advance(cit, RandomRange(count - 1));
-		TileIndex lakeCenter = *cit;
+		/* Maybe we can make a lake. Find the Nth of the considered tiles, in order of their index. */
+		marks.clear();
+		std::sort(queue.begin(), queue.end());
+		TileIndex lakeCenter = queue[RandomRange(count - 1)];
 
 		if (IsValidTile(lakeCenter) &&
 				/* A river, or lake, can only be built on flat slopes. */
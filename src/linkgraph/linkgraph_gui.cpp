@@ -54,34 +54,22 @@ const uint8_t LinkGraphOverlay::LINK_COLOURS[][12] = {
 };
 
 /**
- * Get a DPI for the widget we will be drawing to.
- * @param dpi DrawPixelInfo to fill with the desired dimensions.
- */
-void LinkGraphOverlay::GetWidgetDpi(DrawPixelInfo *dpi) const
-{
-	const NWidgetBase *wi = this->window->GetWidget<NWidgetBase>(this->widget_id);
-	dpi->left = dpi->top = 0;
-	dpi->width = wi->current_x;
-	dpi->height = wi->current_y;
-}
-
-/**
- * Rebuild the cache and recalculate which links and stations to be shown.
+ * Rebuild the cache of links and stations to be shown.
+ * The cache holds everything for the selected cargoes and companies, regardless
+ * of which part of the map is visible; culling is left to the drawing.
+ * Station positions are cached as well, so drawing only needs to translate them
+ * to the current view.
  */
 void LinkGraphOverlay::RebuildCache()
 {
 	this->cached_links.clear();
 	this->cached_stations.clear();
+	this->cached_positions.clear();
 	if (this->company_mask == 0) return;
 
-	DrawPixelInfo dpi;
-	this->GetWidgetDpi(&dpi);
-
 	for (const Station *sta : Station::Iterate()) {
 		if (sta->rect.IsEmpty()) continue;
 
-		Point pta = this->GetStationMiddle(sta);
-
 		StationID from = sta->index;
 		StationLinkMap &seen_links = this->cached_links[from];
 
@@ -106,15 +94,12 @@ void LinkGraphOverlay::RebuildCache()
 				if (stb->owner != OWNER_NONE && sta->owner != OWNER_NONE && !HasBit(this->company_mask, stb->owner)) continue;
 				if (stb->rect.IsEmpty()) continue;
 
-				if (!this->IsLinkVisible(pta, this->GetStationMiddle(stb), &dpi)) continue;
-
 				this->AddLinks(sta, stb);
 				seen_links[to]; // make sure it is created and marked as seen
 			}
 		}
-		if (this->IsPointVisible(pta, &dpi)) {
-			this->cached_stations.emplace_back(from, supply);
-		}
+		this->cached_stations.emplace_back(from, supply);
+		this->cached_positions[from] = this->GetStationPosition(sta);
 	}
 }
 
@@ -278,10 +263,10 @@ void LinkGraphOverlay::DrawLinks(const DrawPixelInfo *dpi) const
 	int width = ScaleGUITrad(this->scale);
 	for (const auto &i : this->cached_links) {
 		if (!Station::IsValidID(i.first)) continue;
-		Point pta = this->GetStationMiddle(Station::Get(i.first));
+		Point pta = this->GetStationMiddle(i.first);
 		for (const auto &j : i.second) {
 			if (!Station::IsValidID(j.first)) continue;
-			Point ptb = this->GetStationMiddle(Station::Get(j.first));
+			Point ptb = this->GetStationMiddle(j.first);
 			if (!this->IsLinkVisible(pta, ptb, dpi, width + 2)) continue;
 			this->DrawContent(pta, ptb, j.second);
 		}
@@ -325,7 +310,7 @@ void LinkGraphOverlay::DrawStationDots(const DrawPixelInfo *dpi) const
 	for (const auto &i : this->cached_stations) {
 		const Station *st = Station::GetIfValid(i.first);
 		if (st == nullptr) continue;
-		Point pt = this->GetStationMiddle(st);
+		Point pt = this->GetStationMiddle(i.first);
 		if (!this->IsPointVisible(pt, dpi, 3 * width)) continue;
 
 		uint r = width * 2 + width * 2 * std::min(200U, i.second) / 200;
@@ -360,13 +345,13 @@ bool LinkGraphOverlay::ShowTooltip(Point pt, TooltipCloseCondition close_cond)
 {
 	for (auto i(this->cached_links.crbegin()); i != this->cached_links.crend(); ++i) {
 		if (!Station::IsValidID(i->first)) continue;
-		Point pta = this->GetStationMiddle(Station::Get(i->first));
+		Point pta = this->GetStationMiddle(i->first);
 		for (auto j(i->second.crbegin()); j != i->second.crend(); ++j) {
 			if (!Station::IsValidID(j->first)) continue;
 			if (i->first == j->first) continue;
 
 			/* Check the distance from the cursor to the line defined by the two stations. */
-			Point ptb = this->GetStationMiddle(Station::Get(j->first));
+			Point ptb = this->GetStationMiddle(j->first);
 			float dist = std::abs((int64_t)(ptb.x - pta.x) * (int64_t)(pta.y - pt.y) - (int64_t)(pta.x - pt.x) * (int64_t)(ptb.y - pta.y)) /
 				std::sqrt((int64_t)(ptb.x - pta.x) * (int64_t)(ptb.x - pta.x) + (int64_t)(ptb.y - pta.y) * (int64_t)(ptb.y - pta.y));
 			const auto &link = j->second;
@@ -414,17 +399,33 @@ bool LinkGraphOverlay::ShowTooltip(Point pt, TooltipCloseCondition close_cond)
 }
 
 /**
- * Determine the middle of a station in the current window.
+ * Determine the position of a station, independent of the scrolling and zooming of the current window.
  * @param st The station we're looking for.
+ * @return Position of the station, to be translated by GetStationMiddle.
+ */
+Point LinkGraphOverlay::GetStationPosition(const Station *st) const
+{
+	if (this->window->viewport != nullptr) {
+		return GetViewportStationPosition(st);
+	} else {
+		/* assume this is a smallmap */
+		return GetSmallMapStationPosition(st);
+	}
+}
+
+/**
+ * Determine the middle of a cached station in the current window.
+ * @param station The station we're looking for.
  * @return Middle point of the station in the current window.
  */
-Point LinkGraphOverlay::GetStationMiddle(const Station *st) const
+Point LinkGraphOverlay::GetStationMiddle(StationID station) const
 {
+	Point pos = this->cached_positions.at(station);
 	if (this->window->viewport != nullptr) {
-		return GetViewportStationMiddle(this->window->viewport, st);
+		return GetViewportStationMiddle(this->window->viewport, pos);
 	} else {
 		/* assume this is a smallmap */
-		return GetSmallMapStationMiddle(this->window, st);
+		return GetSmallMapStationMiddle(this->window, pos);
 	}
 }
 
@@ -43,6 +43,7 @@ public:
 	typedef std::map<StationID, LinkProperties> StationLinkMap;
 	typedef std::map<StationID, StationLinkMap> LinkMap;
 	typedef std::vector<std::pair<StationID, uint> > StationSupplyList;
+	typedef std::map<StationID, Point> StationPositionMap;
 
 	static const uint8_t LINK_COLOURS[][12];
 
@@ -55,7 +56,7 @@ public:
 	 * @param scale Desired thickness of lines and size of station dots.
 	 */
 	LinkGraphOverlay(Window *w, WidgetID wid, CargoTypes cargo_mask, CompanyMask company_mask, uint scale) :
-			window(w), widget_id(wid), cargo_mask(cargo_mask), company_mask(company_mask), scale(scale)
+			window(w), widget_id(wid), cargo_mask(cargo_mask), company_mask(company_mask), scale(scale), dirty(true)
 	{}
 
 	void Draw(const DrawPixelInfo *dpi);
@@ -64,7 +65,7 @@ public:
 
 	bool ShowTooltip(Point pt, TooltipCloseCondition close_cond);
 
-	/** Mark the linkgraph dirty to be rebuilt next time Draw() is called. */
+	/** Mark the linkgraph dirty to be rebuilt next time Draw() is called. Not needed when only the visible area changes. */
 	void SetDirty() { this->dirty = true; }
 
 	/** Get a bitmask of the currently shown cargoes. */
@@ -78,12 +79,14 @@ protected:
 	const WidgetID widget_id;          ///< ID of Widget in Window to be drawn to.
 	CargoTypes cargo_mask;             ///< Bitmask of cargos to be displayed.
 	CompanyMask company_mask;          ///< Bitmask of companies to be displayed.
-	LinkMap cached_links;              ///< Cache for links to reduce recalculation.
-	StationSupplyList cached_stations; ///< Cache for stations to be drawn.
+	LinkMap cached_links;              ///< Cache for all links of the selected cargoes and companies, visible or not.
+	StationSupplyList cached_stations; ///< Cache for stations to be drawn, visible or not.
+	StationPositionMap cached_positions; ///< Positions of the cached stations, independent of scrolling and zooming.
 	uint scale;                        ///< Width of link lines.
 	bool dirty;                        ///< Set if overlay should be rebuilt.
 
-	Point GetStationMiddle(const Station *st) const;
+	Point GetStationPosition(const Station *st) const;
+	Point GetStationMiddle(StationID station) const;
 
 	void AddLinks(const Station *sta, const Station *stb);
 	void DrawLinks(const DrawPixelInfo *dpi) const;
@@ -91,7 +94,6 @@ protected:
 	void DrawContent(Point pta, Point ptb, const LinkProperties &cargo) const;
 	bool IsLinkVisible(Point pta, Point ptb, const DrawPixelInfo *dpi, int padding = 0) const;
 	bool IsPointVisible(Point pt, const DrawPixelInfo *dpi, int padding = 0) const;
-	void GetWidgetDpi(DrawPixelInfo *dpi) const;
 	void RebuildCache();
 
 	static void AddStats(CargoID new_cargo, uint new_cap, uint new_usg, uint new_flow, uint32_t time, bool new_shared, LinkProperties &cargo);
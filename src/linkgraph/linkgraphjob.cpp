@@ -157,15 +157,15 @@ LinkGraphJob::~LinkGraphJob()
 				} else {
 					FlowStat shares(INVALID_STATION, 1);
 					it->second.SwapShares(shares);
-					ge.flows.erase(it++);
+					it = ge.flows.erase(it);
 					for (FlowStat::SharesMap::const_iterator shares_it(shares.GetShares()->begin());
 							shares_it != shares.GetShares()->end(); ++shares_it) {
 						RerouteCargo(st, this->Cargo(), shares_it->second, st->index);
 					}
 				}
 			} else {
+				/* The swapped entry stays behind in flows, but the insert below skips it anyway. */
 				it->second.SwapShares(new_it->second);
-				flows.erase(new_it);
 				++it;
 			}
 		}
@@ -182,9 +182,18 @@ LinkGraphJob::~LinkGraphJob()
 void LinkGraphJob::Init()
 {
 	uint size = this->Size();
+
+	/* Store the annotations of all edges in one block, so the edges of a node are next to each other. */
+	size_t num_edges = 0;
+	for (const auto &node : this->link_graph.nodes) num_edges += node.edges.size();
+	this->edges.reserve(num_edges);
+
 	this->nodes.reserve(size);
 	for (uint i = 0; i < size; ++i) {
-		this->nodes.emplace_back(this->link_graph.nodes[i], this->link_graph.Size());
+		const LinkGraph::BaseNode &node = this->link_graph.nodes[i];
+		size_t first = this->edges.size();
+		for (const auto &e : node.edges) this->edges.emplace_back(e);
+		this->nodes.emplace_back(node, std::span(this->edges).subspan(first, node.edges.size()), this->link_graph.Size());
 	}
 }
 
@@ -72,6 +72,11 @@ public:
 		{
 			return dest < rhs.base.dest_node;
 		}
+
+		inline bool operator <(NodeID rhs) const
+		{
+			return this->base.dest_node < rhs;
+		}
 	};
 
 	/**
@@ -84,13 +89,11 @@ public:
 		PathList paths;          ///< Paths through this node, sorted so that those with flow == 0 are in the back.
 		FlowStatMap flows;       ///< Planned flows to other nodes.
 
-		std::vector<EdgeAnnotation>   edges;   ///< Annotations for all edges originating at this node.
+		std::span<EdgeAnnotation>     edges;   ///< Annotations for all edges originating at this node, sorted by destination. Part of LinkGraphJob::edges.
 		std::vector<DemandAnnotation> demands; ///< Annotations for the demand to all other nodes.
 
-		NodeAnnotation(const LinkGraph::BaseNode &node, size_t size) : base(node), undelivered_supply(node.supply), paths(), flows()
+		NodeAnnotation(const LinkGraph::BaseNode &node, std::span<EdgeAnnotation> edges, size_t size) : base(node), undelivered_supply(node.supply), paths(), flows(), edges(edges)
 		{
-			this->edges.reserve(node.edges.size());
-			for (auto &e : node.edges) this->edges.emplace_back(e);
 			this->demands.resize(size);
 		}
 
@@ -101,8 +104,8 @@ public:
 		 */
 		EdgeAnnotation &operator[](NodeID to)
 		{
-			auto it = std::find_if(this->edges.begin(), this->edges.end(), [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::lower_bound(this->edges.begin(), this->edges.end(), to);
+			assert(it != this->edges.end() && it->base.dest_node == to);
 			return *it;
 		}
 
@@ -113,8 +116,8 @@ public:
 		 */
 		const EdgeAnnotation &operator[](NodeID to) const
 		{
-			auto it = std::find_if(this->edges.begin(), this->edges.end(), [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::lower_bound(this->edges.begin(), this->edges.end(), to);
+			assert(it != this->edges.end() && it->base.dest_node == to);
 			return *it;
 		}
 
@@ -164,6 +167,7 @@ protected:
 	const LinkGraphSettings settings;  ///< Copy of _settings_game.linkgraph at spawn time.
 	std::thread thread;                ///< Thread the job is running in or a default-constructed thread if it's running in the main thread.
 	TimerGameEconomy::Date join_date; ///< Date when the job is to be joined.
+	std::vector<EdgeAnnotation> edges; ///< Extra edge data necessary for link graph calculation, the edges of each node are stored together.
 	NodeAnnotationVector nodes;        ///< Extra node data necessary for link graph calculation.
 	std::atomic<bool> job_completed;   ///< Is the job still running. This is accessed by multiple threads and reads may be stale.
 	std::atomic<bool> job_aborted;     ///< Has the job been aborted. This is accessed by multiple threads and reads may be stale.
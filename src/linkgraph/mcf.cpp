@@ -3,12 +3,18 @@
 #include "../stdafx.h"
 #include "../core/math_func.hpp"
 #include "../timer/timer_game_tick.h"
+#include "../thread_pool.h"
 #include "mcf.h"
 
 #include "../safeguards.h"
 
 typedef std::map<NodeID, Path *> PathViaMap;
 
+/** Components with fewer nodes than this calculate the paths of one source at a time. */
+static const uint MCF_BATCH_MIN_NODES = 128;
+/** Number of sources whose paths are calculated at once in large components. */
+static const uint MCF_BATCH_SIZE = 32;
+
 /**
  * Distance-based annotation for use in the Dijkstra algorithm. This is close
  * to the original meaning of "annotation" in this context. Paths are rated
@@ -87,6 +93,118 @@ public:
 	};
 };
 
+/**
+ * Priority queue of annotations for the Dijkstra algorithm. The annotations are
+ * kept in a binary heap ordered by their comparator, and indexed by their node
+ * IDs, so an annotation can be moved to its new place in logarithmic time when
+ * it changes, without allocating anything.
+ * @tparam Tannotation Annotation to be queued.
+ */
+template <class Tannotation>
+class AnnotationQueue {
+private:
+	static constexpr uint NOT_QUEUED = UINT_MAX; ///< Position of annotations that are not in the queue.
+
+	typename Tannotation::Comparator better; ///< Determines whether one annotation is better than another.
+	std::vector<Tannotation *> heap;         ///< The queued annotations, best one first.
+	std::vector<uint> position;              ///< Position of each node's annotation in the heap.
+
+	/**
+	 * Put an annotation at a position in the heap.
+	 * @param pos Position.
+	 * @param anno Annotation.
+	 */
+	inline void Place(uint pos, Tannotation *anno)
+	{
+		this->heap[pos] = anno;
+		this->position[anno->GetNode()] = pos;
+	}
+
+	/**
+	 * Move an annotation towards the front of the heap until it is in order.
+	 * @param pos Current position of the annotation.
+	 */
+	void SiftUp(uint pos)
+	{
+		Tannotation *anno = this->heap[pos];
+		while (pos > 0) {
+			uint parent = (pos - 1) / 2;
+			if (!this->better(anno, this->heap[parent])) break;
+			this->Place(pos, this->heap[parent]);
+			pos = parent;
+		}
+		this->Place(pos, anno);
+	}
+
+	/**
+	 * Move an annotation towards the back of the heap until it is in order.
+	 * @param pos Current position of the annotation.
+	 */
+	void SiftDown(uint pos)
+	{
+		Tannotation *anno = this->heap[pos];
+		uint size = static_cast<uint>(this->heap.size());
+		for (;;) {
+			uint child = pos * 2 + 1;
+			if (child >= size) break;
+			if (child + 1 < size && this->better(this->heap[child + 1], this->heap[child])) child++;
+			if (!this->better(this->heap[child], anno)) break;
+			this->Place(pos, this->heap[child]);
+			pos = child;
+		}
+		this->Place(pos, anno);
+	}
+
+public:
+	/**
+	 * Create an empty queue.
+	 * @param size Number of nodes in the graph.
+	 */
+	AnnotationQueue(uint16_t size) : position(size, NOT_QUEUED)
+	{
+		this->heap.reserve(size);
+	}
+
+	/**
+	 * Check whether there are no annotations queued.
+	 * @return True if the queue is empty.
+	 */
+	inline bool IsEmpty() const { return this->heap.empty(); }
+
+	/**
+	 * Remove the best annotation from the queue.
+	 * @return The best annotation.
+	 */
+	Tannotation *Pop()
+	{
+		Tannotation *best = this->heap.front();
+		this->position[best->GetNode()] = NOT_QUEUED;
+		Tannotation *last = this->heap.back();
+		this->heap.pop_back();
+		if (last != best) {
+			this->Place(0, last);
+			this->SiftDown(0);
+		}
+		return best;
+	}
+
+	/**
+	 * Tell the queue an annotation changed, or add it again if it is not queued.
+	 * @param anno The annotation.
+	 */
+	void Update(Tannotation *anno)
+	{
+		uint pos = this->position[anno->GetNode()];
+		if (pos == NOT_QUEUED) {
+			pos = static_cast<uint>(this->heap.size());
+			this->heap.push_back(anno);
+			this->position[anno->GetNode()] = pos;
+		}
+		this->SiftUp(pos);
+		this->SiftDown(this->position[anno->GetNode()]);
+	}
+};
+
 /**
  * Iterator class for getting the edges in the order of their next_edge
  * members.
@@ -95,8 +213,8 @@ class GraphEdgeIterator {
 private:
 	LinkGraphJob &job; ///< Job being executed
 
-	std::vector<LinkGraphJob::EdgeAnnotation>::const_iterator i;   ///< Iterator pointing to current edge.
-	std::vector<LinkGraphJob::EdgeAnnotation>::const_iterator end; ///< Iterator pointing beyond last edge.
+	std::span<LinkGraphJob::EdgeAnnotation>::iterator i;   ///< Iterator pointing to current edge.
+	std::span<LinkGraphJob::EdgeAnnotation>::iterator end; ///< Iterator pointing beyond last edge.
 
 public:
 
@@ -112,8 +230,8 @@ public:
 	 */
 	void SetNode(NodeID, NodeID node)
 	{
-		this->i = this->job[node].edges.cbegin();
-		this->end = this->job[node].edges.cend();
+		this->i = this->job[node].edges.begin();
+		this->end = this->job[node].edges.end();
 	}
 
 	/**
@@ -256,21 +374,18 @@ bool CapacityAnnotation::IsBetter(const CapacityAnnotation *base, uint cap,
 template<class Tannotation, class Tedge_iterator>
 void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 {
-	typedef std::set<Tannotation *, typename Tannotation::Comparator> AnnoSet;
 	Tedge_iterator iter(this->job);
 	uint16_t size = this->job.Size();
-	AnnoSet annos;
+	AnnotationQueue<Tannotation> annos(size);
 	paths.resize(size, nullptr);
 	for (NodeID node = 0; node < size; ++node) {
 		Tannotation *anno = new Tannotation(node, node == source_node);
 		anno->UpdateAnnotation();
-		annos.insert(anno);
+		annos.Update(anno);
 		paths[node] = anno;
 	}
-	while (!annos.empty()) {
-		typename AnnoSet::iterator i = annos.begin();
-		Tannotation *source = *i;
-		annos.erase(i);
+	while (!annos.IsEmpty()) {
+		Tannotation *source = annos.Pop();
 		NodeID from = source->GetNode();
 		iter.SetNode(source_node, from);
 		for (NodeID to = iter.Next(); to != INVALID_NODE; to = iter.Next()) {
@@ -295,15 +410,52 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 
 			Tannotation *dest = static_cast<Tannotation *>(paths[to]);
 			if (dest->IsBetter(source, capacity, capacity - edge.Flow(), distance_anno)) {
-				annos.erase(dest);
 				dest->Fork(source, capacity, capacity - edge.Flow(), distance_anno);
 				dest->UpdateAnnotation();
-				annos.insert(dest);
+				annos.Update(dest);
 			}
 		}
 	}
 }
 
+/**
+ * Run the Dijkstra algorithm for several sources at once, spread over the
+ * worker threads. The searches only read the flows of the job, so they are
+ * independent of each other and the results do not depend on the number of
+ * threads.
+ * @tparam Tannotation Annotation to be used.
+ * @tparam Tedge_iterator Iterator to be used for getting outgoing edges.
+ * @param sources Nodes where the searches start.
+ * @param paths Container for the paths of each source, in the same order as the sources.
+ */
+template<class Tannotation, class Tedge_iterator>
+void MultiCommodityFlow::Dijkstra(const std::vector<NodeID> &sources, std::vector<PathVector> &paths)
+{
+	paths.resize(sources.size());
+	ThreadPool::ParallelFor(sources.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) this->Dijkstra<Tannotation, Tedge_iterator>(sources[i], paths[i]);
+	});
+}
+
+/**
+ * Determine the sources to calculate the paths for next. Large components
+ * handle a fixed number of sources at once, based on the flows as they were
+ * before any of them got assigned. Small components handle one at a time.
+ * @param next First source to consider, is moved beyond the chosen sources.
+ * @param finished_sources Sources that have no demand left.
+ * @param sources Output for the chosen sources.
+ */
+void MultiCommodityFlow::GetNextSources(NodeID &next, const std::vector<bool> &finished_sources, std::vector<NodeID> &sources) const
+{
+	uint16_t size = this->job.Size();
+	uint batch = size < MCF_BATCH_MIN_NODES ? 1 : MCF_BATCH_SIZE;
+
+	sources.clear();
+	for (; next < size && sources.size() < batch; ++next) {
+		if (!finished_sources[next]) sources.push_back(next);
+	}
+}
+
 /**
  * Clean up paths that lead nowhere and the root path.
  * @param source_id ID of the root node.
@@ -498,7 +650,8 @@ bool MCF1stPass::EliminateCycles()
  */
 MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 {
-	PathVector paths;
+	std::vector<PathVector> batch_paths;
+	std::vector<NodeID> sources;
 	uint16_t size = job.Size();
 	uint accuracy = job.Settings().accuracy;
 	bool more_loops;
@@ -506,35 +659,39 @@ MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 
 	do {
 		more_loops = false;
-		for (NodeID source = 0; source < size; ++source) {
-			if (finished_sources[source]) continue;
+		for (NodeID next = 0; next < size;) {
+			this->GetNextSources(next, finished_sources, sources);
 
 			/* First saturate the shortest paths. */
-			this->Dijkstra<DistanceAnnotation, GraphEdgeIterator>(source, paths);
-
-			Node &src_node = job[source];
-			bool source_demand_left = false;
-			for (NodeID dest = 0; dest < size; ++dest) {
-				if (src_node.UnsatisfiedDemandTo(dest) > 0) {
-					Path *path = paths[dest];
-					assert(path != nullptr);
-					/* Generally only allow paths that don't exceed the
-					 * available capacity. But if no demand has been assigned
-					 * yet, make an exception and allow any valid path *once*. */
-					if (path->GetFreeCapacity() > 0 && this->PushFlow(src_node, dest, path,
-							accuracy, this->max_saturation) > 0) {
-						/* If a path has been found there is a chance we can
-						 * find more. */
-						more_loops = more_loops || (src_node.UnsatisfiedDemandTo(dest) > 0);
-					} else if (src_node.UnsatisfiedDemandTo(dest) == src_node.DemandTo(dest) &&
-							path->GetFreeCapacity() > INT_MIN) {
-						this->PushFlow(src_node, dest, path, accuracy, UINT_MAX);
+			this->Dijkstra<DistanceAnnotation, GraphEdgeIterator>(sources, batch_paths);
+
+			for (size_t i = 0; i < sources.size(); ++i) {
+				NodeID source = sources[i];
+				PathVector &paths = batch_paths[i];
+				Node &src_node = job[source];
+				bool source_demand_left = false;
+				for (NodeID dest = 0; dest < size; ++dest) {
+					if (src_node.UnsatisfiedDemandTo(dest) > 0) {
+						Path *path = paths[dest];
+						assert(path != nullptr);
+						/* Generally only allow paths that don't exceed the
+						 * available capacity. But if no demand has been assigned
+						 * yet, make an exception and allow any valid path *once*. */
+						if (path->GetFreeCapacity() > 0 && this->PushFlow(src_node, dest, path,
+								accuracy, this->max_saturation) > 0) {
+							/* If a path has been found there is a chance we can
+							 * find more. */
+							more_loops = more_loops || (src_node.UnsatisfiedDemandTo(dest) > 0);
+						} else if (src_node.UnsatisfiedDemandTo(dest) == src_node.DemandTo(dest) &&
+								path->GetFreeCapacity() > INT_MIN) {
+							this->PushFlow(src_node, dest, path, accuracy, UINT_MAX);
+						}
+						if (src_node.UnsatisfiedDemandTo(dest) > 0) source_demand_left = true;
 					}
-					if (src_node.UnsatisfiedDemandTo(dest) > 0) source_demand_left = true;
 				}
+				finished_sources[source] = !source_demand_left;
+				this->CleanupPaths(source, paths);
 			}
-			finished_sources[source] = !source_demand_left;
-			this->CleanupPaths(source, paths);
 		}
 	} while ((more_loops || this->EliminateCycles()) && !job.IsJobAborted());
 }
@@ -547,32 +704,37 @@ MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 MCF2ndPass::MCF2ndPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 {
 	this->max_saturation = UINT_MAX; // disable artificial cap on saturation
-	PathVector paths;
+	std::vector<PathVector> batch_paths;
+	std::vector<NodeID> sources;
 	uint16_t size = job.Size();
 	uint accuracy = job.Settings().accuracy;
 	bool demand_left = true;
 	std::vector<bool> finished_sources(size);
 	while (demand_left && !job.IsJobAborted()) {
 		demand_left = false;
-		for (NodeID source = 0; source < size; ++source) {
-			if (finished_sources[source]) continue;
+		for (NodeID next = 0; next < size;) {
+			this->GetNextSources(next, finished_sources, sources);
 
-			this->Dijkstra<CapacityAnnotation, FlowEdgeIterator>(source, paths);
+			this->Dijkstra<CapacityAnnotation, FlowEdgeIterator>(sources, batch_paths);
 
-			Node &src_node = job[source];
-			bool source_demand_left = false;
-			for (NodeID dest = 0; dest < size; ++dest) {
-				Path *path = paths[dest];
-				if (src_node.UnsatisfiedDemandTo(dest) > 0 && path->GetFreeCapacity() > INT_MIN) {
-					this->PushFlow(src_node, dest, path, accuracy, UINT_MAX);
-					if (src_node.UnsatisfiedDemandTo(dest) > 0) {
-						demand_left = true;
-						source_demand_left = true;
+			for (size_t i = 0; i < sources.size(); ++i) {
+				NodeID source = sources[i];
+				PathVector &paths = batch_paths[i];
+				Node &src_node = job[source];
+				bool source_demand_left = false;
+				for (NodeID dest = 0; dest < size; ++dest) {
+					Path *path = paths[dest];
+					if (src_node.UnsatisfiedDemandTo(dest) > 0 && path->GetFreeCapacity() > INT_MIN) {
+						this->PushFlow(src_node, dest, path, accuracy, UINT_MAX);
+						if (src_node.UnsatisfiedDemandTo(dest) > 0) {
+							demand_left = true;
+							source_demand_left = true;
+						}
 					}
 				}
+				finished_sources[source] = !source_demand_left;
+				this->CleanupPaths(source, paths);
 			}
-			finished_sources[source] = !source_demand_left;
-			this->CleanupPaths(source, paths);
 		}
 	}
 }
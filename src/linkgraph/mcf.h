@@ -23,6 +23,11 @@ protected:
 	template<class Tannotation, class Tedge_iterator>
 	void Dijkstra(NodeID from, PathVector &paths);
 
+	template<class Tannotation, class Tedge_iterator>
+	void Dijkstra(const std::vector<NodeID> &sources, std::vector<PathVector> &paths);
+
+	void GetNextSources(NodeID &next, const std::vector<bool> &finished_sources, std::vector<NodeID> &sources) const;
+
 	uint PushFlow(Node &node, NodeID to, Path *path, uint accuracy, uint max_saturation);
 
 	void CleanupPaths(NodeID source, PathVector &paths);
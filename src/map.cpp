@@ -24,6 +24,7 @@
 /* static */ uint Map::size;      ///< The number of tiles on the map
 /* static */ uint Map::tile_mask; ///< _map_size - 1 (to mask the mapsize)
 
+/* static */ Tile::TileTypeHeight *Tile::type_height_tiles = nullptr; ///< Type and height of the tiles of the map
 /* static */ Tile::TileBase *Tile::base_tiles = nullptr;         ///< Base tiles of the map
 /* static */ Tile::TileExtended *Tile::extended_tiles = nullptr; ///< Extended tiles of the map
 
@@ -40,7 +41,8 @@
 	if (!IsInsideMM(size_x, MIN_MAP_SIZE, MAX_MAP_SIZE + 1) ||
 			!IsInsideMM(size_y, MIN_MAP_SIZE, MAX_MAP_SIZE + 1) ||
 			(size_x & (size_x - 1)) != 0 ||
-			(size_y & (size_y - 1)) != 0) {
+			(size_y & (size_y - 1)) != 0 ||
+			size_x * size_y > MAX_MAP_TILES) {
 		FatalError("Invalid map size");
 	}
 
@@ -53,9 +55,11 @@
 	Map::size = size_x * size_y;
 	Map::tile_mask = Map::size - 1;
 
+	free(Tile::type_height_tiles);
 	free(Tile::base_tiles);
 	free(Tile::extended_tiles);
 
+	Tile::type_height_tiles = CallocT<Tile::TileTypeHeight>(Map::size);
 	Tile::base_tiles = CallocT<Tile::TileBase>(Map::size);
 	Tile::extended_tiles = CallocT<Tile::TileExtended>(Map::size);
 
@@ -26,12 +26,24 @@ class Tile {
 private:
 	friend struct Map;
 	/**
-	 * Data that is stored per tile. Also used TileExtended for this.
+	 * Data that is stored per tile, and that is read by most loops over the map.
+	 * It is stored separately from the rest, so scans over the map that only
+	 * need the type or height of tiles read just a fraction of the memory.
+	 * Also used TileBase and TileExtended for this.
 	 * Look at docs/landscape.html for the exact meaning of the members.
 	 */
-	struct TileBase {
+	struct TileTypeHeight {
 		uint8_t   type;   ///< The type (bits 4..7), bridges (2..3), rainforest/desert (0..1)
 		uint8_t   height; ///< The height of the northern corner.
+	};
+
+	static_assert(sizeof(TileTypeHeight) == 2);
+
+	/**
+	 * Data that is stored per tile. Also used TileTypeHeight and TileExtended for this.
+	 * Look at docs/landscape.html for the exact meaning of the members.
+	 */
+	struct TileBase {
 		uint16_t m2;     ///< Primarily used for indices to towns, industries and stations
 		uint8_t   m1;     ///< Primarily used for ownership information
 		uint8_t   m3;     ///< General purpose
@@ -39,10 +51,10 @@ private:
 		uint8_t   m5;     ///< General purpose
 	};
 
-	static_assert(sizeof(TileBase) == 8);
+	static_assert(sizeof(TileBase) == 6);
 
 	/**
-	 * Data that is stored per tile. Also used TileBase for this.
+	 * Data that is stored per tile. Also used TileTypeHeight and TileBase for this.
 	 * Look at docs/landscape.html for the exact meaning of the members.
 	 */
 	struct TileExtended {
@@ -51,6 +63,7 @@ private:
 		uint16_t m8; ///< General purpose
 	};
 
+	static TileTypeHeight *type_height_tiles; ///< Pointer to the array with the type and height of the tiles.
 	static TileBase *base_tiles;         ///< Pointer to the tile-array.
 	static TileExtended *extended_tiles; ///< Pointer to the extended tile-array.
 
@@ -79,6 +92,19 @@ public:
 	 */
 	debug_inline constexpr operator uint() const { return tile.base(); }
 
+	/**
+	 * Hint the CPU to start loading the map data of this tile, as it is needed soon.
+	 * This has no effect on the map itself.
+	 */
+	debug_inline void Prefetch() const
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(&type_height_tiles[tile.base()]);
+		__builtin_prefetch(&base_tiles[tile.base()]);
+		__builtin_prefetch(&extended_tiles[tile.base()]);
+#endif
+	}
+
 	/**
 	 * The type (bits 4..7), bridges (2..3), rainforest/desert (0..1)
 	 *
@@ -88,7 +114,7 @@ public:
 	 */
 	debug_inline uint8_t &type()
 	{
-		return base_tiles[tile.base()].type;
+		return type_height_tiles[tile.base()].type;
 	}
 
 	/**
@@ -100,7 +126,7 @@ public:
 	 */
 	debug_inline uint8_t &height()
 	{
-		return base_tiles[tile.base()].height;
+		return type_height_tiles[tile.base()].height;
 	}
 
 	/**
@@ -290,6 +316,15 @@ public:
 		return Map::size;
 	}
 
+	/**
+	 * Get the number of bytes allocated for the tiles of the map.
+	 * @return the memory used by the tile arrays
+	 */
+	static inline size_t GetMemoryUsage()
+	{
+		return static_cast<size_t>(Map::size) * (sizeof(Tile::TileTypeHeight) + sizeof(Tile::TileBase) + sizeof(Tile::TileExtended));
+	}
+
 	/**
 	 * Gets the maximum X coordinate within the map, including MP_VOID
 	 * @return the maximum X coordinate
@@ -327,9 +362,9 @@ public:
 	 */
 	static inline uint ScaleBySize(uint n)
 	{
-		/* Subtract 12 from shift in order to prevent integer overflow
-		 * for large values of n. It's safe since the min mapsize is 64x64. */
-		return CeilDiv(n << (Map::LogX() + Map::LogY() - 12), 1 << 4);
+		/* Shift in 64 bits in order to prevent integer overflow
+		 * for large values of n on the largest maps. */
+		return static_cast<uint>(((static_cast<uint64_t>(n) << (Map::LogX() + Map::LogY())) + (1 << 16) - 1) >> 16);
 	}
 
 	/**
@@ -353,7 +388,7 @@ public:
 	 */
 	static bool IsInitialized()
 	{
-		return Tile::base_tiles != nullptr;
+		return Tile::type_height_tiles != nullptr;
 	}
 
 	/**
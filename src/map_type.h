@@ -35,9 +35,17 @@ struct TileIndexDiffC {
 
 /** Minimal and maximal map width and height */
 static const uint MIN_MAP_SIZE_BITS = 6;                       ///< Minimal size of map is equal to 2 ^ MIN_MAP_SIZE_BITS
-static const uint MAX_MAP_SIZE_BITS = 12;                      ///< Maximal size of map is equal to 2 ^ MAX_MAP_SIZE_BITS
+static const uint MAX_MAP_SIZE_BITS = 14;                      ///< Maximal size of map is equal to 2 ^ MAX_MAP_SIZE_BITS
 static const uint MIN_MAP_SIZE      = 1U << MIN_MAP_SIZE_BITS; ///< Minimal map size = 64
-static const uint MAX_MAP_SIZE      = 1U << MAX_MAP_SIZE_BITS; ///< Maximal map size = 4096
+static const uint MAX_MAP_SIZE      = 1U << MAX_MAP_SIZE_BITS; ///< Maximal map size = 16384
+
+/**
+ * Maximal number of tiles of a map is equal to 2 ^ MAX_MAP_TILES_BITS, i.e. 8192 x 8192 or 16384 x 4096.
+ * The map chunks in the savegame store up to two bytes per tile, which must stay within the 28 bit RIFF chunk length.
+ */
+static const uint MAX_MAP_TILES_BITS = 26;
+static const uint MAX_MAP_TILES      = 1U << MAX_MAP_TILES_BITS; ///< Maximal number of tiles of a map
+static_assert(2 * MIN_MAP_SIZE_BITS <= MAX_MAP_TILES_BITS && MAX_MAP_TILES_BITS <= 2 * MAX_MAP_SIZE_BITS);
 
 /**
  * Approximation of the length of a straight track, relative to a diagonal
@@ -32,6 +32,7 @@
 #include "town_kdtree.h"
 #include "viewport_kdtree.h"
 #include "newgrf_profiling.h"
+#include "pathfinder/yapf/yapf_cache.h"
 #include "3rdparty/monocypher/monocypher.h"
 
 #include "safeguards.h"
@@ -124,9 +125,13 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 	PoolBase::Clean(PT_NORMAL);
 
 	RebuildStationKdtree();
+	ClearStationCatchmentIndex();
 	RebuildTownKdtree();
 	RebuildViewportKdtree();
 
+	/* Cached rail segments of the previous game have to go. */
+	YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+
 	ResetPersistentNewGRFData();
 
 	InitializeSound();
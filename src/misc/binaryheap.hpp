@@ -5,7 +5,7 @@
  * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
  */
 
-/** @file binaryheap.hpp Binary heap implementation. */
+/** @file binaryheap.hpp Binary (or d-ary) heap implementation. */
 
 #ifndef BINARYHEAP_HPP
 #define BINARYHEAP_HPP
@@ -47,10 +47,18 @@
  * For further information about the Binary Heap algorithm, see
  * http://www.policyalmanac.org/games/binaryHeaps.htm
  *
+ * @par
+ * Every node can have more than two children. A 4-ary heap is shallower, so
+ * including items is cheaper and the children of a node share a cache line,
+ * at the cost of more comparisons when removing the first item.
+ *
  * @tparam T Type of the items stored in the binary heap
+ * @tparam Tarity Number of children of every node in the tree.
  */
-template <class T>
+template <class T, size_t Tarity = 2>
 class CBinaryHeapT {
+	static_assert(Tarity >= 2);
+
 private:
 	size_t items = 0; ///< Number of valid items in the heap
 	std::vector<T *> data; ///< The pointer to the heap item pointers
@@ -67,6 +75,26 @@ public:
 	}
 
 protected:
+	/**
+	 * Get the position of the first child of an item in the tree.
+	 * @param parent The position of the item.
+	 * @return The position of its first child.
+	 */
+	static inline size_t FirstChild(size_t parent)
+	{
+		return Tarity * (parent - 1) + 2;
+	}
+
+	/**
+	 * Get the position of the parent of an item in the tree.
+	 * @param child The position of the item, must not be the root.
+	 * @return The position of its parent.
+	 */
+	static inline size_t Parent(size_t child)
+	{
+		return (child - 2) / Tarity + 1;
+	}
+
 	/**
 	 * Get position for fixing a gap (downwards).
 	 *  The gap is moved downwards in the binary tree until it
@@ -80,14 +108,15 @@ protected:
 	{
 		assert(gap != 0);
 
-		/* The first child of the gap is at [parent * 2] */
-		size_t child = gap * 2;
+		/* The first child of the gap is at [parent * 2] for a binary tree */
+		size_t child = FirstChild(gap);
 
 		/* while children are valid */
 		while (child <= this->items) {
-			/* choose the smaller child */
-			if (child < this->items && *this->data[child + 1] < *this->data[child]) {
-				child++;
+			/* choose the smallest child */
+			size_t last = std::min(child + Tarity - 1, this->items);
+			for (size_t sibling = child + 1; sibling <= last; sibling++) {
+				if (*this->data[sibling] < *this->data[child]) child = sibling;
 			}
 			/* is it smaller than our parent? */
 			if (!(*this->data[child] < *item)) {
@@ -98,7 +127,7 @@ protected:
 			this->data[gap] = this->data[child];
 			gap = child;
 			/* where do we have our new children? */
-			child = gap * 2;
+			child = FirstChild(gap);
 		}
 		return gap;
 	}
@@ -120,7 +149,7 @@ protected:
 
 		while (gap > 1) {
 			/* compare [gap] with its parent */
-			parent = gap / 2;
+			parent = Parent(gap);
 			if (!(*item < *this->data[parent])) {
 				/* we don't need to continue upstairs */
 				break;
@@ -137,7 +166,7 @@ protected:
 	{
 		assert(this->items == this->data.size() - 1);
 		for (size_t child = 2; child <= this->items; child++) {
-			size_t parent = child / 2;
+			size_t parent = Parent(child);
 			assert(!(*this->data[child] < *this->data[parent]));
 		}
 	}
@@ -64,8 +64,19 @@ static int RateConversion(T *b, int frac_pos)
 	return ((b[0] * ((1 << 16) - frac_pos)) + (b[1] * frac_pos)) >> 16;
 }
 
+/**
+ * Mix the samples of a channel into the mixing buffer.
+ * The buffer is wider than the output, so no clamping is needed per channel
+ * and the inner loops stay simple enough for the compiler to vectorise.
+ * @param sc The channel to mix.
+ * @param buffer The mixing buffer with interleaved left and right samples.
+ * @param samples The number of samples to mix.
+ * @param volume_left The volume for the left output, including the effect volume.
+ * @param volume_right The volume for the right output, including the effect volume.
+ * @tparam T the size of the buffer (8 or 16 bits)
+ */
 template <typename T>
-static void mix_int16(MixerChannel *sc, int16_t *buffer, uint samples, uint8_t effect_vol)
+static void mix_int16(MixerChannel *sc, int32_t *buffer, uint samples, int volume_left, int volume_right)
 {
 	/* Shift required to get sample value into range for the data type. */
 	const uint SHIFT = sizeof(T) * CHAR_BIT;
@@ -77,22 +88,19 @@ static void mix_int16(MixerChannel *sc, int16_t *buffer, uint samples, uint8_t e
 	const T *b = (const T *)sc->memory + sc->pos;
 	uint32_t frac_pos = sc->frac_pos;
 	uint32_t frac_speed = sc->frac_speed;
-	int volume_left = sc->volume_left * effect_vol / 255;
-	int volume_right = sc->volume_right * effect_vol / 255;
 
 	if (frac_speed == 0x10000) {
 		/* Special case when frac_speed is 0x10000 */
-		do {
-			buffer[0] = Clamp(buffer[0] + (*b * volume_left  >> SHIFT), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (*b * volume_right >> SHIFT), -MAX_VOLUME, MAX_VOLUME);
-			b++;
-			buffer += 2;
-		} while (--samples > 0);
+		for (uint i = 0; i < samples; i++) {
+			buffer[i * 2 + 0] += b[i] * volume_left  >> SHIFT;
+			buffer[i * 2 + 1] += b[i] * volume_right >> SHIFT;
+		}
+		b += samples;
 	} else {
 		do {
 			int data = RateConversion(b, frac_pos);
-			buffer[0] = Clamp(buffer[0] + (data * volume_left  >> SHIFT), -MAX_VOLUME, MAX_VOLUME);
-			buffer[1] = Clamp(buffer[1] + (data * volume_right >> SHIFT), -MAX_VOLUME, MAX_VOLUME);
+			buffer[0] += data * volume_left  >> SHIFT;
+			buffer[1] += data * volume_right >> SHIFT;
 			buffer += 2;
 			frac_pos += frac_speed;
 			b += frac_pos >> 16;
@@ -104,6 +112,18 @@ static void mix_int16(MixerChannel *sc, int16_t *buffer, uint samples, uint8_t e
 	sc->pos = b - (const T *)sc->memory;
 }
 
+/**
+ * Check whether two channels play the same sound at the same position, so they can be mixed as one.
+ * @param a The first channel.
+ * @param b The second channel.
+ * @return True iff both channels would produce the same samples.
+ */
+static bool MxIsSameSound(const MixerChannel *a, const MixerChannel *b)
+{
+	return a->memory == b->memory && a->pos == b->pos && a->frac_pos == b->frac_pos && a->frac_speed == b->frac_speed &&
+			a->samples_left == b->samples_left && a->is16bit == b->is16bit;
+}
+
 static void MxCloseChannel(uint8_t channel_index)
 {
 	_active_channels.fetch_and(~(1 << channel_index), std::memory_order_release);
@@ -143,6 +163,9 @@ void MxMixSamples(void *buffer, uint samples)
 		MxCloseChannel(idx);
 	}
 
+	uint8_t active = _active_channels.load(std::memory_order_acquire);
+	if (active == 0) return;
+
 	/* Apply simple x^3 scaling to master effect volume. This increases the
 	 * perceived difference in loudness to better match expectations. effect_vol
 	 * is expected to be in the range 0-127 hence the division by 127 * 127 to
@@ -152,16 +175,54 @@ void MxMixSamples(void *buffer, uint samples)
 	                    effect_vol_setting *
 	                    effect_vol_setting) / (127 * 127);
 
+	/* Mix into a wider buffer, so clamping has to be done only once at the end.
+	 * Only the mixer thread gets here, so the buffer can be reused. */
+	static std::vector<int32_t> mix_buffer;
+	int16_t *output = (int16_t *)buffer;
+	mix_buffer.assign(output, output + samples * 2);
+
 	/* Mix each channel */
-	uint8_t active = _active_channels.load(std::memory_order_acquire);
+	uint8_t merged = 0;
 	for (uint8_t idx : SetBitIterator(active)) {
+		if (HasBit(merged, idx)) continue;
+
 		MixerChannel *mc = &_channels[idx];
+		int volume_left = mc->volume_left;
+		int volume_right = mc->volume_right;
+		uint8_t along = 0;
+
+		/* Channels playing the same sound in lockstep are mixed once with their volumes summed,
+		 * as long as the sum cannot overflow in the mixing. */
+		for (uint8_t other : SetBitIterator(active & ~((2U << idx) - 1))) {
+			const MixerChannel *oc = &_channels[other];
+			if (!MxIsSameSound(mc, oc) || volume_left + oc->volume_left > UINT16_MAX || volume_right + oc->volume_right > UINT16_MAX) continue;
+			volume_left += oc->volume_left;
+			volume_right += oc->volume_right;
+			SetBit(along, other);
+		}
+		merged |= along;
+
+		volume_left = volume_left * effect_vol / 255;
+		volume_right = volume_right * effect_vol / 255;
 		if (mc->is16bit) {
-			mix_int16<int16_t>(mc, (int16_t*)buffer, samples, effect_vol);
+			mix_int16<int16_t>(mc, mix_buffer.data(), samples, volume_left, volume_right);
 		} else {
-			mix_int16<int8_t>(mc, (int16_t*)buffer, samples, effect_vol);
+			mix_int16<int8_t>(mc, mix_buffer.data(), samples, volume_left, volume_right);
 		}
 		if (mc->samples_left == 0) MxCloseChannel(idx);
+
+		/* The merged channels have been played along. */
+		for (uint8_t other : SetBitIterator(along)) {
+			MixerChannel *oc = &_channels[other];
+			oc->pos = mc->pos;
+			oc->frac_pos = mc->frac_pos;
+			oc->samples_left = mc->samples_left;
+			if (oc->samples_left == 0) MxCloseChannel(other);
+		}
+	}
+
+	for (uint i = 0; i < samples * 2; i++) {
+		output[i] = Clamp(mix_buffer[i], -MAX_VOLUME, MAX_VOLUME);
 	}
 }
 
@@ -45,7 +45,7 @@ static const std::string NETWORK_SURVEY_DETAILS_LINK = "https://survey.openttd.o
 static const size_t TCP_MTU = 32767; ///< Number of bytes we can pack in a single TCP packet
 static const size_t COMPAT_MTU = 1460; ///< Number of bytes we can pack in a single packet for backward compatibility
 
-static const uint8_t NETWORK_GAME_ADMIN_VERSION        =    3;           ///< What version of the admin network do we use?
+static const uint8_t NETWORK_GAME_ADMIN_VERSION        =    4;           ///< What version of the admin network do we use?
 static const uint8_t NETWORK_GAME_INFO_VERSION         =    7;           ///< What version of game-info do we use?
 static const uint8_t NETWORK_COORDINATOR_VERSION       =    6;           ///< What version of game-coordinator-protocol do we use?
 static const uint8_t NETWORK_SURVEY_VERSION            =    2;           ///< What version of the survey do we use?
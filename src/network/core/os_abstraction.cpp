@@ -159,6 +159,22 @@ bool SetNoDelay([[maybe_unused]] SOCKET d)
 #endif
 }
 
+/**
+ * Check the state of a number of sockets at once, without blocking. Unlike
+ * select() this is not limited to FD_SETSIZE sockets, and the cost only
+ * depends on the number of sockets passed.
+ * @param fds The sockets and the events to check for; the events that happened are set in them.
+ * @return The number of sockets with events, or a negative value upon errors.
+ */
+int PollSockets(std::span<pollfd> fds)
+{
+#ifdef _WIN32
+	return WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), 0);
+#else
+	return poll(fds.data(), static_cast<nfds_t>(fds.size()), 0);
+#endif
+}
+
 /**
  * Try to set the socket to reuse ports.
  * @param d The socket to reuse ports on.
@@ -90,6 +90,7 @@ typedef unsigned long in_addr_t;
 #	include <errno.h>
 #	include <sys/time.h>
 #	include <netdb.h>
+#	include <poll.h>
 
 #   if defined(__EMSCRIPTEN__)
 /* Emscripten doesn't support AI_ADDRCONFIG and errors out on it. */
@@ -135,6 +136,7 @@ inline socklen_t FixAddrLenForEmscripten(struct sockaddr_storage &address)
 bool SetNonBlocking(SOCKET d);
 bool SetNoDelay(SOCKET d);
 bool SetReusePort(SOCKET d);
+int PollSockets(std::span<pollfd> fds);
 NetworkError GetSocketError(SOCKET d);
 
 /* Make sure these structures have the size we expect them to be */
@@ -16,6 +16,55 @@
 
 #include "../../safeguards.h"
 
+/** Maximum number of buffers kept for reuse per size class; enough for the packets of a busy frame. */
+static const std::array<size_t, 2> MAX_POOLED_PACKET_BUFFERS = {256, 16};
+
+/**
+ * Buffers of destroyed packets, kept to be reused by new packets. The first
+ * size class holds buffers for packets up to #COMPAT_MTU, the second for larger
+ * ones. The pool is per thread, so no locking is needed.
+ */
+struct PacketBufferPool {
+	std::array<std::vector<std::vector<uint8_t>>, 2> buffers; ///< The buffers per size class.
+
+	~PacketBufferPool();
+};
+
+static thread_local PacketBufferPool _packet_buffer_pool;
+static thread_local bool _packet_buffer_pool_destroyed = false; ///< Whether the pool of this thread is gone, e.g. when static sockets are destroyed at exit.
+
+PacketBufferPool::~PacketBufferPool()
+{
+	_packet_buffer_pool_destroyed = true;
+}
+
+/**
+ * Get the size class of the packet buffer pool for packets with the given limit.
+ * @param limit The maximum size of the packet.
+ * @return The index of the size class.
+ */
+static inline size_t GetPacketBufferClass(size_t limit)
+{
+	return limit > COMPAT_MTU ? 1 : 0;
+}
+
+/**
+ * Get an empty buffer for a packet, reusing the buffer of an earlier packet if possible.
+ * @param limit The maximum size of the packet.
+ * @return The buffer.
+ */
+static std::vector<uint8_t> AcquirePacketBuffer(size_t limit)
+{
+	if (_packet_buffer_pool_destroyed) return {};
+
+	auto &pool = _packet_buffer_pool.buffers[GetPacketBufferClass(limit)];
+	if (pool.empty()) return {};
+
+	std::vector<uint8_t> buffer = std::move(pool.back());
+	pool.pop_back();
+	return buffer;
+}
+
 /**
  * Create a packet that is used to read from a network socket.
  * @param cs                The socket handler associated with the socket we are reading from.
@@ -33,6 +82,7 @@ Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size)
 	assert(cs != nullptr);
 
 	this->cs = cs;
+	this->buffer = AcquirePacketBuffer(limit);
 	this->buffer.resize(initial_read_size);
 }
 
@@ -54,11 +104,26 @@ Packet::Packet(NetworkSocketHandler *cs, PacketType type, size_t limit) : pos(0)
 		size += cs->send_encryption_handler->MACSize();
 	}
 	assert(this->CanWriteToPacket(size));
+	this->buffer = AcquirePacketBuffer(limit);
 	this->buffer.resize(size, 0);
 
 	this->Send_uint8(type);
 }
 
+/** Hand the buffer of the packet back to the pool, for reuse by a next packet. */
+Packet::~Packet()
+{
+	/* Moved-from packets have nothing worth keeping. */
+	if (this->buffer.capacity() == 0 || _packet_buffer_pool_destroyed) return;
+
+	size_t size_class = GetPacketBufferClass(this->limit);
+	auto &pool = _packet_buffer_pool.buffers[size_class];
+	if (pool.size() >= MAX_POOLED_PACKET_BUFFERS[size_class]) return;
+
+	this->buffer.clear();
+	pool.push_back(std::move(this->buffer));
+}
+
 
 /**
  * Writes the packet size from the raw packet from packet->size
@@ -448,3 +513,23 @@ size_t Packet::RemainingBytesToTransfer() const
 {
 	return this->Size() - this->pos;
 }
+
+/**
+ * Get the bytes of the packet that have not been transferred yet, for
+ * transferring multiple packets at once.
+ * @return The bytes that still need to be transferred.
+ */
+std::span<const uint8_t> Packet::GetBytesToTransfer() const
+{
+	return std::span<const uint8_t>(this->buffer.data() + this->pos, this->RemainingBytesToTransfer());
+}
+
+/**
+ * Mark bytes returned by #GetBytesToTransfer as transferred.
+ * @param bytes The number of bytes that have been transferred.
+ */
+void Packet::MarkBytesTransferred(size_t bytes)
+{
+	assert(bytes <= this->RemainingBytesToTransfer());
+	this->pos += static_cast<PacketSize>(bytes);
+}
@@ -56,6 +56,12 @@ private:
 public:
 	Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size = EncodedLengthOfPacketSize());
 	Packet(NetworkSocketHandler *cs, PacketType type, size_t limit = COMPAT_MTU);
+	~Packet();
+
+	Packet(const Packet &) = default;
+	Packet(Packet &&) = default;
+	Packet &operator=(const Packet &) = default;
+	Packet &operator=(Packet &&) = default;
 
 	/* Sending/writing of packets */
 	void PrepareToSend();
@@ -88,6 +94,8 @@ public:
 	std::string Recv_string(size_t length, StringValidationSettings settings = SVS_REPLACE_WITH_QUESTION_MARK);
 
 	size_t RemainingBytesToTransfer() const;
+	std::span<const uint8_t> GetBytesToTransfer() const;
+	void MarkBytesTransferred(size_t bytes);
 
 	/**
 	 * Transfer data from the packet to the given function. It starts reading at the
@@ -14,6 +14,10 @@
 
 #include "tcp.h"
 
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+#	include <sys/uio.h>
+#endif
+
 #include "../../safeguards.h"
 
 /**
@@ -90,8 +94,8 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 	if (!this->IsConnected()) return SPS_CLOSED;
 
 	while (!this->packet_queue.empty()) {
-		Packet &p = *this->packet_queue.front();
-		ssize_t res = p.TransferOut<int>(send, this->sock, 0);
+		size_t requested;
+		ssize_t res = this->SendQueuedBytes(requested);
 		if (res == -1) {
 			NetworkError err = NetworkError::GetLast();
 			if (!err.WouldBlock()) {
@@ -110,18 +114,67 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 			return SPS_CLOSED;
 		}
 
-		/* Is this packet sent? */
-		if (p.RemainingBytesToTransfer() == 0) {
-			/* Go to the next packet */
-			this->packet_queue.pop_front();
-		} else {
-			return SPS_PARTLY_SENT;
+		/* Remove the packets that are completely sent. */
+		size_t sent = res;
+		while (sent != 0) {
+			Packet &p = *this->packet_queue.front();
+			size_t amount = std::min(sent, p.RemainingBytesToTransfer());
+			p.MarkBytesTransferred(amount);
+			sent -= amount;
+			if (p.RemainingBytesToTransfer() == 0) this->packet_queue.pop_front();
 		}
+
+		/* The OS did not take everything, so it will not take more right now. */
+		if (static_cast<size_t>(res) != requested) return SPS_PARTLY_SENT;
 	}
 
 	return SPS_ALL_SENT;
 }
 
+/**
+ * Send as many of the queued packets as possible with a single call to the OS.
+ * @param[out] requested The number of bytes that were offered to the OS.
+ * @return The number of sent bytes, or -1 upon errors.
+ */
+ssize_t NetworkTCPSocketHandler::SendQueuedBytes(size_t &requested)
+{
+	requested = 0;
+
+#if defined(_WIN32)
+	std::array<WSABUF, MAX_PACKETS_PER_SEND> buffers;
+#elif defined(UNIX) && !defined(__EMSCRIPTEN__)
+	std::array<iovec, MAX_PACKETS_PER_SEND> buffers;
+#else
+	/* No scatter/gather support, so send one packet at a time. */
+	std::span<const uint8_t> bytes = this->packet_queue.front()->GetBytesToTransfer();
+	requested = bytes.size();
+	return send(this->sock, reinterpret_cast<const char *>(bytes.data()), static_cast<int>(bytes.size()), 0);
+#endif
+
+#if defined(_WIN32) || (defined(UNIX) && !defined(__EMSCRIPTEN__))
+	size_t count = 0;
+	for (auto it = this->packet_queue.begin(); it != this->packet_queue.end() && count < buffers.size(); ++it, ++count) {
+		std::span<const uint8_t> bytes = (*it)->GetBytesToTransfer();
+#	if defined(_WIN32)
+		buffers[count].buf = reinterpret_cast<char *>(const_cast<uint8_t *>(bytes.data()));
+		buffers[count].len = static_cast<ULONG>(bytes.size());
+#	else
+		buffers[count].iov_base = const_cast<uint8_t *>(bytes.data());
+		buffers[count].iov_len = bytes.size();
+#	endif
+		requested += bytes.size();
+	}
+
+#	if defined(_WIN32)
+	DWORD sent;
+	if (WSASend(this->sock, buffers.data(), static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) != 0) return -1;
+	return sent;
+#	else
+	return writev(this->sock, buffers.data(), static_cast<int>(count));
+#	endif
+#endif
+}
+
 /**
  * Receives a packet for the given client
  * @return The received packet (or nullptr when it didn't receive one)
@@ -33,6 +33,11 @@ private:
 	std::deque<std::unique_ptr<Packet>> packet_queue; ///< Packets that are awaiting delivery. Cannot be std::queue as that does not have a clear() function.
 	std::unique_ptr<Packet> packet_recv; ///< Partially received packet
 
+	/** Maximum number of queued packets that are handed to the OS at once. */
+	static const size_t MAX_PACKETS_PER_SEND = 64;
+
+	ssize_t SendQueuedBytes(size_t &requested);
+
 	void EmptyPacketQueue();
 public:
 	SOCKET sock;              ///< The socket currently connected to
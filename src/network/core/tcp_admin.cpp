@@ -95,6 +95,10 @@ NetworkRecvStatus NetworkAdminSocketHandler::HandlePacket(Packet &p)
 		case ADMIN_PACKET_SERVER_PONG:            return this->Receive_SERVER_PONG(p);
 		case ADMIN_PACKET_SERVER_AUTH_REQUEST:    return this->Receive_SERVER_AUTH_REQUEST(p);
 		case ADMIN_PACKET_SERVER_ENABLE_ENCRYPTION: return this->Receive_SERVER_ENABLE_ENCRYPTION(p);
+		case ADMIN_PACKET_SERVER_VEHICLE_PROFIT:  return this->Receive_SERVER_VEHICLE_PROFIT(p);
+		case ADMIN_PACKET_SERVER_STATION_CARGO:   return this->Receive_SERVER_STATION_CARGO(p);
+		case ADMIN_PACKET_SERVER_VEHICLE_REMOVED: return this->Receive_SERVER_VEHICLE_REMOVED(p);
+		case ADMIN_PACKET_SERVER_STATION_REMOVED: return this->Receive_SERVER_STATION_REMOVED(p);
 
 		default:
 			Debug(net, 0, "[tcp/admin] Received invalid packet type {} from '{}' ({})", type, this->admin_name, this->admin_version);
@@ -173,3 +177,7 @@ NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_RCON_END(Packet &) {
 NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_PONG(Packet &) { return this->ReceiveInvalidPacket(ADMIN_PACKET_SERVER_PONG); }
 NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_AUTH_REQUEST(Packet &) { return this->ReceiveInvalidPacket(ADMIN_PACKET_SERVER_AUTH_REQUEST); }
 NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_ENABLE_ENCRYPTION(Packet &) { return this->ReceiveInvalidPacket(ADMIN_PACKET_SERVER_ENABLE_ENCRYPTION); }
+NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_VEHICLE_PROFIT(Packet &) { return this->ReceiveInvalidPacket(ADMIN_PACKET_SERVER_VEHICLE_PROFIT); }
+NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_STATION_CARGO(Packet &) { return this->ReceiveInvalidPacket(ADMIN_PACKET_SERVER_STATION_CARGO); }
+NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_VEHICLE_REMOVED(Packet &) { return this->ReceiveInvalidPacket(ADMIN_PACKET_SERVER_VEHICLE_REMOVED); }
+NetworkRecvStatus NetworkAdminSocketHandler::Receive_SERVER_STATION_REMOVED(Packet &) { return this->ReceiveInvalidPacket(ADMIN_PACKET_SERVER_STATION_REMOVED); }
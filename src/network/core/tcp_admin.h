@@ -65,6 +65,10 @@ enum PacketAdminType : uint8_t {
 	ADMIN_PACKET_SERVER_CMD_LOGGING,     ///< The server gives the admin copies of incoming command packets.
 	ADMIN_PACKET_SERVER_AUTH_REQUEST,    ///< The server gives the admin the used authentication method and required parameters.
 	ADMIN_PACKET_SERVER_ENABLE_ENCRYPTION, ///< The server tells that authentication has completed and requests to enable encryption with the keys of the last \c ADMIN_PACKET_ADMIN_AUTH_RESPONSE.
+	ADMIN_PACKET_SERVER_VEHICLE_PROFIT,  ///< The server gives the admin the profits of vehicles that changed.
+	ADMIN_PACKET_SERVER_STATION_CARGO,   ///< The server gives the admin the waiting cargo of stations that changed.
+	ADMIN_PACKET_SERVER_VEHICLE_REMOVED, ///< The server tells the admin which vehicles with sent profits were removed.
+	ADMIN_PACKET_SERVER_STATION_REMOVED, ///< The server tells the admin which stations with sent cargo were removed.
 
 	INVALID_ADMIN_PACKET = 0xFF,         ///< An invalid marker for admin packets.
 };
@@ -89,6 +93,8 @@ enum AdminUpdateType {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_VEHICLE_PROFIT,  ///< Updates about the profits of vehicles, only of those that changed.
+	ADMIN_UPDATE_STATION_CARGO,   ///< Updates about the cargo waiting at stations, only of those that changed.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -538,6 +544,46 @@ protected:
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_RCON_END(Packet &p);
 
+	/**
+	 * Profits of the vehicles that changed since they were last sent to the admin.
+	 * Repeated until the end of the packet:
+	 * uint32_t  ID of the vehicle.
+	 * int64_t   Profit of the vehicle this year.
+	 * int64_t   Profit of the vehicle last year.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_VEHICLE_PROFIT(Packet &p);
+
+	/**
+	 * Cargo waiting at stations that changed since it was last sent to the admin.
+	 * Repeated until the end of the packet:
+	 * uint16_t  ID of the station.
+	 * uint8_t   ID of the cargo type.
+	 * uint32_t  Amount of waiting cargo.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_STATION_CARGO(Packet &p);
+
+	/**
+	 * Vehicles that were removed after their profits were sent to the admin.
+	 * Repeated until the end of the packet:
+	 * uint32_t  ID of the vehicle.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_VEHICLE_REMOVED(Packet &p);
+
+	/**
+	 * Stations that were removed after their waiting cargo was sent to the admin.
+	 * Repeated until the end of the packet:
+	 * uint16_t  ID of the station.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_STATION_REMOVED(Packet &p);
+
 	NetworkRecvStatus HandlePacket(Packet &p);
 public:
 	NetworkRecvStatus CloseConnection(bool error = true) override;
@@ -124,6 +124,9 @@ enum PacketGameType : uint8_t {
 	PACKET_CLIENT_ERROR,                 ///< A client reports an error to the server.
 	PACKET_SERVER_ERROR_QUIT,            ///< A server tells that a client has hit an error and did quit.
 
+	/* Sending many commands around at once. */
+	PACKET_SERVER_COMMAND_BATCH,         ///< Server distributes multiple commands of the same frame to a client.
+
 	PACKET_END,                          ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -347,6 +350,21 @@ protected:
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_COMMAND(Packet &p);
 
+	/**
+	 * Sends multiple DoCommands to the client at once, to be executed in the
+	 * order they are in the packet. Repeated until the end of the packet:
+	 * uint8_t   ID of the company (0..MAX_COMPANIES-1).
+	 * uint16_t  ID of the command (see command.h).
+	 * uint16_t  ID of the error message to show on failure.
+	 * <var>   Command specific buffer with encoded parameters of variable length.
+	 *         The content differs per command and can change without notification.
+	 * uint8_t   ID of the callback.
+	 * uint32_t  Frame of execution.
+	 * bool    Whether the command was sent by the client itself.
+	 * @param p The packet that was just received.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_COMMAND_BATCH(Packet &p);
+
 	/**
 	 * Sends a chat-packet to the server:
 	 * uint8_t   ID of the action (see NetworkAction).
@@ -100,35 +100,36 @@ public:
 	 */
 	static bool Receive()
 	{
-		fd_set read_fd, write_fd;
-		struct timeval tv;
-
-		FD_ZERO(&read_fd);
-		FD_ZERO(&write_fd);
+		/* Kept between calls, so they do not need to be allocated every tick. */
+		static std::vector<pollfd> fds;
+		static std::vector<Tsocket *> clients;
 
+		fds.clear();
+		clients.clear();
 
 		for (Tsocket *cs : Tsocket::Iterate()) {
-			FD_SET(cs->sock, &read_fd);
-			FD_SET(cs->sock, &write_fd);
+			fds.push_back({cs->sock, POLLIN | POLLOUT, 0});
+			clients.push_back(cs);
 		}
 
 		/* take care of listener port */
 		for (auto &s : sockets) {
-			FD_SET(s.first, &read_fd);
+			fds.push_back({s.first, POLLIN, 0});
 		}
 
-		tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-		if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+		if (PollSockets(fds) < 0) return false;
 
 		/* accept clients.. */
+		size_t i = clients.size();
 		for (auto &s : sockets) {
-			if (FD_ISSET(s.first, &read_fd)) AcceptClient(s.first);
+			if ((fds[i++].revents & POLLIN) != 0) AcceptClient(s.first);
 		}
 
-		/* read stuff from clients */
-		for (Tsocket *cs : Tsocket::Iterate()) {
-			cs->writable = !!FD_ISSET(cs->sock, &write_fd);
-			if (FD_ISSET(cs->sock, &read_fd)) {
+		/* read stuff from clients; errors and hang-ups are found out by reading too */
+		for (i = 0; i < clients.size(); i++) {
+			Tsocket *cs = clients[i];
+			cs->writable = (fds[i].revents & POLLOUT) != 0;
+			if ((fds[i].revents & (POLLIN | POLLERR | POLLHUP)) != 0) {
 				cs->ReceivePackets();
 			}
 		}
@@ -37,10 +37,12 @@
 #include "../gfx_func.h"
 #include "../error.h"
 #include "../misc_cmd.h"
+#include "../trace.h"
 #ifdef DEBUG_DUMP_COMMANDS
 #	include "../fileio_func.h"
 #endif
 #include <charconv>
+#include <deque>
 #include <sstream>
 #include <iomanip>
 
@@ -638,13 +640,32 @@ static void NetworkInitialize(bool close_admins = true)
 	_network_reconnect = 0;
 }
 
+/**
+ * Maximum number of servers that are being connected to for a query at the same time.
+ * Every connecter resolves in its own thread and may keep a few sockets open for
+ * its connection attempts, so refreshing a long server list all at once would
+ * spawn hundreds of threads and sockets.
+ */
+static const uint MAX_CONCURRENT_QUERY_CONNECTS = 32;
+
+static uint _query_connecters_active = 0;           ///< Number of query connecters that have not finished yet.
+static std::deque<std::string> _pending_queries;    ///< Queries waiting for a free connecter slot.
+
 /** Non blocking connection to query servers for their game info. */
 class TCPQueryConnecter : public TCPServerConnecter {
 private:
 	std::string connection_string;
 
 public:
-	TCPQueryConnecter(const std::string &connection_string) : TCPServerConnecter(connection_string, NETWORK_DEFAULT_PORT), connection_string(connection_string) {}
+	TCPQueryConnecter(const std::string &connection_string) : TCPServerConnecter(connection_string, NETWORK_DEFAULT_PORT), connection_string(connection_string)
+	{
+		_query_connecters_active++;
+	}
+
+	~TCPQueryConnecter() override
+	{
+		_query_connecters_active--;
+	}
 
 	void OnFailure() override
 	{
@@ -679,9 +700,28 @@ void NetworkQueryServer(const std::string &connection_string)
 	NetworkGameList *item = NetworkGameListAddItem(connection_string);
 	item->refreshing = true;
 
+	if (_query_connecters_active >= MAX_CONCURRENT_QUERY_CONNECTS) {
+		if (std::ranges::find(_pending_queries, connection_string) == _pending_queries.end()) _pending_queries.push_back(connection_string);
+		return;
+	}
+
 	TCPConnecter::Create<TCPQueryConnecter>(connection_string);
 }
 
+/** Start the queued server queries for which a connecter slot became available. */
+static void NetworkStartPendingQueries()
+{
+	if (!_network_available) {
+		_pending_queries.clear();
+		return;
+	}
+
+	while (!_pending_queries.empty() && _query_connecters_active < MAX_CONCURRENT_QUERY_CONNECTS) {
+		TCPConnecter::Create<TCPQueryConnecter>(_pending_queries.front());
+		_pending_queries.pop_front();
+	}
+}
+
 /**
  * Validates an address entered as a string and adds the server to
  * the list. If you use this function, the games will be marked
@@ -1051,6 +1091,7 @@ void NetworkUpdateServerGameType()
  */
 static bool NetworkReceive()
 {
+	TraceZone trace("NetworkReceive");
 	bool result;
 	if (_network_server) {
 		ServerNetworkAdminSocketHandler::Receive();
@@ -1065,6 +1106,8 @@ static bool NetworkReceive()
 /* This sends all buffered commands (if possible) */
 static void NetworkSend()
 {
+	TraceZone trace("NetworkSend");
+
 	if (_network_server) {
 		ServerNetworkAdminSocketHandler::Send();
 		ServerNetworkGameSocketHandler::Send();
@@ -1083,6 +1126,7 @@ void NetworkBackgroundLoop()
 {
 	_network_content_client.SendReceive();
 	_network_coordinator_client.SendReceive();
+	NetworkStartPendingQueries();
 	TCPConnecter::CheckCallbacks();
 	NetworkHTTPSocketHandler::HTTPReceive();
 	QueryNetworkGameSocketHandler::SendReceive();
@@ -1213,7 +1257,7 @@ void NetworkGameLoop()
 				check_sync_state = true;
 			} else if (strncmp(p, "msg: ", 5) == 0 || strncmp(p, "client: ", 8) == 0 ||
 						strncmp(p, "load: ", 6) == 0 || strncmp(p, "save: ", 6) == 0 ||
-						strncmp(p, "warning: ", 9) == 0) {
+						strncmp(p, "warning: ", 9) == 0 || strncmp(p, "state: ", 7) == 0) {
 				/* A message that is not very important to the log playback, but part of the log. */
 #ifndef DEBUG_FAILED_DUMP_COMMANDS
 			} else if (strncmp(p, "cmdf: ", 6) == 0) {
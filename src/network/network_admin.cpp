@@ -22,6 +22,8 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../station_base.h"
+#include "../vehicle_base.h"
 
 #include "../safeguards.h"
 
@@ -57,6 +59,8 @@ static const AdminUpdateFrequency _admin_update_type_frequencies[] = {
 	ADMIN_FREQUENCY_POLL,                                                                                                                                  ///< ADMIN_UPDATE_CMD_NAMES
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CMD_LOGGING
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_GAMESCRIPT
+	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_VEHICLE_PROFIT
+	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_STATION_CARGO
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -192,6 +196,12 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendWelcome()
 
 	this->SendPacket(std::move(p));
 
+	/* What was sent about the vehicles and stations of the previous game does not apply anymore. */
+	this->sent_vehicle_profit.clear();
+	this->sent_station_cargo.clear();
+	this->removed_vehicles.clear();
+	this->removed_stations.clear();
+
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
@@ -445,6 +455,104 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Add a record to a packet of records, sending the packet and starting a new one when it is full.
+ * @param as The admin to send the packets to.
+ * @param p The packet being filled.
+ * @param type The type of the packets.
+ * @param record_size The size of the record to add.
+ */
+static void PrepareAdminRecord(ServerNetworkAdminSocketHandler *as, std::unique_ptr<Packet> &p, PacketType type, size_t record_size)
+{
+	if (p != nullptr && !p->CanWriteToPacket(record_size)) as->SendPacket(std::move(p));
+	if (p == nullptr) p = std::make_unique<Packet>(as, type);
+}
+
+/**
+ * Send the profits of vehicles.
+ * @param all Whether to send all vehicles, instead of only the ones that changed since the last time.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendVehicleProfit(bool all)
+{
+	static const size_t RECORD_SIZE = sizeof(uint32_t) + 2 * sizeof(int64_t);
+
+	std::unique_ptr<Packet> p;
+	/* Report the removals first, as their IDs might have been reused by the vehicles below. */
+	for (VehicleID vehicle_id : this->removed_vehicles) {
+		PrepareAdminRecord(this, p, ADMIN_PACKET_SERVER_VEHICLE_REMOVED, sizeof(uint32_t));
+		p->Send_uint32(vehicle_id);
+	}
+	if (p != nullptr) this->SendPacket(std::move(p));
+	this->removed_vehicles.clear();
+
+	if (all) this->sent_vehicle_profit.clear();
+
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		if (!v->IsPrimaryVehicle()) continue;
+
+		std::pair<Money, Money> profit(v->profit_this_year, v->profit_last_year);
+		auto [it, inserted] = this->sent_vehicle_profit.try_emplace(v->index, profit);
+		if (!inserted) {
+			if (it->second == profit) continue;
+			it->second = profit;
+		}
+
+		PrepareAdminRecord(this, p, ADMIN_PACKET_SERVER_VEHICLE_PROFIT, RECORD_SIZE);
+		p->Send_uint32(v->index);
+		p->Send_uint64(v->profit_this_year);
+		p->Send_uint64(v->profit_last_year);
+	}
+	if (p != nullptr) this->SendPacket(std::move(p));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+/**
+ * Send the cargo waiting at stations.
+ * @param all Whether to send all stations, instead of only the ones that changed since the last time.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendStationCargo(bool all)
+{
+	static const size_t RECORD_SIZE = sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint32_t);
+
+	std::unique_ptr<Packet> p;
+	/* Report the removals first, as their IDs might have been reused by the stations below. */
+	for (StationID station_id : this->removed_stations) {
+		PrepareAdminRecord(this, p, ADMIN_PACKET_SERVER_STATION_REMOVED, sizeof(uint16_t));
+		p->Send_uint16(station_id);
+	}
+	if (p != nullptr) this->SendPacket(std::move(p));
+	this->removed_stations.clear();
+
+	if (all) this->sent_station_cargo.clear();
+
+	for (const Station *st : Station::Iterate()) {
+		for (CargoID c = 0; c < NUM_CARGO; c++) {
+			uint32_t waiting = st->goods[c].cargo.TotalCount();
+			uint32_t key = st->index << 8 | c;
+
+			auto it = this->sent_station_cargo.find(key);
+			if (it == this->sent_station_cargo.end()) {
+				/* Nothing waiting is not worth a record, until there has been cargo. */
+				if (waiting == 0 && !all) continue;
+				this->sent_station_cargo.emplace(key, waiting);
+				if (waiting == 0) continue;
+			} else {
+				if (it->second == waiting) continue;
+				it->second = waiting;
+			}
+
+			PrepareAdminRecord(this, p, ADMIN_PACKET_SERVER_STATION_CARGO, RECORD_SIZE);
+			p->Send_uint16(st->index);
+			p->Send_uint8(c);
+			p->Send_uint32(waiting);
+		}
+	}
+	if (p != nullptr) this->SendPacket(std::move(p));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -748,6 +856,16 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet &p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_VEHICLE_PROFIT:
+			/* The admin is requesting the profits of all vehicles. */
+			this->SendVehicleProfit(true);
+			break;
+
+		case ADMIN_UPDATE_STATION_CARGO:
+			/* The admin is requesting the waiting cargo of all stations. */
+			this->SendStationCargo(true);
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			Debug(net, 1, "[admin] Not supported poll {} ({}) from '{}' ({}).", type, d1, this->admin_name, this->admin_version);
@@ -989,6 +1107,34 @@ void NetworkAdminCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bc
 	}
 }
 
+/**
+ * Notify the admin network of a vehicle that is removed.
+ * Admins that were sent its profit get the removal with their next profit update.
+ * @param vehicle_id ID of the vehicle that is removed.
+ */
+void NetworkAdminVehicleRemove(VehicleID vehicle_id)
+{
+	for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::IterateActive()) {
+		if (as->sent_vehicle_profit.erase(vehicle_id) != 0) as->removed_vehicles.push_back(vehicle_id);
+	}
+}
+
+/**
+ * Notify the admin network of a station that is removed.
+ * Admins that were sent its waiting cargo get the removal with their next cargo update.
+ * @param station_id ID of the station that is removed.
+ */
+void NetworkAdminStationRemove(StationID station_id)
+{
+	for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::IterateActive()) {
+		bool sent = false;
+		for (CargoID c = 0; c < NUM_CARGO; c++) {
+			if (as->sent_station_cargo.erase(station_id << 8 | c) != 0) sent = true;
+		}
+		if (sent) as->removed_stations.push_back(station_id);
+	}
+}
+
 
 /**
  * Send chat to the admin network (if they did opt in for the respective update).
@@ -1091,6 +1237,14 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendCompanyStats();
 						break;
 
+					case ADMIN_UPDATE_VEHICLE_PROFIT:
+						as->SendVehicleProfit(false);
+						break;
+
+					case ADMIN_UPDATE_STATION_CARGO:
+						as->SendStationCargo(false);
+						break;
+
 					default: NOT_REACHED();
 				}
 			}
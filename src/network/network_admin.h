@@ -13,6 +13,8 @@
 #include "network_internal.h"
 #include "core/tcp_listen.h"
 #include "core/tcp_admin.h"
+#include "../station_type.h"
+#include "../vehicle_type.h"
 
 extern AdminIndex _redirect_console_to_admin;
 
@@ -47,6 +49,11 @@ public:
 	std::chrono::steady_clock::time_point connect_time;      ///< Time of connection.
 	NetworkAddress address;                                  ///< Address of the admin.
 
+	std::unordered_map<uint32_t, std::pair<Money, Money>> sent_vehicle_profit; ///< Profits of the vehicles as last sent to the admin.
+	std::unordered_map<uint32_t, uint32_t> sent_station_cargo;                 ///< Waiting cargo of the stations as last sent to the admin, by station and cargo.
+	std::vector<VehicleID> removed_vehicles;                                   ///< Vehicles with sent profits that were removed since the last update.
+	std::vector<StationID> removed_stations;                                   ///< Stations with sent cargo that were removed since the last update.
+
 	ServerNetworkAdminSocketHandler(SOCKET s);
 	~ServerNetworkAdminSocketHandler();
 
@@ -67,6 +74,8 @@ public:
 	NetworkRecvStatus SendCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
 	NetworkRecvStatus SendCompanyEconomy();
 	NetworkRecvStatus SendCompanyStats();
+	NetworkRecvStatus SendVehicleProfit(bool all);
+	NetworkRecvStatus SendStationCargo(bool all);
 
 	NetworkRecvStatus SendChat(NetworkAction action, DestType desttype, ClientID client_id, const std::string &msg, int64_t data);
 	NetworkRecvStatus SendRcon(uint16_t colour, const std::string_view command);
@@ -112,6 +121,8 @@ void NetworkAdminClientError(ClientID client_id, NetworkErrorCode error_code);
 void NetworkAdminCompanyNew(const Company *company);
 void NetworkAdminCompanyUpdate(const Company *company);
 void NetworkAdminCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
+void NetworkAdminVehicleRemove(VehicleID vehicle_id);
+void NetworkAdminStationRemove(StationID station_id);
 
 void NetworkAdminChat(NetworkAction action, DestType desttype, ClientID client_id, const std::string &msg, int64_t data = 0, bool from_admin = false);
 void NetworkAdminUpdate(AdminUpdateFrequency freq);
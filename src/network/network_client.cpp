@@ -974,6 +974,19 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_COMMAND(Packet
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_COMMAND_BATCH(Packet &p)
+{
+	if (this->status != STATUS_ACTIVE) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	/* The commands are stored just like in a PACKET_SERVER_COMMAND, one after the other. */
+	do {
+		NetworkRecvStatus status = this->Receive_SERVER_COMMAND(p);
+		if (status != NETWORK_RECV_STATUS_OKAY) return status;
+	} while (p.CanReadFromPacket(1));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_CHAT(Packet &p)
 {
 	if (this->status != STATUS_ACTIVE) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
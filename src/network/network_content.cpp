@@ -376,101 +376,98 @@ void ClientNetworkContentSocketHandler::DownloadSelectedContentFallback(const Co
 
 /**
  * Determine the full filename of a piece of content information
- * @param ci         the information to get the filename from
- * @param compressed should the filename end with .gz?
+ * @param ci the information to get the filename from
  * @return a statically allocated buffer with the filename or
  *         nullptr when no filename could be made.
  */
-static std::string GetFullFilename(const ContentInfo *ci, bool compressed)
+static std::string GetFullFilename(const ContentInfo *ci)
 {
 	Subdirectory dir = GetContentInfoSubDir(ci->type);
 	if (dir == NO_DIRECTORY) return {};
 
 	std::string buf = FioGetDirectory(SP_AUTODOWNLOAD_DIR, dir);
 	buf += ci->filename;
-	buf += compressed ? ".tar.gz" : ".tar";
+	buf += ".tar";
 
 	return buf;
 }
 
 /**
- * Gunzip a given file and remove the .gz if successful.
- * @param ci container with filename
- * @return true if the gunzip completed
+ * Decompressor for the gzipped content, so it can be decompressed while it is
+ * being downloaded instead of writing the compressed file to disk and reading
+ * it back once the download completed.
  */
-static bool GunzipFile(const ContentInfo *ci)
-{
+struct ContentDownloadInflater {
 #if defined(WITH_ZLIB)
-	bool ret = true;
+	z_stream z{};          ///< State of zlib.
+	bool finished = false; ///< Whether the end of the (last) gzip stream has been reached.
 
-	/* Need to open the file with fopen() to support non-ASCII on Windows. */
-	FILE *ftmp = fopen(GetFullFilename(ci, true).c_str(), "rb");
-	if (ftmp == nullptr) return false;
-	/* Duplicate the handle, and close the FILE*, to avoid double-closing the handle later. */
-	int fdup = dup(fileno(ftmp));
-	gzFile fin = gzdopen(fdup, "rb");
-	fclose(ftmp);
+	ContentDownloadInflater()
+	{
+		/* Window bits + 16 to only accept the gzip format. */
+		if (inflateInit2(&this->z, MAX_WBITS + 16) != Z_OK) throw std::bad_alloc();
+	}
 
-	FILE *fout = fopen(GetFullFilename(ci, false).c_str(), "wb");
+	~ContentDownloadInflater()
+	{
+		inflateEnd(&this->z);
+	}
 
-	if (fin == nullptr || fout == nullptr) {
-		ret = false;
-	} else {
-		uint8_t buff[8192];
-		for (;;) {
-			int read = gzread(fin, buff, sizeof(buff));
-			if (read == 0) {
-				/* If gzread() returns 0, either the end-of-file has been
-				 * reached or an underlying read error has occurred.
-				 *
-				 * gzeof() can't be used, because:
-				 * 1.2.5 - it is safe, 1 means 'everything was OK'
-				 * 1.2.3.5, 1.2.4 - 0 or 1 is returned 'randomly'
-				 * 1.2.3.3 - 1 is returned for truncated archive
-				 *
-				 * So we use gzerror(). When proper end of archive
-				 * has been reached, then:
-				 * errnum == Z_STREAM_END in 1.2.3.3,
-				 * errnum == 0 in 1.2.4 and 1.2.5 */
-				int errnum;
-				gzerror(fin, &errnum);
-				if (errnum != 0 && errnum != Z_STREAM_END) ret = false;
-				break;
-			}
-			if (read < 0 || static_cast<size_t>(read) != fwrite(buff, 1, read, fout)) {
-				/* If gzread() returns -1, there was an error in archive */
-				ret = false;
-				break;
+	/**
+	 * Decompress a block of downloaded data.
+	 * @param data The compressed data.
+	 * @param length The amount of compressed data.
+	 * @param file The file to write the decompressed data to.
+	 * @return false when the data is corrupt or writing failed.
+	 */
+	bool Inflate(const char *data, size_t length, FILE *file)
+	{
+		uint8_t buff[16384];
+
+		this->z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+		this->z.avail_in = static_cast<uInt>(length);
+
+		while (this->z.avail_in != 0) {
+			/* Like gzread, continue with the next member when gzip streams are concatenated. */
+			if (this->finished) {
+				if (inflateReset(&this->z) != Z_OK) return false;
+				this->finished = false;
 			}
-			/* DO NOT DO THIS! It will fail to detect broken archive with 1.2.3.3!
-			 * if (read < sizeof(buff)) break; */
+
+			this->z.next_out = buff;
+			this->z.avail_out = sizeof(buff);
+
+			int r = inflate(&this->z, Z_NO_FLUSH);
+			if (r != Z_OK && r != Z_STREAM_END && r != Z_BUF_ERROR) return false;
+			if (r == Z_BUF_ERROR && this->z.avail_out == sizeof(buff)) return false;
+
+			size_t produced = sizeof(buff) - this->z.avail_out;
+			if (produced != 0 && fwrite(buff, 1, produced, file) != produced) return false;
+
+			if (r == Z_STREAM_END) this->finished = true;
 		}
+		return true;
 	}
+#else
+	bool finished = false; ///< Never set, content can not be downloaded without zlib.
 
-	if (fin != nullptr) {
-		gzclose(fin);
-	} else if (fdup != -1) {
-		/* Failing gzdopen does not close the passed file descriptor. */
-		close(fdup);
+	bool Inflate(const char *, size_t, FILE *)
+	{
+		NOT_REACHED();
 	}
-	if (fout != nullptr) fclose(fout);
-
-	return ret;
-#else
-	NOT_REACHED();
 #endif /* defined(WITH_ZLIB) */
-}
+};
 
 /**
- * Simple wrapper around fwrite to be able to pass it to Packet's TransferOut.
- * @param file   The file to write data to.
- * @param buffer The buffer to write to the file.
+ * Simple wrapper around WriteDownloadedData to be able to pass it to Packet's TransferOut.
+ * @param handler The handler to write the data with.
+ * @param buffer The buffer to write.
  * @param amount The number of bytes to write.
- * @return The number of bytes that were written.
+ * @return The number of bytes that were written, or -1 on failure.
  */
-static inline ssize_t TransferOutFWrite(FILE *file, const char *buffer, size_t amount)
+static inline ssize_t TransferOutDownloadedData(ClientNetworkContentSocketHandler *handler, const char *buffer, size_t amount)
 {
-	return fwrite(buffer, 1, amount, file);
+	return handler->WriteDownloadedData(buffer, amount) ? static_cast<ssize_t>(amount) : -1;
 }
 
 bool ClientNetworkContentSocketHandler::Receive_SERVER_CONTENT(Packet &p)
@@ -491,12 +488,13 @@ bool ClientNetworkContentSocketHandler::Receive_SERVER_CONTENT(Packet &p)
 	} else {
 		/* We have a file opened, thus are downloading internal content */
 		size_t toRead = p.RemainingBytesToTransfer();
-		if (toRead != 0 && static_cast<size_t>(p.TransferOut(TransferOutFWrite, this->curFile)) != toRead) {
+		if (toRead != 0 && static_cast<size_t>(p.TransferOut(TransferOutDownloadedData, this)) != toRead) {
 			CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_CONTENT_DOWNLOAD);
 			ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD, STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD_FILE_NOT_WRITABLE, WL_ERROR);
 			this->CloseConnection();
 			fclose(this->curFile);
 			this->curFile = nullptr;
+			this->inflater.reset();
 
 			return false;
 		}
@@ -522,18 +520,31 @@ bool ClientNetworkContentSocketHandler::BeforeDownload()
 	}
 
 	if (this->curInfo->filesize != 0) {
-		/* The filesize is > 0, so we are going to download it */
-		std::string filename = GetFullFilename(this->curInfo, true);
+		/* The filesize is > 0, so we are going to download it. It is decompressed
+		 * while it comes in, so only the tar itself ends up on disk. */
+		std::string filename = GetFullFilename(this->curInfo);
 		if (filename.empty() || (this->curFile = fopen(filename.c_str(), "wb")) == nullptr) {
 			/* Unless that fails of course... */
 			CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_CONTENT_DOWNLOAD);
 			ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD, STR_CONTENT_ERROR_COULD_NOT_DOWNLOAD_FILE_NOT_WRITABLE, WL_ERROR);
 			return false;
 		}
+		this->inflater = std::make_unique<ContentDownloadInflater>();
 	}
 	return true;
 }
 
+/**
+ * Decompress and write a block of the currently downloaded file.
+ * @param data The (compressed) data that got downloaded.
+ * @param length The amount of data.
+ * @return false when decompressing or writing failed.
+ */
+bool ClientNetworkContentSocketHandler::WriteDownloadedData(const char *data, size_t length)
+{
+	return this->inflater->Inflate(data, length, this->curFile);
+}
+
 /**
  * Handle the closing and extracting of a file after
  * downloading it has been done.
@@ -541,18 +552,17 @@ bool ClientNetworkContentSocketHandler::BeforeDownload()
 void ClientNetworkContentSocketHandler::AfterDownload()
 {
 	/* We read nothing; that's our marker for end-of-stream.
-	 * Now gunzip the tar and make it known. */
-	fclose(this->curFile);
+	 * The tar has been decompressed already, so make it known. */
+	bool complete = fclose(this->curFile) == 0 && this->inflater->finished;
 	this->curFile = nullptr;
+	this->inflater.reset();
 
-	if (GunzipFile(this->curInfo)) {
-		FioRemove(GetFullFilename(this->curInfo, true));
-
+	if (complete) {
 		Subdirectory sd = GetContentInfoSubDir(this->curInfo->type);
 		if (sd == NO_DIRECTORY) NOT_REACHED();
 
 		TarScanner ts;
-		std::string fname = GetFullFilename(this->curInfo, false);
+		std::string fname = GetFullFilename(this->curInfo);
 		ts.AddFile(sd, fname);
 
 		if (this->curInfo->type == CONTENT_TYPE_BASE_MUSIC) {
@@ -567,6 +577,8 @@ void ClientNetworkContentSocketHandler::AfterDownload()
 
 		this->OnDownloadComplete(this->curInfo->id);
 	} else {
+		/* Do not leave a truncated tar behind for the tar scanner to find. */
+		FioRemove(GetFullFilename(this->curInfo));
 		ShowErrorMessage(STR_CONTENT_ERROR_COULD_NOT_EXTRACT, INVALID_STRING_ID, WL_ERROR);
 	}
 }
@@ -588,6 +600,8 @@ void ClientNetworkContentSocketHandler::OnFailure()
 
 		fclose(this->curFile);
 		this->curFile = nullptr;
+		this->inflater.reset();
+		FioRemove(GetFullFilename(this->curInfo));
 	}
 
 	/* If we fail, download the rest via the 'old' system. */
@@ -622,8 +636,8 @@ void ClientNetworkContentSocketHandler::OnReceiveData(std::unique_ptr<char[]> da
 	}
 
 	if (data != nullptr) {
-		/* We have data, so write it to the file. */
-		if (fwrite(data.get(), 1, length, this->curFile) != length) {
+		/* We have data, so decompress it into the file. */
+		if (!this->WriteDownloadedData(data.get(), length)) {
 			/* Writing failed somehow, let try via the old method. */
 			this->OnFailure();
 		} else {
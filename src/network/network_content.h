@@ -61,6 +61,8 @@ struct ContentCallback {
 	virtual ~ContentCallback() = default;
 };
 
+struct ContentDownloadInflater;
+
 /**
  * Socket handler for the content server connection
  */
@@ -74,8 +76,9 @@ protected:
 	std::vector<char> http_response;              ///< The HTTP response to the requests we've been doing
 	int http_response_index;                      ///< Where we are, in the response, with handling it
 
-	FILE *curFile;        ///< Currently downloaded file
+	FILE *curFile;        ///< Currently downloaded file, already decompressed
 	ContentInfo *curInfo; ///< Information about the currently downloaded file
+	std::unique_ptr<ContentDownloadInflater> inflater; ///< Decompressor of the currently downloaded file
 	bool isConnecting;    ///< Whether we're connecting
 	bool isCancelled;     ///< Whether the download has been cancelled
 	std::chrono::steady_clock::time_point lastActivity;  ///< The last time there was network activity
@@ -112,6 +115,7 @@ public:
 
 	void Connect();
 	void SendReceive();
+	bool WriteDownloadedData(const char *data, size_t length);
 	NetworkRecvStatus CloseConnection(bool error = true) override;
 	void Cancel();
 
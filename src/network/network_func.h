@@ -11,7 +11,8 @@
 #define NETWORK_FUNC_H
 
 /**
- * Uncomment the following define to enable command replaying.
+ * Uncomment the following define to enable command replaying, or
+ * configure with -DOPTION_REPLAY_COMMANDS=ON which defines it for you.
  * See docs/desync.md for details.
  */
 // #define DEBUG_DUMP_COMMANDS
@@ -66,6 +67,7 @@ void NetworkOnGameStart();
 void NetworkServerSendConfigUpdate();
 void NetworkServerUpdateGameInfo();
 void NetworkServerShowStatusToConsole();
+bool NetworkServerIsIdle();
 bool NetworkServerStart();
 void NetworkServerNewCompany(const Company *company, NetworkClientInfo *ci);
 bool NetworkServerChangeClientName(ClientID client_id, const std::string &new_name);
@@ -35,7 +35,6 @@
 #include "../timer/timer_game_economy.h"
 #include "../timer/timer_game_realtime.h"
 #include <mutex>
-#include <condition_variable>
 
 #include "../safeguards.h"
 
@@ -63,54 +62,32 @@ static NetworkAuthenticationDefaultAuthorizedKeyHandler _authorized_key_handler(
 static NetworkAuthenticationDefaultAuthorizedKeyHandler _rcon_authorized_key_handler(_settings_client.network.rcon_authorized_keys); ///< Provides the authorized key validation for rcon.
 
 
-/** Writing a savegame directly to a number of packets. */
-struct PacketWriter : SaveFilter {
-	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
-	std::unique_ptr<Packet> current; ///< The packet we're currently writing to.
-	size_t total_size;                  ///< Total size of the compressed savegame.
-	std::deque<std::unique_ptr<Packet>> packets; ///< Packet queue of the savegame; send these "slowly" to the client. Cannot be a std::queue as we want to push the map size packet in front of the data packets.
-	std::mutex mutex;                   ///< Mutex for making threaded saving safe.
-	std::condition_variable exit_sig;   ///< Signal for threaded destruction of this packet writer.
+/** Maximum number of map packets handed to the send queue of a client at once. */
+static const uint MAP_PACKETS_PER_TRANSFER = 64;
 
-	/**
-	 * Create the packet writer.
-	 * @param cs The socket handler we're making the packets for.
-	 */
-	PacketWriter(ServerNetworkGameSocketHandler *cs) : SaveFilter(nullptr), cs(cs), total_size(0)
-	{
-	}
-
-	/** Make sure everything is cleaned up. */
-	~PacketWriter()
+/**
+ * Compressed savegame that is streamed to all clients that start downloading
+ * the map at the same moment. Every client keeps its own position in the
+ * savegame, and packets are only made when its socket can take more data.
+ */
+struct NetworkMapSnapshot : SaveFilter {
+	std::mutex mutex;          ///< Mutex for making threaded saving safe.
+	std::vector<uint8_t> data; ///< The compressed savegame written so far.
+	bool finished = false;     ///< Whether the whole savegame has been written.
+	bool cancelled = false;    ///< Whether none of the clients want the savegame anymore.
+
+	/** Create the snapshot. */
+	NetworkMapSnapshot() : SaveFilter(nullptr)
 	{
-		std::unique_lock<std::mutex> lock(this->mutex);
-
-		if (this->cs != nullptr) this->exit_sig.wait(lock);
-
-		/* This must all wait until the Destroy function is called. */
-
-		this->packets.clear();
-		this->current = nullptr;
 	}
 
-	/**
-	 * Begin the destruction of this packet writer. It can happen in two ways:
-	 * in the first case the client disconnected while saving the map. In this
-	 * case the saving has not finished and killed this PacketWriter. In that
-	 * case we simply set cs to nullptr, triggering the appending to fail due to
-	 * the connection problem and eventually triggering the destructor. In the
-	 * second case the destructor is already called, and it is waiting for our
-	 * signal which we will send. Only then the packets will be removed by the
-	 * destructor.
-	 */
-	void Destroy()
+	/** Stop making the savegame, as none of the clients want it anymore. */
+	void Cancel()
 	{
-		std::unique_lock<std::mutex> lock(this->mutex);
-
-		this->cs = nullptr;
-
-		this->exit_sig.notify_all();
-		lock.unlock();
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->cancelled = true;
+		}
 
 		/* Make sure the saving is completely cancelled. Yes,
 		 * we need to handle the save finish as well as the
@@ -119,23 +96,39 @@ struct PacketWriter : SaveFilter {
 	}
 
 	/**
-	 * Transfer all packets from here to the network's queue while holding
-	 * the lock on our mutex.
-	 * @return True iff the last packet of the map has been sent.
+	 * Queue the next part of the savegame in the packet queue of a client.
+	 * @param cs The client to send the savegame to.
+	 * @return True iff the last packet of the map has been queued.
 	 */
-	bool TransferToNetworkQueue()
+	bool TransferToNetworkQueue(ServerNetworkGameSocketHandler *cs)
 	{
-		/* Unsafe check for the queue being empty or not. */
-		if (this->packets.empty()) return false;
-
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		while (!this->packets.empty()) {
-			bool last_packet = this->packets.front()->GetPacketType() == PACKET_SERVER_MAP_DONE;
-			this->cs->SendPacket(std::move(this->packets.front()));
-			this->packets.pop_front();
+		if (this->finished && !cs->savegame_size_sent) {
+			/* Fast-track the size to the client. */
+			auto p = std::make_unique<Packet>(cs, PACKET_SERVER_MAP_SIZE);
+			p->Send_uint32((uint32_t)this->data.size());
+			cs->SendPacket(std::move(p));
+			cs->savegame_size_sent = true;
+		}
 
-			if (last_packet) return true;
+		for (uint i = 0; i < MAP_PACKETS_PER_TRANSFER; i++) {
+			size_t available = this->data.size() - cs->savegame_pos;
+			if (available == 0) {
+				if (!this->finished) return false;
+
+				/* Add a packet stating that this is the end to the queue. */
+				cs->SendPacket(std::make_unique<Packet>(cs, PACKET_SERVER_MAP_DONE));
+				return true;
+			}
+
+			/* Wait for enough data to fill a packet, unless it is the end of the savegame. */
+			if (!this->finished && available < TCP_MTU) return false;
+
+			auto p = std::make_unique<Packet>(cs, PACKET_SERVER_MAP_DATA, TCP_MTU);
+			std::span<const uint8_t> to_write(this->data.data() + cs->savegame_pos, available);
+			cs->savegame_pos += available - p->Send_bytes(to_write).size();
+			cs->SendPacket(std::move(p));
 		}
 
 		return false;
@@ -145,41 +138,20 @@ struct PacketWriter : SaveFilter {
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
-		if (this->current == nullptr) this->current = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DATA, TCP_MTU);
+		/* We want to abort the saving when all sockets are closed. */
+		if (this->cancelled) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
-		std::span<const uint8_t> to_write(buf, size);
-		while (!to_write.empty()) {
-			to_write = this->current->Send_bytes(to_write);
-
-			if (!this->current->CanWriteToPacket(1)) {
-				this->packets.push_back(std::move(this->current));
-				if (!to_write.empty()) this->current = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DATA, TCP_MTU);
-			}
-		}
-
-		this->total_size += size;
+		this->data.insert(this->data.end(), buf, buf + size);
 	}
 
 	void Finish() override
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
-		/* Make sure the last packet is flushed. */
-		if (this->current != nullptr) this->packets.push_back(std::move(this->current));
-
-		/* Add a packet stating that this is the end to the queue. */
-		this->packets.push_back(std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_DONE));
+		/* We want to abort the saving when all sockets are closed. */
+		if (this->cancelled) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
-		/* Fast-track the size to the client. */
-		auto p = std::make_unique<Packet>(this->cs, PACKET_SERVER_MAP_SIZE);
-		p->Send_uint32((uint32_t)this->total_size);
-		this->packets.push_front(std::move(p));
+		this->finished = true;
 	}
 };
 
@@ -212,14 +184,28 @@ ServerNetworkGameSocketHandler::~ServerNetworkGameSocketHandler()
 	if (_redirect_console_to_client == this->client_id) _redirect_console_to_client = INVALID_CLIENT_ID;
 	OrderBackup::ResetUser(this->client_id);
 
-	if (this->savegame != nullptr) {
-		this->savegame->Destroy();
-		this->savegame = nullptr;
-	}
+	this->ReleaseMapSnapshot();
 
 	InvalidateWindowData(WC_CLIENT_LIST, 0);
 }
 
+/**
+ * Stop using the savegame this client is downloading, and stop making the
+ * savegame when no other client is downloading it.
+ */
+void ServerNetworkGameSocketHandler::ReleaseMapSnapshot()
+{
+	if (this->savegame == nullptr) return;
+
+	bool shared = false;
+	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
+		if (cs != this && cs->savegame == this->savegame) shared = true;
+	}
+	if (!shared) this->savegame->Cancel();
+
+	this->savegame = nullptr;
+}
+
 std::unique_ptr<Packet> ServerNetworkGameSocketHandler::ReceivePacket()
 {
 	/* Only allow receiving when we have some buffer free; this value
@@ -262,9 +248,8 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::CloseConnection(NetworkRecvSta
 	/* If we were transfering a map to this client, stop the savegame creation
 	 * process and queue the next client to receive the map. */
 	if (this->status == STATUS_MAP) {
-		/* Ensure the saving of the game is stopped too. */
-		this->savegame->Destroy();
-		this->savegame = nullptr;
+		/* Ensure the saving of the game is stopped too, if nobody else needs it. */
+		this->ReleaseMapSnapshot();
 
 		this->CheckNextClientToSendMap(this);
 	}
@@ -522,33 +507,67 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendWait()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Start sending the map to the clients waiting for it, unless a map is still
+ * being sent. All waiting clients get the same savegame.
+ * @param ignore_cs Client to not send the map to, as it is leaving.
+ */
 void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocket *ignore_cs)
 {
 	Debug(net, 9, "client[{}] CheckNextClientToSendMap()", this->client_id);
 
-	/* Find the best candidate for joining, i.e. the first joiner. */
-	NetworkClientSocket *best = nullptr;
+	std::vector<NetworkClientSocket *> waiting;
+	bool transferring = false;
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
 		if (ignore_cs == new_cs) continue;
 
-		if (new_cs->status == STATUS_MAP_WAIT) {
-			if (best == nullptr || best->GetInfo()->join_date > new_cs->GetInfo()->join_date || (best->GetInfo()->join_date == new_cs->GetInfo()->join_date && best->client_id > new_cs->client_id)) {
-				best = new_cs;
-			}
-		}
+		/* Clients that get a savegame have to get it at the same time. */
+		if (new_cs->status == STATUS_MAP) transferring = true;
+		if (new_cs->status == STATUS_MAP_WAIT) waiting.push_back(new_cs);
+	}
+
+	if (transferring) {
+		/* The waiting clients have to wait for the others to finish; tell them where they are in the queue. */
+		for (NetworkClientSocket *new_cs : waiting) new_cs->SendWait();
+		return;
 	}
 
 	/* Is there someone else to join? */
-	if (best != nullptr) {
-		/* Let the first start joining. */
-		best->status = STATUS_AUTHORIZED;
-		best->SendMap();
+	if (waiting.empty()) return;
 
-		/* And update the rest. */
-		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-			if (new_cs->status == STATUS_MAP_WAIT) new_cs->SendWait();
-		}
-	}
+	WaitTillSaved();
+	auto snapshot = std::make_shared<NetworkMapSnapshot>();
+	for (NetworkClientSocket *new_cs : waiting) new_cs->BeginMapTransfer(snapshot);
+
+	/* Make a dump of the current game */
+	if (SaveWithFilter(snapshot, true) != SL_OK) UserError("network savedump failed");
+
+	for (NetworkClientSocket *new_cs : waiting) new_cs->SendMap();
+}
+
+/**
+ * Tell the client the map is coming, and start downloading the given savegame.
+ * @param snapshot The savegame to send to the client.
+ */
+void ServerNetworkGameSocketHandler::BeginMapTransfer(std::shared_ptr<NetworkMapSnapshot> snapshot)
+{
+	Debug(net, 9, "client[{}] SendMap(): first_packet", this->client_id);
+
+	this->savegame = snapshot;
+	this->savegame_pos = 0;
+	this->savegame_size_sent = false;
+
+	/* Now send the _frame_counter and how many packets are coming */
+	auto p = std::make_unique<Packet>(this, PACKET_SERVER_MAP_BEGIN);
+	p->Send_uint32(_frame_counter);
+	this->SendPacket(std::move(p));
+
+	NetworkSyncCommandQueue(this);
+	Debug(net, 9, "client[{}] status = MAP", this->client_id);
+	this->status = STATUS_MAP;
+	/* Mark the start of download */
+	this->last_frame = _frame_counter;
+	this->last_frame_server = _frame_counter;
 }
 
 /** This sends the map to the client */
@@ -560,35 +579,23 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 	}
 
 	if (this->status == STATUS_AUTHORIZED) {
-		Debug(net, 9, "client[{}] SendMap(): first_packet", this->client_id);
-
 		WaitTillSaved();
-		this->savegame = std::make_shared<PacketWriter>(this);
-
-		/* Now send the _frame_counter and how many packets are coming */
-		auto p = std::make_unique<Packet>(this, PACKET_SERVER_MAP_BEGIN);
-		p->Send_uint32(_frame_counter);
-		this->SendPacket(std::move(p));
-
-		NetworkSyncCommandQueue(this);
-		Debug(net, 9, "client[{}] status = MAP", this->client_id);
-		this->status = STATUS_MAP;
-		/* Mark the start of download */
-		this->last_frame = _frame_counter;
-		this->last_frame_server = _frame_counter;
+		auto snapshot = std::make_shared<NetworkMapSnapshot>();
+		this->BeginMapTransfer(snapshot);
 
 		/* Make a dump of the current game */
-		if (SaveWithFilter(this->savegame, true) != SL_OK) UserError("network savedump failed");
+		if (SaveWithFilter(snapshot, true) != SL_OK) UserError("network savedump failed");
 	}
 
-	if (this->status == STATUS_MAP) {
-		bool last_packet = this->savegame->TransferToNetworkQueue();
+	/* Only queue more of the map when the socket has sent everything it had,
+	 * so the savegame is not copied into the send queue of all clients at once. */
+	while (this->status == STATUS_MAP && !this->HasSendQueue()) {
+		bool last_packet = this->savegame->TransferToNetworkQueue(this);
 		if (last_packet) {
 			Debug(net, 9, "client[{}] SendMap(): last_packet", this->client_id);
 
 			/* Done reading, make sure saving is done as well */
-			this->savegame->Destroy();
-			this->savegame = nullptr;
+			this->ReleaseMapSnapshot();
 
 			/* Set the status to DONE_MAP, no we will wait for the client
 			 *  to send it is ready (maybe that happens like never ;)) */
@@ -596,7 +603,11 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 			this->status = STATUS_DONE_MAP;
 
 			this->CheckNextClientToSendMap();
+			break;
 		}
+
+		/* Nothing new to send yet, or the socket cannot take more right now. */
+		if (!this->HasSendQueue() || this->SendPackets() != SPS_ALL_SENT) break;
 	}
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -674,6 +685,32 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommand(const CommandPacke
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Send multiple DoCommands to the client, packed in as few packets as possible.
+ * @param queue The commands to send, in the order they have to be executed.
+ */
+NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommandBatch(const CommandQueue &queue)
+{
+	Debug(net, 9, "client[{}] SendCommandBatch(): count={}", this->client_id, queue.size());
+
+	/* Company, command, error message, buffer length, callback, frame and my_cmd. */
+	static const size_t COMMAND_RECORD_SIZE = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(bool);
+
+	std::unique_ptr<Packet> p;
+	for (const CommandPacket &cp : queue) {
+		size_t record_size = COMMAND_RECORD_SIZE + cp.data.size();
+		if (p != nullptr && !p->CanWriteToPacket(record_size)) this->SendPacket(std::move(p));
+		if (p == nullptr) p = std::make_unique<Packet>(this, PACKET_SERVER_COMMAND_BATCH, TCP_MTU);
+
+		this->NetworkGameSocketHandler::SendCommand(*p, cp);
+		p->Send_uint32(cp.frame);
+		p->Send_bool  (cp.my_cmd);
+	}
+	if (p != nullptr) this->SendPacket(std::move(p));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -1674,7 +1711,12 @@ bool NetworkServerChangeClientName(ClientID client_id, const std::string &new_na
  */
 static void NetworkHandleCommandQueue(NetworkClientSocket *cs)
 {
-	for (auto &cp : cs->outgoing_queue) cs->SendCommand(cp);
+	/* Dragging rail or road easily makes lots of commands at once, so pack those together. */
+	if (cs->outgoing_queue.size() > 1) {
+		cs->SendCommandBatch(cs->outgoing_queue);
+	} else {
+		for (auto &cp : cs->outgoing_queue) cs->SendCommand(cp);
+	}
 	cs->outgoing_queue.clear();
 }
 
@@ -1927,6 +1969,15 @@ const std::string &ServerNetworkGameSocketHandler::GetClientIP()
 	return this->client_address.GetHostname();
 }
 
+/**
+ * Check whether this is a dedicated server without any clients, i.e. nobody is watching the game.
+ * @return True iff no client is connected to this dedicated server.
+ */
+bool NetworkServerIsIdle()
+{
+	return _network_dedicated && NetworkClientSocket::GetNumItems() == 0;
+}
+
 /** Show the status message of all clients on the console. */
 void NetworkServerShowStatusToConsole()
 {
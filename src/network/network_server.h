@@ -71,7 +71,9 @@ public:
 	CommandQueue outgoing_queue; ///< The command-queue awaiting delivery; conceptually more a bucket to gather commands in, after which the whole bucket is sent to the client.
 	size_t receive_limit;        ///< Amount of bytes that we can receive at this moment
 
-	std::shared_ptr<struct PacketWriter> savegame; ///< Writer used to write the savegame.
+	std::shared_ptr<struct NetworkMapSnapshot> savegame; ///< Savegame the client is downloading.
+	size_t savegame_pos = 0;                       ///< Number of bytes of the savegame already queued for the client.
+	bool savegame_size_sent = false;               ///< Whether the client has been told the size of the savegame.
 	NetworkAddress client_address; ///< IP-address of the client (so they can be banned)
 
 	ServerNetworkGameSocketHandler(SOCKET s);
@@ -82,6 +84,8 @@ public:
 	std::string GetClientName() const;
 
 	void CheckNextClientToSendMap(NetworkClientSocket *ignore_cs = nullptr);
+	void BeginMapTransfer(std::shared_ptr<struct NetworkMapSnapshot> snapshot);
+	void ReleaseMapSnapshot();
 
 	NetworkRecvStatus SendWait();
 	NetworkRecvStatus SendMap();
@@ -100,6 +104,7 @@ public:
 	NetworkRecvStatus SendFrame();
 	NetworkRecvStatus SendSync();
 	NetworkRecvStatus SendCommand(const CommandPacket &cp);
+	NetworkRecvStatus SendCommandBatch(const CommandQueue &queue);
 	NetworkRecvStatus SendConfigUpdate();
 
 	static void Send();
@@ -45,6 +45,13 @@ enum ServerGameType : uint8_t {
 	SERVER_GAME_TYPE_INVITE_ONLY,
 };
 
+/** How a dedicated server runs the game while no clients are connected. */
+enum ServerIdleMode : uint8_t {
+	SERVER_IDLE_MODE_NORMAL = 0, ///< Run the game as if clients were connected.
+	SERVER_IDLE_MODE_FAST_FORWARD, ///< Run the game as fast as possible.
+	SERVER_IDLE_MODE_LOW_COST, ///< Run the game at a fraction of the normal speed.
+};
+
 /** 'Unique' identifier to be given to clients */
 enum ClientID : uint32_t {
 	INVALID_CLIENT_ID = 0, ///< Client is not part of anything
@@ -5233,6 +5233,9 @@ static void NewSpriteGroup(ByteReader &buf)
 				/* Continue reading var adjusts while bit 5 is set. */
 			} while (HasBit(varadjust, 5));
 
+			uint folded = group->FoldConstantAdjusts();
+			if (folded != 0) GrfMsg(9, "NewSpriteGroup: Precomputed {} constant adjustments of set {:02X}", folded, setid);
+
 			std::vector<DeterministicSpriteGroupRange> ranges;
 			ranges.resize(buf.ReadByte());
 			for (auto &range : ranges) {
@@ -10087,6 +10090,7 @@ void LoadNewGRF(uint load_index, uint num_baseset)
 
 		uint num_grfs = 0;
 		uint num_non_static = 0;
+		std::vector<SpriteFile *> files;
 
 		_cur.stage = stage;
 		for (GRFConfig *c = _grfconfig; c != nullptr; c = c->next) {
@@ -10115,7 +10119,9 @@ void LoadNewGRF(uint load_index, uint num_baseset)
 			num_grfs++;
 
 			LoadNewGRFFile(c, stage, subdir, false);
-			if (stage == GLS_RESERVE) {
+			if (stage == GLS_LABELSCAN) {
+				if (std::find(files.begin(), files.end(), _cur.file) == files.end()) files.push_back(_cur.file);
+			} else if (stage == GLS_RESERVE) {
 				SetBit(c->flags, GCF_RESERVED);
 			} else if (stage == GLS_ACTIVATION) {
 				ClrBit(c->flags, GCF_RESERVED);
@@ -10128,10 +10134,14 @@ void LoadNewGRF(uint load_index, uint num_baseset)
 				ClearTemporaryNewGRFData(_cur.grffile);
 			}
 		}
+
+		/* The sprite sections are needed in the init and activation stages; they are independent per file, so parse them all at once. */
+		if (stage == GLS_LABELSCAN) PrepareGRFSpriteOffsets(files);
 	}
 
 	/* Pseudo sprite processing is finished; free temporary stuff */
 	_cur.ClearDataForNextFile();
+	ClearPreparedGRFSpriteOffsets();
 
 	/* Call any functions that should be run after GRFs have been loaded. */
 	AfterLoadGRFs();
@@ -291,7 +291,7 @@ struct AirportTileAnimationBase : public AnimationBase<AirportTileAnimationBase,
 void AnimateAirportTile(TileIndex tile)
 {
 	const AirportTileSpec *ats = AirportTileSpec::GetByTile(tile);
-	if (ats == nullptr) return;
+	if (ats == nullptr || AirportTileAnimationBase::IsAnimationTickSkipped(ats)) return;
 
 	AirportTileAnimationBase::AnimateTile(ats, Station::GetByTile(tile), tile, HasBit(ats->animation_special_flags, 0));
 }
@@ -34,6 +34,18 @@ struct TileAnimationFrameAnimationHelper {
  */
 template <typename Tbase, typename Tspec, typename Tobj, typename Textra, uint16_t (*GetCallback)(CallbackID callback, uint32_t param1, uint32_t param2, const Tspec *statspec, Tobj *st, TileIndex tile, Textra extra_data), typename Tframehelper>
 struct AnimationBase {
+	/**
+	 * Check whether animating a tile of this specification would do nothing this tick,
+	 * without asking the NewGRF. Callers can skip looking up the tile's object then.
+	 * @param spec Specification related to the tile.
+	 * @return True iff the animation speed is fixed and this is not a tick on which the frame changes.
+	 */
+	static bool IsAnimationTickSkipped(const Tspec *spec)
+	{
+		if (HasBit(spec->callback_mask, Tbase::cbm_animation_speed)) return false;
+		return TimerGameTick::counter % (1ULL << spec->animation.speed) != 0;
+	}
+
 	/**
 	 * Animate a single tile.
 	 * @param spec        Specification related to the tile.
@@ -21,11 +21,15 @@
 #include "strings_func.h"
 #include "textfile_gui.h"
 #include "thread.h"
+#include "thread_pool.h"
 #include "newgrf_config.h"
 #include "newgrf_text.h"
 
 #include "fileio_func.h"
 #include "fios.h"
+#include "ini_type.h"
+
+#include <filesystem>
 
 #include "safeguards.h"
 
@@ -276,13 +280,167 @@ size_t GRFGetSizeOfDataSection(FILE *f)
 	return SIZE_MAX;
 }
 
+std::string _newgrf_md5_file; ///< File with the MD5 sums of the NewGRFs and base set files calculated during earlier scans.
+
+/** MD5 sum of a NewGRF or base set file, valid as long as the size and the modification time of the file do not change. */
+struct GRFMD5CacheEntry {
+	uintmax_t size;     ///< Size of the file.
+	int64_t write_time; ///< Modification time of the file.
+	MD5Hash md5sum;     ///< MD5 sum of the file.
+	bool used;          ///< Whether the entry was used since the cache was loaded.
+};
+
+static std::map<std::string, GRFMD5CacheEntry> _grf_md5_cache; ///< Cached MD5 sums, by full path of the file.
+static bool _grf_md5_cache_loaded = false;  ///< Whether the cache has been read from disk.
+static bool _grf_md5_cache_changed = false; ///< Whether the cache needs to be written to disk.
+static std::mutex _grf_md5_cache_mutex;     ///< Lock for the cache, as the NewGRF scan and the base set checks can run in different threads.
+
 /**
- * Calculate the MD5 sum for a GRF, and store it in the config.
- * @param config GRF to compute.
+ * Get the size and the modification time of a file.
+ * @param path The full path to the file.
+ * @param[out] size The size of the file.
+ * @param[out] write_time The modification time of the file.
+ * @return False if the file could not be found.
+ */
+static bool GetFileStamp(const std::string &path, uintmax_t &size, int64_t &write_time)
+{
+	std::error_code error_code;
+	size = std::filesystem::file_size(OTTD2FS(path), error_code);
+	if (error_code) return false;
+	auto time = std::filesystem::last_write_time(OTTD2FS(path), error_code);
+	if (error_code) return false;
+	write_time = time.time_since_epoch().count();
+	return true;
+}
+
+/** Load the MD5 sums of the previous scans, unless that already happened. */
+static void LoadGRFMD5Cache()
+{
+	std::lock_guard<std::mutex> lock(_grf_md5_cache_mutex);
+	if (_grf_md5_cache_loaded || _newgrf_md5_file.empty()) return;
+	_grf_md5_cache_loaded = true;
+
+	IniFile ini;
+	ini.LoadFromDisk(_newgrf_md5_file, NO_DIRECTORY);
+
+	const IniGroup *group = ini.GetGroup("md5sums");
+	if (group == nullptr) return;
+
+	for (const IniItem &item : group->items) {
+		if (!item.value.has_value()) continue;
+
+		/* The value is "<size>,<modification time>,<md5sum>". */
+		const std::string &value = *item.value;
+		size_t first = value.find(',');
+		size_t second = value.find(',', first == std::string::npos ? first : first + 1);
+		if (second == std::string::npos) continue;
+
+		GRFMD5CacheEntry entry{};
+		entry.size = std::strtoull(value.c_str(), nullptr, 10);
+		entry.write_time = std::strtoll(value.c_str() + first + 1, nullptr, 10);
+		if (!ConvertHexToBytes(std::string_view(value).substr(second + 1), entry.md5sum)) continue;
+		_grf_md5_cache[item.name] = entry;
+	}
+}
+
+/** Write the MD5 sums that were used during the scan to disk, so later scans can skip calculating them. */
+static void SaveGRFMD5Cache()
+{
+	std::lock_guard<std::mutex> lock(_grf_md5_cache_mutex);
+
+	/* Forget about files that were not seen during the scan and are gone or changed.
+	 * Files that were not seen but did not change, like those of the base sets, are kept. */
+	for (auto it = _grf_md5_cache.begin(); it != _grf_md5_cache.end(); /* nothing */) {
+		uintmax_t file_size;
+		int64_t write_time;
+		if (it->second.used || (GetFileStamp(it->first, file_size, write_time) && file_size == it->second.size && write_time == it->second.write_time)) {
+			it->second.used = false;
+			++it;
+		} else {
+			it = _grf_md5_cache.erase(it);
+			_grf_md5_cache_changed = true;
+		}
+	}
+
+	if (!_grf_md5_cache_changed || _newgrf_md5_file.empty()) return;
+
+	IniFile ini;
+	IniGroup &group = ini.GetOrCreateGroup("md5sums");
+	for (const auto &[path, entry] : _grf_md5_cache) {
+		group.GetOrCreateItem(path).SetValue(fmt::format("{},{},{}", entry.size, entry.write_time, FormatArrayAsHex(entry.md5sum)));
+	}
+
+	if (ini.SaveToDisk(_newgrf_md5_file)) _grf_md5_cache_changed = false;
+}
+
+/**
+ * Get the size and the modification time of a file in one of the search paths.
+ * @param filename The name of the file.
  * @param subdir The subdirectory to look in.
+ * @param[out] path The full path to the file.
+ * @param[out] size The size of the file.
+ * @param[out] write_time The modification time of the file.
+ * @return False if the file is not a plain file, e.g. when it is inside a tar.
+ */
+static bool GetFileStamp(const std::string &filename, Subdirectory subdir, std::string &path, uintmax_t &size, int64_t &write_time)
+{
+	path = FioFindFullPath(subdir, filename);
+	if (path.empty()) return false;
+	return GetFileStamp(path, size, write_time);
+}
+
+/**
+ * Get the MD5 sum of a file calculated during an earlier scan, if the file did not change since.
+ * @param filename The name of the file.
+ * @param subdir The subdirectory to look in.
+ * @param[out] md5sum The MD5 sum.
+ * @return True iff the MD5 sum was found.
+ */
+bool GetCachedMD5Sum(const std::string &filename, Subdirectory subdir, MD5Hash &md5sum)
+{
+	LoadGRFMD5Cache();
+
+	std::string path;
+	uintmax_t file_size;
+	int64_t write_time;
+	if (!GetFileStamp(filename, subdir, path, file_size, write_time)) return false;
+
+	std::lock_guard<std::mutex> lock(_grf_md5_cache_mutex);
+	auto it = _grf_md5_cache.find(path);
+	if (it == _grf_md5_cache.end() || it->second.size != file_size || it->second.write_time != write_time) return false;
+
+	it->second.used = true;
+	md5sum = it->second.md5sum;
+	return true;
+}
+
+/**
+ * Remember the MD5 sum of a file, so later scans do not have to calculate it again.
+ * @param filename The name of the file.
+ * @param subdir The subdirectory to look in.
+ * @param md5sum The MD5 sum.
+ */
+void CacheMD5Sum(const std::string &filename, Subdirectory subdir, const MD5Hash &md5sum)
+{
+	std::string path;
+	uintmax_t file_size;
+	int64_t write_time;
+	if (!GetFileStamp(filename, subdir, path, file_size, write_time)) return;
+
+	std::lock_guard<std::mutex> lock(_grf_md5_cache_mutex);
+	_grf_md5_cache[path] = { file_size, write_time, md5sum, true };
+	_grf_md5_cache_changed = true;
+}
+
+/**
+ * Calculate the MD5 sum of the data section of a GRF file.
+ * This only reads the file, so it can be done for multiple files at the same time.
+ * @param filename The name of the GRF file.
+ * @param subdir The subdirectory to look in.
+ * @param[out] md5sum The MD5 sum.
  * @return MD5 sum was successfully computed
  */
-static bool CalcGRFMD5Sum(GRFConfig *config, Subdirectory subdir)
+static bool HashGRFFile(const std::string &filename, Subdirectory subdir, MD5Hash &md5sum)
 {
 	FILE *f;
 	Md5 checksum;
@@ -290,7 +448,7 @@ static bool CalcGRFMD5Sum(GRFConfig *config, Subdirectory subdir)
 	size_t len, size;
 
 	/* open the file */
-	f = FioFOpenFile(config->filename, "rb", subdir, &size);
+	f = FioFOpenFile(filename, "rb", subdir, &size);
 	if (f == nullptr) return false;
 
 	long start = ftell(f);
@@ -306,22 +464,39 @@ static bool CalcGRFMD5Sum(GRFConfig *config, Subdirectory subdir)
 		size -= len;
 		checksum.Append(buffer, len);
 	}
-	checksum.Finish(config->ident.md5sum);
+	checksum.Finish(md5sum);
 
 	FioFCloseFile(f);
 
 	return true;
 }
 
+/**
+ * Calculate the MD5 sum for a GRF, and store it in the config.
+ * @param config GRF to compute.
+ * @param subdir The subdirectory to look in.
+ * @return MD5 sum was successfully computed
+ */
+static bool CalcGRFMD5Sum(GRFConfig *config, Subdirectory subdir)
+{
+	/* Reading the whole file is the most expensive part of scanning, so reuse the result of an earlier scan when the file did not change. */
+	if (GetCachedMD5Sum(config->filename, subdir, config->ident.md5sum)) return true;
+
+	if (!HashGRFFile(config->filename, subdir, config->ident.md5sum)) return false;
+
+	CacheMD5Sum(config->filename, subdir, config->ident.md5sum);
+	return true;
+}
+
 
 /**
- * Find the GRFID of a given grf, and calculate its md5sum.
+ * Find the GRFID and the other Action 8 information of a given grf.
  * @param config    grf to fill.
  * @param is_static grf is static.
  * @param subdir    the subdirectory to search in.
  * @return Operation was successfully completed.
  */
-bool FillGRFDetails(GRFConfig *config, bool is_static, Subdirectory subdir)
+static bool ReadGRFDetails(GRFConfig *config, bool is_static, Subdirectory subdir)
 {
 	if (!FioCheckFileExists(config->filename, subdir)) {
 		config->status = GCS_NOT_FOUND;
@@ -344,7 +519,19 @@ bool FillGRFDetails(GRFConfig *config, bool is_static, Subdirectory subdir)
 		if (HasBit(config->flags, GCF_UNSAFE)) return false;
 	}
 
-	return CalcGRFMD5Sum(config, subdir);
+	return true;
+}
+
+/**
+ * Find the GRFID of a given grf, and calculate its md5sum.
+ * @param config    grf to fill.
+ * @param is_static grf is static.
+ * @param subdir    the subdirectory to search in.
+ * @return Operation was successfully completed.
+ */
+bool FillGRFDetails(GRFConfig *config, bool is_static, Subdirectory subdir)
+{
+	return ReadGRFDetails(config, is_static, subdir) && CalcGRFMD5Sum(config, subdir);
 }
 
 
@@ -528,6 +715,11 @@ int _skip_all_newgrf_scanning = 0;
 class GRFFileScanner : FileScanner {
 	std::chrono::steady_clock::time_point next_update; ///< The next moment we do update the screen.
 	uint num_scanned; ///< The number of GRFs we have scanned.
+	uint num_added = 0; ///< The number of GRFs added to the list of all GRFs.
+	std::vector<GRFConfig *> found; ///< GRFs of which the details are read, but the MD5 sum is not calculated yet.
+
+	bool Finish();
+	bool AddToList(GRFConfig *c);
 
 public:
 	GRFFileScanner() : num_scanned(0)
@@ -546,11 +738,11 @@ public:
 		}
 
 		GRFFileScanner fs;
-		int ret = fs.Scan(".grf", NEWGRF_DIR);
+		fs.Scan(".grf", NEWGRF_DIR);
 		/* The number scanned and the number returned may not be the same;
 		 * duplicate NewGRFs and base sets are ignored in the return value. */
 		_settings_client.gui.last_newgrf_count = fs.num_scanned;
-		return ret;
+		return fs.Finish() ? fs.num_added : 0;
 	}
 };
 
@@ -561,34 +753,8 @@ bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length
 
 	GRFConfig *c = new GRFConfig(filename.c_str() + basepath_length);
 
-	bool added = true;
-	if (FillGRFDetails(c, false)) {
-		if (_all_grfs == nullptr) {
-			_all_grfs = c;
-		} else {
-			/* Insert file into list at a position determined by its
-			 * name, so the list is sorted as we go along */
-			GRFConfig **pd, *d;
-			bool stop = false;
-			for (pd = &_all_grfs; (d = *pd) != nullptr; pd = &d->next) {
-				if (c->ident.grfid == d->ident.grfid && c->ident.md5sum == d->ident.md5sum) added = false;
-				/* Because there can be multiple grfs with the same name, make sure we checked all grfs with the same name,
-				 *  before inserting the entry. So insert a new grf at the end of all grfs with the same name, instead of
-				 *  just after the first with the same name. Avoids doubles in the list. */
-				if (StrCompareIgnoreCase(c->GetName(), d->GetName()) <= 0) {
-					stop = true;
-				} else if (stop) {
-					break;
-				}
-			}
-			if (added) {
-				c->next = d;
-				*pd = c;
-			}
-		}
-	} else {
-		added = false;
-	}
+	/* Reading the details uses the global NewGRF loading state, so it is done one file at a time. */
+	bool found = ReadGRFDetails(c, false, NEWGRF_DIR);
 
 	this->num_scanned++;
 
@@ -598,12 +764,98 @@ bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length
 	UpdateNewGRFScanStatus(this->num_scanned, name);
 	VideoDriver::GetInstance()->GameLoopPause();
 
-	if (!added) {
+	if (!found) {
 		/* File couldn't be opened, or is either not a NewGRF or is a
-		 * 'system' NewGRF or it's already known, so forget about it. */
+		 * 'system' NewGRF, so forget about it. */
 		delete c;
+		return false;
 	}
 
+	this->found.push_back(c);
+	return true;
+}
+
+/**
+ * Calculate the MD5 sums of all found GRFs, and add them to the list of all GRFs.
+ * Files that are not in the MD5 cache are hashed in parallel, a batch at a time so the progress can be shown.
+ * @return False if the scan was aborted because the game is closing.
+ */
+bool GRFFileScanner::Finish()
+{
+	std::vector<GRFConfig *> to_hash;
+	for (GRFConfig *c : this->found) {
+		if (!GetCachedMD5Sum(c->filename, NEWGRF_DIR, c->ident.md5sum)) to_hash.push_back(c);
+	}
+
+	std::vector<uint8_t> hashed(to_hash.size(), false);
+	const size_t batch_size = std::max<size_t>(1, ThreadPool::GetConcurrency()) * 4;
+	for (size_t batch = 0; batch < to_hash.size(); batch += batch_size) {
+		if (_exit_game) break;
+
+		size_t count = std::min(batch_size, to_hash.size() - batch);
+		ThreadPool::ParallelFor(count, 1, [&](size_t begin, size_t end) {
+			for (size_t i = batch + begin; i < batch + end; i++) {
+				hashed[i] = HashGRFFile(to_hash[i]->filename, NEWGRF_DIR, to_hash[i]->ident.md5sum);
+			}
+		});
+
+		UpdateNewGRFScanStatus(this->num_scanned, to_hash[batch + count - 1]->filename.c_str());
+		VideoDriver::GetInstance()->GameLoopPause();
+	}
+
+	for (size_t i = 0; i < to_hash.size(); i++) {
+		if (hashed[i]) {
+			CacheMD5Sum(to_hash[i]->filename, NEWGRF_DIR, to_hash[i]->ident.md5sum);
+		} else {
+			to_hash[i]->status = GCS_NOT_FOUND;
+		}
+	}
+
+	bool complete = !_exit_game;
+	for (GRFConfig *c : this->found) {
+		if (complete && c->status != GCS_NOT_FOUND && this->AddToList(c)) {
+			this->num_added++;
+		} else {
+			delete c;
+		}
+	}
+	this->found.clear();
+
+	return complete;
+}
+
+/**
+ * Add a GRF to the list of all GRFs, unless it is already known.
+ * @param c The GRF to add.
+ * @return True iff the GRF was added.
+ */
+bool GRFFileScanner::AddToList(GRFConfig *c)
+{
+	if (_all_grfs == nullptr) {
+		_all_grfs = c;
+		return true;
+	}
+
+	/* Insert file into list at a position determined by its
+	 * name, so the list is sorted as we go along */
+	GRFConfig **pd, *d;
+	bool stop = false;
+	bool added = true;
+	for (pd = &_all_grfs; (d = *pd) != nullptr; pd = &d->next) {
+		if (c->ident.grfid == d->ident.grfid && c->ident.md5sum == d->ident.md5sum) added = false;
+		/* Because there can be multiple grfs with the same name, make sure we checked all grfs with the same name,
+		 *  before inserting the entry. So insert a new grf at the end of all grfs with the same name, instead of
+		 *  just after the first with the same name. Avoids doubles in the list. */
+		if (StrCompareIgnoreCase(c->GetName(), d->GetName()) <= 0) {
+			stop = true;
+		} else if (stop) {
+			break;
+		}
+	}
+	if (added) {
+		c->next = d;
+		*pd = c;
+	}
 	return added;
 }
 
@@ -628,7 +880,10 @@ void DoScanNewGRFFiles(NewGRFScanCallback *callback)
 	TarScanner::DoScan(TarScanner::NEWGRF);
 
 	Debug(grf, 1, "Scanning for NewGRFs");
+	LoadGRFMD5Cache();
 	uint num = GRFFileScanner::DoScan();
+	/* Only a complete scan tells which files are gone. */
+	if (num != 0 && !_exit_game) SaveGRFMD5Cache();
 
 	Debug(grf, 1, "Scan complete, found {} files", num);
 	if (num != 0 && _all_grfs != nullptr) {
@@ -211,6 +211,8 @@ struct NewGRFScanCallback {
 };
 
 size_t GRFGetSizeOfDataSection(FILE *f);
+bool GetCachedMD5Sum(const std::string &filename, Subdirectory subdir, MD5Hash &md5sum);
+void CacheMD5Sum(const std::string &filename, Subdirectory subdir, const MD5Hash &md5sum);
 
 void ScanNewGRFFiles(NewGRFScanCallback *callback);
 const GRFConfig *FindGRFConfig(uint32_t grfid, FindGRFConfigMode mode, const MD5Hash *md5sum = nullptr, uint32_t desired_version = 0);
@@ -595,7 +595,7 @@ struct HouseAnimationBase : public AnimationBase<HouseAnimationBase, HouseSpec,
 void AnimateNewHouseTile(TileIndex tile)
 {
 	const HouseSpec *hs = HouseSpec::Get(GetHouseType(tile));
-	if (hs == nullptr) return;
+	if (hs == nullptr || HouseAnimationBase::IsAnimationTickSkipped(hs)) return;
 
 	HouseAnimationBase::AnimateTile(hs, Town::GetByTile(tile), tile, HasBit(hs->extra_flags, CALLBACK_1A_RANDOM_BITS));
 }
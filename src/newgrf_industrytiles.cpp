@@ -268,7 +268,7 @@ struct IndustryAnimationBase : public AnimationBase<IndustryAnimationBase, Indus
 void AnimateNewIndustryTile(TileIndex tile)
 {
 	const IndustryTileSpec *itspec = GetIndustryTileSpec(GetIndustryGfx(tile));
-	if (itspec == nullptr) return;
+	if (itspec == nullptr || IndustryAnimationBase::IsAnimationTickSkipped(itspec)) return;
 
 	IndustryAnimationBase::AnimateTile(itspec, Industry::GetByTile(tile), tile, (itspec->special_flags & INDTILE_SPECIAL_NEXTFRAME_RANDOMBITS) != 0);
 }
@@ -20,6 +20,10 @@
 
 
 std::vector<NewGRFProfiler> _newgrf_profilers;
+bool _newgrf_aggregate_profiling = false; ///< Whether the aggregating profiler is collecting data.
+
+/** Aggregated resolves, by GRFID in the upper 32 bits, feature in bits 16..23 and callback in the lower 16 bits. */
+static std::unordered_map<uint64_t, NewGRFAggregateProfiler::Entry> _newgrf_aggregates;
 
 
 /**
@@ -177,3 +181,94 @@ static TimeoutTimer<TimerGameTick> _profiling_finish_timeout({ TimerGameTick::Pr
 {
 	_profiling_finish_timeout.Abort();
 }
+
+
+/**
+ * Account a top-level sprite group resolution to the aggregates.
+ * @param resolver Data about the sprite group that was resolved.
+ * @param time Time the resolution took.
+ */
+/* static */ void NewGRFAggregateProfiler::Add(const ResolverObject &resolver, std::chrono::nanoseconds time)
+{
+	if (resolver.grffile == nullptr) return;
+
+	uint64_t key = static_cast<uint64_t>(resolver.grffile->grfid) << 32 | static_cast<uint64_t>(resolver.GetFeature()) << 16 | resolver.callback;
+	Entry &entry = _newgrf_aggregates[key];
+
+	uint64_t ns = time.count();
+	entry.calls++;
+	entry.nanoseconds += ns;
+
+	uint64_t us = ns / 1000;
+	size_t bucket = 0;
+	while (bucket < HISTOGRAM_BOUNDS.size() && us >= HISTOGRAM_BOUNDS[bucket]) bucket++;
+	entry.histogram[bucket]++;
+}
+
+/** Discard all aggregated data. */
+/* static */ void NewGRFAggregateProfiler::Reset()
+{
+	_newgrf_aggregates.clear();
+}
+
+/**
+ * Print the GRFs and the callbacks that took the most time to the console.
+ * @param count Maximum number of GRFs and of callbacks to print.
+ */
+/* static */ void NewGRFAggregateProfiler::Print(size_t count)
+{
+	extern const std::vector<GRFFile *> &GetAllGRFFiles();
+
+	if (_newgrf_aggregates.empty()) {
+		IConsolePrint(CC_INFO, "No NewGRF resolves have been aggregated.");
+		return;
+	}
+
+	auto by_time = [](const auto &a, const auto &b) { return a.second.nanoseconds > b.second.nanoseconds; };
+	auto filename = [](uint32_t grfid) -> std::string_view {
+		for (const GRFFile *grf : GetAllGRFFiles()) {
+			if (grf->grfid == grfid) return grf->filename;
+		}
+		return "(not loaded)";
+	};
+
+	std::unordered_map<uint32_t, Entry> grf_totals;
+	uint64_t total_calls = 0;
+	uint64_t total_ns = 0;
+	for (const auto &[key, entry] : _newgrf_aggregates) {
+		Entry &total = grf_totals[static_cast<uint32_t>(key >> 32)];
+		total.calls += entry.calls;
+		total.nanoseconds += entry.nanoseconds;
+		for (size_t i = 0; i < entry.histogram.size(); i++) total.histogram[i] += entry.histogram[i];
+		total_calls += entry.calls;
+		total_ns += entry.nanoseconds;
+	}
+
+	auto histogram = [](const Entry &entry) {
+		std::string result;
+		for (uint64_t n : entry.histogram) {
+			if (!result.empty()) result += '/';
+			fmt::format_to(std::back_inserter(result), "{}", n);
+		}
+		return result;
+	};
+
+	IConsolePrint(CC_INFO, "{} resolves taking {} us in total. Histogram buckets: <1/<4/<16/<64/<256/more us.", total_calls, total_ns / 1000);
+
+	std::vector<std::pair<uint32_t, Entry>> grfs(grf_totals.begin(), grf_totals.end());
+	std::sort(grfs.begin(), grfs.end(), by_time);
+	if (grfs.size() > count) grfs.resize(count);
+	IConsolePrint(CC_INFO, "GRFs taking the most time:");
+	for (const auto &[grfid, entry] : grfs) {
+		IConsolePrint(CC_INFO, "  [{:08X}] {}: {} calls, {} us, {} ns avg, hist {}", BSWAP32(grfid), filename(grfid), entry.calls, entry.nanoseconds / 1000, entry.nanoseconds / entry.calls, histogram(entry));
+	}
+
+	std::vector<std::pair<uint64_t, Entry>> callbacks(_newgrf_aggregates.begin(), _newgrf_aggregates.end());
+	std::sort(callbacks.begin(), callbacks.end(), by_time);
+	if (callbacks.size() > count) callbacks.resize(count);
+	IConsolePrint(CC_INFO, "Callbacks taking the most time:");
+	for (const auto &[key, entry] : callbacks) {
+		uint32_t grfid = static_cast<uint32_t>(key >> 32);
+		IConsolePrint(CC_INFO, "  [{:08X}] feature 0x{:02X}, callback 0x{:04X}: {} calls, {} us, {} ns avg, hist {}", BSWAP32(grfid), GB(key, 16, 8), GB(key, 0, 16), entry.calls, entry.nanoseconds / 1000, entry.nanoseconds / entry.calls, histogram(entry));
+	}
+}
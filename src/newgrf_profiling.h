@@ -16,6 +16,8 @@
 #include "newgrf_callbacks.h"
 #include "newgrf_spritegroup.h"
 
+#include <chrono>
+
 
 /**
  * Callback profiler for NewGRF development
@@ -58,4 +60,27 @@ struct NewGRFProfiler {
 
 extern std::vector<NewGRFProfiler> _newgrf_profilers;
 
+/**
+ * Aggregating callback profiler. Instead of recording every resolve it only
+ * counts them and the time spent in them, per GRF, feature and callback.
+ * That is cheap enough to leave running on a server for a long time.
+ */
+struct NewGRFAggregateProfiler {
+	/** Upper bounds, in microseconds, of the buckets of the time histogram; the last bucket has no upper bound. */
+	static constexpr std::array<uint32_t, 5> HISTOGRAM_BOUNDS = { 1, 4, 16, 64, 256 };
+
+	/** Aggregated resolves of one callback of one feature of one GRF. */
+	struct Entry {
+		uint64_t calls = 0;       ///< Number of top-level resolves.
+		uint64_t nanoseconds = 0; ///< Cumulative time spent in the resolves.
+		std::array<uint64_t, HISTOGRAM_BOUNDS.size() + 1> histogram{}; ///< Number of resolves per time bucket.
+	};
+
+	static void Add(const ResolverObject &resolver, std::chrono::nanoseconds time);
+	static void Reset();
+	static void Print(size_t count);
+};
+
+extern bool _newgrf_aggregate_profiling;
+
 #endif /* NEWGRF_PROFILING_H */
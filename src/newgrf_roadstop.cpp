@@ -359,7 +359,7 @@ struct RoadStopAnimationBase : public AnimationBase<RoadStopAnimationBase, RoadS
 void AnimateRoadStopTile(TileIndex tile)
 {
 	const RoadStopSpec *ss = GetRoadStopSpec(tile);
-	if (ss == nullptr) return;
+	if (ss == nullptr || RoadStopAnimationBase::IsAnimationTickSkipped(ss)) return;
 
 	RoadStopAnimationBase::AnimateTile(ss, BaseStation::GetByTile(tile), tile, HasBit(ss->flags, RSF_CB141_RANDOM_BITS));
 }
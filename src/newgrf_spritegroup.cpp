@@ -11,6 +11,7 @@
 #include "debug.h"
 #include "newgrf_spritegroup.h"
 #include "newgrf_profiling.h"
+#include "trace.h"
 #include "core/pool_func.hpp"
 
 #include "safeguards.h"
@@ -35,15 +36,27 @@ TemporaryStorageArray<int32_t, 0x110> _temp_store;
 {
 	if (group == nullptr) return nullptr;
 
+	/* Only trace the outermost resolve, the nested ones are part of it. */
+	TraceZone trace(top_level ? "NewGRF resolve" : nullptr);
+
 	const GRFFile *grf = object.grffile;
 	auto profiler = std::find_if(_newgrf_profilers.begin(), _newgrf_profilers.end(), [&](const NewGRFProfiler &pr) { return pr.grffile == grf; });
 
 	if (profiler == _newgrf_profilers.end() || !profiler->active) {
-		if (top_level) _temp_store.ClearChanges();
-		return group->Resolve(object);
+		if (!top_level) return group->Resolve(object);
+
+		_temp_store.ClearChanges();
+		object.InvalidateVariableCache();
+		if (!_newgrf_aggregate_profiling) return group->Resolve(object);
+
+		auto start = std::chrono::steady_clock::now();
+		const SpriteGroup *result = group->Resolve(object);
+		NewGRFAggregateProfiler::Add(object, std::chrono::steady_clock::now() - start);
+		return result;
 	} else if (top_level) {
 		profiler->BeginResolve(object);
 		_temp_store.ClearChanges();
+		object.InvalidateVariableCache();
 		const SpriteGroup *result = group->Resolve(object);
 		profiler->EndResolve(result);
 		return result;
@@ -78,6 +91,41 @@ static inline uint32_t GetVariable(const ResolverObject &object, ScopeResolver *
 	}
 }
 
+/**
+ * Get a variable, reusing its value when it has already been read during the current resolve.
+ * Deep chains of deterministic groups often read the same feature variables over and over.
+ * Those only depend on the game state, which does not change while resolving, and on the
+ * registers. Writes to the registers invalidate the cache, as do nested resolves, which
+ * reset the temporary storage.
+ * @param object The object being resolved.
+ * @param scope The scope to read the variable in.
+ * @param cacheable Whether the scope is the same object throughout the resolve.
+ * @param variable The variable to read.
+ * @param parameter The parameter of the variable.
+ * @param[in,out] available Set to false when the variable is not available.
+ * @return The value of the variable.
+ */
+static inline uint32_t GetVariableCached(ResolverObject &object, ScopeResolver *scope, bool cacheable, uint8_t variable, uint32_t parameter, bool &available)
+{
+	/* Global variables, callback parameters, registers and GRF parameters are cheap enough to get. */
+	if (!cacheable || variable < 0x40 || variable > 0x7C) return GetVariable(object, scope, variable, parameter, available);
+
+	if (object.variable_cache_storage_key != _temp_store.init_key) {
+		object.variable_cache_storage_key = _temp_store.init_key;
+		object.InvalidateVariableCache();
+	}
+
+	ResolverObject::CachedVariable &entry = object.variable_cache[(variable ^ parameter) % object.variable_cache.size()];
+	if (entry.key == object.variable_cache_key && entry.scope == scope && entry.variable == variable && entry.parameter == parameter) {
+		available = entry.available;
+		return entry.value;
+	}
+
+	uint32_t value = GetVariable(object, scope, variable, parameter, available);
+	entry = {scope, object.variable_cache_key, parameter, value, variable, available};
+	return value;
+}
+
 /**
  * Get a few random bits. Default implementation has no random bits.
  * @return Random bits.
@@ -137,10 +185,10 @@ static inline uint32_t GetVariable(const ResolverObject &object, ScopeResolver *
 	return &this->default_scope;
 }
 
-/* Evaluate an adjustment for a variable of the given size.
+/* Shift, mask and divide the value of a variable as an adjustment of the given size says.
  * U is the unsigned type and S is the signed type to use. */
 template <typename U, typename S>
-static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, U last_value, uint32_t value)
+static uint32_t AdjustValueT(const DeterministicSpriteGroupAdjust &adjust, uint32_t value)
 {
 	value >>= adjust.shift_num;
 	value  &= adjust.and_mask;
@@ -151,6 +199,16 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 		case DSGA_TYPE_NONE: break;
 	}
 
+	return value;
+}
+
+/* Evaluate an adjustment for a variable of the given size.
+ * U is the unsigned type and S is the signed type to use. */
+template <typename U, typename S>
+static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, U last_value, uint32_t value)
+{
+	value = AdjustValueT<U, S>(adjust, value);
+
 	switch (adjust.operation) {
 		case DSGA_OP_ADD:  return last_value + value;
 		case DSGA_OP_SUB:  return last_value - value;
@@ -180,6 +238,40 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 }
 
 
+/**
+ * Precompute the adjustments of constants, i.e. of variable 1A which is always -1.
+ * NewGRF compilers use those for every literal in an expression, so this saves
+ * shifting, masking and dividing them every time the group is resolved. The
+ * adjustment is rewritten so it yields the precomputed value as is.
+ * @return The number of adjustments that were changed.
+ */
+uint DeterministicSpriteGroup::FoldConstantAdjusts()
+{
+	uint folded = 0;
+	for (auto &adjust : this->adjusts) {
+		if (adjust.variable != 0x1A) continue;
+		if (adjust.shift_num == 0 && adjust.type == DSGA_TYPE_NONE) continue;
+		/* Leave the division by zero to the resolving, like it always was. */
+		if (adjust.type != DSGA_TYPE_NONE && adjust.divmod_val == 0) continue;
+
+		uint32_t value;
+		switch (this->size) {
+			case DSG_SIZE_BYTE:  value = AdjustValueT<uint8_t,  int8_t> (adjust, UINT32_MAX); break;
+			case DSG_SIZE_WORD:  value = AdjustValueT<uint16_t, int16_t>(adjust, UINT32_MAX); break;
+			case DSG_SIZE_DWORD: value = AdjustValueT<uint32_t, int32_t>(adjust, UINT32_MAX); break;
+			default: NOT_REACHED();
+		}
+
+		adjust.shift_num = 0;
+		adjust.and_mask = value;
+		adjust.type = DSGA_TYPE_NONE;
+		adjust.add_val = 0;
+		adjust.divmod_val = 0;
+		folded++;
+	}
+	return folded;
+}
+
 static bool RangeHighComparator(const DeterministicSpriteGroupRange &range, uint32_t value)
 {
 	return range.high < value;
@@ -191,6 +283,8 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 	uint32_t value = 0;
 
 	ScopeResolver *scope = object.GetScope(this->var_scope);
+	/* The relative scope is retargeted for every use, so its variables can not be reused. */
+	bool cacheable = this->var_scope != VSG_SCOPE_RELATIVE;
 
 	for (const auto &adjust : this->adjusts) {
 		/* Try to get the variable. We shall assume it is available, unless told otherwise. */
@@ -204,10 +298,13 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 			}
 
 			/* Note: 'last_value' and 'reseed' are shared between the main chain and the procedure */
+		} else if (adjust.variable == 0x1A) {
+			/* Constant; the adjustment turns it into the actual value. */
+			value = UINT32_MAX;
 		} else if (adjust.variable == 0x7B) {
-			value = GetVariable(object, scope, adjust.parameter, last_value, available);
+			value = GetVariableCached(object, scope, cacheable, adjust.parameter, last_value, available);
 		} else {
-			value = GetVariable(object, scope, adjust.variable, adjust.parameter, available);
+			value = GetVariableCached(object, scope, cacheable, adjust.variable, adjust.parameter, available);
 		}
 
 		if (!available) {
@@ -223,6 +320,9 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 			default: NOT_REACHED();
 		}
 		last_value = value;
+
+		/* Variables might read the registers that just got written. */
+		if (adjust.operation == DSGA_OP_STO || adjust.operation == DSGA_OP_STOP) object.InvalidateVariableCache();
 	}
 
 	object.last_value = last_value;
@@ -178,6 +178,8 @@ struct DeterministicSpriteGroup : SpriteGroup {
 
 	const SpriteGroup *error_group; // was first range, before sorting ranges
 
+	uint FoldConstantAdjusts();
+
 protected:
 	const SpriteGroup *Resolve(ResolverObject &object) const override;
 };
@@ -335,6 +337,31 @@ struct ResolverObject {
 	const GRFFile *grffile;     ///< GRFFile the resolved SpriteGroup belongs to
 	const SpriteGroup *root_spritegroup; ///< Root SpriteGroup to use for resolving
 
+	/** Value of a feature variable that has been read while resolving. */
+	struct CachedVariable {
+		const ScopeResolver *scope; ///< Scope the variable was read in.
+		uint32_t key;               ///< Value of #variable_cache_key when it was read; the entry is only valid while they match.
+		uint32_t parameter;         ///< Parameter of the variable.
+		uint32_t value;             ///< Value of the variable.
+		uint8_t variable;           ///< Number of the variable.
+		bool available;             ///< Whether the variable is available.
+	};
+
+	std::array<CachedVariable, 8> variable_cache{}; ///< Recently read feature variables of the current resolve.
+	uint32_t variable_cache_key = 1;                ///< Key of the valid entries in #variable_cache.
+	uint16_t variable_cache_storage_key = 0;        ///< Generation of the temporary storage the cache was filled with.
+
+	/**
+	 * Forget all cached variables, as what they depend on might have changed.
+	 */
+	void InvalidateVariableCache()
+	{
+		if (++this->variable_cache_key == 0) {
+			this->variable_cache = {};
+			this->variable_cache_key = 1;
+		}
+	}
+
 	/**
 	 * Resolve SpriteGroup.
 	 * @return Result spritegroup.
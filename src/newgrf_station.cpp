@@ -162,7 +162,15 @@ static TileIndex FindRailStationEnd(TileIndex tile, TileIndexDiff delta, bool ch
 }
 
 
-static uint32_t GetPlatformInfoHelper(TileIndex tile, bool check_type, bool check_axis, bool centred)
+/**
+ * Get the platform info of a station tile, both relative to the ends of the platform and relative to its centre.
+ * Both are made from the same walk over the platform, which is the expensive part.
+ * @param tile The station tile.
+ * @param check_type Whether the platform ends where the station spec changes.
+ * @param check_axis Whether the platform ends where the axis changes.
+ * @return The platform info without and with centring.
+ */
+static std::pair<uint32_t, uint32_t> GetPlatformInfoHelper(TileIndex tile, bool check_type, bool check_axis)
 {
 	int tx = TileX(tile);
 	int ty = TileY(tile);
@@ -174,7 +182,9 @@ static uint32_t GetPlatformInfoHelper(TileIndex tile, bool check_type, bool chec
 	tx -= sx; ex -= sx;
 	ty -= sy; ey -= sy;
 
-	return GetPlatformInfo(GetRailStationAxis(tile), GetStationGfx(tile), ex, ey, tx, ty, centred);
+	Axis axis = GetRailStationAxis(tile);
+	uint8_t gfx = GetStationGfx(tile);
+	return {GetPlatformInfo(axis, gfx, ex, ey, tx, ty, false), GetPlatformInfo(axis, gfx, ex, ey, tx, ty, true)};
 }
 
 
@@ -245,8 +255,26 @@ static struct {
 	uint32_t v47;
 	uint32_t v49;
 	uint8_t valid; ///< Bits indicating what variable is valid (for each bit, \c 0 is invalid, \c 1 is valid).
+	TileIndex tile; ///< Tile the variables are valid for.
+	bool keep; ///< Whether to keep the variables of the tile over several resolves, see #StationTileVariableCacheScope.
 } _svc;
 
+/**
+ * Keep the cached station variables of a tile over all resolves for this tile while the scope exists.
+ * @param tile The tile that is going to be resolved several times.
+ */
+StationTileVariableCacheScope::StationTileVariableCacheScope(TileIndex tile) : previous_keep(_svc.keep)
+{
+	_svc.valid = 0;
+	_svc.tile = tile;
+	_svc.keep = true;
+}
+
+StationTileVariableCacheScope::~StationTileVariableCacheScope()
+{
+	_svc.keep = this->previous_keep;
+}
+
 /**
  * Get the town scope associated with a station, if it exists.
  * On the first call, the town scope is created (if possible).
@@ -302,12 +330,14 @@ TownScopeResolver *StationResolverObject::GetTown()
 	switch (variable) {
 		/* Calculated station variables */
 		case 0x40:
-			if (!HasBit(_svc.valid, 0)) { _svc.v40 = GetPlatformInfoHelper(this->tile, false, false, false); SetBit(_svc.valid, 0); }
-			return _svc.v40;
+		case 0x46:
+			if (!HasBit(_svc.valid, 0)) { std::tie(_svc.v40, _svc.v46) = GetPlatformInfoHelper(this->tile, false, false); SetBit(_svc.valid, 0); }
+			return variable == 0x40 ? _svc.v40 : _svc.v46;
 
 		case 0x41:
-			if (!HasBit(_svc.valid, 1)) { _svc.v41 = GetPlatformInfoHelper(this->tile, true,  false, false); SetBit(_svc.valid, 1); }
-			return _svc.v41;
+		case 0x47:
+			if (!HasBit(_svc.valid, 1)) { std::tie(_svc.v41, _svc.v47) = GetPlatformInfoHelper(this->tile, true,  false); SetBit(_svc.valid, 1); }
+			return variable == 0x41 ? _svc.v41 : _svc.v47;
 
 		case 0x42: return GetTerrainType(this->tile) | (GetReverseRailTypeTranslation(GetRailType(this->tile), this->statspec->grf_prop.grffile) << 8);
 		case 0x43: return GetCompanyInfo(this->st->owner); // Station owner
@@ -316,16 +346,8 @@ TownScopeResolver *StationResolverObject::GetTown()
 			if (!HasBit(_svc.valid, 2)) { _svc.v45 = GetRailContinuationInfo(this->tile); SetBit(_svc.valid, 2); }
 			return _svc.v45;
 
-		case 0x46:
-			if (!HasBit(_svc.valid, 3)) { _svc.v46 = GetPlatformInfoHelper(this->tile, false, false, true); SetBit(_svc.valid, 3); }
-			return _svc.v46;
-
-		case 0x47:
-			if (!HasBit(_svc.valid, 4)) { _svc.v47 = GetPlatformInfoHelper(this->tile, true,  false, true); SetBit(_svc.valid, 4); }
-			return _svc.v47;
-
 		case 0x49:
-			if (!HasBit(_svc.valid, 5)) { _svc.v49 = GetPlatformInfoHelper(this->tile, false, true, false); SetBit(_svc.valid, 5); }
+			if (!HasBit(_svc.valid, 3)) { _svc.v49 = GetPlatformInfoHelper(this->tile, false, true).first; SetBit(_svc.valid, 3); }
 			return _svc.v49;
 
 		case 0x4A: // Animation frame of tile
@@ -571,8 +593,11 @@ StationResolverObject::StationResolverObject(const StationSpec *statspec, BaseSt
 	: ResolverObject(statspec->grf_prop.grffile, callback, callback_param1, callback_param2),
 	station_scope(*this, statspec, base_station, tile)
 {
-	/* Invalidate all cached vars */
-	_svc.valid = 0;
+	/* Invalidate all cached vars, unless they are kept for this tile. */
+	if (!_svc.keep || _svc.tile != tile) {
+		_svc.valid = 0;
+		_svc.tile = tile;
+	}
 
 	CargoID ctype = SpriteGroupCargo::SG_DEFAULT_NA;
 
@@ -870,7 +895,7 @@ struct StationAnimationBase : public AnimationBase<StationAnimationBase, Station
 void AnimateStationTile(TileIndex tile)
 {
 	const StationSpec *ss = GetStationSpec(tile);
-	if (ss == nullptr) return;
+	if (ss == nullptr || StationAnimationBase::IsAnimationTickSkipped(ss)) return;
 
 	StationAnimationBase::AnimateTile(ss, BaseStation::GetByTile(tile), tile, HasBit(ss->flags, SSF_CB141_RANDOM_BITS));
 }
@@ -213,4 +213,16 @@ void TriggerStationAnimation(BaseStation *st, TileIndex tile, StationAnimationTr
 void TriggerStationRandomisation(Station *st, TileIndex tile, StationRandomTrigger trigger, CargoID cargo_type = INVALID_CARGO);
 void StationUpdateCachedTriggers(BaseStation *st);
 
+/**
+ * Keeps the expensive platform and rail continuation variables of a station tile cached over several resolves.
+ * Only use this where the map does not change while the scope exists, like when drawing a tile.
+ */
+struct StationTileVariableCacheScope {
+	StationTileVariableCacheScope(TileIndex tile);
+	~StationTileVariableCacheScope();
+
+private:
+	bool previous_keep; ///< Whether the variables were kept before this scope.
+};
+
 #endif /* NEWGRF_STATION_H */
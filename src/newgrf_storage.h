@@ -69,11 +69,13 @@ struct PersistentStorageArray : BasePersistentStorageArray {
 
 	StorageType storage{}; ///< Memory for the storage array
 	std::unique_ptr<StorageType> prev_storage{}; ///< Temporary memory to store previous state so it can be reverted, e.g. for command tests.
+	std::vector<std::pair<uint16_t, TYPE>> prev_values{}; ///< Previous values of the changed positions, in order of change, while there are fewer changes than \c SIZE.
 
 	/**
 	 * Stores some value at a given position.
-	 * If there is no backup of the data that backup is made and then
-	 * we write the data.
+	 * If the change is not persistent, the previous value is remembered
+	 * so it can be reverted; only after many changes a backup of the
+	 * whole array is made instead.
 	 * @param pos   the position to write at
 	 * @param value the value to write
 	 */
@@ -86,15 +88,22 @@ struct PersistentStorageArray : BasePersistentStorageArray {
 		 * Saves a few cycles and such and it's pretty easy to check. */
 		if (this->storage[pos] == value) return;
 
-		/* We do not have made a backup; lets do so */
 		if (AreChangesPersistent()) {
-			assert(!this->prev_storage);
+			assert(!this->prev_storage && this->prev_values.empty());
 		} else if (!this->prev_storage) {
-			this->prev_storage = std::make_unique<StorageType>(this->storage);
-
-			/* We only need to register ourselves when we made the backup
+			/* We only need to register ourselves at the first change
 			 * as that is the only time something will have changed */
-			AddChangedPersistentStorage(this);
+			if (this->prev_values.empty()) AddChangedPersistentStorage(this);
+
+			if (this->prev_values.size() < SIZE) {
+				this->prev_values.emplace_back(pos, this->storage[pos]);
+			} else {
+				/* Too many changes to keep track of each; back up the whole previous state. */
+				this->prev_storage = std::make_unique<StorageType>(this->storage);
+				this->RevertValues(*this->prev_storage);
+				this->storage[pos] = value;
+				return;
+			}
 		}
 
 		this->storage[pos] = value;
@@ -119,6 +128,20 @@ struct PersistentStorageArray : BasePersistentStorageArray {
 			this->storage = *this->prev_storage;
 			this->prev_storage.reset();
 		}
+		this->RevertValues(this->storage);
+	}
+
+private:
+	/**
+	 * Revert the remembered changes, and forget about them.
+	 * @param target The storage to revert the changes in.
+	 */
+	void RevertValues(StorageType &target)
+	{
+		for (auto it = this->prev_values.rbegin(); it != this->prev_values.rend(); ++it) {
+			target[it->first] = it->second;
+		}
+		this->prev_values.clear();
 	}
 };
 
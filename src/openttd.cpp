@@ -76,6 +76,8 @@
 #include "timer/timer_game_realtime.h"
 #include "timer/timer_game_tick.h"
 #include "social_integration.h"
+#include "thread_pool.h"
+#include "trace.h"
 
 #include "linkgraph/linkgraphschedule.h"
 
@@ -95,6 +97,7 @@ void CallWindowGameTickEvent();
 bool HandleBootstrap();
 
 extern void CheckCaches();
+extern void LogStateHashes();
 extern Company *DoStartupNewCompany(bool is_ai, CompanyID company = INVALID_COMPANY);
 extern void OSOpenBrowser(const std::string &url);
 extern void ShowOSErrorBox(const char *buf, bool system);
@@ -302,6 +305,8 @@ static void ShutdownGame()
 	LinkGraphSchedule::Clear();
 	PoolBase::Clean(PT_ALL);
 
+	ThreadPool::Shutdown();
+
 	/* No NewGRFs were loaded when it was still bootstrapping. */
 	if (_game_mode != GM_BOOTSTRAP) ResetNewGRFData();
 
@@ -375,6 +380,20 @@ void OpenBrowser(const std::string &url)
 	}
 }
 
+static std::chrono::steady_clock::time_point _startup_start;       ///< When starting OpenTTD began.
+static std::chrono::steady_clock::time_point _startup_stage_start; ///< Start of the current stage of starting OpenTTD.
+
+/**
+ * Log how long a stage of starting OpenTTD took, to find out what makes starting slow.
+ * @param stage The stage that just finished.
+ */
+static void LogStartupStage(std::string_view stage)
+{
+	auto now = std::chrono::steady_clock::now();
+	Debug(misc, 2, "Startup: {} took {} ms", stage, std::chrono::duration_cast<std::chrono::milliseconds>(now - _startup_stage_start).count());
+	_startup_stage_start = now;
+}
+
 /** Callback structure of statements to be executed after the NewGRF scan. */
 struct AfterNewGRFScan : NewGRFScanCallback {
 	TimerGameCalendar::Year startyear = CalendarTime::INVALID_YEAR; ///< The start year.
@@ -397,12 +416,16 @@ struct AfterNewGRFScan : NewGRFScanCallback {
 
 	void OnNewGRFsScanned() override
 	{
+		LogStartupStage("scanning NewGRFs");
 		ResetGRFConfig(false);
 
 		TarScanner::DoScan(TarScanner::SCENARIO);
+		LogStartupStage("scanning scenarios");
 
 		AI::Initialize();
+		LogStartupStage("scanning AIs");
 		Game::Initialize();
+		LogStartupStage("scanning game scripts");
 
 		/* We want the new (correct) NewGRF count to survive the loading. */
 		uint last_newgrf_count = _settings_client.gui.last_newgrf_count;
@@ -438,6 +461,8 @@ struct AfterNewGRFScan : NewGRFScanCallback {
 		IConsoleInit();
 		InitializeGUI();
 		IConsoleCmdExec("exec scripts/autoexec.scr 0");
+		LogStartupStage("loading the configuration and starting the console");
+		Debug(misc, 2, "Startup: done after {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(_startup_stage_start - _startup_start).count());
 
 		/* Make sure _settings is filled with _settings_newgame if we switch to a game directly */
 		if (_switch_mode != SM_NONE) MakeNewgameSettingsLive();
@@ -505,6 +530,7 @@ int openttd_main(std::span<char * const> arguments)
 {
 	_game_session_stats.start_time = std::chrono::steady_clock::now();
 	_game_session_stats.savegame_size = std::nullopt;
+	_startup_start = _startup_stage_start = _game_session_stats.start_time;
 
 	std::string musicdriver;
 	std::string sounddriver;
@@ -663,6 +689,7 @@ int openttd_main(std::span<char * const> arguments)
 
 	DeterminePaths(arguments[0], only_local_path);
 	TarScanner::DoScan(TarScanner::BASESET);
+	LogStartupStage("scanning base set tars");
 
 	if (dedicated) Debug(net, 3, "Starting dedicated server, version {}", _openttd_revision);
 	if (_dedicated_forks && !dedicated) _dedicated_forks = false;
@@ -673,6 +700,7 @@ int openttd_main(std::span<char * const> arguments)
 #endif
 
 	LoadFromConfig(true);
+	LogStartupStage("loading the configuration");
 
 	if (resolution.width != 0) _cur_resolution = resolution;
 
@@ -691,9 +719,11 @@ int openttd_main(std::span<char * const> arguments)
 
 	/* enumerate language files */
 	InitializeLanguagePacks();
+	LogStartupStage("loading languages");
 
 	/* Initialize the font cache */
 	InitFontCache(false);
+	LogStartupStage("loading fonts");
 
 	/* This must be done early, since functions use the SetWindowDirty* calls */
 	InitWindowSystem();
@@ -726,6 +756,8 @@ int openttd_main(std::span<char * const> arguments)
 		ScheduleErrorMessage(msg);
 	}
 
+	LogStartupStage("finding base graphics");
+
 	/* Initialize game palette */
 	GfxInitPalettes();
 
@@ -750,6 +782,7 @@ int openttd_main(std::span<char * const> arguments)
 
 	if (videodriver.empty() && !_ini_videodriver.empty()) videodriver = _ini_videodriver;
 	DriverFactoryBase::SelectDriver(videodriver, Driver::DT_VIDEO);
+	LogStartupStage("starting the video driver");
 
 	InitializeSpriteSorter();
 
@@ -766,11 +799,13 @@ int openttd_main(std::span<char * const> arguments)
 		ShutdownGame();
 		return ret;
 	}
+	LogStartupStage("starting the network");
 
 	VideoDriver::GetInstance()->ClaimMousePointer();
 
 	/* initialize screenshot formats */
 	InitializeScreenshotFormats();
+	LogStartupStage("initialising screenshot formats");
 
 	BaseSounds::FindSets();
 	if (sounds_set.empty() && !BaseSounds::ini_set.empty()) sounds_set = BaseSounds::ini_set;
@@ -784,6 +819,8 @@ int openttd_main(std::span<char * const> arguments)
 		}
 	}
 
+	LogStartupStage("finding base sounds");
+
 	BaseMusic::FindSets();
 	if (music_set.empty() && !BaseMusic::ini_set.empty()) music_set = BaseMusic::ini_set;
 	if (!BaseMusic::SetSetByName(music_set)) {
@@ -796,14 +833,18 @@ int openttd_main(std::span<char * const> arguments)
 		}
 	}
 
+	LogStartupStage("finding base music");
+
 	if (sounddriver.empty() && !_ini_sounddriver.empty()) sounddriver = _ini_sounddriver;
 	DriverFactoryBase::SelectDriver(sounddriver, Driver::DT_SOUND);
 
 	if (musicdriver.empty() && !_ini_musicdriver.empty()) musicdriver = _ini_musicdriver;
 	DriverFactoryBase::SelectDriver(musicdriver, Driver::DT_MUSIC);
+	LogStartupStage("starting the sound and music drivers");
 
 	GenerateWorld(GWM_EMPTY, 64, 64); // Make the viewport initialization happy
 	LoadIntroGame(false);
+	LogStartupStage("loading the intro game");
 
 	/* ScanNewGRFFiles now has control over the scanner. */
 	RequestNewGRFScan(scanner.release());
@@ -1211,6 +1252,9 @@ void SwitchToMode(SwitchMode new_mode)
  */
 void StateGameLoop()
 {
+	Tracer::Tick();
+	TraceZone trace("StateGameLoop");
+
 	if (!_networking || _network_server) {
 		StateGameLoop_LinkGraphPauseControl();
 	}
@@ -1255,6 +1299,7 @@ void StateGameLoop()
 		}
 
 		CheckCaches();
+		LogStateHashes();
 
 		/* All these actions has to be done from OWNER_NONE
 		 *  for multiplayer compatibility */
@@ -1372,7 +1417,7 @@ void GameLoop()
 		if (_exit_game) return;
 	}
 
-	IncreaseSpriteLRU();
+	EvictSpritesFromSpriteCache();
 
 	/* Check for UDP stuff */
 	if (_network_available) NetworkBackgroundLoop();
@@ -266,6 +266,7 @@ private:
 	uint num_vehicles;                ///< NOSAVE: Number of vehicles that share this order list.
 	Vehicle *first_shared;            ///< NOSAVE: pointer to the first vehicle in the shared order chain.
 	Order *first;                     ///< First order of the order list.
+	std::vector<Order *> orders;      ///< NOSAVE: The orders of the order list in order, for quick access by index.
 
 	TimerGameTick::Ticks timetable_duration;         ///< NOSAVE: Total timetabled duration of the order list.
 	TimerGameTick::Ticks total_duration;             ///< NOSAVE: Total (timetabled or not) duration of the order list.
@@ -281,8 +281,10 @@ void OrderList::Initialize(Order *chain, Vehicle *v)
 	this->num_manual_orders = 0;
 	this->num_vehicles = 1;
 	this->timetable_duration = 0;
+	this->orders.clear();
 
 	for (Order *o = this->first; o != nullptr; o = o->next) {
+		this->orders.push_back(o);
 		++this->num_orders;
 		if (!o->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 		this->total_duration += o->GetWaitTime() + o->GetTravelTime();
@@ -325,6 +327,7 @@ void OrderList::FreeChain(bool keep_orderlist)
 
 	if (keep_orderlist) {
 		this->first = nullptr;
+		this->orders.clear();
 		this->num_orders = 0;
 		this->num_manual_orders = 0;
 		this->timetable_duration = 0;
@@ -340,14 +343,9 @@ void OrderList::FreeChain(bool keep_orderlist)
  */
 Order *OrderList::GetOrderAt(int index) const
 {
-	if (index < 0) return nullptr;
+	if (index < 0 || static_cast<size_t>(index) >= this->orders.size()) return nullptr;
 
-	Order *order = this->first;
-
-	while (order != nullptr && index-- > 0) {
-		order = order->next;
-	}
-	return order;
+	return this->orders[index];
 }
 
 /**
@@ -472,6 +470,7 @@ void OrderList::InsertOrderAt(Order *new_order, int index)
 			order->next = new_order;
 		}
 	}
+	this->orders.insert(this->orders.begin() + std::min<size_t>(index, this->orders.size()), new_order);
 	++this->num_orders;
 	if (!new_order->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 	this->timetable_duration += new_order->GetTimetabledWait() + new_order->GetTimetabledTravel();
@@ -505,6 +504,7 @@ void OrderList::DeleteOrderAt(int index)
 		to_remove = prev->next;
 		prev->next = to_remove->next;
 	}
+	this->orders.erase(this->orders.begin() + index);
 	--this->num_orders;
 	if (!to_remove->IsType(OT_IMPLICIT)) --this->num_manual_orders;
 	this->timetable_duration -= (to_remove->GetTimetabledWait() + to_remove->GetTimetabledTravel());
@@ -521,26 +521,18 @@ void OrderList::MoveOrder(int from, int to)
 {
 	if (from >= this->num_orders || to >= this->num_orders || from == to) return;
 
-	Order *moving_one;
-
-	/* Take the moving order out of the pointer-chain */
-	if (from == 0) {
-		moving_one = this->first;
-		this->first = moving_one->next;
+	if (from < to) {
+		std::rotate(this->orders.begin() + from, this->orders.begin() + from + 1, this->orders.begin() + to + 1);
 	} else {
-		Order *one_before = GetOrderAt(from - 1);
-		moving_one = one_before->next;
-		one_before->next = moving_one->next;
+		std::rotate(this->orders.begin() + to, this->orders.begin() + from, this->orders.begin() + from + 1);
 	}
 
-	/* Insert the moving_order again in the pointer-chain */
-	if (to == 0) {
-		moving_one->next = this->first;
-		this->first = moving_one;
-	} else {
-		Order *one_before = GetOrderAt(to - 1);
-		moving_one->next = one_before->next;
-		one_before->next = moving_one;
+	/* Relink the pointer-chain in the new order */
+	int first_changed = std::min(from, to);
+	int last_changed = std::max(from, to);
+	if (first_changed == 0) this->first = this->orders.front();
+	for (int i = std::max(first_changed - 1, 0); i <= last_changed; i++) {
+		this->orders[i]->next = (static_cast<size_t>(i) + 1 < this->orders.size()) ? this->orders[i + 1] : nullptr;
 	}
 }
 
@@ -584,6 +576,7 @@ void OrderList::DebugCheckSanity() const
 	Debug(misc, 6, "Checking OrderList {} for sanity...", this->index);
 
 	for (const Order *o = this->first; o != nullptr; o = o->next) {
+		assert(check_num_orders < this->orders.size() && this->orders[check_num_orders] == o);
 		++check_num_orders;
 		if (!o->IsType(OT_IMPLICIT)) ++check_num_manual_orders;
 		check_timetable_duration += o->GetTimetabledWait() + o->GetTimetabledTravel();
@@ -239,6 +239,9 @@ protected:
 			m_new_td_bits = (TrackdirBits)(GetTrackBits(m_new_tile) * 0x101);
 		} else if (IsRoadTT()) {
 			m_new_td_bits = GetTrackdirBitsForRoad(m_new_tile, this->IsTram() ? RTT_TRAM : RTT_ROAD);
+		} else if (IsWaterTT() && IsWaterTile(m_new_tile) && IsTileFlat(m_new_tile) && TileX(m_new_tile) != 0 && TileY(m_new_tile) != 0) {
+			/* Open water away from the north map borders, as in GetTileTrackStatus_Water. */
+			m_new_td_bits = TrackBitsToTrackdirBits(TRACK_BIT_ALL);
 		} else {
 			m_new_td_bits = TrackStatusToTrackdirBits(GetTileTrackStatus(m_new_tile, TT(), 0));
 		}
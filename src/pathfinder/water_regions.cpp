@@ -221,6 +221,7 @@ public:
 
 std::vector<WaterRegionData> _water_region_data;
 std::vector<bool> _is_water_region_valid;
+uint32_t _water_region_change_counter = 0; ///< Incremented whenever any water region gets invalidated.
 
 TileIndex GetTileIndexFromLocalCoordinate(int region_x, int region_y, int local_x, int local_y)
 {
@@ -316,6 +317,7 @@ void InvalidateWaterRegion(TileIndex tile)
 		const int water_region_index = GetWaterRegionIndex(tile);
 		if (!_is_water_region_valid[water_region_index]) Debug(map, 3, "Invalidated water region ({},{})", GetWaterRegionX(tile), GetWaterRegionY(tile));
 		_is_water_region_valid[water_region_index] = false;
+		_water_region_change_counter++;
 	};
 
 	invalidate_region(tile);
@@ -329,6 +331,16 @@ void InvalidateWaterRegion(TileIndex tile)
 	}
 }
 
+/**
+ * Get a number that changes whenever any water region gets invalidated.
+ * Anything derived from the water regions has to be thrown away when it changes.
+ * @return The current change counter.
+ */
+uint32_t GetWaterRegionChangeCounter()
+{
+	return _water_region_change_counter;
+}
+
 /**
  * Calls the provided callback function for all water region patches
  * accessible from one particular side of the starting patch.
@@ -417,6 +429,7 @@ void AllocateWaterRegions()
 
 	_is_water_region_valid.clear();
 	_is_water_region_valid.resize(number_of_regions, false);
+	_water_region_change_counter++;
 
 	Debug(map, 2, "Allocating {} x {} water regions", GetWaterRegionMapSizeX(), GetWaterRegionMapSizeY());
 	assert(_is_water_region_valid.size() == _water_region_data.size());
@@ -17,8 +17,9 @@
  * Hash table based node list multi-container class.
  *  Implements open list, closed list and priority queue for A-star
  *  path finder.
+ * @tparam Theap_arity_ Number of children per node in the open list heap.
  */
-template <class Titem_, int Thash_bits_open_, int Thash_bits_closed_>
+template <class Titem_, int Thash_bits_open_, int Thash_bits_closed_, size_t Theap_arity_ = 2>
 class CNodeList_HashTableT {
 public:
 	typedef Titem_ Titem;                                        ///< Make #Titem_ visible from outside of class.
@@ -26,10 +27,11 @@ public:
 	using CItemArray = std::deque<Titem_>;                       ///< Type that we will use as item container.
 	typedef CHashTableT<Titem_, Thash_bits_open_  > COpenList;   ///< How pointers to open nodes will be stored.
 	typedef CHashTableT<Titem_, Thash_bits_closed_> CClosedList; ///< How pointers to closed nodes will be stored.
-	typedef CBinaryHeapT<Titem_> CPriorityQueue;                 ///< How the priority queue will be managed.
+	typedef CBinaryHeapT<Titem_, Theap_arity_> CPriorityQueue;   ///< How the priority queue will be managed.
 
 protected:
 	CItemArray      m_arr;        ///< Here we store full item data (Titem_).
+	size_t          m_arr_used;   ///< Number of items of m_arr in use, the others are kept for reuse.
 	COpenList       m_open;       ///< Hash table of pointers to open item data.
 	CClosedList     m_closed;     ///< Hash table of pointers to closed item data.
 	CPriorityQueue  m_open_queue; ///< Priority queue of pointers to open item data.
@@ -39,6 +41,7 @@ public:
 	/** default constructor */
 	CNodeList_HashTableT() : m_open_queue(2048)
 	{
+		m_arr_used = 0;
 		m_new_node = nullptr;
 	}
 
@@ -62,10 +65,28 @@ public:
 	/** allocate new data item from m_arr */
 	inline Titem_ *CreateNewNode()
 	{
-		if (m_new_node == nullptr) m_new_node = &m_arr.emplace_back();
+		if (m_new_node == nullptr) {
+			if (m_arr_used == m_arr.size()) {
+				m_new_node = &m_arr.emplace_back();
+			} else {
+				m_new_node = &m_arr[m_arr_used];
+				*m_new_node = Titem_();
+			}
+			m_arr_used++;
+		}
 		return m_new_node;
 	}
 
+	/** Forget all nodes, but keep the allocated memory for the next search. */
+	inline void Clear()
+	{
+		m_open.Clear();
+		m_closed.Clear();
+		m_open_queue.Clear();
+		m_arr_used = 0;
+		m_new_node = nullptr;
+	}
+
 	/** Notify the nodelist that we don't want to discard the given node. */
 	inline void FoundBestNode(Titem_ &item)
 	{
@@ -140,7 +161,7 @@ public:
 	/** The number of items. */
 	inline int TotalCount()
 	{
-		return m_arr.Length();
+		return static_cast<int>(m_arr_used);
 	}
 
 	/** Get a particular item. */
@@ -156,4 +177,45 @@ public:
 	}
 };
 
+/**
+ * Node list borrowed from a per-thread pool of node lists.
+ *  Searches run very often, so instead of building a new node list for every
+ *  search, the node lists of finished searches are cleared and handed out
+ *  again. Every thread has its own pool, and nested searches simply borrow
+ *  another node list.
+ */
+template <class Tlist>
+class CNodeListPoolT {
+	static const size_t MAX_POOLED_LISTS = 4; ///< Number of idle node lists kept per thread.
+	static inline thread_local std::vector<std::unique_ptr<Tlist>> s_idle; ///< The idle node lists of this thread.
+
+	std::unique_ptr<Tlist> m_list; ///< The borrowed node list.
+
+public:
+	/** Borrow an idle node list, or create a new one. */
+	CNodeListPoolT()
+	{
+		if (s_idle.empty()) {
+			m_list = std::make_unique<Tlist>();
+		} else {
+			m_list = std::move(s_idle.back());
+			s_idle.pop_back();
+		}
+	}
+
+	/** Hand back the node list, so the next search can reuse it. */
+	~CNodeListPoolT()
+	{
+		if (s_idle.size() >= MAX_POOLED_LISTS) return;
+		m_list->Clear();
+		s_idle.push_back(std::move(m_list));
+	}
+
+	/** Get the borrowed node list. */
+	inline Tlist &Get()
+	{
+		return *m_list;
+	}
+};
+
 #endif /* NODELIST_HPP */
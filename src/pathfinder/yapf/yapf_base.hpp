@@ -12,6 +12,7 @@
 
 #include "../../debug.h"
 #include "../../settings_type.h"
+#include "../../trace.h"
 
 /**
  * CYapfBaseT - A-star type path finder base class.
@@ -54,7 +55,10 @@ public:
 	typedef typename Node::Key Key;            ///< key to hash tables
 
 
-	NodeList             m_nodes;              ///< node list multi-container
+private:
+	CNodeListPoolT<NodeList> m_nodes_pool;     ///< where our node list is borrowed from
+public:
+	NodeList            &m_nodes;              ///< node list multi-container
 protected:
 	Node                *m_pBestDestNode;      ///< pointer to the destination node found at last round
 	Node                *m_pBestIntermediateNode; ///< here should be node closest to the destination if path not found
@@ -71,7 +75,8 @@ public:
 public:
 	/** default constructor */
 	inline CYapfBaseT()
-		: m_pBestDestNode(nullptr)
+		: m_nodes(m_nodes_pool.Get())
+		, m_pBestDestNode(nullptr)
 		, m_pBestIntermediateNode(nullptr)
 		, m_settings(&_settings_game.pf.yapf)
 		, m_max_search_nodes(PfGetSettings().max_search_nodes)
@@ -110,6 +115,7 @@ public:
 	 */
 	inline bool FindPath(const VehicleType *v)
 	{
+		TraceZone trace("YAPF FindPath");
 		m_veh = v;
 
 		Yapf().PfSetStartupNodes();
@@ -11,6 +11,7 @@
 #define YAPF_COSTCACHE_HPP
 
 #include "../../timer/timer_game_calendar.h"
+#include "../../tilearea_type.h"
 
 /**
  * CYapfSegmentCostCacheNoneT - the formal only yapf cost cache provider that implements
@@ -40,14 +41,29 @@ public:
  *  the track layout changes. It is implemented as base class because it needs
  *  to be shared between all rail YAPF types (one shared counter, one notification
  *  function.
+ * Changes of a single tile are logged, so each cache can drop just the segments
+ *  around that tile the next time it is used. Unknown changes, or too many of
+ *  them at once, increment the counter which flushes the caches completely.
+ * Every map change that can alter the cost or the end of a cached segment has to
+ *  be notified, e.g. track, signal, station and depot changes, terraforming and
+ *  changes of ownership. Otherwise a cache would keep a cost that a client which
+ *  joined later, with an empty cache, calculates differently.
  */
 struct CSegmentCostCacheBase
 {
+	static const size_t MAX_CHANGED_TILES = 1 << 16; ///< Maximum number of logged changes before we rather flush everything.
+
 	static int   s_rail_change_counter;
+	static std::vector<TileIndex> s_changed_tiles;
 
-	static void NotifyTrackLayoutChange(TileIndex, Track)
+	static void NotifyTrackLayoutChange(TileIndex tile, Track)
 	{
-		s_rail_change_counter++;
+		if (tile == INVALID_TILE || s_changed_tiles.size() >= MAX_CHANGED_TILES) {
+			s_rail_change_counter++;
+			s_changed_tiles.clear();
+		} else {
+			s_changed_tiles.push_back(tile);
+		}
 	}
 };
 
@@ -65,13 +81,18 @@ struct CSegmentCostCacheBase
 template <class Tsegment>
 struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 	static const int C_HASH_BITS = 14;
+	static const size_t MAX_TILE_INDEX_ENTRIES = 1 << 20; ///< Flush the cache when the tile index grows beyond this.
 
 	typedef CHashTableT<Tsegment, C_HASH_BITS> HashTable;
 	using Heap = std::deque<Tsegment>;
+	using TileIndexMap = std::unordered_map<uint32_t, std::vector<Tsegment *>>;
 	typedef typename Tsegment::Key Key;    ///< key to hash table
 
 	HashTable    m_map;
 	Heap         m_heap;
+	TileIndexMap m_tile_index;             ///< The cached segments passing each tile.
+	size_t       m_tile_index_entries = 0; ///< Total number of segments in #m_tile_index.
+	bool         m_flush_pending = false;  ///< The tile index grew too large, flush before the next use.
 
 	inline CSegmentCostCacheT() {}
 
@@ -80,6 +101,43 @@ struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 	{
 		m_map.Clear();
 		m_heap.clear();
+		m_tile_index.clear();
+		m_tile_index_entries = 0;
+		m_flush_pending = false;
+	}
+
+	/**
+	 * Remember the tiles a newly cached segment passes, so it can be dropped when any of them changes.
+	 * @param segment The segment.
+	 * @param tiles The tiles the segment passes, including the skipped ones.
+	 */
+	inline void RegisterTiles(Tsegment &segment, const std::vector<TileIndex> &tiles)
+	{
+		for (TileIndex tile : tiles) {
+			m_tile_index[tile.base()].push_back(&segment);
+		}
+		m_tile_index_entries += tiles.size();
+
+		/* Invalidated segments are not removed from the tile index of the other tiles they passed, so it can only grow. */
+		if (m_tile_index_entries > MAX_TILE_INDEX_ENTRIES) m_flush_pending = true;
+	}
+
+	/**
+	 * Forget the cost of all segments that pass the given tile or one of its neighbours.
+	 * The neighbours are included as a segment also depends on the tile following its
+	 * last tile, and the length of a platform changes when a tile gets added to its end.
+	 * @param tile The tile that changed.
+	 */
+	inline void InvalidateTile(TileIndex tile)
+	{
+		for (TileIndex t : OrthogonalTileArea(tile, 1, 1).Expand(1)) {
+			auto it = m_tile_index.find(t.base());
+			if (it == m_tile_index.end()) continue;
+
+			for (Tsegment *segment : it->second) segment->Invalidate();
+			m_tile_index_entries -= it->second.size();
+			m_tile_index.erase(it);
+		}
 	}
 
 	inline Tsegment &Get(Key &key, bool *found)
@@ -127,13 +185,20 @@ protected:
 	inline static Cache &stGetGlobalCache()
 	{
 		static int last_rail_change_counter = 0;
+		static size_t last_changed_tile = 0;
 		static Cache C;
 
 		/* delete the cache sometimes... */
-		if (last_rail_change_counter != Cache::s_rail_change_counter) {
+		if (last_rail_change_counter != Cache::s_rail_change_counter || C.m_flush_pending) {
 			last_rail_change_counter = Cache::s_rail_change_counter;
+			last_changed_tile = Cache::s_changed_tiles.size();
 			C.Flush();
 		}
+
+		/* ... otherwise only forget the segments around the tiles that changed since the last time. */
+		for (; last_changed_tile < Cache::s_changed_tiles.size(); last_changed_tile++) {
+			C.InvalidateTile(Cache::s_changed_tiles[last_changed_tile]);
+		}
 		return C;
 	}
 
@@ -156,6 +221,18 @@ public:
 		Yapf().ConnectNodeToCachedData(n, item);
 		return found;
 	}
+
+	/**
+	 * Called by YAPF when it calculated the cost of a segment, to register the tiles it passes.
+	 * @param n The node of the segment.
+	 * @param tiles The tiles of the segment.
+	 */
+	inline void PfNodeCacheRegisterTiles(Node &n, const std::vector<TileIndex> &tiles)
+	{
+		if (!Yapf().CanUseGlobalCache(n)) return;
+
+		m_global_cache.RegisterTiles(*n.m_segment, tiles);
+	}
 };
 
 #endif /* YAPF_COSTCACHE_HPP */
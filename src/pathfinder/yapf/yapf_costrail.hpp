@@ -56,6 +56,7 @@ protected:
 	int m_max_cost;
 	bool m_disable_cache;
 	std::vector<int> m_sig_look_ahead_costs;
+	std::vector<TileIndex> m_segment_tiles; ///< Tiles of the segment being calculated, for the global cache.
 
 public:
 	bool          m_stopped_on_first_two_way_signal;
@@ -323,6 +324,10 @@ public:
 
 		TrackFollower tf_local(v, Yapf().GetCompatibleRailTypes());
 
+		/* Collect the tiles of segments that will be stored in the global cache, so they can be invalidated when those tiles change. */
+		bool collect_tiles = !is_cached_segment && Yapf().CanUseGlobalCache(n);
+		m_segment_tiles.clear();
+
 		if (!has_parent) {
 			/* We will jump to the middle of the cost calculator assuming that segment cache is not used. */
 			assert(!is_cached_segment);
@@ -375,6 +380,14 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 			/* If we skipped some tunnel/bridge/station tiles, add their base cost */
 			segment_cost += YAPF_TILE_LENGTH * tf->m_tiles_skipped;
 
+			if (collect_tiles) {
+				TileIndexDiff diff = TileOffsByDiagDir(TrackdirToExitdir(ReverseTrackdir(cur.td)));
+				TileIndex tile = cur.tile;
+				for (int skipped = tf->m_tiles_skipped; skipped >= 0; skipped--, tile += diff) {
+					m_segment_tiles.push_back(tile);
+				}
+			}
+
 			/* Slope cost. */
 			segment_cost += Yapf().SlopeCost(cur.tile, cur.td);
 
@@ -569,6 +582,8 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 			segment.m_end_segment_reason = end_segment_reason & ESRB_CACHED_MASK;
 			/* Save end of segment back to the node. */
 			n.SetLastTileTrackdir(cur.tile, cur.td);
+
+			if (collect_tiles) Yapf().PfNodeCacheRegisterTiles(n, m_segment_tiles);
 		}
 
 		/* Do we have an excuse why not to continue pathfinding in this direction? */
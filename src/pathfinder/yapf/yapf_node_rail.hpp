@@ -92,6 +92,17 @@ struct CYapfRailSegment
 		return m_key.GetTile();
 	}
 
+	/** Forget the cached information, so it gets calculated again the next time the segment is used. */
+	inline void Invalidate()
+	{
+		m_last_tile = INVALID_TILE;
+		m_last_td = INVALID_TRACKDIR;
+		m_cost = -1;
+		m_last_signal_tile = INVALID_TILE;
+		m_last_signal_td = INVALID_TRACKDIR;
+		m_end_segment_reason = ESRB_NONE;
+	}
+
 	inline CYapfRailSegment *GetHashNext()
 	{
 		return m_hash_next;
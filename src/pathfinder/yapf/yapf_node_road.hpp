@@ -31,7 +31,8 @@ typedef CYapfRoadNodeT<CYapfNodeKeyExitDir>  CYapfRoadNodeExitDir;
 typedef CYapfRoadNodeT<CYapfNodeKeyTrackDir> CYapfRoadNodeTrackDir;
 
 /* Default NodeList types */
-typedef CNodeList_HashTableT<CYapfRoadNodeExitDir , 8, 10> CRoadNodeListExitDir;
-typedef CNodeList_HashTableT<CYapfRoadNodeTrackDir, 8, 10> CRoadNodeListTrackDir;
+/* Road vehicle searches are many but small, so use a shallow 4-ary heap for the open list. */
+typedef CNodeList_HashTableT<CYapfRoadNodeExitDir , 8, 10, 4> CRoadNodeListExitDir;
+typedef CNodeList_HashTableT<CYapfRoadNodeTrackDir, 8, 10, 4> CRoadNodeListTrackDir;
 
 #endif /* YAPF_NODE_ROAD_HPP */
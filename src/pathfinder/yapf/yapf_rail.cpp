@@ -177,10 +177,8 @@ public:
 
 		if (target != nullptr) target->okay = true;
 
-		if (Yapf().CanUseGlobalCache(*m_res_node)) {
-			YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
-		}
-
+		/* The segment cost cache does not need to know about the reservation. Reserved tiles only
+		 * add costs within the signal look-ahead, and those segments are never cached globally. */
 		return true;
 	}
 };
@@ -645,6 +643,7 @@ bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, b
 
 /** if any track changes, this counter is incremented - that will invalidate segment cost cache */
 int CSegmentCostCacheBase::s_rail_change_counter = 0;
+std::vector<TileIndex> CSegmentCostCacheBase::s_changed_tiles;
 
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
@@ -35,18 +35,26 @@ protected:
 		return *static_cast<Tpf *>(this);
 	}
 
-	int SlopeCost(TileIndex tile, TileIndex next_tile, Trackdir)
+	/**
+	 * Get the height of the center of a tile.
+	 * @param tile The tile.
+	 * @return The height in pixels.
+	 */
+	static int TileCenterZ(TileIndex tile)
 	{
-		/* height of the center of the current tile */
-		int x1 = TileX(tile) * TILE_SIZE;
-		int y1 = TileY(tile) * TILE_SIZE;
-		int z1 = GetSlopePixelZ(x1 + TILE_SIZE / 2, y1 + TILE_SIZE / 2, true);
-
-		/* height of the center of the next tile */
-		int x2 = TileX(next_tile) * TILE_SIZE;
-		int y2 = TileY(next_tile) * TILE_SIZE;
-		int z2 = GetSlopePixelZ(x2 + TILE_SIZE / 2, y2 + TILE_SIZE / 2, true);
+		int x = TileX(tile) * TILE_SIZE;
+		int y = TileY(tile) * TILE_SIZE;
+		return GetSlopePixelZ(x + TILE_SIZE / 2, y + TILE_SIZE / 2, true);
+	}
 
+	/**
+	 * Penalty for going from one tile to the next.
+	 * @param z1 Height of the center of the current tile, see #TileCenterZ.
+	 * @param z2 Height of the center of the next tile.
+	 * @return The penalty.
+	 */
+	int SlopeCost(int z1, int z2)
+	{
 		if (z2 - z1 > 1) {
 			/* Slope up */
 			return Yapf().PfGetSettings().road_slope_penalty;
@@ -120,11 +128,15 @@ public:
 		Trackdir trackdir = n.m_key.m_td;
 		int parent_cost = (n.m_parent != nullptr) ? n.m_parent->m_cost : 0;
 
+		/* The vehicle speed does not change along the segment, and the height of every tile is needed twice. */
+		const RoadVehicle *v = Yapf().GetVehicle();
+		const int max_veh_speed = std::min<int>(v->GetDisplayMaxSpeed(), v->current_order.GetMaxSpeed() * 2);
+		int z = TileCenterZ(tile);
+
 		for (;;) {
 			/* base tile cost depending on distance between edges */
 			segment_cost += Yapf().OneTileCost(tile, trackdir);
 
-			const RoadVehicle *v = Yapf().GetVehicle();
 			/* we have reached the vehicle's destination - segment should end here to avoid target skipping */
 			if (Yapf().PfDetectDestinationTile(tile, trackdir)) break;
 
@@ -157,11 +169,12 @@ public:
 			tiles += F.m_tiles_skipped + 1;
 
 			/* add hilly terrain penalty */
-			segment_cost += Yapf().SlopeCost(tile, F.m_new_tile, trackdir);
+			int next_z = TileCenterZ(F.m_new_tile);
+			segment_cost += Yapf().SlopeCost(z, next_z);
+			z = next_z;
 
 			/* add min/max speed penalties */
 			int min_speed = 0;
-			int max_veh_speed = std::min<int>(v->GetDisplayMaxSpeed(), v->current_order.GetMaxSpeed() * 2);
 			int max_speed = F.GetSpeedLimit(&min_speed);
 			if (max_speed < max_veh_speed) segment_cost += YAPF_TILE_LENGTH * (max_veh_speed - max_speed) * (4 + F.m_tiles_skipped) / max_veh_speed;
 			if (min_speed > max_veh_speed) segment_cost += YAPF_TILE_LENGTH * (min_speed - max_veh_speed);
@@ -11,6 +11,7 @@
 #include "../../ship.h"
 #include "../../industry.h"
 #include "../../vehicle_func.h"
+#include "../../core/flatmap_type.hpp"
 
 #include "yapf.hpp"
 #include "yapf_node_ship.hpp"
@@ -332,6 +333,9 @@ public:
 	typedef typename Types::NodeList::Titem Node; ///< this will be our node type.
 	typedef typename Node::Key Key;               ///< key to hash tables.
 
+protected:
+	FlatMap<TileIndex, uint> docking_tile_ship_counts; ///< Number of ships on the docking tiles visited in this search.
+
 	/** to access inherited path finder */
 	Tpf &Yapf()
 	{
@@ -363,6 +367,23 @@ public:
 		return nullptr;
 	}
 
+	/**
+	 * Get the number of ships on a docking tile.
+	 * Ships do not move during a search, while a docking tile is visited for each of its trackdirs, so the count is only made once per tile.
+	 * @param tile The docking tile.
+	 * @return Number of ships on the tile, excluding the ones in a depot.
+	 */
+	inline uint GetDockingTileShipCount(TileIndex tile)
+	{
+		auto [it, inserted] = this->docking_tile_ship_counts.emplace(tile, 0);
+		if (inserted) {
+			uint count = 0;
+			HasVehicleOnPos(tile, VEH_SHIP, &count, &CountShipProc);
+			it->second = count;
+		}
+		return it->second;
+	}
+
 	/**
 	 * Called by YAPF to calculate the cost from the origin to the given node.
 	 * Calculates only the cost of given node, adds it to the parent node cost
@@ -377,9 +398,7 @@ public:
 
 		if (IsDockingTile(n.GetTile())) {
 			/* Check docking tile for occupancy. */
-			uint count = 0;
-			HasVehicleOnPos(n.GetTile(), &count, &CountShipProc);
-			c += count * 3 * YAPF_TILE_LENGTH;
+			c += this->GetDockingTileShipCount(n.GetTile()) * 3 * YAPF_TILE_LENGTH;
 		}
 
 		/* Skipped tile cost for aqueducts. */
@@ -19,6 +19,30 @@
 constexpr int DIRECT_NEIGHBOR_COST = 100;
 constexpr int NODES_PER_REGION = 4;
 constexpr int MAX_NUMBER_OF_NODES = 65536;
+constexpr size_t MAX_CACHED_REGION_PATHS = 16384;
+
+/**
+ * Cache of found water region paths. The key consists of the maximum path length, the
+ * start patch and the origin patches of the search, and fully determines the result.
+ * Any change to the water regions throws away the whole cache, so a cached path is
+ * always identical to the path a fresh search would find.
+ */
+struct WaterRegionPathCache {
+	using Key = std::vector<int>;
+
+	std::map<Key, std::vector<WaterRegionPatchDesc>> paths; ///< The cached paths.
+	uint32_t change_counter = 0; ///< Water region change counter the cached paths are valid for.
+
+	/** Throw away all paths when the water regions changed since they were found. */
+	void Validate()
+	{
+		if (this->change_counter == GetWaterRegionChangeCounter()) return;
+		this->change_counter = GetWaterRegionChangeCounter();
+		this->paths.clear();
+	}
+};
+
+static WaterRegionPathCache _water_region_path_cache;
 
 /** Yapf Node Key that represents a single patch of interconnected water within a water region. */
 struct CYapfRegionPatchNodeKey {
@@ -111,6 +135,12 @@ public:
 		return std::find(m_origin_keys.begin(), m_origin_keys.end(), CYapfRegionPatchNodeKey{ water_region_patch }) != m_origin_keys.end();
 	}
 
+	/** Add the origins, in the order they were added, to the key of a cached path. */
+	void AppendOriginsToKey(WaterRegionPathCache::Key &key) const
+	{
+		for (const CYapfRegionPatchNodeKey &origin_key : m_origin_keys) key.push_back(origin_key.CalcHash());
+	}
+
 	void PfSetStartupNodes()
 	{
 		for (const CYapfRegionPatchNodeKey &origin_key : m_origin_keys) {
@@ -217,8 +247,20 @@ public:
 		path.reserve(max_returned_path_length);
 		if (pf.HasOrigin(start_water_region_patch)) return path;
 
+		/* Many ships travel between the same places, so first look whether we found this path before. */
+		_water_region_path_cache.Validate();
+		WaterRegionPathCache::Key key = { max_returned_path_length, CalculateWaterRegionPatchHash(start_water_region_patch) };
+		pf.AppendOriginsToKey(key);
+		auto it = _water_region_path_cache.paths.find(key);
+		if (it != _water_region_path_cache.paths.end()) return it->second;
+
+		if (_water_region_path_cache.paths.size() >= MAX_CACHED_REGION_PATHS) _water_region_path_cache.paths.clear();
+
 		/* Find best path. */
-		if (!pf.FindPath(v)) return {}; // Path not found.
+		if (!pf.FindPath(v)) {
+			_water_region_path_cache.paths.emplace(std::move(key), std::vector<WaterRegionPatchDesc>{});
+			return {}; // Path not found.
+		}
 
 		Node *node = pf.GetBestNode();
 		for (int i = 0; i < max_returned_path_length - 1; ++i) {
@@ -229,6 +271,7 @@ public:
 		}
 
 		assert(!path.empty());
+		_water_region_path_cache.paths.emplace(std::move(key), path);
 		return path;
 	}
 };
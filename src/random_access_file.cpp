@@ -15,6 +15,13 @@
 #include "fileio_func.h"
 #include "string_func.h"
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#	define WITH_MMAP
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
 #include "safeguards.h"
 
 /**
@@ -22,7 +29,7 @@
  * @param filename Name of the file at the disk.
  * @param subdir   The sub directory to search this file in.
  */
-RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory subdir) : filename(filename)
+RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory subdir) : filename(filename), mapping(nullptr), mapping_size(0)
 {
 	this->file_handle = FioFOpenFile(filename, "rb", subdir);
 	if (this->file_handle == nullptr) UserError("Cannot open file '{}'", filename);
@@ -37,6 +44,7 @@ RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory sub
 	this->simplified_filename = name_without_path.substr(0, name_without_path.rfind('.'));
 	strtolower(this->simplified_filename);
 
+	this->MapFile();
 	this->SeekTo(static_cast<size_t>(pos), SEEK_SET);
 }
 
@@ -45,9 +53,34 @@ RandomAccessFile::RandomAccessFile(const std::string &filename, Subdirectory sub
  */
 RandomAccessFile::~RandomAccessFile()
 {
+#ifdef WITH_MMAP
+	if (this->mapping != nullptr) munmap(this->mapping, this->mapping_size);
+#endif
 	fclose(this->file_handle);
 }
 
+/**
+ * Try to map the whole file into memory, so reading does not need a system call per buffer of data.
+ * When the file is in a tar-file, the whole tar-file is mapped; positions are in the tar-file anyway.
+ * If mapping fails, reading falls back to the local buffer.
+ */
+void RandomAccessFile::MapFile()
+{
+#ifdef WITH_MMAP
+	struct stat st;
+	if (fstat(fileno(this->file_handle), &st) != 0 || st.st_size <= 0) return;
+
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(this->file_handle), 0);
+	if (mapping == MAP_FAILED) {
+		Debug(misc, 3, "Mapping {} into memory failed, reading it via a buffer", this->filename);
+		return;
+	}
+
+	this->mapping = static_cast<uint8_t *>(mapping);
+	this->mapping_size = st.st_size;
+#endif
+}
+
 /**
  * Get the filename of the opened file with the path from the SubDirectory and the extension.
  * @return Name of the file.
@@ -85,6 +118,14 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 {
 	if (mode == SEEK_CUR) pos += this->GetPos();
 
+	if (this->mapping != nullptr) {
+		/* The buffer is the whole mapping; the end of the buffer is the end of the file. */
+		this->pos = this->mapping_size;
+		this->buffer = this->mapping + std::min(pos, this->mapping_size);
+		this->buffer_end = this->mapping + this->mapping_size;
+		return;
+	}
+
 	this->pos = pos;
 	if (fseek(this->file_handle, this->pos, SEEK_SET) < 0) {
 		Debug(misc, 0, "Seeking in {} failed", this->filename);
@@ -101,6 +142,8 @@ void RandomAccessFile::SeekTo(size_t pos, int mode)
 uint8_t RandomAccessFile::ReadByte()
 {
 	if (this->buffer == this->buffer_end) {
+		if (this->mapping != nullptr) return 0;
+
 		this->buffer = this->buffer_start;
 		size_t size = fread(this->buffer, 1, RandomAccessFile::BUFFER_SIZE, this->file_handle);
 		this->pos += size;
@@ -138,10 +181,50 @@ uint32_t RandomAccessFile::ReadDword()
  */
 void RandomAccessFile::ReadBlock(void *ptr, size_t size)
 {
+	if (this->mapping != nullptr) {
+		size = std::min<size_t>(size, this->buffer_end - this->buffer);
+		memcpy(ptr, this->buffer, size);
+		this->buffer += size;
+		return;
+	}
+
 	this->SeekTo(this->GetPos(), SEEK_SET);
 	this->pos += fread(ptr, 1, size, this->file_handle);
 }
 
+/**
+ * Read a block without copying it, when the data is already in memory.
+ * That is always the case when the file is mapped into memory, otherwise only when the block is in the local buffer.
+ * @param size Number of bytes to read.
+ * @return Pointer to the data, valid until the next seek or read, or \c nullptr if the block has to be read with #ReadBlock.
+ */
+const uint8_t *RandomAccessFile::ReadDirect(size_t size)
+{
+	assert(this->buffer_end >= this->buffer);
+	if (size > static_cast<size_t>(this->buffer_end - this->buffer)) return nullptr;
+
+	const uint8_t *data = this->buffer;
+	this->buffer += size;
+	return data;
+}
+
+/**
+ * Tell the system the next \a size bytes are going to be read, so it can read them ahead.
+ * This only has an effect when the file is mapped into memory and the block spans multiple pages.
+ * @param size Number of bytes that will be read.
+ */
+void RandomAccessFile::Prefetch([[maybe_unused]] size_t size)
+{
+#ifdef WITH_MMAP
+	static const size_t page_size = sysconf(_SC_PAGESIZE);
+	if (this->mapping == nullptr || size < 2 * page_size) return;
+
+	size = std::min<size_t>(size, this->buffer_end - this->buffer);
+	size_t offset = (this->buffer - this->mapping) & ~(page_size - 1);
+	madvise(this->mapping + offset, this->buffer + size - (this->mapping + offset), MADV_WILLNEED);
+#endif
+}
+
 /**
  * Skip \a n bytes ahead in the file.
  * @param n Number of bytes to skip reading.
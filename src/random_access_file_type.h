@@ -33,6 +33,11 @@ class RandomAccessFile {
 	uint8_t *buffer_end;                ///< Last valid byte of buffer.
 	uint8_t buffer_start[BUFFER_SIZE];  ///< Local buffer when read from file.
 
+	uint8_t *mapping;                   ///< The whole file mapped into memory, or \c nullptr when reading via the local buffer.
+	size_t mapping_size;                ///< Size of the memory mapping.
+
+	void MapFile();
+
 public:
 	RandomAccessFile(const std::string &filename, Subdirectory subdir);
 	RandomAccessFile(const RandomAccessFile&) = delete;
@@ -51,6 +56,8 @@ public:
 	uint32_t ReadDword();
 
 	void ReadBlock(void *ptr, size_t size);
+	const uint8_t *ReadDirect(size_t size);
+	void Prefetch(size_t size);
 	void SkipBytes(size_t n);
 };
 
@@ -40,6 +40,7 @@
 #include "company_gui.h"
 #include "road_func.h"
 #include "road_cmd.h"
+#include "water.h"
 #include "landscape_cmd.h"
 #include "rail_cmd.h"
 
@@ -480,6 +481,8 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 					if (rtt == RTT_ROAD) SetDisallowedRoadDirections(tile, DRD_NONE);
 					SetRoadBits(tile, present, rtt);
 					MarkTileDirtyByTile(tile);
+					/* The foundation might have changed, so the tile might be floodable now. */
+					ClearNeighbourNonFloodingStates(tile);
 				}
 			}
 
@@ -520,6 +523,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				}
 				MarkTileDirtyByTile(tile);
 				YapfNotifyTrackLayoutChange(tile, railtrack);
+				ClearNeighbourNonFloodingStates(tile);
 			}
 			return CommandCost(EXPENSES_CONSTRUCTION, RoadClearCost(existing_rt) * 2);
 		}
@@ -936,6 +940,8 @@ do_clear:;
 		}
 
 		MarkTileDirtyByTile(tile);
+		/* The foundation might have changed, so the tile might be floodable now. */
+		ClearNeighbourNonFloodingStates(tile);
 	}
 	return cost;
 }
@@ -2539,7 +2545,7 @@ CommandCost CmdConvertRoad(DoCommandFlag flags, TileIndex tile, TileIndex area_s
 				MarkTileDirtyByTile(tile);
 
 				/* update power of train on this tile */
-				FindVehicleOnPos(tile, &affected_rvs, &UpdateRoadVehPowerProc);
+				FindVehicleOnPos(tile, VEH_ROAD, &affected_rvs, &UpdateRoadVehPowerProc);
 
 				if (IsRoadDepotTile(tile)) {
 					/* Update build vehicle window related to this depot */
@@ -2589,8 +2595,8 @@ CommandCost CmdConvertRoad(DoCommandFlag flags, TileIndex tile, TileIndex area_s
 				SetRoadType(tile,    rtt, to_type);
 				SetRoadType(endtile, rtt, to_type);
 
-				FindVehicleOnPos(tile, &affected_rvs, &UpdateRoadVehPowerProc);
-				FindVehicleOnPos(endtile, &affected_rvs, &UpdateRoadVehPowerProc);
+				FindVehicleOnPos(tile, VEH_ROAD, &affected_rvs, &UpdateRoadVehPowerProc);
+				FindVehicleOnPos(endtile, VEH_ROAD, &affected_rvs, &UpdateRoadVehPowerProc);
 
 				if (IsBridge(tile)) {
 					MarkBridgeDirty(tile);
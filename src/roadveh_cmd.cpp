@@ -624,15 +624,17 @@ static Vehicle *EnumCheckRoadVehClose(Vehicle *v, void *data)
 	short x_diff = v->x_pos - rvf->x;
 	short y_diff = v->y_pos - rvf->y;
 
+	/* Most vehicles in the hash are rejected here, so test the cheap things first
+	 * and only then dereference the vehicle chains. */
 	if (v->type == VEH_ROAD &&
-			!v->IsInDepot() &&
-			abs(v->z_pos - rvf->veh->z_pos) < 6 &&
 			v->direction == rvf->dir &&
-			rvf->veh->First() != v->First() &&
 			(dist_x[v->direction] >= 0 || (x_diff > dist_x[v->direction] && x_diff <= 0)) &&
 			(dist_x[v->direction] <= 0 || (x_diff < dist_x[v->direction] && x_diff >= 0)) &&
 			(dist_y[v->direction] >= 0 || (y_diff > dist_y[v->direction] && y_diff <= 0)) &&
-			(dist_y[v->direction] <= 0 || (y_diff < dist_y[v->direction] && y_diff >= 0))) {
+			(dist_y[v->direction] <= 0 || (y_diff < dist_y[v->direction] && y_diff >= 0)) &&
+			abs(v->z_pos - rvf->veh->z_pos) < 6 &&
+			RoadVehicle::From(v)->state != RVSB_IN_DEPOT &&
+			rvf->veh->First() != v->First()) {
 		uint diff = abs(x_diff) + abs(y_diff);
 
 		if (diff < rvf->best_diff || (diff == rvf->best_diff && v->index < rvf->best->index)) {
@@ -793,7 +795,7 @@ static bool CheckRoadBlockedForOvertaking(OvertakeData *od)
 	if (!HasBit(trackdirbits, od->trackdir) || (trackbits & ~TRACK_BIT_CROSS) || (red_signals != TRACKDIR_BIT_NONE)) return true;
 
 	/* Are there more vehicles on the tile except the two vehicles involved in overtaking */
-	return HasVehicleOnPos(od->tile, od, EnumFindVehBlockingOvertake);
+	return HasVehicleOnPos(od->tile, VEH_ROAD, od, EnumFindVehBlockingOvertake);
 }
 
 static void RoadVehCheckOvertake(RoadVehicle *v, RoadVehicle *u)
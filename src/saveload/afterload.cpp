@@ -62,6 +62,7 @@
 #include "../timer/timer_game_calendar.h"
 #include "../timer/timer_game_economy.h"
 #include "../timer/timer_game_tick.h"
+#include "../thread_pool.h"
 
 #include "saveload_internal.h"
 
@@ -312,6 +313,39 @@ static void InitializeWindowsAndCaches()
 	BuildOwnerLegend();
 }
 
+/** Measures how long a pass of AfterLoadGame takes, and logs it at the "sl" debug level. */
+struct AfterLoadPassTimer {
+	const char *name; ///< Name of the pass.
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); ///< When the pass started.
+
+	AfterLoadPassTimer(const char *name) : name(name) {}
+
+	~AfterLoadPassTimer()
+	{
+		Debug(sl, 3, "AfterLoadGame: {} took {} us", this->name, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->start).count());
+	}
+};
+
+/**
+ * Rebuild the kd-trees of towns, stations and viewport signs. They only read
+ * the pools and each fill their own tree, so they are built concurrently.
+ */
+static void RebuildAllKdtrees()
+{
+	AfterLoadPassTimer timer("rebuilding kd-trees");
+
+	ThreadPool::ParallelFor(3, 1, [](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			switch (i) {
+				case 0: RebuildTownKdtree(); break;
+				case 1: RebuildStationKdtree(); break;
+				case 2: RebuildViewportKdtree(); break;
+				default: NOT_REACHED();
+			}
+		}
+	});
+}
+
 typedef void (CDECL *SignalHandlerPointer)(int);
 static SignalHandlerPointer _prev_segfault = nullptr;
 static SignalHandlerPointer _prev_abort    = nullptr;
@@ -563,6 +597,8 @@ static void StartScripts()
  */
 bool AfterLoadGame()
 {
+	AfterLoadPassTimer total_timer("all passes");
+
 	SetSignalHandlers();
 
 	extern TileIndex _cur_tileloop_tile; // From landscape.cpp.
@@ -574,11 +610,9 @@ bool AfterLoadGame()
 	_gamelog.TestRevision();
 	_gamelog.TestMode();
 
-	RebuildTownKdtree();
-	RebuildStationKdtree();
 	/* This needs to be done even before conversion, because some conversions will destroy objects
 	 * that otherwise won't exist in the tree. */
-	RebuildViewportKdtree();
+	RebuildAllKdtrees();
 
 	if (IsSavegameVersionBefore(SLV_98)) _gamelog.GRFAddList(_grfconfig);
 
@@ -2191,25 +2225,17 @@ bool AfterLoadGame()
 
 	if (IsSavegameVersionBefore(SLV_122)) {
 		/* Animated tiles would sometimes not be actually animated or
-		 * in case of old savegames duplicate. */
+		 * in case of old savegames duplicate. Compacting the list
+		 * the first time removes the duplicates. */
+		CompactAnimatedTiles();
 
 		extern std::vector<TileIndex> _animated_tiles;
 
-		for (auto tile = _animated_tiles.begin(); tile < _animated_tiles.end(); /* Nothing */) {
-			/* Remove if tile is not animated */
-			bool remove = _tile_type_procs[GetTileType(*tile)]->animate_tile_proc == nullptr;
-
-			/* and remove if duplicate */
-			for (auto j = _animated_tiles.begin(); !remove && j < tile; j++) {
-				remove = *tile == *j;
-			}
-
-			if (remove) {
-				tile = _animated_tiles.erase(tile);
-			} else {
-				tile++;
-			}
+		/* Remove if tile is not animated */
+		for (TileIndex tile : _animated_tiles) {
+			if (_tile_type_procs[GetTileType(tile)]->animate_tile_proc == nullptr) DeleteAnimatedTile(tile);
 		}
+		CompactAnimatedTiles();
 	}
 
 	if (IsSavegameVersionBefore(SLV_124) && !IsSavegameVersionBefore(SLV_1)) {
@@ -2708,6 +2734,14 @@ bool AfterLoadGame()
 			assert(v->tile != TileVirtXY(v->x_pos, v->y_pos) || v->z_pos == GetSlopePixelZ(v->x_pos, v->y_pos, true));
 		}
 
+		/* The inclination of the vehicles changed, so update the slope resistance of the consists. */
+		for (Train *t : Train::Iterate()) {
+			if (t->First() == t) t->UpdateSlopeResistance();
+		}
+		for (RoadVehicle *rv : RoadVehicle::Iterate()) {
+			if (rv->First() == rv) rv->UpdateSlopeResistance();
+		}
+
 		/* Fill Vehicle::cur_real_order_index */
 		for (Vehicle *v : Vehicle::Iterate()) {
 			if (!v->IsPrimaryVehicle()) continue;
@@ -3227,7 +3261,10 @@ bool AfterLoadGame()
 	}
 
 	/* Compute station catchment areas. This is needed here in case UpdateStationAcceptance is called below. */
-	Station::RecomputeCatchmentForAll();
+	{
+		AfterLoadPassTimer timer("recomputing catchment");
+		Station::RecomputeCatchmentForAll();
+	}
 
 	/* Station acceptance is some kind of cache */
 	if (IsSavegameVersionBefore(SLV_127)) {
@@ -3272,6 +3309,13 @@ bool AfterLoadGame()
 		ScriptObject::InitializeRandomizers();
 	}
 
+	if (IsSavegameVersionBefore(SLV_NON_FLOODING_WATER_TILES)) {
+		/* Let all water tiles check for flooding at least once. */
+		for (auto t : Map::Iterate()) {
+			if (IsTileType(t, MP_WATER)) SetNonFloodingWaterTile(t, false);
+		}
+	}
+
 	for (Company *c : Company::Iterate()) {
 		UpdateCompanyLiveries(c);
 	}
@@ -3288,18 +3332,30 @@ bool AfterLoadGame()
 	}
 
 	AfterLoadLabelMaps();
-	AfterLoadCompanyStats();
+	{
+		AfterLoadPassTimer timer("company statistics");
+		AfterLoadCompanyStats();
+	}
 	AfterLoadStoryBook();
 
 	_gamelog.PrintDebug(1);
 
-	InitializeWindowsAndCaches();
+	{
+		AfterLoadPassTimer timer("windows and caches");
+		InitializeWindowsAndCaches();
+	}
 	/* Restore the signals */
 	ResetSignalHandlers();
 
-	AfterLoadLinkGraphs();
+	{
+		AfterLoadPassTimer timer("link graphs");
+		AfterLoadLinkGraphs();
+	}
 
-	CheckGroundVehiclesAtCorrectZ();
+	{
+		AfterLoadPassTimer timer("vehicle heights");
+		CheckGroundVehiclesAtCorrectZ();
+	}
 
 	/* Start the scripts. This MUST happen after everything else except
 	 * starting a new company. */
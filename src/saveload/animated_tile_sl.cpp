@@ -13,13 +13,17 @@
 #include "compat/animated_tile_sl_compat.h"
 
 #include "../tile_type.h"
+#include "../animated_tile_func.h"
 
 #include "../safeguards.h"
 
 extern std::vector<TileIndex> _animated_tiles;
 
+/** The animated tiles as saved, without the tiles that have been deleted from the list but not removed yet. */
+static std::vector<TileIndex> _saved_animated_tiles;
+
 static const SaveLoad _animated_tile_desc[] = {
-	 SLEG_VECTOR("tiles", _animated_tiles, SLE_UINT32),
+	 SLEG_VECTOR("tiles", _saved_animated_tiles, SLE_UINT32),
 };
 
 struct ANITChunkHandler : ChunkHandler {
@@ -27,10 +31,15 @@ struct ANITChunkHandler : ChunkHandler {
 
 	void Save() const override
 	{
+		/* Deleted tiles must not come back to life when loading. The list itself is left
+		 * alone, as saving must not change the game state of e.g. a server. */
+		_saved_animated_tiles = GetAnimatedTiles();
+
 		SlTableHeader(_animated_tile_desc);
 
 		SlSetArrayIndex(0);
 		SlGlobList(_animated_tile_desc);
+		_saved_animated_tiles.clear();
 	}
 
 	void Load() const override
@@ -61,6 +70,8 @@ struct ANITChunkHandler : ChunkHandler {
 		if (SlIterateArray() == -1) return;
 		SlGlobList(slt);
 		if (SlIterateArray() != -1) SlErrorCorrupt("Too many ANIT entries");
+		_animated_tiles = std::move(_saved_animated_tiles);
+		_saved_animated_tiles.clear();
 	}
 };
 
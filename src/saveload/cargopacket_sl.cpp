@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 
 #include "saveload.h"
+#include "saveload_internal.h"
 #include "compat/cargopacket_sl_compat.h"
 
 #include "../vehicle_base.h"
@@ -144,7 +145,7 @@ struct CAPAChunkHandler : ChunkHandler {
 		SlTableHeader(GetCargoPacketDesc());
 
 		for (CargoPacket *cp : CargoPacket::Iterate()) {
-			SlSetArrayIndex(cp->index);
+			SlSetArrayIndex(GetCargoPacketSaveIndex(cp->index));
 			SlObject(cp, GetCargoPacketDesc());
 		}
 	}
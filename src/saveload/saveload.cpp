@@ -42,7 +42,12 @@
 #include "../string_func.h"
 #include "../fios.h"
 #include "../error.h"
+#include "../trace.h"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <optional>
 #ifdef __EMSCRIPTEN__
 #	include <emscripten.h>
 #endif
@@ -113,6 +118,31 @@ struct ReadBuffer {
 		return *this->bufp++;
 	}
 
+	/**
+	 * Read a block of bytes, copying whole parts of the buffer at once.
+	 * @param ptr Destination of the bytes.
+	 * @param length Number of bytes to read.
+	 */
+	void CopyBytes(uint8_t *ptr, size_t length)
+	{
+		while (length != 0) {
+			if (this->bufp == this->bufe) {
+				size_t len = this->reader->Read(this->buf, lengthof(this->buf));
+				if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
+
+				this->read += len;
+				this->bufp = this->buf;
+				this->bufe = this->buf + len;
+			}
+
+			size_t to_copy = std::min<size_t>(length, this->bufe - this->bufp);
+			memcpy(ptr, this->bufp, to_copy);
+			this->bufp += to_copy;
+			ptr += to_copy;
+			length -= to_copy;
+		}
+	}
+
 	/**
 	 * Get the size of the memory dump made so far.
 	 * @return The size.
@@ -145,6 +175,27 @@ struct MemoryDumper {
 		*this->buf++ = b;
 	}
 
+	/**
+	 * Write a block of bytes into the dumper, copying whole parts of it at once.
+	 * @param ptr The bytes to write.
+	 * @param length Number of bytes to write.
+	 */
+	void CopyBytes(const uint8_t *ptr, size_t length)
+	{
+		while (length != 0) {
+			if (this->buf == this->bufe) {
+				this->buf = this->blocks.emplace_back(std::make_unique<uint8_t[]>(MEMORY_CHUNK_SIZE)).get();
+				this->bufe = this->buf + MEMORY_CHUNK_SIZE;
+			}
+
+			size_t to_copy = std::min<size_t>(length, this->bufe - this->buf);
+			memcpy(this->buf, ptr, to_copy);
+			this->buf += to_copy;
+			ptr += to_copy;
+			length -= to_copy;
+		}
+	}
+
 	/**
 	 * Flush this dumper into a writer.
 	 * @param writer The filter we want to use.
@@ -199,6 +250,37 @@ struct SaveLoadParams {
 
 static SaveLoadParams _sl; ///< Parameters used for/at saveload.
 
+/**
+ * Index each cargo packet gets in the savegame that is being written.
+ * Cargo packets come and go all the time, so after a while their pool is
+ * full of holes. Nothing in the game depends on the index of a cargo packet,
+ * so they are renumbered densely (in their current order) when saving, and
+ * a loaded game starts with a compact pool.
+ */
+static std::vector<CargoPacketID> _cargo_packet_save_index;
+
+/** Assign the dense indices to the cargo packets for saving. */
+static void BuildCargoPacketSaveIndex()
+{
+	_cargo_packet_save_index.assign(CargoPacket::GetPoolSize(), 0);
+
+	CargoPacketID save_index = 0;
+	for (const CargoPacket *cp : CargoPacket::Iterate()) {
+		_cargo_packet_save_index[cp->index] = save_index++;
+	}
+}
+
+/**
+ * Get the index a cargo packet gets in the savegame that is being written.
+ * @param index The index of the cargo packet in its pool.
+ * @return The index of the cargo packet in the savegame.
+ */
+size_t GetCargoPacketSaveIndex(size_t index)
+{
+	assert(_sl.action == SLA_SAVE);
+	return _cargo_packet_save_index[index];
+}
+
 static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 {
 	/* These define the chunks */
@@ -310,6 +392,15 @@ static void SlNullPointers()
 	assert(_sl.action == SLA_NULL);
 }
 
+/** Whether this thread is the one reading ahead for a #ReadAheadLoadFilter. */
+static thread_local bool _sl_read_ahead_thread = false;
+
+/** Error raised by #SlError on the read ahead thread, to be raised again by the loading thread. */
+struct SlReadAheadError {
+	StringID string;       ///< Error message.
+	std::string extra_msg; ///< Extra information about the error.
+};
+
 /**
  * Error handler. Sets everything up to show an error message and to clean
  * up the mess of a partial savegame load.
@@ -320,6 +411,9 @@ static void SlNullPointers()
  */
 [[noreturn]] void SlError(StringID string, const std::string &extra_msg)
 {
+	/* The read ahead thread must not touch the game state; the loading thread reports the error for it. */
+	if (_sl_read_ahead_thread) throw SlReadAheadError{string, extra_msg};
+
 	/* Distinguish between loading into _load_check_data vs. normal save/load. */
 	if (_sl.action == SLA_LOAD_CHECK) {
 		_load_check_data.error = string;
@@ -768,10 +862,10 @@ static void SlCopyBytes(void *ptr, size_t length)
 	switch (_sl.action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD:
-			for (; length != 0; length--) *p++ = SlReadByte();
+			_sl.reader->CopyBytes(p, length);
 			break;
 		case SLA_SAVE:
-			for (; length != 0; length--) SlWriteByte(*p++);
+			_sl.dumper->CopyBytes(p, length);
 			break;
 		default: NOT_REACHED();
 	}
@@ -1116,7 +1210,7 @@ static size_t ReferenceToInt(const void *obj, SLRefType rt)
 		case REF_ORDER:     return ((const    Order*)obj)->index + 1;
 		case REF_ROADSTOPS: return ((const RoadStop*)obj)->index + 1;
 		case REF_ENGINE_RENEWS:  return ((const       EngineRenew*)obj)->index + 1;
-		case REF_CARGO_PACKET:   return ((const       CargoPacket*)obj)->index + 1;
+		case REF_CARGO_PACKET:   return GetCargoPacketSaveIndex(((const CargoPacket*)obj)->index) + 1;
 		case REF_ORDERLIST:      return ((const         OrderList*)obj)->index + 1;
 		case REF_STORAGE:        return ((const PersistentStorage*)obj)->index + 1;
 		case REF_LINK_GRAPH:     return ((const         LinkGraph*)obj)->index + 1;
@@ -2111,15 +2205,53 @@ static void SlSaveChunk(const ChunkHandler &ch)
 	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
+/** Uncompressed size and time of a chunk that was saved or loaded. */
+struct ChunkStatistics {
+	uint32_t id;                               ///< Identifier of the chunk.
+	size_t bytes;                              ///< Uncompressed bytes of the chunk in the savegame.
+	std::chrono::steady_clock::duration time;  ///< Time spent saving or loading the chunk.
+};
+
+/**
+ * Print the chunks from largest to smallest, so it is easy to see what makes a savegame big or slow.
+ * @param action What was done with the chunks, for the message.
+ * @param stats The statistics of all chunks.
+ */
+static void ReportChunkStatistics(std::string_view action, std::vector<ChunkStatistics> &stats)
+{
+	std::sort(stats.begin(), stats.end(), [](const ChunkStatistics &a, const ChunkStatistics &b) { return a.bytes > b.bytes; });
+
+	size_t total = 0;
+	for (const ChunkStatistics &cs : stats) total += cs.bytes;
+	Debug(sl, 1, "{} {} chunks, {} bytes uncompressed", action, stats.size(), total);
+	for (const ChunkStatistics &cs : stats) {
+		Debug(sl, 1, "  {:c}{:c}{:c}{:c}: {:>10} bytes ({:5.1f}%) in {:8.2f} ms", cs.id >> 24, cs.id >> 16, cs.id >> 8, cs.id,
+			cs.bytes, total == 0 ? 0.0 : 100.0 * cs.bytes / total,
+			std::chrono::duration<double, std::milli>(cs.time).count());
+	}
+}
+
 /** Save all chunks */
 static void SlSaveChunks()
 {
-	for (auto &ch : ChunkHandlers()) {
+	std::vector<ChunkStatistics> stats;
+
+	for (const ChunkHandler &ch : ChunkHandlers()) {
+		if (_debug_sl_level < 1) {
+			SlSaveChunk(ch);
+			continue;
+		}
+
+		size_t start_pos = _sl.dumper->GetSize();
+		auto start_time = std::chrono::steady_clock::now();
 		SlSaveChunk(ch);
+		if (ch.type != CH_READONLY) stats.push_back({ch.id, _sl.dumper->GetSize() - start_pos, std::chrono::steady_clock::now() - start_time});
 	}
 
 	/* Terminator */
 	SlWriteUint32(0);
+
+	if (_debug_sl_level >= 1) ReportChunkStatistics("Saved", stats);
 }
 
 /**
@@ -2139,14 +2271,26 @@ static void SlLoadChunks()
 {
 	uint32_t id;
 	const ChunkHandler *ch;
+	std::vector<ChunkStatistics> stats;
 
 	for (id = SlReadUint32(); id != 0; id = SlReadUint32()) {
 		Debug(sl, 2, "Loading chunk {:c}{:c}{:c}{:c}", id >> 24, id >> 16, id >> 8, id);
 
 		ch = SlFindChunkHandler(id);
 		if (ch == nullptr) SlErrorCorrupt("Unknown chunk type");
+
+		if (_debug_sl_level < 1) {
+			SlLoadChunk(*ch);
+			continue;
+		}
+
+		size_t start_pos = _sl.reader->GetSize();
+		auto start_time = std::chrono::steady_clock::now();
 		SlLoadChunk(*ch);
+		stats.push_back({id, _sl.reader->GetSize() - start_pos, std::chrono::steady_clock::now() - start_time});
 	}
+
+	if (_debug_sl_level >= 1) ReportChunkStatistics("Loaded", stats);
 }
 
 /** Load all chunks for savegame checking */
@@ -2519,6 +2663,9 @@ struct ZlibSaveFilter : SaveFilter {
  */
 static const lzma_stream _lzma_init = LZMA_STREAM_INIT;
 
+/** Maximum number of threads to compress a savegame with; every thread needs a few blocks worth of buffers. */
+static const uint MAX_LZMA_SAVE_THREADS = 8;
+
 /** Filter without any compression. */
 struct LZMALoadFilter : LoadFilter {
 	lzma_stream lzma;                  ///< Stream state that we are reading from.
@@ -2574,6 +2721,18 @@ struct LZMASaveFilter : SaveFilter {
 	 */
 	LZMASaveFilter(std::shared_ptr<SaveFilter> chain, uint8_t compression_level) : SaveFilter(chain), lzma(_lzma_init)
 	{
+#if LZMA_VERSION >= 50020002
+		/* Compress independent blocks with multiple threads. The result is a normal
+		 * multi-block xz stream, which the (single threaded) loader reads just fine. */
+		uint threads = std::min<uint>(lzma_cputhreads(), MAX_LZMA_SAVE_THREADS);
+		if (threads > 1) {
+			lzma_mt mt{};
+			mt.threads = threads;
+			mt.preset = compression_level;
+			mt.check = LZMA_CHECK_CRC32;
+			if (lzma_stream_encoder_mt(&this->lzma, &mt) == LZMA_OK) return;
+		}
+#endif /* LZMA_VERSION >= 50020002 */
 		if (lzma_easy_encoder(&this->lzma, compression_level, LZMA_CHECK_CRC32) != LZMA_OK) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
 	}
 
@@ -2623,6 +2782,167 @@ struct LZMASaveFilter : SaveFilter {
 
 #endif /* WITH_LIBLZMA */
 
+/********************************************
+ ********** START OF READ AHEAD CODE ********
+ ********************************************/
+
+/** Number of blocks the read ahead filter decompresses in advance. */
+static const uint READ_AHEAD_BLOCKS = 4;
+
+/**
+ * Filter that runs the rest of the chain, which does the decompression, on
+ * its own thread. That way decompressing the next blocks of the savegame
+ * overlaps with parsing the chunks of the current one.
+ */
+struct ReadAheadLoadFilter : LoadFilter {
+	/** Block of data read by the chain. */
+	struct Block {
+		std::unique_ptr<uint8_t[]> data; ///< The data.
+		size_t size = 0;                 ///< Number of valid bytes in the data.
+	};
+
+	std::mutex lock;                                   ///< Lock for the administration below.
+	std::condition_variable changed;                   ///< Signalled when blocks are filled or freed.
+	std::deque<Block> filled;                          ///< Blocks read by the thread, in order.
+	std::vector<std::unique_ptr<uint8_t[]>> unused;    ///< Blocks the thread can read into.
+	std::optional<SlReadAheadError> error;             ///< Error the chain ran into, if any.
+	bool finished = false;                             ///< Whether the thread reached the end of the chain.
+	bool exit = false;                                 ///< Whether the thread has to stop.
+	std::thread thread;                                ///< The thread reading ahead.
+	bool threaded = false;                             ///< Whether the thread got started; if not the chain is read directly.
+
+	Block current;                                     ///< Block we are reading from.
+	size_t pos = 0;                                    ///< Position in the current block.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	ReadAheadLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(chain)
+	{
+		this->Start();
+	}
+
+	/** Stop the thread. */
+	~ReadAheadLoadFilter()
+	{
+		this->Stop();
+	}
+
+	/** Start reading ahead. */
+	void Start()
+	{
+		for (uint i = 0; i < READ_AHEAD_BLOCKS; i++) this->unused.push_back(std::make_unique<uint8_t[]>(MEMORY_CHUNK_SIZE));
+		this->threaded = StartNewThread(&this->thread, "ottd:loadahead", [this]() { this->Run(); });
+	}
+
+	/** Stop reading ahead and throw away everything that has been read. */
+	void Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->lock);
+			this->exit = true;
+		}
+		this->changed.notify_all();
+		if (this->thread.joinable()) this->thread.join();
+
+		this->filled.clear();
+		this->unused.clear();
+		this->error.reset();
+		this->finished = false;
+		this->exit = false;
+		this->current = {};
+		this->pos = 0;
+	}
+
+	/** Main loop of the thread reading ahead. */
+	void Run()
+	{
+		_sl_read_ahead_thread = true;
+
+		for (;;) {
+			Block block;
+			{
+				std::unique_lock<std::mutex> lock(this->lock);
+				this->changed.wait(lock, [this]() { return this->exit || !this->unused.empty(); });
+				if (this->exit) return;
+
+				block.data = std::move(this->unused.back());
+				this->unused.pop_back();
+			}
+
+			std::optional<SlReadAheadError> error;
+			try {
+				block.size = this->chain->Read(block.data.get(), MEMORY_CHUNK_SIZE);
+			} catch (SlReadAheadError &e) {
+				error = std::move(e);
+			} catch (...) {
+				error = SlReadAheadError{STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "reading ahead failed"};
+			}
+
+			bool done = error.has_value() || block.size == 0;
+			{
+				std::lock_guard<std::mutex> lock(this->lock);
+				if (done) {
+					this->error = std::move(error);
+					this->finished = true;
+				} else {
+					this->filled.push_back(std::move(block));
+				}
+			}
+			this->changed.notify_all();
+			if (done) return;
+		}
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		if (!this->threaded) return this->chain->Read(buf, size);
+
+		size_t done = 0;
+		while (done < size) {
+			if (this->pos == this->current.size) {
+				std::unique_lock<std::mutex> lock(this->lock);
+				if (this->current.data != nullptr) {
+					this->unused.push_back(std::move(this->current.data));
+					this->current = {};
+					this->pos = 0;
+					this->changed.notify_all();
+				}
+
+				this->changed.wait(lock, [this]() { return !this->filled.empty() || this->finished; });
+				if (this->filled.empty()) {
+					/* Only report errors once all data that was read before it has been handled. */
+					if (this->error.has_value()) {
+						SlReadAheadError error = *this->error;
+						lock.unlock();
+						SlError(error.string, error.extra_msg);
+					}
+					break;
+				}
+
+				this->current = std::move(this->filled.front());
+				this->filled.pop_front();
+				this->pos = 0;
+			}
+
+			size_t to_copy = std::min(size - done, this->current.size - this->pos);
+			memcpy(buf + done, this->current.data.get() + this->pos, to_copy);
+			this->pos += to_copy;
+			done += to_copy;
+		}
+
+		return done;
+	}
+
+	void Reset() override
+	{
+		this->Stop();
+		this->chain->Reset();
+		this->Start();
+	}
+};
+
 /*******************************************
  ************* END OF CODE *****************
  *******************************************/
@@ -2869,7 +3189,9 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
 	_sl_version = SAVEGAME_VERSION;
 
 	SaveViewportBeforeSaveGame();
+	BuildCargoPacketSaveIndex();
 	SlSaveChunks();
+	_cargo_packet_save_index.clear();
 
 	SaveFileStart();
 
@@ -2974,6 +3296,7 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 	}
 
 	_sl.lf = fmt->init_load(_sl.lf);
+	if (fmt->tag != SAVEGAME_TAG_NONE) _sl.lf = std::make_shared<ReadAheadLoadFilter>(_sl.lf);
 	_sl.reader = std::make_unique<ReadBuffer>(_sl.lf);
 	_next_offs = 0;
 
@@ -3073,6 +3396,8 @@ SaveOrLoadResult LoadWithFilter(std::shared_ptr<LoadFilter> reader)
  */
 SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop, DetailedFileType dft, Subdirectory sb, bool threaded)
 {
+	TraceZone trace(fop == SLO_SAVE ? "Save" : "Load");
+
 	/* An instance of saving is already active, so don't go saving again */
 	if (_sl.saveinprogress && fop == SLO_SAVE && dft == DFT_GAME_FILE && threaded) {
 		/* if not an autosave, but a user action, show error message */
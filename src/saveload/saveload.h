@@ -383,6 +383,9 @@ enum SaveLoadVersion : uint16_t {
 	SLV_GROUP_NUMBERS,                      ///< 336  PR#12297 Add per-company group numbers.
 	SLV_INCREASE_STATION_TYPE_FIELD_SIZE,   ///< 337  PR#12572 Increase size of StationType field in map array
 	SLV_ROAD_WAYPOINTS,                     ///< 338  PR#12572 Road waypoints
+	SLV_STATION_CARGO_MERGE_TOLERANCE,      ///< 339  Tolerance for merging cargo packets waiting at stations.
+	SLV_SCRIPT_LONG_STRINGS,                ///< 340  Script save data can contain strings of any length.
+	SLV_NON_FLOODING_WATER_TILES,           ///< 341  Water tiles that have nothing left to flood are marked in the map.
 
 	SL_MAX_VERSION,                         ///< Highest possible saveload version
 };
@@ -47,6 +47,8 @@ void ResetTempEngineData();
 Engine *GetTempDataEngine(EngineID index);
 void CopyTempEngineData();
 
+size_t GetCargoPacketSaveIndex(size_t index);
+
 extern int32_t _saved_scrollpos_x;
 extern int32_t _saved_scrollpos_y;
 extern ZoomLevel _saved_scrollpos_zoom;
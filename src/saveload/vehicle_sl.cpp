@@ -575,6 +575,7 @@ void FixupTrainLengths()
 					int r = CountVehiclesInChain(u) - 1; // number of vehicles - 1
 					int l = 0;
 					do ReverseTrainSwapVeh(u, l++, r--); while (l <= r);
+					u->UpdateSlopeResistance();
 
 					/* We moved the first vehicle which is now the last. Move it back to the
 					 * original position as we will fix up the last vehicle later in the loop. */
@@ -592,6 +593,7 @@ void FixupTrainLengths()
 					r = CountVehiclesInChain(u) - 1; // number of vehicles - 1
 					l = 0;
 					do ReverseTrainSwapVeh(u, l++, r--); while (l <= r);
+					u->UpdateSlopeResistance();
 
 					u->force_proceed = old_tfp;
 
@@ -73,6 +73,20 @@ struct ScreenshotFormat {
 
 #define MKCOLOUR(x)         TO_LE32(x)
 
+/**
+ * Get the number of lines to let the callback generate in one go.
+ * Every call renders the tiles and sprites around the edges of its lines again,
+ * so especially for the world screenshots fewer calls with more lines are a lot
+ * quicker. Try to use up to 16 MiB of memory, and store between 16 and 128 lines.
+ * @param w Width of the image in pixels.
+ * @param bytes_per_pixel Number of bytes per pixel in the buffer of the callback.
+ * @return Number of lines per call.
+ */
+static uint GetScreenshotLinesPerCall(uint w, uint bytes_per_pixel)
+{
+	return static_cast<uint>(Clamp<size_t>((16 << 20) / (static_cast<size_t>(w) * bytes_per_pixel), 16, 128));
+}
+
 /*************************************************
  **** SCREENSHOT CODE FOR WINDOWS BITMAP (.BMP)
  *************************************************/
@@ -176,10 +190,9 @@ static bool MakeBMPImage(const char *name, ScreenshotCallback *callb, void *user
 		}
 	}
 
-	/* Try to use 64k of memory, store between 16 and 128 lines */
-	uint maxlines = Clamp(65536 / (w * pixelformat / 8), 16, 128); // number of lines per iteration
+	uint maxlines = GetScreenshotLinesPerCall(w, pixelformat / 8); // number of lines per iteration
 
-	uint8_t *buff = MallocT<uint8_t>(maxlines * w * pixelformat / 8); // buffer which is rendered to
+	uint8_t *buff = MallocT<uint8_t>(static_cast<size_t>(maxlines) * w * pixelformat / 8); // buffer which is rendered to
 	uint8_t *line = CallocT<uint8_t>(bytewidth); // one line, stored to file
 
 	/* Start at the bottom, since bitmaps are stored bottom up */
@@ -368,8 +381,7 @@ static bool MakePNGImage(const char *name, ScreenshotCallback *callb, void *user
 		}
 	}
 
-	/* use by default 64k temp memory */
-	maxlines = Clamp(65536 / w, 16, 128);
+	maxlines = GetScreenshotLinesPerCall(w, bpp);
 
 	/* now generate the bitmap bits */
 	void *buff = CallocT<uint8_t>(static_cast<size_t>(w) * maxlines * bpp); // by default generate 128 lines at a time.
@@ -475,8 +487,7 @@ static bool MakePCXImage(const char *name, ScreenshotCallback *callb, void *user
 		return false;
 	}
 
-	/* use by default 64k temp memory */
-	maxlines = Clamp(65536 / w, 16, 128);
+	maxlines = GetScreenshotLinesPerCall(w, 1);
 
 	/* now generate the bitmap bits */
 	uint8_t *buff = CallocT<uint8_t>(static_cast<size_t>(w) * maxlines); // by default generate 128 lines at a time.
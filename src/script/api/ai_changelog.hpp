@@ -17,6 +17,20 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li AITileList::KeepBuildable
+ * \li AITileList::KeepSlope
+ * \li AITileList::KeepOwner
+ * \li AITileList::KeepHeightRange
+ * \li AITileList::KeepDistanceManhattan
+ * \li AIEventController::SetEventTypeEnabled
+ * \li AIEventController::SetAllEventTypesEnabled
+ * \li AIEventController::IsEventTypeEnabled
+ *
+ * Other changes:
+ * \li ET_VEHICLE_LOST and ET_STATION_FIRST_VEHICLE events are not queued again while the same event is still waiting
+ * \li Strings in the data returned by Save can be longer than 254 characters and can contain any byte.
+ *
  * \b 14.0
  *
  * API additions:
@@ -17,6 +17,20 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li GSTileList::KeepBuildable
+ * \li GSTileList::KeepSlope
+ * \li GSTileList::KeepOwner
+ * \li GSTileList::KeepHeightRange
+ * \li GSTileList::KeepDistanceManhattan
+ * \li GSEventController::SetEventTypeEnabled
+ * \li GSEventController::SetAllEventTypesEnabled
+ * \li GSEventController::IsEventTypeEnabled
+ *
+ * Other changes:
+ * \li ET_VEHICLE_LOST and ET_STATION_FIRST_VEHICLE events are not queued again while the same event is still waiting
+ * \li Strings in the data returned by Save can be longer than 254 characters and can contain any byte.
+ *
  * \b 14.0
  *
  * API additions:
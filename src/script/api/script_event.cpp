@@ -10,15 +10,64 @@
 #include "../../stdafx.h"
 #include "script_event_types.hpp"
 
-#include <queue>
+#include <bitset>
+#include <deque>
 
 #include "../../safeguards.h"
 
+/** The largest number of event types that can be filtered. */
+static const uint MAX_EVENT_TYPES = 64;
+static_assert(ScriptEvent::ET_STORYPAGE_VEHICLE_SELECT < MAX_EVENT_TYPES);
+
 /** The queue of events for a script. */
 struct ScriptEventData {
-	std::queue<ScriptEvent *> stack; ///< The actual queue.
+	std::deque<ScriptEvent *> stack; ///< The actual queue.
+	std::bitset<MAX_EVENT_TYPES> disabled; ///< The event types that are not queued.
 };
 
+/**
+ * Check whether an event is of a type that #IsDuplicateEvent checks, so the queue has to be searched for it.
+ * @param event The event to queue.
+ * @return True iff there might be a duplicate of \a event in the queue.
+ */
+static bool CanHaveDuplicateEvent(ScriptEvent *event)
+{
+	switch (event->GetEventType()) {
+		case ScriptEvent::ET_VEHICLE_LOST:
+		case ScriptEvent::ET_STATION_FIRST_VEHICLE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Check whether two events tell the script the same thing, so the later one can be dropped.
+ * Only the bursty events that are fired again for the same subject are checked, see #CanHaveDuplicateEvent.
+ * @param a The event already in the queue.
+ * @param b The event to queue.
+ * @return True iff \a b carries no information that \a a does not.
+ */
+static bool IsDuplicateEvent(ScriptEvent *a, ScriptEvent *b)
+{
+	if (a->GetEventType() != b->GetEventType()) return false;
+
+	switch (a->GetEventType()) {
+		case ScriptEvent::ET_VEHICLE_LOST:
+			return static_cast<ScriptEventVehicleLost *>(a)->GetVehicleID() == static_cast<ScriptEventVehicleLost *>(b)->GetVehicleID();
+
+		case ScriptEvent::ET_STATION_FIRST_VEHICLE: {
+			ScriptEventStationFirstVehicle *sa = static_cast<ScriptEventStationFirstVehicle *>(a);
+			ScriptEventStationFirstVehicle *sb = static_cast<ScriptEventStationFirstVehicle *>(b);
+			return sa->GetStationID() == sb->GetStationID() && sa->GetVehicleID() == sb->GetVehicleID();
+		}
+
+		default:
+			return false;
+	}
+}
+
 /* static */ void ScriptEventController::CreateEventPointer()
 {
 	assert(ScriptObject::GetEventPointer() == nullptr);
@@ -33,7 +82,7 @@ struct ScriptEventData {
 	/* Free all waiting events (if any) */
 	while (!data->stack.empty()) {
 		ScriptEvent *e = data->stack.front();
-		data->stack.pop();
+		data->stack.pop_front();
 		e->Release();
 	}
 
@@ -57,16 +106,55 @@ struct ScriptEventData {
 	if (data->stack.empty()) return nullptr;
 
 	ScriptEvent *e = data->stack.front();
-	data->stack.pop();
+	data->stack.pop_front();
 	return e;
 }
 
+/* static */ void ScriptEventController::SetEventTypeEnabled(ScriptEvent::ScriptEventType type, bool enabled)
+{
+	if (static_cast<uint>(type) >= MAX_EVENT_TYPES) return;
+
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+
+	data->disabled.set(type, !enabled);
+}
+
+/* static */ void ScriptEventController::SetAllEventTypesEnabled(bool enabled)
+{
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+
+	if (enabled) {
+		data->disabled.reset();
+	} else {
+		data->disabled.set();
+	}
+}
+
+/* static */ bool ScriptEventController::IsEventTypeEnabled(ScriptEvent::ScriptEventType type)
+{
+	if (static_cast<uint>(type) >= MAX_EVENT_TYPES) return false;
+
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+
+	return !data->disabled.test(type);
+}
+
 /* static */ void ScriptEventController::InsertEvent(ScriptEvent *event)
 {
 	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
 	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
 
+	if (data->disabled.test(event->GetEventType())) return;
+	if (CanHaveDuplicateEvent(event)) {
+		for (ScriptEvent *queued : data->stack) {
+			if (IsDuplicateEvent(queued, event)) return;
+		}
+	}
+
 	event->AddRef();
-	data->stack.push(event);
+	data->stack.push_back(event);
 }
 
@@ -100,9 +100,40 @@ public:
 	 */
 	static ScriptEvent *GetNextEvent();
 
+	/**
+	 * Enable or disable receiving events of a type. Events of a disabled type
+	 *  are never queued, so they do not need to be fetched just to be ignored.
+	 *  By default all event types are enabled.
+	 * @param type The type of event to enable or disable.
+	 * @param enabled True to receive events of this type, false to ignore them.
+	 * @note Events already waiting in the queue are not affected.
+	 * @note Which event types are enabled is not saved, so after loading a game the script has to set this again.
+	 */
+	static void SetEventTypeEnabled(ScriptEvent::ScriptEventType type, bool enabled);
+
+	/**
+	 * Enable or disable receiving events of all types. Disabling all types
+	 *  and then enabling the few that are handled is the easiest way to
+	 *  receive only those events.
+	 * @param enabled True to receive all events, false to ignore all events.
+	 * @note Events already waiting in the queue are not affected.
+	 * @note Which event types are enabled is not saved, so after loading a game the script has to set this again.
+	 */
+	static void SetAllEventTypesEnabled(bool enabled);
+
+	/**
+	 * Check whether events of a type are received.
+	 * @param type The type of event to check.
+	 * @return True if events of this type are queued.
+	 */
+	static bool IsEventTypeEnabled(ScriptEvent::ScriptEventType type);
+
 	/**
 	 * Insert an event to the queue for the company.
 	 * @param event The event to insert.
+	 * @note Events of a disabled type are dropped, as are events about a
+	 *  vehicle getting lost or arriving first at a station while the same
+	 *  event is still waiting in the queue.
 	 * @api -all
 	 */
 	static void InsertEvent(ScriptEvent *event);
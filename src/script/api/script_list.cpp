@@ -585,44 +585,74 @@ void ScriptList::SwapList(ScriptList *list)
 	list->sorter->Retarget(list);
 }
 
+/**
+ * Remove all items with a value in a range of buckets.
+ * @param begin The first bucket to remove.
+ * @param end The bucket after the last one to remove.
+ */
+void ScriptList::RemoveBuckets(ScriptListBucket::iterator begin, ScriptListBucket::iterator end)
+{
+	if (!this->sorter->IsEnd()) {
+		/* The sorter is iterating, so it has to be told about every removed item. */
+		std::vector<SQInteger> removed;
+		for (ScriptListBucket::iterator iter = begin; iter != end; iter++) {
+			removed.insert(removed.end(), iter->second.begin(), iter->second.end());
+		}
+		for (SQInteger item : removed) this->RemoveItem(item);
+		return;
+	}
+
+	/* Otherwise whole buckets can be dropped at once. */
+	for (ScriptListBucket::iterator iter = begin; iter != end; iter++) {
+		for (SQInteger item : iter->second) this->items.erase(item);
+	}
+	this->buckets.erase(begin, end);
+}
+
+/**
+ * Recreate the buckets from the values of the items, after the values
+ * have been changed without updating the buckets.
+ */
+void ScriptList::RebuildBuckets()
+{
+	this->buckets.clear();
+	for (const auto &[item, value] : this->items) {
+		/* Items come in ascending order, so they can be appended to their bucket. */
+		ScriptItemList &bucket = this->buckets[value];
+		bucket.insert(bucket.end(), item);
+	}
+	/* Any iteration has lost its place now. */
+	this->sorter->End();
+}
+
 void ScriptList::RemoveAboveValue(SQInteger value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveBuckets(this->buckets.upper_bound(value), this->buckets.end());
 }
 
 void ScriptList::RemoveBelowValue(SQInteger value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second < value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveBuckets(this->buckets.begin(), this->buckets.lower_bound(value));
 }
 
 void ScriptList::RemoveBetweenValue(SQInteger start, SQInteger end)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > start && (*iter).second < end) this->RemoveItem((*iter).first);
-	}
+	if (end <= start) return;
+	this->RemoveBuckets(this->buckets.upper_bound(start), this->buckets.lower_bound(end));
 }
 
 void ScriptList::RemoveValue(SQInteger value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second == value) this->RemoveItem((*iter).first);
-	}
+	ScriptListBucket::iterator iter = this->buckets.find(value);
+	if (iter != this->buckets.end()) this->RemoveBuckets(iter, std::next(iter));
 }
 
 void ScriptList::RemoveTop(SQInteger count)
@@ -717,40 +747,30 @@ void ScriptList::KeepAboveValue(SQInteger value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveBuckets(this->buckets.begin(), this->buckets.upper_bound(value));
 }
 
 void ScriptList::KeepBelowValue(SQInteger value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second >= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveBuckets(this->buckets.lower_bound(value), this->buckets.end());
 }
 
 void ScriptList::KeepBetweenValue(SQInteger start, SQInteger end)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= start || (*iter).second >= end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveBuckets(this->buckets.lower_bound(end), this->buckets.end());
+	this->RemoveBuckets(this->buckets.begin(), this->buckets.upper_bound(start));
 }
 
 void ScriptList::KeepValue(SQInteger value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second != value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveBuckets(this->buckets.begin(), this->buckets.lower_bound(value));
+	this->RemoveBuckets(this->buckets.upper_bound(value), this->buckets.end());
 }
 
 void ScriptList::KeepTop(SQInteger count)
@@ -868,6 +888,13 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Limit the total number of ops that can be consumed by a valuate operation */
 	SQOpsLimiter limiter(vm, MAX_VALUATE_OPS, "valuator function");
 
+	/* When nobody is iterating the list, the new values are collected and only
+	 * stored once all valuators have run, so the buckets can be updated in one go.
+	 * Until then the list itself is left alone, so a valuator that uses the list
+	 * sees it consistent; if it modifies the list, nothing is stored at all. */
+	bool deferred_values = this->sorter->IsEnd();
+	std::vector<std::pair<SQInteger, SQInteger>> changed_values;
+
 	/* Push the function to call */
 	sq_push(vm, 2);
 
@@ -922,7 +949,11 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			return sq_throwerror(vm, "modifying valuated list outside of valuator function");
 		}
 
-		this->SetValue((*iter).first, value);
+		if (!deferred_values) {
+			this->SetValue((*iter).first, value);
+		} else if ((*iter).second != value) {
+			changed_values.emplace_back((*iter).first, value);
+		}
 
 		/* Pop the return value. */
 		sq_poptop(vm);
@@ -936,6 +967,16 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	 * 4. The ScriptList instance object. */
 	sq_pop(vm, nparam + 3);
 
+	if (changed_values.size() > this->items.size() / 2 && this->sorter->IsEnd()) {
+		/* Most items move, so it is cheaper to start the buckets over. */
+		for (const auto &[item, value] : changed_values) this->items[item] = value;
+		this->RebuildBuckets();
+	} else {
+		/* Either only a few items move, or the valuator started iterating the list
+		 * and the sorter has to be told about every move. */
+		for (const auto &[item, value] : changed_values) this->SetValue(item, value);
+	}
+
 	ScriptObject::SetAllowDoCommand(backup_allow);
 	return 0;
 }
@@ -151,6 +151,11 @@ public:
 	ScriptListMap items;           ///< The items in the list
 	ScriptListBucket buckets;      ///< The items in the list, sorted by value
 
+private:
+	void RemoveBuckets(ScriptListBucket::iterator begin, ScriptListBucket::iterator end);
+	void RebuildBuckets();
+
+public:
 	ScriptList();
 	~ScriptList();
 
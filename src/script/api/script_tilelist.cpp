@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_tilelist.hpp"
 #include "script_industry.hpp"
+#include "script_map.hpp"
 #include "../../industry.h"
 #include "../../station_base.h"
 
@@ -47,6 +48,50 @@ void ScriptTileList::RemoveTile(TileIndex tile)
 	this->RemoveItem(tile.base());
 }
 
+/**
+ * Remove all tiles from a list that do not match a predicate, without calling back into the script.
+ * @param list The list to filter.
+ * @param keep Whether to keep the tile.
+ */
+template <typename Tkeep>
+static void KeepTiles(ScriptList *list, Tkeep keep)
+{
+	std::vector<SQInteger> remove;
+	for (const auto &item : list->items) {
+		if (!keep(::TileIndex(static_cast<uint32_t>(item.first)))) remove.push_back(item.first);
+	}
+	for (SQInteger item : remove) list->RemoveItem(item);
+}
+
+void ScriptTileList::KeepBuildable()
+{
+	KeepTiles(this, [](TileIndex tile) { return ScriptTile::IsBuildable(tile); });
+}
+
+void ScriptTileList::KeepSlope(ScriptTile::Slope slope)
+{
+	KeepTiles(this, [slope](TileIndex tile) { return ScriptTile::GetSlope(tile) == slope; });
+}
+
+void ScriptTileList::KeepOwner(ScriptCompany::CompanyID company)
+{
+	KeepTiles(this, [company](TileIndex tile) { return ScriptTile::GetOwner(tile) == company; });
+}
+
+void ScriptTileList::KeepHeightRange(SQInteger min_height, SQInteger max_height)
+{
+	KeepTiles(this, [min_height, max_height](TileIndex tile) {
+		return ScriptTile::GetMinHeight(tile) >= min_height && ScriptTile::GetMaxHeight(tile) <= max_height;
+	});
+}
+
+void ScriptTileList::KeepDistanceManhattan(TileIndex tile, SQInteger distance)
+{
+	if (!::IsValidTile(tile)) return;
+
+	KeepTiles(this, [tile, distance](TileIndex t) { return ScriptMap::DistanceManhattan(tile, t) <= distance; });
+}
+
 /**
  * Helper to get list of tiles that will cover an industry's production or acceptance.
  * @param i Industry in question
@@ -12,6 +12,7 @@
 
 #include "script_station.hpp"
 #include "script_list.hpp"
+#include "script_tile.hpp"
 
 /**
  * Creates an empty list, in which you can add tiles.
@@ -51,6 +52,39 @@ public:
 	 * @pre ScriptMap::IsValidTile(tile).
 	 */
 	void RemoveTile(TileIndex tile);
+
+	/**
+	 * Keep only the tiles that are buildable, i.e. for which ScriptTile::IsBuildable is true.
+	 * @note This is much faster than Valuate(ScriptTile.IsBuildable) followed by KeepValue(1).
+	 */
+	void KeepBuildable();
+
+	/**
+	 * Keep only the tiles with the given slope, see ScriptTile::GetSlope.
+	 * @param slope The slope the tiles must have.
+	 */
+	void KeepSlope(ScriptTile::Slope slope);
+
+	/**
+	 * Keep only the tiles with the given owner, see ScriptTile::GetOwner.
+	 * @param company The owner the tiles must have; COMPANY_INVALID for tiles without owner.
+	 */
+	void KeepOwner(ScriptCompany::CompanyID company);
+
+	/**
+	 * Keep only the tiles of which all corners are within a range of heights.
+	 * @param min_height The lowest height a corner of the tile may have.
+	 * @param max_height The highest height a corner of the tile may have.
+	 */
+	void KeepHeightRange(SQInteger min_height, SQInteger max_height);
+
+	/**
+	 * Keep only the tiles that are at most a given distance from a tile.
+	 * @param tile The tile to measure the distance from.
+	 * @param distance The largest distance, see ScriptMap::DistanceManhattan, a tile may have.
+	 * @pre ScriptMap::IsValidTile(tile).
+	 */
+	void KeepDistanceManhattan(TileIndex tile, SQInteger distance);
 };
 
 /**
@@ -30,6 +30,8 @@
 #include "../league_type.h"
 #include "../misc/endian_buffer.hpp"
 
+#include <chrono>
+
 #include "../safeguards.h"
 
 ScriptStorage::~ScriptStorage()
@@ -328,10 +330,12 @@ ScriptLogTypes::LogData &ScriptInstance::GetLogData()
  * First 1 byte indicating if there is a data blob at all.
  * 1 byte indicating the type of data.
  * The data itself, this differs per type:
- *  - integer: a binary representation of the integer (int32_t).
+ *  - integer: a binary representation of the integer (int64_t).
  *  - string:  First one byte with the string length, then a 0-terminated char
  *             array. The string can't be longer than 255 bytes (including
  *             terminating '\0').
+ *  - long string: First four bytes with the string length, then the bytes of
+ *             the string as is. Used for strings that do not fit the above.
  *  - array:   All data-elements of the array are saved recursive in this
  *             format, and ended with an element of the type
  *             SQSL_ARRAY_TABLE_END.
@@ -342,6 +346,7 @@ ScriptLogTypes::LogData &ScriptInstance::GetLogData()
  *             SQSL_ARRAY_TABLE_END.
  *  - bool:    A single byte with value 1 representing true and 0 false.
  *  - null:    No data.
+ * All numbers are big endian, like everything else in the savegame.
  */
 
 static uint8_t _script_sl_byte; ///< Used as source/target by the script saveload code to store/load a single byte.
@@ -351,7 +356,20 @@ static const SaveLoad _script_byte[] = {
 	SLEG_VAR("type", _script_sl_byte, SLE_UINT8),
 };
 
-/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, bool test)
+/**
+ * Append a big endian number to the serialised save data.
+ * @param buffer The serialised save data.
+ * @param value The number to append.
+ */
+template <typename T>
+static void AppendSaveNumber(std::vector<uint8_t> &buffer, T value)
+{
+	for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+		buffer.push_back(static_cast<uint8_t>(static_cast<std::make_unsigned_t<T>>(value) >> shift));
+	}
+}
+
+/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, std::vector<uint8_t> &buffer)
 {
 	if (max_depth == 0) {
 		ScriptLog::Error("Savedata can only be nested to 25 deep. No data saved."); // SQUIRREL_MAX_DEPTH = 25
@@ -360,48 +378,41 @@ static const SaveLoad _script_byte[] = {
 
 	switch (sq_gettype(vm, index)) {
 		case OT_INTEGER: {
-			if (!test) {
-				_script_sl_byte = SQSL_INT;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_INT);
 			SQInteger res;
 			sq_getinteger(vm, index, &res);
-			if (!test) {
-				int64_t value = (int64_t)res;
-				SlCopy(&value, 1, SLE_INT64);
-			}
+			AppendSaveNumber<int64_t>(buffer, res);
 			return true;
 		}
 
 		case OT_STRING: {
-			if (!test) {
-				_script_sl_byte = SQSL_STRING;
-				SlObject(nullptr, _script_byte);
-			}
 			const SQChar *buf;
 			sq_getstring(vm, index, &buf);
-			size_t len = strlen(buf) + 1;
-			if (len >= 255) {
-				ScriptLog::Error("Maximum string length is 254 chars. No data saved.");
-				return false;
+			size_t len = sq_getsize(vm, index);
+			if (len < 254 && strlen(buf) == len) {
+				buffer.push_back(SQSL_STRING);
+				/* Including the terminating '\0'. */
+				buffer.push_back(static_cast<uint8_t>(len + 1));
+				buffer.insert(buffer.end(), buf, buf + len + 1);
+				return true;
 			}
-			if (!test) {
-				_script_sl_byte = (uint8_t)len;
-				SlObject(nullptr, _script_byte);
-				SlCopy(const_cast<char *>(buf), len, SLE_CHAR);
+			if (len > UINT32_MAX) {
+				ScriptLog::Error("Maximum string length is 4 GiB. No data saved.");
+				return false;
 			}
+			/* Long strings, and strings with embedded '\0', are stored as is. */
+			buffer.push_back(SQSL_LONG_STRING);
+			AppendSaveNumber<uint32_t>(buffer, static_cast<uint32_t>(len));
+			buffer.insert(buffer.end(), buf, buf + len);
 			return true;
 		}
 
 		case OT_ARRAY: {
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_ARRAY);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the value */
-				bool res = SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -1, max_depth - 1, buffer);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -409,22 +420,16 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_TABLE: {
-			if (!test) {
-				_script_sl_byte = SQSL_TABLE;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_TABLE);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the key + value */
-				bool res = SaveObject(vm, -2, max_depth - 1, test) && SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -2, max_depth - 1, buffer) && SaveObject(vm, -1, max_depth - 1, buffer);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -432,32 +437,20 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_BOOL: {
-			if (!test) {
-				_script_sl_byte = SQSL_BOOL;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_BOOL);
 			SQBool res;
 			sq_getbool(vm, index, &res);
-			if (!test) {
-				_script_sl_byte = res ? 1 : 0;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(res ? 1 : 0);
 			return true;
 		}
 
 		case OT_NULL: {
-			if (!test) {
-				_script_sl_byte = SQSL_NULL;
-				SlObject(nullptr, _script_byte);
-			}
+			buffer.push_back(SQSL_NULL);
 			return true;
 		}
 
@@ -467,6 +460,33 @@ static const SaveLoad _script_byte[] = {
 	}
 }
 
+/**
+ * Serialise the object on top of the stack, and when that succeeded write it to the savegame.
+ * Everything is serialised in memory first, so nothing is written when the data
+ * turns out to be invalid, and the savegame gets the data in one go.
+ * @param vm The virtual machine to get the data from.
+ * @return True if the saving was successful.
+ */
+/* static */ bool ScriptInstance::SaveData(HSQUIRRELVM vm)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<uint8_t> buffer;
+	if (!SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, buffer)) return false;
+
+	_script_sl_byte = 1;
+	SlObject(nullptr, _script_byte);
+	SlCopy(buffer.data(), buffer.size(), SLE_UINT8);
+
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	if (_current_company == OWNER_DEITY) {
+		Debug(sl, 2, "Saved {} bytes of game script data in {} us", buffer.size(), duration.count());
+	} else {
+		Debug(sl, 2, "Saved {} bytes of AI data for company {} in {} us", buffer.size(), _current_company + 1, duration.count());
+	}
+	return true;
+}
+
 /* static */ void ScriptInstance::SaveEmpty()
 {
 	_script_sl_byte = 0;
@@ -485,10 +505,8 @@ void ScriptInstance::Save()
 
 	HSQUIRRELVM vm = this->engine->GetVM();
 	if (this->is_save_data_on_stack) {
-		_script_sl_byte = 1;
-		SlObject(nullptr, _script_byte);
 		/* Save the data that was just loaded. */
-		SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
+		if (!SaveData(vm)) SaveEmpty();
 	} else if (!this->is_started) {
 		SaveEmpty();
 		return;
@@ -527,10 +545,7 @@ void ScriptInstance::Save()
 			return;
 		}
 		sq_pushobject(vm, savedata);
-		if (SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, true)) {
-			_script_sl_byte = 1;
-			SlObject(nullptr, _script_byte);
-			SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
+		if (SaveData(vm)) {
 			this->is_save_data_on_stack = true;
 		} else {
 			SaveEmpty();
@@ -581,6 +596,18 @@ bool ScriptInstance::IsPaused()
 			return true;
 		}
 
+		case SQSL_LONG_STRING: {
+			if (IsSavegameVersionBefore(SLV_SCRIPT_LONG_STRINGS)) SlErrorCorrupt("Invalid script data type");
+			uint32_t len;
+			SlCopy(&len, 1, SLE_UINT32);
+			/* The script could not have held a longer string, so do not allocate whatever a corrupt length asks for. */
+			if (len > static_cast<size_t>(_settings_game.script.script_max_memory_megabytes) << 20) SlErrorCorrupt("Script string longer than the script memory limit");
+			std::string str(len, '\0');
+			SlCopy(str.data(), len, SLE_CHAR);
+			if (data != nullptr) data->push_back(std::move(str));
+			return true;
+		}
+
 		case SQSL_ARRAY:
 		case SQSL_TABLE: {
 			if (data != nullptr) data->push_back((SQSaveLoadType)_script_sl_byte);
@@ -32,6 +32,7 @@ private:
 		SQSL_TABLE           = 0x03, ///< The following data is an table.
 		SQSL_BOOL            = 0x04, ///< The following data is a boolean.
 		SQSL_NULL            = 0x05, ///< A null variable.
+		SQSL_LONG_STRING     = 0x06, ///< The following data is a string of any length and content.
 		SQSL_ARRAY_TABLE_END = 0xFF, ///< Marks the end of an array or table, no data follows.
 	};
 
@@ -303,16 +304,17 @@ private:
 	bool CallLoad();
 
 	/**
-	 * Save one object (int / string / array / table) to the savegame.
+	 * Serialise one object (int / string / array / table) for the savegame.
 	 * @param vm The virtual machine to get all the data from.
 	 * @param index The index on the squirrel stack of the element to save.
 	 * @param max_depth The maximum depth recursive arrays / tables will be stored
 	 *   with before an error is returned.
-	 * @param test If true, don't really store the data but only check if it is
-	 *   valid.
-	 * @return True if the saving was successful.
+	 * @param buffer The buffer to append the serialised data to.
+	 * @return True if the data is valid and fully serialised.
 	 */
-	static bool SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, bool test);
+	static bool SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, std::vector<uint8_t> &buffer);
+
+	static bool SaveData(HSQUIRRELVM vm);
 
 	/**
 	 * Load all objects from a savegame.
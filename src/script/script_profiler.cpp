@@ -0,0 +1,143 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_profiler.cpp Implementation of the sampling profiler for the scripts. */
+
+#include "../stdafx.h"
+#include "script_profiler.hpp"
+#include "../company_func.h"
+#include "../fileio_func.h"
+#include "../console_func.h"
+#include "../3rdparty/fmt/chrono.h"
+
+#include <chrono>
+
+#include "../safeguards.h"
+
+/** What has been attributed to a single call stack. */
+struct ScriptProfileSample {
+	uint64_t ops = 0;         ///< Number of executed opcodes.
+	uint64_t nanoseconds = 0; ///< Wall time spent.
+};
+
+static bool _script_profiler_active = false; ///< Whether the profiler is collecting samples.
+static uint _script_profiler_run_depth = 0;  ///< Number of nested RunScopes.
+static std::chrono::steady_clock::time_point _script_profiler_last_sample; ///< Time of the last sample, or of the start of the run.
+static std::unordered_map<std::string, ScriptProfileSample> _script_profile; ///< Collected samples, by folded call stack.
+
+/**
+ * Sample the call stack of the script; called by Squirrel every SAMPLE_INTERVAL opcodes.
+ * @param vm The VM that is running.
+ * @param ops The number of opcodes executed since the previous sample.
+ */
+static void ScriptProfilerSample(HSQUIRRELVM vm, SQInteger ops)
+{
+	auto now = std::chrono::steady_clock::now();
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _script_profiler_last_sample).count();
+	_script_profiler_last_sample = now;
+
+	/* While a script runs, the current company is the one the script plays for. */
+	std::string stack = (_current_company == OWNER_DEITY) ? "GS" : fmt::format("AI company {}", _current_company + 1);
+
+	/* Find the outermost frame, as the folded format goes from the root to the leaf. */
+	SQStackInfos si;
+	SQInteger levels = 0;
+	while (SQ_SUCCEEDED(sq_stackinfos(vm, levels, &si))) levels++;
+
+	for (SQInteger level = levels - 1; level >= 0; level--) {
+		sq_stackinfos(vm, level, &si);
+		const char *funcname = si.funcname != nullptr ? si.funcname : "unknown";
+		const char *source = si.source != nullptr ? si.source : "unknown";
+		if (si.line < 0) {
+			fmt::format_to(std::back_inserter(stack), ";{} ({})", funcname, source);
+		} else {
+			fmt::format_to(std::back_inserter(stack), ";{} ({}:{})", funcname, source, si.line);
+		}
+	}
+
+	ScriptProfileSample &sample = _script_profile[stack];
+	sample.ops += ops;
+	sample.nanoseconds += elapsed;
+}
+
+/**
+ * Start sampling a script that is going to run.
+ * @param vm The VM that is going to run.
+ */
+ScriptProfiler::RunScope::RunScope(HSQUIRRELVM vm) : vm(vm)
+{
+	if (_script_profiler_run_depth++ != 0) return;
+
+	if (_script_profiler_active) {
+		_script_profiler_last_sample = std::chrono::steady_clock::now();
+		sq_setprofilehook(vm, &ScriptProfilerSample, SAMPLE_INTERVAL);
+	} else {
+		sq_setprofilehook(vm, nullptr, 0);
+	}
+}
+
+/** Stop sampling, so time outside the script is not attributed to it. */
+ScriptProfiler::RunScope::~RunScope()
+{
+	if (--_script_profiler_run_depth != 0) return;
+
+	sq_setprofilehook(this->vm, nullptr, 0);
+}
+
+/** Start collecting samples; previously collected samples are discarded. */
+/* static */ void ScriptProfiler::Start()
+{
+	_script_profile.clear();
+	_script_profiler_active = true;
+}
+
+/** Stop collecting samples and discard them. */
+/* static */ void ScriptProfiler::Abort()
+{
+	_script_profiler_active = false;
+	_script_profile.clear();
+}
+
+/** Stop collecting samples and write them to the screenshot directory; once weighted by opcodes and once by wall time. */
+/* static */ void ScriptProfiler::Finish()
+{
+	_script_profiler_active = false;
+
+	std::string base = fmt::format("{}scriptprofile-{:%Y%m%d-%H%M}", FiosGetScreenshotDir(), fmt::localtime(time(nullptr)));
+	std::string ops_filename = base + "-ops.folded";
+	std::string time_filename = base + "-us.folded";
+
+	FILE *f_ops = FioFOpenFile(ops_filename, "wt", Subdirectory::NO_DIRECTORY);
+	FILE *f_time = FioFOpenFile(time_filename, "wt", Subdirectory::NO_DIRECTORY);
+	FileCloser ops_closer(f_ops);
+	FileCloser time_closer(f_time);
+
+	if (f_ops == nullptr || f_time == nullptr) {
+		IConsolePrint(CC_ERROR, "Could not write the script profile to '{}'.", base);
+		_script_profile.clear();
+		return;
+	}
+
+	uint64_t total_ops = 0;
+	for (const auto &[stack, sample] : _script_profile) {
+		fmt::print(f_ops, "{} {}\n", stack, sample.ops);
+		if (sample.nanoseconds >= 1000) fmt::print(f_time, "{} {}\n", stack, sample.nanoseconds / 1000);
+		total_ops += sample.ops;
+	}
+
+	IConsolePrint(CC_DEBUG, "Finished script profile of {} opcodes in {} call stacks, written to '{}' and '{}'.", total_ops, _script_profile.size(), ops_filename, time_filename);
+	_script_profile.clear();
+}
+
+/**
+ * Whether the profiler is collecting samples.
+ * @return True iff it is collecting.
+ */
+/* static */ bool ScriptProfiler::IsActive()
+{
+	return _script_profiler_active;
+}
@@ -0,0 +1,45 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_profiler.hpp Sampling profiler for the scripts. */
+
+#ifndef SCRIPT_PROFILER_HPP
+#define SCRIPT_PROFILER_HPP
+
+#include <squirrel.h>
+
+/**
+ * Sampling profiler for AIs and game scripts. While active, every so many
+ * executed opcodes the call stack of the running script is sampled, and the
+ * opcodes and the wall time since the previous sample are attributed to it.
+ * The result is written in the "folded stacks" format that flame graph tools
+ * like flamegraph.pl and speedscope read.
+ */
+class ScriptProfiler {
+public:
+	/** Number of opcodes between two samples. */
+	static const SQInteger SAMPLE_INTERVAL = 64;
+
+	/**
+	 * Scope in which a script is being run, and thus should be sampled.
+	 */
+	class RunScope {
+	public:
+		RunScope(HSQUIRRELVM vm);
+		~RunScope();
+
+	private:
+		HSQUIRRELVM vm; ///< The VM that is running.
+	};
+
+	static void Start();
+	static void Abort();
+	static void Finish();
+	static bool IsActive();
+};
+
+#endif /* SCRIPT_PROFILER_HPP */
@@ -13,6 +13,7 @@
 #include "../fileio_func.h"
 #include "../string_func.h"
 #include "script_fatalerror.hpp"
+#include "script_profiler.hpp"
 #include "../settings_type.h"
 #include <sqstdaux.h>
 #include <../squirrel/sqpcheader.h>
@@ -46,6 +47,20 @@ struct ScriptAllocator {
 
 	static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almost any situation
 
+	static const size_t POOL_GRANULARITY = 16; ///< Difference in size between the size classes of small allocations.
+	static const size_t POOL_MAX_SIZE = 256; ///< Largest allocation that is served from the size classes; larger ones go to the system allocator.
+	static const size_t POOL_CHUNK_SIZE = 64 * 1024; ///< Size of the chunks the small allocations are carved from.
+
+	/** A freed small allocation, waiting to be reused for the same size class. */
+	struct FreeBlock {
+		FreeBlock *next; ///< Next free block of the same size class.
+	};
+
+	std::array<FreeBlock *, POOL_MAX_SIZE / POOL_GRANULARITY> free_blocks{}; ///< Free blocks of each size class.
+	std::vector<void *> chunks; ///< Chunks of memory for small allocations; they are only returned when the script is stopped.
+	uint8_t *chunk_pos = nullptr; ///< Start of the not yet used part of the last chunk.
+	size_t chunk_left = 0; ///< Size of the not yet used part of the last chunk.
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 	std::map<void *, size_t> allocations;
 #endif
@@ -56,15 +71,73 @@ struct ScriptAllocator {
 	}
 
 	/**
-	 * Catch all validation for the allocation; did it allocate too much memory according
-	 * to the allocation limit or did the allocation at the OS level maybe fail? In those
-	 * error situations a Script_FatalError is thrown, but once that has been done further
-	 * allocations are allowed to make it possible for Squirrel to throw the error and
-	 * clean everything up.
-	 * @param requested_size The requested size that was requested to be allocated.
-	 * @param p              The pointer to the allocated object, or null if allocation failed.
+	 * Get the size class of a small allocation.
+	 * @param size The size of the allocation.
+	 * @return Index of the size class.
 	 */
-	void CheckAllocation(size_t requested_size, void *p)
+	static inline size_t GetSizeClass(size_t size)
+	{
+		assert(size > 0 && size <= POOL_MAX_SIZE);
+		return (size - 1) / POOL_GRANULARITY;
+	}
+
+	/**
+	 * Get memory from the size classes, or from the system for large sizes.
+	 * @param size The size of the allocation.
+	 * @return The memory, or \c nullptr when there is no memory left.
+	 */
+	void *Allocate(size_t size)
+	{
+		if (size == 0 || size > POOL_MAX_SIZE) return malloc(size);
+
+		size_t size_class = GetSizeClass(size);
+		FreeBlock *block = this->free_blocks[size_class];
+		if (block != nullptr) {
+			this->free_blocks[size_class] = block->next;
+			return block;
+		}
+
+		size_t class_size = (size_class + 1) * POOL_GRANULARITY;
+		if (this->chunk_left < class_size) {
+			void *chunk = malloc(POOL_CHUNK_SIZE);
+			if (chunk == nullptr) return nullptr;
+			this->chunks.push_back(chunk);
+			this->chunk_pos = static_cast<uint8_t *>(chunk);
+			this->chunk_left = POOL_CHUNK_SIZE;
+		}
+
+		void *p = this->chunk_pos;
+		this->chunk_pos += class_size;
+		this->chunk_left -= class_size;
+		return p;
+	}
+
+	/**
+	 * Give memory back to its size class, or to the system for large sizes.
+	 * @param p The memory.
+	 * @param size The size it was allocated with.
+	 */
+	void Deallocate(void *p, size_t size)
+	{
+		if (size == 0 || size > POOL_MAX_SIZE) {
+			free(p);
+			return;
+		}
+
+		size_t size_class = GetSizeClass(size);
+		FreeBlock *block = static_cast<FreeBlock *>(p);
+		block->next = this->free_blocks[size_class];
+		this->free_blocks[size_class] = block;
+	}
+
+	/**
+	 * Catch all validation for the allocation; would it allocate too much memory according
+	 * to the allocation limit? In that case a Script_FatalError is thrown, but once that has
+	 * been done further allocations are allowed to make it possible for Squirrel to throw
+	 * the error and clean everything up.
+	 * @param requested_size The requested size that is going to be allocated.
+	 */
+	void CheckAllocationLimit(size_t requested_size)
 	{
 		if (this->allocated_size + requested_size > this->allocation_limit && !this->error_thrown) {
 			/* Do not allow allocating more than the allocation limit, except when an error is
@@ -73,11 +146,18 @@ struct ScriptAllocator {
 			this->error_thrown = true;
 			std::string msg = fmt::format("Maximum memory allocation exceeded by {} bytes when allocating {} bytes",
 				this->allocated_size + requested_size - this->allocation_limit, requested_size);
-			/* Don't leak the rejected allocation. */
-			free(p);
 			throw Script_FatalError(msg);
 		}
+	}
 
+	/**
+	 * Did the allocation at the OS level maybe fail? In that case a Script_FatalError is thrown,
+	 * with the same allowance for further allocations as #CheckAllocationLimit.
+	 * @param requested_size The requested size that was requested to be allocated.
+	 * @param p              The pointer to the allocated object, or null if allocation failed.
+	 */
+	void CheckAllocation(size_t requested_size, void *p)
+	{
 		if (p == nullptr) {
 			/* The OS did not have enough memory to allocate the object, regardless of the
 			 * limit imposed by OpenTTD on the amount of memory that may be allocated. */
@@ -96,8 +176,8 @@ struct ScriptAllocator {
 
 	void *Malloc(SQUnsignedInteger size)
 	{
-		void *p = malloc(size);
-
+		this->CheckAllocationLimit(size);
+		void *p = this->Allocate(size);
 		this->CheckAllocation(size, p);
 
 		this->allocated_size += size;
@@ -121,6 +201,19 @@ struct ScriptAllocator {
 			return nullptr;
 		}
 
+		if (size > oldsize) this->CheckAllocationLimit(size - oldsize);
+
+		/* A small allocation that stays in the same size class does not have to move. */
+		if (oldsize <= POOL_MAX_SIZE && size <= POOL_MAX_SIZE && GetSizeClass(oldsize) == GetSizeClass(size)) {
+#ifdef SCRIPT_DEBUG_ALLOCATIONS
+			assert(this->allocations[p] == oldsize);
+			this->allocations[p] = size;
+#endif
+			this->allocated_size -= oldsize;
+			this->allocated_size += size;
+			return p;
+		}
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations[p] == oldsize);
 		this->allocations.erase(p);
@@ -129,13 +222,13 @@ struct ScriptAllocator {
 		 * If memory exception is thrown, the old pointer is expected
 		 * to be valid for engine cleanup.
 		 */
-		void *new_p = malloc(size);
+		void *new_p = this->Allocate(size);
 
 		this->CheckAllocation(size - oldsize, new_p);
 
 		/* Memory limit test passed, we can copy data and free old pointer. */
 		memcpy(new_p, p, std::min(oldsize, size));
-		free(p);
+		this->Deallocate(p, oldsize);
 
 		this->allocated_size -= oldsize;
 		this->allocated_size += size;
@@ -152,7 +245,7 @@ struct ScriptAllocator {
 	void Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		free(p);
+		this->Deallocate(p, size);
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -161,6 +254,20 @@ struct ScriptAllocator {
 #endif
 	}
 
+	/**
+	 * Return the chunks of the size classes to the system at once.
+	 * @pre Nothing is allocated anymore.
+	 */
+	void ReleaseChunks()
+	{
+		assert(this->allocated_size == 0);
+		for (void *chunk : this->chunks) free(chunk);
+		this->chunks.clear();
+		this->free_blocks.fill(nullptr);
+		this->chunk_pos = nullptr;
+		this->chunk_left = 0;
+	}
+
 	ScriptAllocator()
 	{
 		this->allocated_size = 0;
@@ -174,6 +281,8 @@ struct ScriptAllocator {
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.empty());
 #endif
+		/* Small allocations the engine did not free itself go together with their chunks. */
+		for (void *chunk : this->chunks) free(chunk);
 	}
 };
 
@@ -376,6 +485,7 @@ bool Squirrel::Resume(int suspend)
 		suspend = -this->overdrawn_ops;
 	}
 
+	ScriptProfiler::RunScope profile_scope(this->vm);
 	this->crashed = !sq_resumecatch(this->vm, suspend);
 	this->overdrawn_ops = -this->vm->_ops_till_suspend;
 	this->allocator->CheckLimit();
@@ -753,6 +863,7 @@ void Squirrel::Uninitialize()
 	sq_close(this->vm);
 
 	assert(this->allocator->allocated_size == 0);
+	this->allocator->ReleaseChunks();
 
 	/* Reset memory allocation errors. */
 	this->allocator->error_thrown = false;
@@ -48,6 +48,7 @@
 #include "fios.h"
 #include "fileio_func.h"
 #include "settings_cmd.h"
+#include "pathfinder/yapf/yapf_cache.h"
 
 #include "table/strings.h"
 
@@ -1606,6 +1607,41 @@ void IntSettingDesc::ChangeValue(const void *object, int32_t newval) const
 	if (_save_config) SaveToConfig();
 }
 
+/** Lookup tables from the names of the settings in a settings table to their descriptions. */
+struct SettingNameIndex {
+	std::unordered_map<std::string_view, const SettingDesc *> full_names;  ///< Full names, e.g. "gui.autosave".
+	std::unordered_map<std::string_view, const SettingDesc *> short_names; ///< Every part after a dot of the full names, e.g. "autosave".
+};
+
+/**
+ * Get the name index of a settings table, building it on first use.
+ * Which settings are valid only depends on the current savegame version, so the index never needs to be rebuilt.
+ * @param settings Table to get the index of.
+ * @return The index.
+ */
+static const SettingNameIndex &GetSettingNameIndex(const SettingTable &settings)
+{
+	static std::unordered_map<const SettingVariant *, SettingNameIndex> indices;
+
+	auto [it, inserted] = indices.try_emplace(settings.data());
+	SettingNameIndex &index = it->second;
+	if (!inserted) return index;
+
+	for (auto &desc : settings) {
+		const SettingDesc *sd = GetSettingDesc(desc);
+		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to)) continue;
+
+		/* Only the first setting in the table is kept for each name, just like a linear search would find it. */
+		std::string_view name = sd->GetName();
+		index.full_names.try_emplace(name, sd);
+		for (size_t dot = name.find('.'); dot != std::string_view::npos; dot = name.find('.', dot + 1)) {
+			index.short_names.try_emplace(name.substr(dot + 1), sd);
+		}
+	}
+
+	return index;
+}
+
 /**
  * Given a name of setting, return a setting description from the table.
  * @param name Name of the setting to return a setting description of.
@@ -1615,20 +1651,15 @@ void IntSettingDesc::ChangeValue(const void *object, int32_t newval) const
  */
 static const SettingDesc *GetSettingFromName(const std::string_view name, const SettingTable &settings)
 {
+	const SettingNameIndex &index = GetSettingNameIndex(settings);
+
 	/* First check all full names */
-	for (auto &desc : settings) {
-		const SettingDesc *sd = GetSettingDesc(desc);
-		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to)) continue;
-		if (sd->GetName() == name) return sd;
-	}
+	auto it = index.full_names.find(name);
+	if (it != index.full_names.end()) return it->second;
 
 	/* Then check the shortcut variant of the name. */
-	std::string short_name_suffix = std::string{ "." }.append(name);
-	for (auto &desc : settings) {
-		const SettingDesc *sd = GetSettingDesc(desc);
-		if (!SlIsObjectCurrentlyValid(sd->save.version_from, sd->save.version_to)) continue;
-		if (sd->GetName().ends_with(short_name_suffix)) return sd;
-	}
+	it = index.short_names.find(name);
+	if (it != index.short_names.end()) return it->second;
 
 	return nullptr;
 }
@@ -1706,6 +1737,9 @@ CommandCost CmdChangeSetting(DoCommandFlag flags, const std::string &name, int32
 
 	if (flags & DC_EXEC) {
 		sd->AsIntSetting()->ChangeValue(&GetGameSettings(), value);
+
+		/* The cached rail segment costs include the pathfinder penalties. */
+		if (sd->GetName().starts_with("pf.")) YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
 	}
 
 	return CommandCost();
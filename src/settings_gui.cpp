@@ -2162,6 +2162,7 @@ static SettingsContainer &GetSettingsTree()
 			limitations->Add(new SettingEntry("station.station_spread"));
 			limitations->Add(new SettingEntry("station.distant_join_stations"));
 			limitations->Add(new SettingEntry("station.modified_catchment"));
+			limitations->Add(new SettingEntry("station.cargo_merge_tolerance"));
 			limitations->Add(new SettingEntry("construction.road_stop_on_town_road"));
 			limitations->Add(new SettingEntry("construction.road_stop_on_competitor_road"));
 			limitations->Add(new SettingEntry("construction.crossing_with_competitor"));
@@ -317,6 +317,7 @@ struct NetworkSettings {
 	uint16_t      server_admin_port;                        ///< port the server listens on for the admin network
 	bool        server_admin_chat;                        ///< allow private chat for the server to be distributed to the admin network
 	ServerGameType server_game_type;                      ///< Server type: local / public / invite-only.
+	ServerIdleMode idle_mode;                             ///< How a dedicated server runs the game while no clients are connected.
 	std::string server_invite_code;                       ///< Invite code to use when registering as server.
 	std::string server_invite_code_secret;                ///< Secret to proof we got this invite code from the Game Coordinator.
 	std::string server_name;                              ///< name of the server
@@ -568,6 +569,7 @@ struct StationSettings {
 	bool   distant_join_stations;            ///< allow to join non-adjacent stations
 	bool   never_expire_airports;            ///< never expire airports
 	uint8_t station_spread;                  ///< amount a station may spread
+	uint8_t cargo_merge_tolerance;           ///< maximum difference in periods in transit for merging cargo packets waiting at a station
 };
 
 /** Default settings for vehicles. */
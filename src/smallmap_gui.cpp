@@ -869,7 +869,6 @@ protected:
 		this->scroll_x = sx;
 		this->scroll_y = sy;
 		this->subscroll = sub;
-		if (this->map_type == SMT_LINKSTATS) this->overlay->SetDirty();
 	}
 
 	/**
@@ -1243,8 +1242,6 @@ protected:
 				Point new_tile = this->PixelToTile(zoom_pt->x, zoom_pt->y, &sub);
 				this->SetNewScroll(this->scroll_x + (tile.x - new_tile.x) * TILE_SIZE,
 						this->scroll_y + (tile.y - new_tile.y) * TILE_SIZE, sub);
-			} else if (this->map_type == SMT_LINKSTATS) {
-				this->overlay->SetDirty();
 			}
 			this->SetWidgetDisabledState(WID_SM_ZOOM_IN,  this->zoom == zoomlevels[MIN_ZOOM_INDEX]);
 			this->SetWidgetDisabledState(WID_SM_ZOOM_OUT, this->zoom == zoomlevels[MAX_ZOOM_INDEX]);
@@ -1495,11 +1492,9 @@ public:
 	 * @param st Station to find in the smallmap.
 	 * @return Point with coordinates of the station.
 	 */
-	Point GetStationMiddle(const Station *st) const
+	Point GetStationMiddle(Point pos) const
 	{
-		int x = CenterBounds(st->rect.left, st->rect.right, 0);
-		int y = CenterBounds(st->rect.top, st->rect.bottom, 0);
-		Point ret = this->RemapTile(x, y);
+		Point ret = this->RemapTile(pos.x, pos.y);
 
 		/* Same magic 3 as in DrawVehicles; that's where I got it from.
 		 * No idea what it is, but without it the result looks bad.
@@ -2093,11 +2088,23 @@ bool ScrollMainWindowTo(int x, int y, int z, bool instant)
 }
 
 /**
- * Determine the middle of a station in the smallmap window.
+ * Determine the position of a station in tile coordinates.
+ * This does not depend on scrolling or zooming, so it can be cached.
  * @param st The station we're looking for.
+ * @return Position of the station, see GetSmallMapStationMiddle.
+ */
+Point GetSmallMapStationPosition(const Station *st)
+{
+	return {CenterBounds(st->rect.left, st->rect.right, 0), CenterBounds(st->rect.top, st->rect.bottom, 0)};
+}
+
+/**
+ * Determine the middle of a station in the smallmap window.
+ * @param w The smallmap window.
+ * @param pos Position of the station, from GetSmallMapStationPosition.
  * @return Middle point of the station in the smallmap window.
  */
-Point GetSmallMapStationMiddle(const Window *w, const Station *st)
+Point GetSmallMapStationMiddle(const Window *w, Point pos)
 {
-	return static_cast<const SmallMapWindow *>(w)->GetStationMiddle(st);
+	return static_cast<const SmallMapWindow *>(w)->GetStationMiddle(pos);
 }
@@ -32,6 +32,7 @@ enum class IncludeHeightmap {
 
 uint32_t GetSmallMapOwnerPixels(TileIndex tile, TileType t, IncludeHeightmap include_heightmap);
 
-Point GetSmallMapStationMiddle(const Window *w, const Station *st);
+Point GetSmallMapStationPosition(const Station *st);
+Point GetSmallMapStationMiddle(const Window *w, Point pos);
 
 #endif /* SMALLMAP_GUI_H */
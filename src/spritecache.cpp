@@ -11,7 +11,6 @@
 #include "random_access_file_type.h"
 #include "spriteloader/grf.hpp"
 #include "gfx_func.h"
-#include "error.h"
 #include "error_func.h"
 #include "zoom_func.h"
 #include "settings_type.h"
@@ -21,6 +20,7 @@
 #include "video/video_driver.hpp"
 #include "spritecache.h"
 #include "spritecache_internal.h"
+#include "thread_pool.h"
 
 #include "table/sprites.h"
 #include "table/strings.h"
@@ -101,17 +101,29 @@ SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdi
 	return *file;
 }
 
+/** Header in front of the data of every sprite in the sprite cache. */
 struct MemBlock {
-	size_t size;
-	uint8_t data[];
+	size_t size;    ///< Size of the block, including this header.
+	uint8_t data[]; ///< The data of the sprite.
 };
 
-static uint _sprite_lru_counter;
-static MemBlock *_spritecache_ptr;
-static uint _allocated_sprite_cache_size = 0;
-static int _compact_cache_counter;
+static size_t _sprite_cache_budget = 0; ///< Number of bytes the sprite cache may use before sprites are evicted.
+static size_t _sprite_cache_used = 0;   ///< Number of bytes used by the sprites in the sprite cache.
+static std::vector<uint32_t> _sprite_clock; ///< Indices of the sprites in the sprite cache, in no particular order.
+static size_t _sprite_clock_hand = 0;   ///< Position in #_sprite_clock where the search for a sprite to evict continues.
 
-static void CompactSpriteCache();
+static void DeleteEntryFromSpriteCache(uint item);
+static void AddToSpriteCache(uint item, void *data);
+
+/**
+ * Get the header of the memory of a sprite in the sprite cache.
+ * @param ptr The data of the sprite.
+ * @return The header.
+ */
+static inline MemBlock *GetMemBlock(void *ptr)
+{
+	return reinterpret_cast<MemBlock *>(static_cast<uint8_t *>(ptr) - offsetof(MemBlock, data));
+}
 
 /**
  * Skip the given amount of sprite graphics data.
@@ -237,12 +249,17 @@ static bool ResizeSpriteIn(SpriteLoader::SpriteCollection &sprite, ZoomLevel src
 
 	sprite[tgt].AllocateData(tgt, static_cast<size_t>(sprite[tgt].width) * sprite[tgt].height);
 
+	/* Widen each line of the source once, then repeat the widened line instead of scaling every pixel again. */
 	SpriteLoader::CommonPixel *dst = sprite[tgt].data;
-	for (int y = 0; y < sprite[tgt].height; y++) {
-		const SpriteLoader::CommonPixel *src_ln = &sprite[src].data[y / scaled_1 * sprite[src].width];
-		for (int x = 0; x < sprite[tgt].width; x++) {
-			*dst = src_ln[x / scaled_1];
-			dst++;
+	const size_t tgt_width = sprite[tgt].width;
+	for (int y = 0; y < sprite[src].height; y++) {
+		const SpriteLoader::CommonPixel *src_ln = &sprite[src].data[y * sprite[src].width];
+		SpriteLoader::CommonPixel *dst_ln = dst;
+		for (int x = 0; x < sprite[src].width; x++) {
+			dst = std::fill_n(dst, scaled_1, src_ln[x]);
+		}
+		for (uint i = 1; i < scaled_1; i++) {
+			dst = std::copy_n(dst_ln, tgt_width, dst);
 		}
 	}
 
@@ -546,6 +563,7 @@ struct GrfSpriteOffset {
 
 /** Map from sprite numbers to position in the GRF file. */
 static std::map<uint32_t, GrfSpriteOffset> _grf_sprite_offsets;
+static std::map<const SpriteFile *, std::map<uint32_t, GrfSpriteOffset>> _prepared_grf_sprite_offsets; ///< Sprite sections parsed ahead of loading the GRFs.
 
 /**
  * Get the file offset for a specific sprite in the sprite section of a GRF.
@@ -558,54 +576,106 @@ size_t GetGRFSpriteOffset(uint32_t id)
 }
 
 /**
- * Parse the sprite section of GRFs.
- * @param container_version Container version of the GRF we're currently processing.
+ * Parse the sprite section of a GRF.
+ * @param file The GRF, positioned at the offset of the sprite section; afterwards it is positioned just after that offset.
+ * @param[out] offsets The offsets of the sprites in the sprite section.
  */
-void ReadGRFSpriteOffsets(SpriteFile &file)
+static void ParseGRFSpriteOffsets(SpriteFile &file, std::map<uint32_t, GrfSpriteOffset> &offsets)
 {
-	_grf_sprite_offsets.clear();
-
-	if (file.GetContainerVersion() >= 2) {
-		/* Seek to sprite section of the GRF. */
-		size_t data_offset = file.ReadDword();
-		size_t old_pos = file.GetPos();
-		file.SeekTo(data_offset, SEEK_CUR);
-
-		GrfSpriteOffset offset = { 0, 0 };
-
-		/* Loop over all sprite section entries and store the file
-		 * offset for each newly encountered ID. */
-		uint32_t id, prev_id = 0;
-		while ((id = file.ReadDword()) != 0) {
-			if (id != prev_id) {
-				_grf_sprite_offsets[prev_id] = offset;
-				offset.file_pos = file.GetPos() - 4;
-				offset.control_flags = 0;
-			}
-			prev_id = id;
-			uint length = file.ReadDword();
+	/* Seek to sprite section of the GRF. */
+	size_t data_offset = file.ReadDword();
+	size_t old_pos = file.GetPos();
+	file.SeekTo(data_offset, SEEK_CUR);
+
+	GrfSpriteOffset offset = { 0, 0 };
+
+	/* Loop over all sprite section entries and store the file
+	 * offset for each newly encountered ID. */
+	uint32_t id, prev_id = 0;
+	while ((id = file.ReadDword()) != 0) {
+		if (id != prev_id) {
+			offsets[prev_id] = offset;
+			offset.file_pos = file.GetPos() - 4;
+			offset.control_flags = 0;
+		}
+		prev_id = id;
+		uint length = file.ReadDword();
+		if (length > 0) {
+			uint8_t colour = file.ReadByte() & SCC_MASK;
+			length--;
 			if (length > 0) {
-				uint8_t colour = file.ReadByte() & SCC_MASK;
+				uint8_t zoom = file.ReadByte();
 				length--;
-				if (length > 0) {
-					uint8_t zoom = file.ReadByte();
-					length--;
-					if (colour != 0 && zoom == 0) { // ZOOM_LVL_NORMAL (normal zoom)
-						SetBit(offset.control_flags, (colour != SCC_PAL) ? SCCF_ALLOW_ZOOM_MIN_1X_32BPP : SCCF_ALLOW_ZOOM_MIN_1X_PAL);
-						SetBit(offset.control_flags, (colour != SCC_PAL) ? SCCF_ALLOW_ZOOM_MIN_2X_32BPP : SCCF_ALLOW_ZOOM_MIN_2X_PAL);
-					}
-					if (colour != 0 && zoom == 2) { // ZOOM_LVL_IN_2X (2x zoomed in)
-						SetBit(offset.control_flags, (colour != SCC_PAL) ? SCCF_ALLOW_ZOOM_MIN_2X_32BPP : SCCF_ALLOW_ZOOM_MIN_2X_PAL);
-					}
+				if (colour != 0 && zoom == 0) { // ZOOM_LVL_NORMAL (normal zoom)
+					SetBit(offset.control_flags, (colour != SCC_PAL) ? SCCF_ALLOW_ZOOM_MIN_1X_32BPP : SCCF_ALLOW_ZOOM_MIN_1X_PAL);
+					SetBit(offset.control_flags, (colour != SCC_PAL) ? SCCF_ALLOW_ZOOM_MIN_2X_32BPP : SCCF_ALLOW_ZOOM_MIN_2X_PAL);
+				}
+				if (colour != 0 && zoom == 2) { // ZOOM_LVL_IN_2X (2x zoomed in)
+					SetBit(offset.control_flags, (colour != SCC_PAL) ? SCCF_ALLOW_ZOOM_MIN_2X_32BPP : SCCF_ALLOW_ZOOM_MIN_2X_PAL);
 				}
 			}
-			file.SkipBytes(length);
 		}
-		if (prev_id != 0) _grf_sprite_offsets[prev_id] = offset;
+		file.SkipBytes(length);
+	}
+	if (prev_id != 0) offsets[prev_id] = offset;
 
-		/* Continue processing the data section. */
-		file.SeekTo(old_pos, SEEK_SET);
+	/* Continue processing the data section. */
+	file.SeekTo(old_pos, SEEK_SET);
+}
+
+/**
+ * Parse the sprite section of GRFs.
+ * @param file The GRF, positioned just after its container header.
+ */
+void ReadGRFSpriteOffsets(SpriteFile &file)
+{
+	if (file.GetContainerVersion() < 2) {
+		_grf_sprite_offsets.clear();
+		return;
+	}
+
+	auto prepared = _prepared_grf_sprite_offsets.find(&file);
+	if (prepared != _prepared_grf_sprite_offsets.end()) {
+		_grf_sprite_offsets = prepared->second;
+		/* Skip the offset of the sprite section, as ParseGRFSpriteOffsets would. */
+		file.ReadDword();
+		return;
 	}
+
+	_grf_sprite_offsets.clear();
+	ParseGRFSpriteOffsets(file, _grf_sprite_offsets);
+}
+
+/**
+ * Parse the sprite sections of several GRFs up front, spread over the worker
+ * threads, so ReadGRFSpriteOffsets does not need to do that while loading them.
+ * Every file is touched by one thread only, and no other state is touched.
+ * @param files The GRFs to parse; duplicates are not allowed.
+ */
+void PrepareGRFSpriteOffsets(std::span<SpriteFile * const> files)
+{
+	std::vector<std::map<uint32_t, GrfSpriteOffset>> offsets(files.size());
+	ThreadPool::ParallelFor(files.size(), 1, [&files, &offsets](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			SpriteFile &file = *files[i];
+			if (file.GetContainerVersion() < 2) continue;
+
+			size_t pos = file.GetPos();
+			file.SeekToBegin();
+			ParseGRFSpriteOffsets(file, offsets[i]);
+			file.SeekTo(pos, SEEK_SET);
+		}
+	});
+
+	for (size_t i = 0; i < files.size(); i++) {
+		if (files[i]->GetContainerVersion() >= 2) _prepared_grf_sprite_offsets[files[i]] = std::move(offsets[i]);
+	}
+}
+
+/** Forget the sprite sections parsed by PrepareGRFSpriteOffsets. */
+void ClearPreparedGRFSpriteOffsets()
+{
+	_prepared_grf_sprite_offsets.clear();
 }
 
 
@@ -675,10 +745,12 @@ bool LoadNextSprite(int load_index, SpriteFile &file, uint file_sprite_id)
 	}
 
 	SpriteCache *sc = AllocateSpriteCache(load_index);
+	/* A sprite that gets replaced must not linger in the sprite cache. */
+	if (sc->ptr != nullptr) DeleteEntryFromSpriteCache(load_index);
 	sc->file = &file;
 	sc->file_pos = file_pos;
-	sc->ptr = data;
-	sc->lru = 0;
+	AddToSpriteCache(load_index, data);
+	sc->referenced = false;
 	sc->id = file_sprite_id;
 	sc->type = type;
 	sc->warned = false;
@@ -693,197 +765,123 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
 	SpriteCache *scnew = AllocateSpriteCache(new_spr); // may reallocate: so put it first
 	SpriteCache *scold = GetSpriteCache(old_spr);
 
+	if (scnew->ptr != nullptr) DeleteEntryFromSpriteCache(new_spr);
 	scnew->file = scold->file;
 	scnew->file_pos = scold->file_pos;
-	scnew->ptr = nullptr;
 	scnew->id = scold->id;
 	scnew->type = scold->type;
 	scnew->warned = false;
 }
 
 /**
- * S_FREE_MASK is used to mask-out lower bits of MemBlock::size
- * If they are non-zero, the block is free.
- * S_FREE_MASK has to ensure MemBlock is correctly aligned -
- * it means 8B (S_FREE_MASK == 7) on 64bit systems!
+ * Whether the data of a sprite is owned by the sprite cache.
+ * @param item Index of the sprite.
+ * @return True iff the data of the sprite was allocated by CacheSpriteAllocator.
  */
-static const size_t S_FREE_MASK = sizeof(size_t) - 1;
-
-/* to make sure nobody adds things to MemBlock without checking S_FREE_MASK first */
-static_assert(sizeof(MemBlock) == sizeof(size_t));
-/* make sure it's a power of two */
-static_assert((sizeof(size_t) & (sizeof(size_t) - 1)) == 0);
-
-static inline MemBlock *NextBlock(MemBlock *block)
+static bool IsInSpriteCache(uint item)
 {
-	return (MemBlock*)((uint8_t*)block + (block->size & ~S_FREE_MASK));
+	const SpriteCache *sc = GetSpriteCache(item);
+	return sc->ptr != nullptr && sc->clock_index < _sprite_clock.size() && _sprite_clock[sc->clock_index] == item;
 }
 
-static size_t GetSpriteCacheUsage()
+/**
+ * Delete a single entry from the sprite cache.
+ * @param item Entry to delete.
+ */
+static void DeleteEntryFromSpriteCache(uint item)
 {
-	size_t tot_size = 0;
-	MemBlock *s;
-
-	for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-		if (!(s->size & S_FREE_MASK)) tot_size += s->size;
+	SpriteCache *sc = GetSpriteCache(item);
+	if (!IsInSpriteCache(item)) {
+		/* Not allocated by the sprite cache, e.g. in the unit tests; just forget about it. */
+		sc->ptr = nullptr;
+		return;
 	}
 
-	return tot_size;
-}
-
-
-void IncreaseSpriteLRU()
-{
-	/* Increase all LRU values */
-	if (_sprite_lru_counter > 16384) {
-		SpriteID i;
+	/* Take it out of the clock by moving the last sprite of the clock in its place. */
+	uint32_t last = _sprite_clock.back();
+	_sprite_clock[sc->clock_index] = last;
+	GetSpriteCache(last)->clock_index = sc->clock_index;
+	_sprite_clock.pop_back();
 
-		Debug(sprite, 5, "Fixing lru {}, inuse={}", _sprite_lru_counter, GetSpriteCacheUsage());
-
-		for (i = 0; i != _spritecache_items; i++) {
-			SpriteCache *sc = GetSpriteCache(i);
-			if (sc->ptr != nullptr) {
-				if (sc->lru >= 0) {
-					sc->lru = -1;
-				} else if (sc->lru != -32768) {
-					sc->lru--;
-				}
-			}
-		}
-		_sprite_lru_counter = 0;
-	}
-
-	/* Compact sprite cache every now and then. */
-	if (++_compact_cache_counter >= 740) {
-		CompactSpriteCache();
-		_compact_cache_counter = 0;
-	}
+	MemBlock *block = GetMemBlock(sc->ptr);
+	_sprite_cache_used -= block->size;
+	delete[] reinterpret_cast<uint8_t *>(block);
+	sc->ptr = nullptr;
 }
 
 /**
- * Called when holes in the sprite cache should be removed.
- * That is accomplished by moving the cached data.
+ * Evict a sprite that has not been used for a while from the sprite cache.
+ * The clock hand skips, and clears, the sprites that were used since it last passed them.
+ * @return False if there is nothing that can be evicted.
  */
-static void CompactSpriteCache()
+static bool EvictSpriteFromSpriteCache()
 {
-	MemBlock *s;
-
-	Debug(sprite, 3, "Compacting sprite cache, inuse={}", GetSpriteCacheUsage());
-
-	for (s = _spritecache_ptr; s->size != 0;) {
-		if (s->size & S_FREE_MASK) {
-			MemBlock *next = NextBlock(s);
-			MemBlock temp;
-			SpriteID i;
-
-			/* Since free blocks are automatically coalesced, this should hold true. */
-			assert(!(next->size & S_FREE_MASK));
-
-			/* If the next block is the sentinel block, we can safely return */
-			if (next->size == 0) break;
-
-			/* Locate the sprite belonging to the next pointer. */
-			for (i = 0; GetSpriteCache(i)->ptr != next->data; i++) {
-				assert(i != _spritecache_items);
-			}
-
-			GetSpriteCache(i)->ptr = s->data; // Adjust sprite array entry
-			/* Swap this and the next block */
-			temp = *s;
-			memmove(s, next, next->size);
-			s = NextBlock(s);
-			*s = temp;
-
-			/* Coalesce free blocks */
-			while (NextBlock(s)->size & S_FREE_MASK) {
-				s->size += NextBlock(s)->size & ~S_FREE_MASK;
-			}
+	/* After two rounds every sprite has had its reference cleared, so only recolour sprites would be left. */
+	for (size_t steps = 0; steps < _sprite_clock.size() * 2; steps++) {
+		if (_sprite_clock_hand >= _sprite_clock.size()) _sprite_clock_hand = 0;
+
+		uint32_t item = _sprite_clock[_sprite_clock_hand];
+		SpriteCache *sc = GetSpriteCache(item);
+		if (sc->type == SpriteType::Recolour) {
+			/* Recolour sprites are looked up without going through GetRawSprite, so never evict them. */
+			_sprite_clock_hand++;
+		} else if (sc->referenced) {
+			sc->referenced = false;
+			_sprite_clock_hand++;
 		} else {
-			s = NextBlock(s);
+			Debug(sprite, 3, "Evicting sprite {} from the sprite cache, inuse={}", item, _sprite_cache_used);
+			/* The last sprite of the clock moves into this position, so the hand stays. */
+			DeleteEntryFromSpriteCache(item);
+			return true;
 		}
 	}
+	return false;
 }
 
 /**
- * Delete a single entry from the sprite cache.
- * @param item Entry to delete.
+ * Evict sprites that have not been used for a while until the sprite cache is within its budget again.
+ * Sprite pointers returned by GetSprite are used without any further bookkeeping while drawing,
+ * so sprites may only be evicted at a point where none are held, i.e. between frames.
  */
-static void DeleteEntryFromSpriteCache(uint item)
-{
-	/* Mark the block as free (the block must be in use) */
-	MemBlock *s = (MemBlock*)GetSpriteCache(item)->ptr - 1;
-	assert(!(s->size & S_FREE_MASK));
-	s->size |= S_FREE_MASK;
-	GetSpriteCache(item)->ptr = nullptr;
-
-	/* And coalesce adjacent free blocks */
-	for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-		if (s->size & S_FREE_MASK) {
-			while (NextBlock(s)->size & S_FREE_MASK) {
-				s->size += NextBlock(s)->size & ~S_FREE_MASK;
-			}
-		}
-	}
-}
-
-static void DeleteEntryFromSpriteCache()
+void EvictSpritesFromSpriteCache()
 {
-	uint best = UINT_MAX;
-	int cur_lru;
-
-	Debug(sprite, 3, "DeleteEntryFromSpriteCache, inuse={}", GetSpriteCacheUsage());
-
-	cur_lru = 0xffff;
-	for (SpriteID i = 0; i != _spritecache_items; i++) {
-		SpriteCache *sc = GetSpriteCache(i);
-		if (sc->type != SpriteType::Recolour && sc->ptr != nullptr && sc->lru < cur_lru) {
-			cur_lru = sc->lru;
-			best = i;
-		}
+	while (_sprite_cache_used > _sprite_cache_budget) {
+		/* When nothing can be evicted, stay over budget rather than failing. */
+		if (!EvictSpriteFromSpriteCache()) break;
 	}
-
-	/* Display an error message and die, in case we found no sprite at all.
-	 * This shouldn't really happen, unless all sprites are locked. */
-	if (best == UINT_MAX) FatalError("Out of sprite memory");
-
-	DeleteEntryFromSpriteCache(best);
 }
 
+/**
+ * Allocate memory for a sprite in the sprite cache.
+ * Every sprite is a separate allocation, so freeing is cheap and nothing ever needs to be moved.
+ * Other sprites are never evicted here, the cache may go over its budget until EvictSpritesFromSpriteCache is called.
+ * The sprite is only registered with the sprite cache when it is added to a SpriteCache entry, see AddToSpriteCache.
+ * @param mem_req Number of bytes to allocate.
+ * @return The allocated memory.
+ */
 void *CacheSpriteAllocator::AllocatePtr(size_t mem_req)
 {
 	mem_req += sizeof(MemBlock);
 
-	/* Align this to correct boundary. This also makes sure at least one
-	 * bit is not used, so we can use it for other things. */
-	mem_req = Align(mem_req, S_FREE_MASK + 1);
-
-	for (;;) {
-		MemBlock *s;
-
-		for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-			if (s->size & S_FREE_MASK) {
-				size_t cur_size = s->size & ~S_FREE_MASK;
-
-				/* Is the block exactly the size we need or
-				 * big enough for an additional free block? */
-				if (cur_size == mem_req ||
-						cur_size >= mem_req + sizeof(MemBlock)) {
-					/* Set size and in use */
-					s->size = mem_req;
-
-					/* Do we need to inject a free block too? */
-					if (cur_size != mem_req) {
-						NextBlock(s)->size = (cur_size - mem_req) | S_FREE_MASK;
-					}
+	MemBlock *block = reinterpret_cast<MemBlock *>(new uint8_t[mem_req]);
+	block->size = mem_req;
+	_sprite_cache_used += mem_req;
+	return block->data;
+}
 
-					return s->data;
-				}
-			}
-		}
+/**
+ * Register the data of a sprite, allocated by CacheSpriteAllocator, with the sprite cache.
+ * @param item Index of the sprite.
+ * @param data The data of the sprite.
+ */
+static void AddToSpriteCache(uint item, void *data)
+{
+	SpriteCache *sc = GetSpriteCache(item);
+	sc->ptr = data;
+	if (data == nullptr) return;
 
-		/* Reached sentinel, but no block found yet. Delete some old entry. */
-		DeleteEntryFromSpriteCache();
-	}
+	sc->clock_index = static_cast<uint32_t>(_sprite_clock.size());
+	_sprite_clock.push_back(item);
 }
 
 /**
@@ -974,11 +972,10 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 		/* Load sprite into/from spritecache */
 		CacheSpriteAllocator cache_allocator;
 
-		/* Update LRU */
-		sc->lru = ++_sprite_lru_counter;
+		sc->referenced = true;
 
 		/* Load the sprite, if it is not loaded, yet */
-		if (sc->ptr == nullptr) sc->ptr = ReadSprite(sc, sprite, type, cache_allocator, nullptr);
+		if (sc->ptr == nullptr) AddToSpriteCache(sprite, ReadSprite(sc, sprite, type, cache_allocator, nullptr));
 
 		return sc->ptr;
 	} else {
@@ -990,61 +987,27 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 
 static void GfxInitSpriteCache()
 {
-	/* initialize sprite cache heap */
 	int bpp = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
-	uint target_size = (bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
-
-	/* Remember 'target_size' from the previous allocation attempt, so we do not try to reach the target_size multiple times in case of failure. */
-	static uint last_alloc_attempt = 0;
-
-	if (_spritecache_ptr == nullptr || (_allocated_sprite_cache_size != target_size && target_size != last_alloc_attempt)) {
-		delete[] reinterpret_cast<uint8_t *>(_spritecache_ptr);
-
-		last_alloc_attempt = target_size;
-		_allocated_sprite_cache_size = target_size;
-
-		do {
-			/* Try to allocate 50% more to make sure we do not allocate almost all available. */
-			_spritecache_ptr = reinterpret_cast<MemBlock *>(new(std::nothrow) uint8_t[_allocated_sprite_cache_size + _allocated_sprite_cache_size / 2]);
-
-			if (_spritecache_ptr != nullptr) {
-				/* Allocation succeeded, but we wanted less. */
-				delete[] reinterpret_cast<uint8_t *>(_spritecache_ptr);
-				_spritecache_ptr = reinterpret_cast<MemBlock *>(new uint8_t[_allocated_sprite_cache_size]);
-			} else if (_allocated_sprite_cache_size < 2 * 1024 * 1024) {
-				UserError("Cannot allocate spritecache");
-			} else {
-				/* Try again to allocate half. */
-				_allocated_sprite_cache_size >>= 1;
-			}
-		} while (_spritecache_ptr == nullptr);
-
-		if (_allocated_sprite_cache_size != target_size) {
-			Debug(misc, 0, "Not enough memory to allocate {} MiB of spritecache. Spritecache was reduced to {} MiB.", target_size / 1024 / 1024, _allocated_sprite_cache_size / 1024 / 1024);
-
-			ErrorMessageData msg(STR_CONFIG_ERROR_OUT_OF_MEMORY, STR_CONFIG_ERROR_SPRITECACHE_TOO_BIG);
-			msg.SetDParam(0, target_size);
-			msg.SetDParam(1, _allocated_sprite_cache_size);
-			ScheduleErrorMessage(msg);
-		}
-	}
-
-	/* A big free block */
-	_spritecache_ptr->size = (_allocated_sprite_cache_size - sizeof(MemBlock)) | S_FREE_MASK;
-	/* Sentinel block (identified by size == 0) */
-	NextBlock(_spritecache_ptr)->size = 0;
+	_sprite_cache_budget = static_cast<size_t>(bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
 }
 
 void GfxInitSpriteMem()
 {
 	GfxInitSpriteCache();
 
+	/* Free all sprites in the sprite cache. */
+	for (uint32_t item : _sprite_clock) {
+		delete[] reinterpret_cast<uint8_t *>(GetMemBlock(GetSpriteCache(item)->ptr));
+	}
+	_sprite_clock.clear();
+	_sprite_clock_hand = 0;
+	_sprite_cache_used = 0;
+
 	/* Reset the spritecache 'pool' */
 	free(_spritecache);
 	_spritecache_items = 0;
 	_spritecache = nullptr;
 
-	_compact_cache_counter = 0;
 	_sprite_files.clear();
 }
 
@@ -1076,4 +1039,22 @@ void GfxClearFontSpriteCache()
 	}
 }
 
+/**
+ * Get the number of bytes used by the sprites in the sprite cache.
+ * @return the used bytes
+ */
+size_t GetSpriteCacheUsage()
+{
+	return _sprite_cache_used;
+}
+
+/**
+ * Get the number of bytes the sprite cache may use before sprites are evicted.
+ * @return the budget in bytes
+ */
+size_t GetSpriteCacheBudget()
+{
+	return _sprite_cache_budget;
+}
+
 /* static */ ReusableBuffer<SpriteLoader::CommonPixel> SpriteLoader::Sprite::buffer[ZOOM_LVL_END];
@@ -70,12 +70,16 @@ inline const uint8_t *GetNonSprite(SpriteID sprite, SpriteType type)
 void GfxInitSpriteMem();
 void GfxClearSpriteCache();
 void GfxClearFontSpriteCache();
-void IncreaseSpriteLRU();
+void EvictSpritesFromSpriteCache();
+size_t GetSpriteCacheUsage();
+size_t GetSpriteCacheBudget();
 
 SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 std::span<const std::unique_ptr<SpriteFile>> GetCachedSpriteFiles();
 
 void ReadGRFSpriteOffsets(SpriteFile &file);
+void PrepareGRFSpriteOffsets(std::span<SpriteFile * const> files);
+void ClearPreparedGRFSpriteOffsets();
 size_t GetGRFSpriteOffset(uint32_t id);
 bool LoadNextSprite(int load_index, SpriteFile &file, uint file_sprite_id);
 bool SkipSpriteData(SpriteFile &file, uint8_t type, uint16_t num);
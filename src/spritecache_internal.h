@@ -25,7 +25,8 @@ struct SpriteCache {
 	size_t file_pos;
 	SpriteFile *file;    ///< The file the sprite in this entry can be found in.
 	uint32_t id;
-	int16_t lru;
+	uint32_t clock_index; ///< Position in the clock of sprites in the sprite cache; only meaningful while the sprite is in there.
+	bool referenced;     ///< Whether the sprite was used since the clock hand last passed it.
 	SpriteType type;     ///< In some cases a single sprite is misused by two NewGRFs. Once as real sprite and once as recolour sprite. If the recolour sprite gets into the cache it might be drawn as real sprite which causes enormous trouble.
 	bool warned;         ///< True iff the user has been warned about incorrect use of this sprite
 	uint8_t control_flags;  ///< Control flags, see SpriteCacheCtrlFlags
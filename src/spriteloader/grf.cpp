@@ -81,9 +81,15 @@ bool DecodeSingleSprite(SpriteLoader::Sprite *sprite, SpriteFile &file, size_t f
 			int size = (code == 0) ? 0x80 : code;
 			num -= size;
 			if (num < 0) return WarnCorruptSprite(file, file_pos, __LINE__);
-			for (; size > 0; size--) {
-				*dest = file.ReadByte();
-				dest++;
+			if (const uint8_t *src = file.ReadDirect(size); src != nullptr) {
+				/* Copy the run in one go straight from the file's memory. */
+				memcpy(dest, src, size);
+				dest += size;
+			} else {
+				for (; size > 0; size--) {
+					*dest = file.ReadByte();
+					dest++;
+				}
 			}
 		} else {
 			/* Copy bytes from earlier in the sprite */
@@ -333,6 +339,7 @@ uint8_t LoadSpriteV2(SpriteLoader::SpriteCollection &sprite, SpriteFile &file, s
 			 * otherwise we can calculate it from the image dimensions. */
 			uint decomp_size = (type & 0x08) ? file.ReadDword() : sprite[zoom_lvl].width * sprite[zoom_lvl].height * bpp;
 
+			if (file.GetPos() < start_pos + num) file.Prefetch(start_pos + num - file.GetPos());
 			bool valid = DecodeSingleSprite(&sprite[zoom_lvl], file, file_pos, sprite_type, decomp_size, type, zoom_lvl, colour, 2);
 			if (file.GetPos() != start_pos + num) {
 				WarnCorruptSprite(file, file_pos, __LINE__);
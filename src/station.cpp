@@ -26,6 +26,7 @@
 #include "core/random_func.hpp"
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/linkgraphschedule.h"
+#include "network/network_admin.h"
 
 #include "table/strings.h"
 
@@ -47,6 +48,76 @@ void RebuildStationKdtree()
 	_station_kdtree.Build(stids.begin(), stids.end());
 }
 
+/** Width and height of a cell of the catchment index, in tiles. */
+static const uint CATCHMENT_INDEX_CELL_SIZE = 16;
+
+/**
+ * Index of the stations whose catchment area overlaps a block of the map, per
+ * block of CATCHMENT_INDEX_CELL_SIZE by CATCHMENT_INDEX_CELL_SIZE tiles. This
+ * saves scanning all tiles around an area for station tiles.
+ */
+static std::vector<std::vector<StationID>> _station_catchment_index;
+
+/** Remove all stations from the catchment index, e.g. when the map changes. */
+void ClearStationCatchmentIndex()
+{
+	_station_catchment_index.clear();
+}
+
+/**
+ * Call a function for all cells of the catchment index that overlap an area.
+ * @param ta The area.
+ * @param func The function to call with the list of stations of the cell.
+ */
+template <typename Func>
+static void ForAllCatchmentIndexCells(const TileArea &ta, Func func)
+{
+	if (ta.tile == INVALID_TILE || ta.w == 0 || ta.h == 0) return;
+
+	uint cells_x = Map::SizeX() / CATCHMENT_INDEX_CELL_SIZE;
+	if (_station_catchment_index.empty()) _station_catchment_index.resize(cells_x * (Map::SizeY() / CATCHMENT_INDEX_CELL_SIZE));
+
+	uint x1 = TileX(ta.tile) / CATCHMENT_INDEX_CELL_SIZE;
+	uint y1 = TileY(ta.tile) / CATCHMENT_INDEX_CELL_SIZE;
+	uint x2 = (TileX(ta.tile) + ta.w - 1) / CATCHMENT_INDEX_CELL_SIZE;
+	uint y2 = (TileY(ta.tile) + ta.h - 1) / CATCHMENT_INDEX_CELL_SIZE;
+	for (uint y = y1; y <= y2; y++) {
+		for (uint x = x1; x <= x2; x++) {
+			func(_station_catchment_index[y * cells_x + x]);
+		}
+	}
+}
+
+/**
+ * Find the stations whose catchment area might cover any tile of an area.
+ * This may find more stations than needed, but never misses one.
+ * @param ta The area.
+ * @param[out] stations The set to add the stations to.
+ */
+void FindStationsWithCatchmentNear(const TileArea &ta, std::set<StationID> &stations)
+{
+	ForAllCatchmentIndexCells(ta, [&stations](const std::vector<StationID> &cell) {
+		stations.insert(cell.begin(), cell.end());
+	});
+}
+
+/** Add this station to the catchment index, for its current catchment area. */
+void Station::AddToCatchmentIndex() const
+{
+	ForAllCatchmentIndexCells(this->catchment_tiles, [this](std::vector<StationID> &cell) {
+		cell.push_back(this->index);
+	});
+}
+
+/** Remove this station from the catchment index, for its current catchment area. */
+void Station::RemoveFromCatchmentIndex() const
+{
+	ForAllCatchmentIndexCells(this->catchment_tiles, [this](std::vector<StationID> &cell) {
+		auto it = std::find(cell.begin(), cell.end(), this->index);
+		if (it != cell.end()) cell.erase(it);
+	});
+}
+
 
 BaseStation::~BaseStation()
 {
@@ -89,6 +160,8 @@ Station::~Station()
 		return;
 	}
 
+	NetworkAdminStationRemove(this->index);
+
 	while (!this->loading_vehicles.empty()) {
 		this->loading_vehicles.front()->LeaveStation();
 	}
@@ -129,6 +202,7 @@ Station::~Station()
 
 	/* Remove station from industries and towns that reference it. */
 	this->RemoveFromAllNearbyLists();
+	this->RemoveFromCatchmentIndex();
 
 	/* Clear the persistent storage. */
 	delete this->airport.psa;
@@ -471,6 +545,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 {
 	this->industries_near.clear();
 	if (!no_clear_nearby_lists) this->RemoveFromAllNearbyLists();
+	this->RemoveFromCatchmentIndex();
 
 	if (this->rect.IsEmpty()) {
 		this->catchment_tiles.Reset();
@@ -485,6 +560,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 				this->catchment_tiles.SetTile(tile);
 			}
 		}
+		this->AddToCatchmentIndex();
 		/* The industry's stations_near may have been computed before its neutral station was built so clear and re-add here. */
 		for (Station *st : this->industry->stations_near) {
 			st->RemoveIndustryToDeliver(this->industry);
@@ -509,6 +585,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 		TileArea ta2 = TileArea(tile, 1, 1).Expand(r);
 		for (TileIndex tile2 : ta2) this->catchment_tiles.SetTile(tile2);
 	}
+	this->AddToCatchmentIndex();
 
 	/* Search catchment tiles for towns and industries */
 	BitmapTileIterator it(this->catchment_tiles);
@@ -539,6 +616,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 {
 	for (Town *t : Town::Iterate()) { t->stations_near.clear(); }
 	for (Industry *i : Industry::Iterate()) { i->stations_near.clear(); }
+	ClearStationCatchmentIndex();
 	for (Station *st : Station::Iterate()) { st->RecomputeCatchment(true); }
 }
 
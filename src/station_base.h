@@ -18,27 +18,28 @@
 #include "linkgraph/linkgraph_type.h"
 #include "newgrf_storage.h"
 #include "bitmap_type.h"
+#include "core/flatmap_type.hpp"
 
 static const uint8_t INITIAL_STATION_RATING = 175;
 static const uint8_t MAX_STATION_RATING = 255;
 
 /**
  * Flow statistics telling how much flow should be sent along a link. This is
- * done by creating "flow shares" and using std::map's upper_bound() method to
+ * done by creating "flow shares" and using the map's upper_bound() method to
  * look them up with a random number. A flow share is the difference between a
  * key in a map and the previous key. So one key in the map doesn't actually
  * mean anything by itself.
  */
 class FlowStat {
 public:
-	typedef std::map<uint32_t, StationID> SharesMap;
+	typedef FlatMap<uint32_t, StationID> SharesMap;
 
 	static const SharesMap empty_sharesmap;
 
 	/**
 	 * Invalid constructor. This can't be called as a FlowStat must not be
 	 * empty. However, the constructor must be defined and reachable for
-	 * FlowStat to be used in a std::map.
+	 * FlowStat to be used in a map.
 	 */
 	inline FlowStat() {NOT_REACHED();}
 
@@ -144,8 +145,12 @@ private:
 	uint unrestricted; ///< Limit for unrestricted shares.
 };
 
-/** Flow descriptions by origin stations. */
-class FlowStatMap : public std::map<StationID, FlowStat> {
+/**
+ * Flow descriptions by origin stations. These are looked up and iterated for
+ * every cargo packet that gets routed, but only change when a link graph job
+ * finishes, so they are stored flat.
+ */
+class FlowStatMap : public FlatMap<StationID, FlowStat> {
 public:
 	uint GetFlow() const;
 	uint GetFlowVia(StationID via) const;
@@ -495,6 +500,8 @@ public:
 	void AddIndustryToDeliver(Industry *ind, TileIndex tile);
 	void RemoveIndustryToDeliver(Industry *ind);
 	void RemoveFromAllNearbyLists();
+	void AddToCatchmentIndex() const;
+	void RemoveFromCatchmentIndex() const;
 
 	inline bool TileIsInCatchment(TileIndex tile) const
 	{
@@ -552,6 +559,8 @@ public:
 };
 
 void RebuildStationKdtree();
+void ClearStationCatchmentIndex();
+void FindStationsWithCatchmentNear(const TileArea &ta, std::set<StationID> &stations);
 
 /**
  * Call a function on all stations that have any part of the requested area within their catchment.
@@ -566,16 +575,10 @@ void ForAllStationsAroundTiles(const TileArea &ta, Func func)
 	/* There are no stations, so we will never find anything. */
 	if (Station::GetNumItems() == 0) return;
 
-	/* Not using, or don't have a nearby stations list, so we need to scan. */
+	/* Not using, or don't have a nearby stations list, so we need to look up the
+	 * stations whose catchment area might cover the requested area. */
 	std::set<StationID> seen_stations;
-
-	/* Scan an area around the building covering the maximum possible station
-	 * to find the possible nearby stations. */
-	uint max_c = _settings_game.station.modified_catchment ? MAX_CATCHMENT : CA_UNMODIFIED;
-	TileArea ta_ext = TileArea(ta).Expand(max_c);
-	for (TileIndex tile : ta_ext) {
-		if (IsTileType(tile, MP_STATION)) seen_stations.insert(GetStationIndex(tile));
-	}
+	FindStationsWithCatchmentNear(ta, seen_stations);
 
 	for (StationID stationid : seen_stations) {
 		Station *st = Station::GetIfValid(stationid);
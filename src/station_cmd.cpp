@@ -67,6 +67,7 @@
 #include "timer/timer_game_tick.h"
 #include "cheat_type.h"
 #include "road_func.h"
+#include "trace.h"
 
 #include "widgets/station_widget.h"
 
@@ -3091,6 +3092,9 @@ static void DrawTile_Station(TileInfo *ti)
 	const StationSpec *statspec = nullptr;
 	uint tile_layout = 0;
 
+	/* The sprite layout, relocation and foundation resolves of a tile all ask for the same expensive platform variables. */
+	StationTileVariableCacheScope station_variable_cache(ti->tile);
+
 	if (HasStationRail(ti->tile)) {
 		rti = GetRailTypeInfo(GetRailType(ti->tile));
 		total_offset = rti->GetRailtypeSpriteOffset();
@@ -3830,6 +3834,7 @@ static void TruncateCargo(const CargoSpec *cs, GoodsEntry *ge, uint amount = UIN
 static void UpdateStationRating(Station *st)
 {
 	bool waiting_changed = false;
+	bool rating_changed = false;
 
 	byte_inc_sat(&st->time_since_load);
 	byte_inc_sat(&st->time_since_unload);
@@ -3841,6 +3846,7 @@ static void UpdateStationRating(Station *st)
 		 *  failed while you didn't moved that cargo yet to a station. */
 		if (!ge->HasRating() && ge->rating < INITIAL_STATION_RATING) {
 			ge->rating++;
+			rating_changed = true;
 		}
 
 		/* Only change the rating if we are moving this cargo */
@@ -3872,6 +3878,7 @@ static void UpdateStationRating(Station *st)
 			uint waiting_avg = waiting / (num_dests + 1);
 
 			if (_cheats.station_rating.value) {
+				if (ge->rating != MAX_STATION_RATING) rating_changed = true;
 				ge->rating = rating = MAX_STATION_RATING;
 				skip = true;
 			} else if (HasBit(cs->callback_mask, CBM_CARGO_STATION_RATING_CALC)) {
@@ -3927,6 +3934,7 @@ static void UpdateStationRating(Station *st)
 
 				/* only modify rating in steps of -2, -1, 0, 1 or 2 */
 				ge->rating = rating = or_ + Clamp(ClampTo<uint8_t>(rating) - or_, -2, 2);
+				if (rating != or_) rating_changed = true;
 
 				/* if rating is <= 64 and more than 100 items waiting on average per destination,
 				 * remove some random amount of goods from the station */
@@ -3978,10 +3986,12 @@ static void UpdateStationRating(Station *st)
 		}
 	}
 
+	/* Finding the window means walking all windows, so only do so when something visible changed. In the
+	 * steady state most ratings stay the same, and this is done for every station every 2.5 days. */
 	StationID index = st->index;
 	if (waiting_changed) {
 		SetWindowDirty(WC_STATION_VIEW, index); // update whole window
-	} else {
+	} else if (rating_changed) {
 		SetWindowWidgetDirty(WC_STATION_VIEW, index, WID_SV_ACCEPT_RATING_LIST); // update only ratings list
 	}
 }
@@ -4196,6 +4206,8 @@ void OnTick_Station()
 {
 	if (_game_mode == GM_EDITOR) return;
 
+	TraceZone trace("OnTick_Station");
+
 	for (BaseStation *st : BaseStation::Iterate()) {
 		StationHandleSmallTick(st);
 
@@ -5072,7 +5084,7 @@ StationIDStack FlowStatMap::DeleteFlows(StationID via)
 		s_flows.ChangeShare(via, INT_MIN);
 		if (s_flows.GetShares()->empty()) {
 			ret.Push(f_it->first);
-			this->erase(f_it++);
+			f_it = this->erase(f_it);
 		} else {
 			++f_it;
 		}
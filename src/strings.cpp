@@ -899,6 +899,56 @@ uint ConvertDisplaySpeedToKmhishSpeed(uint speed, VehicleType type)
 	return GetVelocityUnits(type).c.FromDisplay(speed * 16, true, 10);
 }
 
+/**
+ * Check whether formatting a string needs a dry run first.
+ * That is only the case when a gender choice has to know the type of a parameter
+ * that might come later in the string, or when NewGRF control codes are in it,
+ * as those may refer to values of the NewGRF text stack or insert other strings.
+ * @param str The string with format codes.
+ * @return True iff a dry run is needed.
+ */
+static bool FormatStringNeedsDryRun(const char *str)
+{
+	for (;;) {
+		char32_t c = Utf8Consume(&str);
+		switch (c) {
+			case '\0': return false;
+			case SCC_GENDER_LIST: return true;
+
+			/* The raw bytes following these codes can be zero, so they must be skipped. */
+			case SCC_ARG_INDEX:
+			case SCC_SET_CASE:
+			case SCC_GENDER_INDEX:
+				str++;
+				break;
+
+			case SCC_PLURAL_LIST: {
+				/* <PLURAL FORM> <OFFSET> <NUM> {Length of each string} {each string} */
+				str += 2;
+				uint num = (uint8_t)*str++;
+				uint len = 0;
+				for (uint i = 0; i != num; i++) len += (uint8_t)*str++;
+				str += len;
+				break;
+			}
+
+			case SCC_SWITCH_CASE: {
+				/* <NUM CASES> <CASE1> <LEN1> <STRING1> ... <STRINGDEFAULT>; each case string is terminated separately. */
+				uint num = (uint8_t)*str++;
+				for (; num != 0; num--) {
+					if (FormatStringNeedsDryRun(str + 3)) return true;
+					str += 3 + ((uint8_t)str[1] << 8) + (uint8_t)str[2];
+				}
+				break;
+			}
+
+			default:
+				if (SCC_NEWGRF_FIRST <= c && c <= SCC_NEWGRF_LAST) return true;
+				break;
+		}
+	}
+}
+
 /**
  * Parse most format codes within a string and write the result to a buffer.
  * @param builder The string builder to write the final string to.
@@ -910,14 +960,14 @@ static void FormatString(StringBuilder &builder, const char *str_arg, StringPara
 {
 	size_t orig_offset = args.GetOffset();
 
-	if (!dry_run) {
+	if (!dry_run && (game_script || UsingNewGRFTextStack() || FormatStringNeedsDryRun(str_arg))) {
 		/*
 		 * This function is normally called with `dry_run` false, then we call this function again
 		 * with `dry_run` being true. The dry run is required for the gender formatting. For the
 		 * gender determination we need to format a sub string to get the gender, but for that we
 		 * need to know as what string control code type the specific parameter is encoded. Since
 		 * gendered words can be before the "parameter" words, this needs to be determined before
-		 * the actual formatting.
+		 * the actual formatting. Most strings have no gender at all, so they can do without.
 		 */
 		std::string buffer;
 		StringBuilder dry_run_builder(buffer);
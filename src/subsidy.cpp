@@ -311,6 +311,27 @@ bool FindSubsidyPassengerRoute()
 
 bool FindSubsidyCargoDestination(CargoID cid, SourceType src_type, SourceID src);
 
+/**
+ * Checks whether a subsidy could be offered between a source and destination, not looking at the cargo acceptance.
+ * @param cid      Subsidized cargo.
+ * @param src_type Type of \a src.
+ * @param src      Index of source.
+ * @param dst_type Type of \a dst.
+ * @param dst      Index of destination.
+ * @return True iff the route is neither too long nor already subsidised.
+ */
+static bool CheckSubsidyRoute(CargoID cid, SourceType src_type, SourceID src, SourceType dst_type, SourceID dst)
+{
+	/* Check that the source and the destination are not the same. */
+	if (src_type == dst_type && src == dst) return false;
+
+	/* Check distance between source and destination. */
+	if (!CheckSubsidyDistance(src_type, src, dst_type, dst)) return false;
+
+	/* Avoid duplicate subsidies. */
+	return !CheckSubsidyDuplicate(cid, src_type, src, dst_type, dst);
+}
+
 
 /**
  * Tries to create a cargo subsidy with a town as source.
@@ -434,6 +455,10 @@ bool FindSubsidyCargoDestination(CargoID cid, SourceType src_type, SourceID src)
 		case SourceType::Town: {
 			/* Select a random town. */
 			const Town *dst_town = Town::GetRandom();
+			dst = dst_town->index;
+
+			/* Most random towns are too far away, so check that before the more expensive scan of the houses. */
+			if (!CheckSubsidyRoute(cid, src_type, src, dst_type, dst)) return false;
 
 			/* Calculate cargo acceptance of houses around town center. */
 			CargoArray town_cargo_accepted{};
@@ -446,8 +471,6 @@ bool FindSubsidyCargoDestination(CargoID cid, SourceType src_type, SourceID src)
 
 			/* Check if the town can accept this cargo. */
 			if (town_cargo_accepted[cid] < 8) return false;
-
-			dst = dst_town->index;
 			break;
 		}
 
@@ -460,21 +483,13 @@ bool FindSubsidyCargoDestination(CargoID cid, SourceType src_type, SourceID src)
 			if (!dst_ind->IsCargoAccepted(cid)) return false;
 
 			dst = dst_ind->index;
+			if (!CheckSubsidyRoute(cid, src_type, src, dst_type, dst)) return false;
 			break;
 		}
 
 		default: NOT_REACHED();
 	}
 
-	/* Check that the source and the destination are not the same. */
-	if (src_type == dst_type && src == dst) return false;
-
-	/* Check distance between source and destination. */
-	if (!CheckSubsidyDistance(src_type, src, dst_type, dst)) return false;
-
-	/* Avoid duplicate subsidies. */
-	if (CheckSubsidyDuplicate(cid, src_type, src, dst_type, dst)) return false;
-
 	CreateSubsidy(cid, src_type, src, dst_type, dst);
 
 	return true;
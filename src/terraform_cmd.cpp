@@ -17,21 +17,22 @@
 #include "company_base.h"
 #include "company_func.h"
 #include "core/backup_type.hpp"
+#include "core/flatmap_type.hpp"
 #include "terraform_cmd.h"
 #include "landscape_cmd.h"
+#include "water.h"
+#include "pathfinder/yapf/yapf_cache.h"
 
 #include "table/strings.h"
 
 #include "safeguards.h"
 
-/** Set of tiles. */
-typedef std::set<TileIndex> TileIndexSet;
 /** Mapping of tiles to their height. */
-typedef std::map<TileIndex, int> TileIndexToHeightMap;
+typedef FlatMap<TileIndex, int> TileIndexToHeightMap;
 
 /** State of the terraforming. */
 struct TerraformerState {
-	TileIndexSet dirty_tiles;                ///< The tiles that need to be redrawn.
+	std::vector<TileIndex> dirty_tiles;      ///< The tiles that need to be redrawn; sorted and made unique by #TerraformSortDirtyTiles.
 	TileIndexToHeightMap tile_to_new_height; ///< The tiles for which the height has changed.
 };
 
@@ -61,7 +62,7 @@ static void TerraformSetHeightOfTile(TerraformerState *ts, TileIndex tile, int h
 }
 
 /**
- * Adds a tile to the "tile_table" in a TerraformerState.
+ * Adds a tile to the dirty tiles of a TerraformerState.
  *
  * @param ts TerraformerState.
  * @param tile Tile.
@@ -69,11 +70,24 @@ static void TerraformSetHeightOfTile(TerraformerState *ts, TileIndex tile, int h
  */
 static void TerraformAddDirtyTile(TerraformerState *ts, TileIndex tile)
 {
-	ts->dirty_tiles.insert(tile);
+	ts->dirty_tiles.push_back(tile);
 }
 
 /**
- * Adds all tiles that incident with the north corner of a specific tile to the "tile_table" in a TerraformerState.
+ * Sort the dirty tiles of a TerraformerState and remove the duplicates,
+ * once all tiles have been added.
+ *
+ * @param ts TerraformerState.
+ * @ingroup dirty
+ */
+static void TerraformSortDirtyTiles(TerraformerState *ts)
+{
+	std::sort(ts->dirty_tiles.begin(), ts->dirty_tiles.end());
+	ts->dirty_tiles.erase(std::unique(ts->dirty_tiles.begin(), ts->dirty_tiles.end()), ts->dirty_tiles.end());
+}
+
+/**
+ * Adds all tiles that incident with the north corner of a specific tile to the dirty tiles of a TerraformerState.
  *
  * @param ts TerraformerState.
  * @param tile Tile.
@@ -213,6 +227,8 @@ std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags,
 		total_cost.AddCost(cost);
 	}
 
+	TerraformSortDirtyTiles(&ts);
+
 	/* Check if the terraforming is valid wrt. tunnels, bridges and objects on the surface
 	 * Pass == 0: Collect tileareas which are caused to be auto-cleared.
 	 * Pass == 1: Collect the actual cost. */
@@ -293,9 +309,10 @@ std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags,
 	}
 
 	if (flags & DC_EXEC) {
-		/* Mark affected areas dirty. */
+		/* Mark affected areas dirty. The slopes of these tiles change, so water around them may flood again. */
 		for (const auto &t : ts.dirty_tiles) {
 			MarkTileDirtyByTile(t);
+			ClearNeighbourNonFloodingStates(t);
 			TileIndexToHeightMap::const_iterator new_height = ts.tile_to_new_height.find(t);
 			if (new_height == ts.tile_to_new_height.end()) continue;
 			MarkTileDirtyByTile(t, 0, new_height->second);
@@ -307,6 +324,8 @@ std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags,
 			int height = it.second;
 
 			SetTileHeight(t, (uint)height);
+			/* The slope of the tracks on the tiles around this corner may have changed. */
+			YapfNotifyTrackLayoutChange(t, INVALID_TRACK);
 		}
 
 		if (c != nullptr) c->terraform_limit -= (uint32_t)ts.tile_to_new_height.size() << 16;
@@ -0,0 +1,88 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file binaryheap.cpp Test functionality from misc/binaryheap. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../misc/binaryheap.hpp"
+
+/** Item of the heap, ordered by its key. */
+struct HeapItem {
+	int key;
+	bool operator<(const HeapItem &other) const { return this->key < other.key; }
+};
+
+template <size_t Tarity>
+static void CheckHeapOrder()
+{
+	std::vector<HeapItem> items;
+	for (int i = 0; i < 100; i++) items.push_back({(i * 37) % 101});
+
+	CBinaryHeapT<HeapItem, Tarity> heap(16);
+	for (HeapItem &item : items) heap.Include(&item);
+	CHECK(heap.Length() == items.size());
+
+	/* Remove some items from the middle. */
+	for (int i = 0; i < 100; i += 7) {
+		size_t index = heap.FindIndex(items[i]);
+		REQUIRE(index != 0);
+		heap.Remove(index);
+	}
+	CHECK(heap.FindIndex(items[0]) == 0);
+
+	int last = -1;
+	while (!heap.IsEmpty()) {
+		HeapItem *item = heap.Shift();
+		CHECK(item->key >= last);
+		last = item->key;
+	}
+}
+
+TEST_CASE("BinaryHeap - binary")
+{
+	CheckHeapOrder<2>();
+}
+
+TEST_CASE("BinaryHeap - 4-ary")
+{
+	CheckHeapOrder<4>();
+}
+
+/**
+ * Use the heap like the open list of a pathfinder does; keep shifting the best
+ * item and including a few new items that are slightly worse than it.
+ * @return The sum of the keys of all shifted items, so nothing gets optimised away.
+ */
+template <size_t Tarity>
+static int64_t RunOpenListWorkload(std::vector<HeapItem> &items)
+{
+	CBinaryHeapT<HeapItem, Tarity> heap(1024);
+	size_t next = 0;
+	int64_t sum = 0;
+
+	heap.Include(&items[next++]);
+	while (!heap.IsEmpty()) {
+		HeapItem *best = heap.Shift();
+		sum += best->key;
+		for (int i = 0; i < 3 && next < items.size(); i++) {
+			items[next].key = best->key + (int)((next * 2654435761U) % 1000);
+			heap.Include(&items[next++]);
+		}
+	}
+	return sum;
+}
+
+TEST_CASE("BinaryHeap - open list benchmark", "[.][benchmark]")
+{
+	std::vector<HeapItem> items(100000);
+
+	BENCHMARK("binary") { return RunOpenListWorkload<2>(items); };
+	BENCHMARK("4-ary") { return RunOpenListWorkload<4>(items); };
+}
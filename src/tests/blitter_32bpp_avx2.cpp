@@ -0,0 +1,117 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file blitter_32bpp_avx2.cpp Test the AVX2 32bpp blitter against the SSE4 one it is derived from. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../blitter/factory.hpp"
+#include "../core/random_func.hpp"
+#include "../spritecache.h"
+
+#if defined(WITH_SSE) && !defined(DEDICATED)
+
+static const int SPRITE_WIDTH = 61;  ///< Width of the test sprite; odd, so the single pixel paths are used as well.
+static const int SPRITE_HEIGHT = 16; ///< Height of the test sprite.
+
+/**
+ * Make a sprite with random colours, with transparent, translucent and opaque pixels.
+ * @param random Random number generator to use.
+ * @param sprite Collection to put the sprite in; only the lowest zoom level is used.
+ */
+static void MakeRandomSprite(Randomizer &random, SpriteLoader::SpriteCollection &sprite)
+{
+	SpriteLoader::Sprite &s = sprite[ZOOM_LVL_MIN];
+	s.width = SPRITE_WIDTH;
+	s.height = SPRITE_HEIGHT;
+	s.x_offs = 0;
+	s.y_offs = 0;
+	/* Font sprites are only encoded for a single zoom level. */
+	s.type = SpriteType::Font;
+	s.colours = SCC_RGB | SCC_ALPHA;
+	s.AllocateData(ZOOM_LVL_MIN, SPRITE_WIDTH * SPRITE_HEIGHT);
+
+	for (int i = 0; i < SPRITE_WIDTH * SPRITE_HEIGHT; i++) {
+		SpriteLoader::CommonPixel &px = s.data[i];
+		px.r = random.Next(256);
+		px.g = random.Next(256);
+		px.b = random.Next(256);
+		switch (random.Next(4)) {
+			case 0: px.a = 0; break;
+			case 1: px.a = 255; break;
+			default: px.a = random.Next(256); break;
+		}
+		px.m = 0;
+	}
+}
+
+/**
+ * Draw a sprite with a blitter onto a copy of the given background.
+ * @param blitter The blitter to draw with.
+ * @param sprite The sprite, before encoding.
+ * @param background The pixels to draw onto.
+ * @param mode The blitter mode to draw with.
+ * @param skip_left Number of sprite pixels to skip on the left.
+ * @return The resulting pixels.
+ */
+static std::vector<uint32_t> DrawSprite(Blitter *blitter, const SpriteLoader::SpriteCollection &sprite, const std::vector<uint32_t> &background, BlitterMode mode, int skip_left)
+{
+	UniquePtrSpriteAllocator allocator;
+	Sprite *encoded = blitter->Encode(sprite, allocator);
+
+	static uint8_t identity_remap[256];
+	for (int i = 0; i < 256; i++) identity_remap[i] = i;
+
+	std::vector<uint32_t> pixels = background;
+	Blitter::BlitterParams bp{};
+	bp.sprite = encoded->data;
+	bp.remap = identity_remap;
+	bp.skip_left = skip_left;
+	bp.skip_top = 0;
+	bp.width = SPRITE_WIDTH - skip_left;
+	bp.height = SPRITE_HEIGHT;
+	bp.sprite_width = SPRITE_WIDTH;
+	bp.sprite_height = SPRITE_HEIGHT;
+	bp.left = 0;
+	bp.top = 0;
+	bp.dst = pixels.data();
+	bp.pitch = SPRITE_WIDTH;
+	blitter->Draw(&bp, mode, ZOOM_LVL_MIN);
+	return pixels;
+}
+
+TEST_CASE("Blitter_32bppAVX2 - draws the same as the SSE4 blitter on random input")
+{
+	BlitterFactory *sse4_factory = BlitterFactory::GetBlitterFactory("32bpp-sse4");
+	BlitterFactory *avx2_factory = BlitterFactory::GetBlitterFactory("32bpp-avx2");
+	if (sse4_factory == nullptr || avx2_factory == nullptr) {
+		WARN("The CPU does not support AVX2 or SSE4.1; skipping.");
+		return;
+	}
+	std::unique_ptr<Blitter> sse4(sse4_factory->CreateInstance());
+	std::unique_ptr<Blitter> avx2(avx2_factory->CreateInstance());
+
+	Randomizer random;
+	random.SetSeed(1);
+	for (int round = 0; round < 32; round++) {
+		SpriteLoader::SpriteCollection sprite;
+		MakeRandomSprite(random, sprite);
+
+		std::vector<uint32_t> background(SPRITE_WIDTH * SPRITE_HEIGHT);
+		for (uint32_t &px : background) px = random.Next() | 0xFF000000;
+
+		/* Without skipping the margin path is used, with skipping the path that reads every pixel. */
+		for (int skip_left : {0, 3}) {
+			CHECK(DrawSprite(sse4.get(), sprite, background, BM_NORMAL, skip_left) == DrawSprite(avx2.get(), sprite, background, BM_NORMAL, skip_left));
+		}
+		CHECK(DrawSprite(sse4.get(), sprite, background, BM_TRANSPARENT, 0) == DrawSprite(avx2.get(), sprite, background, BM_TRANSPARENT, 0));
+	}
+}
+
+#endif /* WITH_SSE && !DEDICATED */
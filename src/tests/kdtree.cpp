@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file kdtree.cpp Test functionality from core/kdtree. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/kdtree.hpp"
+
+/** Coordinates of the test points; the index into this is stored in the tree. */
+static std::vector<std::pair<int, int>> _kdtree_points;
+
+/** Get a coordinate of a test point. */
+static int KdtreePointXY(uint index, int dim)
+{
+	return dim == 0 ? _kdtree_points[index].first : _kdtree_points[index].second;
+}
+
+using TestKdtree = Kdtree<uint, decltype(&KdtreePointXY), int, int>;
+
+/** Find the nearest point the slow way, with the same tie breaking as the tree. */
+static uint FindNearestBruteForce(int x, int y)
+{
+	uint best = 0;
+	int best_dist = INT_MAX;
+	for (uint i = 0; i < _kdtree_points.size(); i++) {
+		int dist = abs(_kdtree_points[i].first - x) + abs(_kdtree_points[i].second - y);
+		if (dist < best_dist) {
+			best = i;
+			best_dist = dist;
+		}
+	}
+	return best;
+}
+
+TEST_CASE("Kdtree - FindNearest matches brute force")
+{
+	_kdtree_points.clear();
+	std::vector<uint> indices;
+	for (uint i = 0; i < 500; i++) {
+		/* Coarse coordinates, so there are many ties in distance. */
+		_kdtree_points.emplace_back((i * 7919) % 64, (i * 104729) % 64);
+		indices.push_back(i);
+	}
+
+	TestKdtree tree(&KdtreePointXY);
+	tree.Build(indices.begin(), indices.end());
+	CHECK(tree.Count() == indices.size());
+
+	for (int x = -4; x < 68; x += 3) {
+		for (int y = -4; y < 68; y += 5) {
+			CHECK(tree.FindNearest(x, y) == FindNearestBruteForce(x, y));
+		}
+	}
+
+	/* Remove half of the points one by one, which unbalances and rebuilds the tree. */
+	for (uint i = 0; i < 500; i += 2) tree.Remove(i);
+	CHECK(tree.Count() == 250);
+
+	for (int x = -4; x < 68; x += 3) {
+		for (int y = -4; y < 68; y += 5) {
+			uint nearest = tree.FindNearest(x, y);
+			CHECK(nearest % 2 == 1);
+			int dist = abs(_kdtree_points[nearest].first - x) + abs(_kdtree_points[nearest].second - y);
+			for (uint i = 1; i < 500; i += 2) {
+				int other = abs(_kdtree_points[i].first - x) + abs(_kdtree_points[i].second - y);
+				CHECK((other > dist || (other == dist && i >= nearest)));
+			}
+		}
+	}
+}
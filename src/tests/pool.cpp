@@ -0,0 +1,75 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file pool.cpp Test functionality from core/pool_type. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/pool_func.hpp"
+
+struct PoolTestItem;
+using PoolTestPool = Pool<PoolTestItem, uint16_t, 16, 4000, PT_NORMAL>;
+static PoolTestPool _pool_test_pool("PoolTest");
+
+/** Item of the pool to test with. */
+struct PoolTestItem : PoolTestPool::PoolItem<&_pool_test_pool> {
+	uint value; ///< Some value for the item.
+
+	PoolTestItem(uint value) : value(value) {}
+};
+
+INSTANTIATE_POOL_METHODS(PoolTest)
+
+TEST_CASE("Pool - Iterate skips free indices")
+{
+	_pool_test_pool.CleanPool();
+
+	REQUIRE(PoolTestItem::CanAllocateItem(1000));
+	for (uint i = 0; i < 1000; i++) new PoolTestItem(i);
+
+	/* Free indices in runs of varying length, so whole bitmap words end up empty too. */
+	for (uint i = 0; i < 1000; i++) {
+		if (i % 7 == 0 || (i >= 128 && i < 320) || i % 64 == 63 || i >= 990) delete PoolTestItem::Get(i);
+	}
+
+	std::vector<size_t> expected;
+	for (size_t i = 0; i < PoolTestItem::GetPoolSize(); i++) {
+		if (PoolTestItem::IsValidID(i)) expected.push_back(i);
+	}
+
+	std::vector<size_t> iterated;
+	for (const PoolTestItem *item : PoolTestItem::Iterate()) iterated.push_back(item->index);
+	CHECK(iterated == expected);
+
+	iterated.clear();
+	for (const PoolTestItem *item : PoolTestItem::Iterate(200)) iterated.push_back(item->index);
+	CHECK(iterated == std::vector<size_t>(std::lower_bound(expected.begin(), expected.end(), 200), expected.end()));
+
+	CHECK(PoolTestItem::GetNextUsedIndex(expected.back() + 1) == PoolTestItem::GetPoolSize());
+
+	_pool_test_pool.CleanPool();
+	CHECK(PoolTestItem::Iterate().empty());
+}
+
+TEST_CASE("Pool - GetMemoryUsage")
+{
+	_pool_test_pool.CleanPool();
+
+	REQUIRE(PoolTestItem::CanAllocateItem(20));
+	for (uint i = 0; i < 20; i++) new PoolTestItem(i);
+	delete PoolTestItem::Get(3);
+
+	PoolMemoryUsage usage = _pool_test_pool.GetMemoryUsage();
+	CHECK(usage.items == 19);
+	CHECK(usage.used_bytes == 19 * sizeof(PoolTestItem));
+	CHECK(usage.allocated_bytes >= usage.used_bytes + 32 * sizeof(PoolTestItem *));
+
+	_pool_test_pool.CleanPool();
+	CHECK(_pool_test_pool.GetMemoryUsage().allocated_bytes == 0);
+}
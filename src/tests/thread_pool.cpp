@@ -0,0 +1,46 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file thread_pool.cpp Test functionality from thread_pool. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../thread_pool.h"
+
+#include <atomic>
+
+TEST_CASE("ThreadPool - every index exactly once")
+{
+	for (size_t count : { 0, 1, 7, 1000, 100000 }) {
+		std::vector<std::atomic<int>> seen(count);
+		std::atomic<bool> empty_range = false;
+		/* Catch2 is not thread safe, so only check the results afterwards. */
+		ThreadPool::ParallelFor(count, 16, [&seen, &empty_range](size_t begin, size_t end) {
+			if (begin >= end) empty_range = true;
+			for (size_t i = begin; i < end; i++) seen[i]++;
+		});
+
+		CHECK_FALSE(empty_range);
+
+		for (size_t i = 0; i < count; i++) CHECK(seen[i] == 1);
+	}
+}
+
+TEST_CASE("ThreadPool - nested sections")
+{
+	std::atomic<size_t> total = 0;
+	ThreadPool::ParallelFor(64, 1, [&total](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			ThreadPool::ParallelFor(100, 1, [&total](size_t begin, size_t end) { total += end - begin; });
+		}
+	});
+	CHECK(total == 6400);
+
+	ThreadPool::Shutdown();
+}
@@ -0,0 +1,158 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file viewport_sprite_sorter.cpp Test the parent sprite sorters of the viewport. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "mock_spritecache.h"
+#include "../core/random_func.hpp"
+#include "../landscape.h"
+#include "../spritecache.h"
+#include "../viewport_sprite_sorter.h"
+
+static const SpriteID TEST_SPRITE = 1;  ///< Sprite used for all parent sprites; the mock sprite cache returns the same sprite for every ID.
+static const int SPRITE_WIDTH = 128;    ///< Width of #TEST_SPRITE.
+static const int SPRITE_HEIGHT = 96;    ///< Height of #TEST_SPRITE.
+static const int CELL_SIZE = 16;        ///< Size of the cells of the world that each hold at most one bounding box.
+
+/** Give the mock sprite, and thus every parent sprite, the same size; large enough for neighbours to overlap on screen. */
+static void SetupTestSprite()
+{
+	MockGfxLoadSprites();
+	Sprite *spr = const_cast<Sprite *>(GetSprite(TEST_SPRITE, SpriteType::Normal));
+	spr->width = SPRITE_WIDTH;
+	spr->height = SPRITE_HEIGHT;
+	spr->x_offs = -SPRITE_WIDTH / 2;
+	spr->y_offs = -SPRITE_HEIGHT + SPRITE_HEIGHT / 4;
+}
+
+/**
+ * Make parent sprites for a piece of world, in the order the viewport would add them.
+ * Every bounding box lies in its own cell of a grid, so no bounding boxes intersect
+ * and whether one sprite has to be drawn before another does not depend on the sorter.
+ * @param size Number of cells along the X and Y axis.
+ * @param seed Seed for the random extents of the bounding boxes.
+ * @return The parent sprites.
+ */
+static std::vector<ParentSpriteToDraw> MakeParentSprites(int size, uint32_t seed)
+{
+	Randomizer random;
+	random.SetSeed(seed);
+
+	std::vector<ParentSpriteToDraw> sprites;
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			int levels = random.Next(4);
+			for (int z = 0; z < levels; z++) {
+				if (random.Next(4) == 0) continue;
+
+				ParentSpriteToDraw ps{};
+				ps.xmin = x * CELL_SIZE + random.Next(CELL_SIZE / 2);
+				ps.ymin = y * CELL_SIZE + random.Next(CELL_SIZE / 2);
+				ps.zmin = z * CELL_SIZE + random.Next(CELL_SIZE / 2);
+				ps.xmax = ps.xmin + random.Next(CELL_SIZE / 2);
+				ps.ymax = ps.ymin + random.Next(CELL_SIZE / 2);
+				ps.zmax = ps.zmin + random.Next(CELL_SIZE / 2);
+
+				Point pt = RemapCoords(ps.xmin, ps.ymin, ps.zmin);
+				ps.x = pt.x;
+				ps.y = pt.y;
+				ps.left = ps.x - SPRITE_WIDTH / 2;
+				ps.top = ps.y - SPRITE_HEIGHT + SPRITE_HEIGHT / 4;
+				ps.image = TEST_SPRITE;
+				ps.first_child = -1;
+				sprites.push_back(ps);
+			}
+		}
+	}
+	return sprites;
+}
+
+/**
+ * Sort parent sprites.
+ * @param sprites The sprites to sort.
+ * @param sorter The sorter to use.
+ * @return For every sprite its position in the sorted order.
+ */
+static std::vector<size_t> SortParentSprites(std::vector<ParentSpriteToDraw> &sprites, VpSpriteSorter sorter)
+{
+	ParentSpriteToSortVector psdv;
+	for (ParentSpriteToDraw &ps : sprites) psdv.push_back(&ps);
+	sorter(&psdv);
+	REQUIRE(psdv.size() == sprites.size());
+
+	std::vector<size_t> position(sprites.size());
+	for (size_t i = 0; i < psdv.size(); i++) position[psdv[i] - sprites.data()] = i;
+	return position;
+}
+
+/**
+ * Check whether two parent sprites draw to any of the same pixels.
+ * @param a The first sprite.
+ * @param b The second sprite.
+ * @return True iff the sprites overlap on the screen.
+ */
+static bool ParentSpritesOverlapOnScreen(const ParentSpriteToDraw &a, const ParentSpriteToDraw &b)
+{
+	return a.left < b.left + SPRITE_WIDTH && b.left < a.left + SPRITE_WIDTH &&
+			a.top < b.top + SPRITE_HEIGHT && b.top < a.top + SPRITE_HEIGHT;
+}
+
+/**
+ * Check whether a parent sprite is behind another one, so it has to be drawn first.
+ * As the bounding boxes do not intersect, at most one of two sprites is behind the other.
+ * @param p The sprite that might be behind.
+ * @param s The sprite that might be in front.
+ * @return True iff \a p has to be drawn before \a s.
+ */
+static bool ParentSpriteIsBehind(const ParentSpriteToDraw &p, const ParentSpriteToDraw &s)
+{
+	return s.xmax >= p.xmin && s.ymax >= p.ymin && s.zmax >= p.zmin;
+}
+
+TEST_CASE("ViewportSortParentSprites - bucketed sorter draws like the original sorter")
+{
+	SetupTestSprite();
+
+	for (uint32_t seed = 1; seed <= 8; seed++) {
+		std::vector<ParentSpriteToDraw> sprites = MakeParentSprites(12, seed);
+		std::vector<ParentSpriteToDraw> copy = sprites;
+		std::vector<size_t> original = SortParentSprites(sprites, &ViewportSortParentSprites);
+		std::vector<size_t> bucketed = SortParentSprites(copy, &ViewportSortParentSpritesBucketed);
+
+		/* The order only matters for sprites that overlap on the screen and where one is behind the other. */
+		size_t compared = 0;
+		for (size_t i = 0; i < sprites.size(); i++) {
+			for (size_t j = 0; j < sprites.size(); j++) {
+				if (i == j || !ParentSpritesOverlapOnScreen(sprites[i], sprites[j])) continue;
+				if (!ParentSpriteIsBehind(sprites[i], sprites[j])) continue;
+				compared++;
+				CHECK(original[i] < original[j]);
+				CHECK(bucketed[i] < bucketed[j]);
+			}
+		}
+		CHECK(compared > sprites.size());
+	}
+}
+
+TEST_CASE("ViewportSortParentSprites - benchmark", "[.][benchmark]")
+{
+	SetupTestSprite();
+
+	std::vector<ParentSpriteToDraw> sprites = MakeParentSprites(64, 1);
+
+	BENCHMARK("original") { return SortParentSprites(sprites, &ViewportSortParentSprites); };
+	BENCHMARK("bucketed") { return SortParentSprites(sprites, &ViewportSortParentSpritesBucketed); };
+#ifdef WITH_SSE
+	if (ViewportSortParentSpritesSSE41Checker()) {
+		BENCHMARK("sse4.1") { return SortParentSprites(sprites, &ViewportSortParentSpritesSSE41); };
+	}
+#endif
+}
@@ -13,6 +13,7 @@
 #include "genworld.h"
 #include "core/random_func.hpp"
 #include "landscape_type.h"
+#include "thread_pool.h"
 
 #include "safeguards.h"
 
@@ -195,6 +196,12 @@ static HeightMap _height_map = { {}, 0, 0, 0 };
 /** Conversion: Amplitude to Height */
 #define A2H(a) ((a) >> (amplitude_decimal_bits - height_decimal_bits))
 
+/** Minimum number of rows of the height map to process on one thread; there is not much work per row. */
+static const size_t MIN_ROWS_PER_BATCH = 16;
+
+/** Minimum number of heights to process on one thread. */
+static const size_t MIN_HEIGHTS_PER_BATCH = 1 << 14;
+
 /** Maximum number of TGP noise frequencies. */
 static const int MAX_TGP_FREQUENCIES = 10;
 
@@ -227,12 +234,12 @@ static Height TGPGetMaxHeight()
 	 * around the mountain to build on. On a 4096x4096 map, it won't cover any major part of the map.
 	 */
 	static const int max_height[5][MAX_MAP_SIZE_BITS - MIN_MAP_SIZE_BITS + 1] = {
-		/* 64  128  256  512 1024 2048 4096 */
-		{   3,   3,   3,   3,   4,   5,   7 }, ///< Very flat
-		{   5,   7,   8,   9,  14,  19,  31 }, ///< Flat
-		{   8,   9,  10,  15,  23,  37,  61 }, ///< Hilly
-		{  10,  11,  17,  19,  49,  63,  73 }, ///< Mountainous
-		{  12,  19,  25,  31,  67,  75,  87 }, ///< Alpinist
+		/* 64  128  256  512 1024 2048 4096 8192 16384 */
+		{   3,   3,   3,   3,   4,   5,   7,   9,  11 }, ///< Very flat
+		{   5,   7,   8,   9,  14,  19,  31,  39,  47 }, ///< Flat
+		{   8,   9,  10,  15,  23,  37,  61,  75,  89 }, ///< Hilly
+		{  10,  11,  17,  19,  49,  63,  73,  85,  97 }, ///< Mountainous
+		{  12,  19,  25,  31,  67,  75,  87,  99, 111 }, ///< Alpinist
 	};
 
 	int map_size_bucket = std::min(Map::LogX(), Map::LogY()) - MIN_MAP_SIZE_BITS;
@@ -385,28 +392,34 @@ static void HeightMapGenerate()
 			continue;
 		}
 
-		/* It is regular iteration round.
+		/* It is regular iteration round. The interpolations only read heights
+		 * they do not write, so the rows can be done in any order.
 		 * Interpolate height values at odd x, even y tiles */
-		for (int y = 0; y <= _height_map.size_y; y += 2 * step) {
-			for (int x = 0; x <= _height_map.size_x - 2 * step; x += 2 * step) {
-				Height h00 = _height_map.height(x + 0 * step, y);
-				Height h02 = _height_map.height(x + 2 * step, y);
-				Height h01 = (h00 + h02) / 2;
-				_height_map.height(x + 1 * step, y) = h01;
+		ThreadPool::ParallelFor(_height_map.size_y / (2 * step) + 1, MIN_ROWS_PER_BATCH, [step](size_t begin, size_t end) {
+			for (int y = (int)begin * 2 * step; y < (int)end * 2 * step; y += 2 * step) {
+				for (int x = 0; x <= _height_map.size_x - 2 * step; x += 2 * step) {
+					Height h00 = _height_map.height(x + 0 * step, y);
+					Height h02 = _height_map.height(x + 2 * step, y);
+					Height h01 = (h00 + h02) / 2;
+					_height_map.height(x + 1 * step, y) = h01;
+				}
 			}
-		}
+		});
 
 		/* Interpolate height values at odd y tiles */
-		for (int y = 0; y <= _height_map.size_y - 2 * step; y += 2 * step) {
-			for (int x = 0; x <= _height_map.size_x; x += step) {
-				Height h00 = _height_map.height(x, y + 0 * step);
-				Height h20 = _height_map.height(x, y + 2 * step);
-				Height h10 = (h00 + h20) / 2;
-				_height_map.height(x, y + 1 * step) = h10;
+		ThreadPool::ParallelFor(_height_map.size_y / (2 * step), MIN_ROWS_PER_BATCH, [step](size_t begin, size_t end) {
+			for (int y = (int)begin * 2 * step; y < (int)end * 2 * step; y += 2 * step) {
+				for (int x = 0; x <= _height_map.size_x; x += step) {
+					Height h00 = _height_map.height(x, y + 0 * step);
+					Height h20 = _height_map.height(x, y + 2 * step);
+					Height h10 = (h00 + h20) / 2;
+					_height_map.height(x, y + 1 * step) = h10;
+				}
 			}
-		}
+		});
 
-		/* Add noise for next higher frequency (smaller steps) */
+		/* Add noise for next higher frequency (smaller steps); this has to
+		 * stay serial as the random numbers have to be drawn in this order. */
 		for (int y = 0; y <= _height_map.size_y; y += step) {
 			for (int x = 0; x <= _height_map.size_x; x += step) {
 				_height_map.height(x, y) += RandomHeight(amplitude);
@@ -452,79 +465,103 @@ static int *HeightMapMakeHistogram(Height h_min, [[maybe_unused]] Height h_max,
 	return hist;
 }
 
-/** Applies sine wave redistribution onto height map */
-static void HeightMapSineTransform(Height h_min, Height h_max)
+/**
+ * Applies sine wave redistribution onto a single height.
+ * @param h The height to transform, at least \a h_min.
+ * @param h_min The lowest height to transform.
+ * @param h_max The highest height after transformation.
+ * @return The transformed height.
+ */
+static Height SineTransformHeight(Height h, Height h_min, Height h_max)
 {
-	for (Height &h : _height_map.h) {
-		double fheight;
-
-		if (h < h_min) continue;
-
-		/* Transform height into 0..1 space */
-		fheight = (double)(h - h_min) / (double)(h_max - h_min);
-		/* Apply sine transform depending on landscape type */
-		switch (_settings_game.game_creation.landscape) {
-			case LT_TOYLAND:
-			case LT_TEMPERATE:
-				/* Move and scale 0..1 into -1..+1 */
-				fheight = 2 * fheight - 1;
-				/* Sine transform */
-				fheight = sin(fheight * M_PI_2);
-				/* Transform it back from -1..1 into 0..1 space */
-				fheight = 0.5 * (fheight + 1);
-				break;
-
-			case LT_ARCTIC:
-				{
-					/* Arctic terrain needs special height distribution.
-					 * Redistribute heights to have more tiles at highest (75%..100%) range */
-					double sine_upper_limit = 0.75;
-					double linear_compression = 2;
-					if (fheight >= sine_upper_limit) {
-						/* Over the limit we do linear compression up */
-						fheight = 1.0 - (1.0 - fheight) / linear_compression;
-					} else {
-						double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
-						/* Get 0..sine_upper_limit into -1..1 */
-						fheight = 2.0 * fheight / sine_upper_limit - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
-						fheight = 0.5 * (fheight + 1.0) * m;
-					}
+	double fheight;
+
+	/* Transform height into 0..1 space */
+	fheight = (double)(h - h_min) / (double)(h_max - h_min);
+	/* Apply sine transform depending on landscape type */
+	switch (_settings_game.game_creation.landscape) {
+		case LT_TOYLAND:
+		case LT_TEMPERATE:
+			/* Move and scale 0..1 into -1..+1 */
+			fheight = 2 * fheight - 1;
+			/* Sine transform */
+			fheight = sin(fheight * M_PI_2);
+			/* Transform it back from -1..1 into 0..1 space */
+			fheight = 0.5 * (fheight + 1);
+			break;
+
+		case LT_ARCTIC:
+			{
+				/* Arctic terrain needs special height distribution.
+				 * Redistribute heights to have more tiles at highest (75%..100%) range */
+				double sine_upper_limit = 0.75;
+				double linear_compression = 2;
+				if (fheight >= sine_upper_limit) {
+					/* Over the limit we do linear compression up */
+					fheight = 1.0 - (1.0 - fheight) / linear_compression;
+				} else {
+					double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
+					/* Get 0..sine_upper_limit into -1..1 */
+					fheight = 2.0 * fheight / sine_upper_limit - 1.0;
+					/* Sine wave transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
+					fheight = 0.5 * (fheight + 1.0) * m;
 				}
-				break;
-
-			case LT_TROPIC:
-				{
-					/* Desert terrain needs special height distribution.
-					 * Half of tiles should be at lowest (0..25%) heights */
-					double sine_lower_limit = 0.5;
-					double linear_compression = 2;
-					if (fheight <= sine_lower_limit) {
-						/* Under the limit we do linear compression down */
-						fheight = fheight / linear_compression;
-					} else {
-						double m = sine_lower_limit / linear_compression;
-						/* Get sine_lower_limit..1 into -1..1 */
-						fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
-						fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
-					}
+			}
+			break;
+
+		case LT_TROPIC:
+			{
+				/* Desert terrain needs special height distribution.
+				 * Half of tiles should be at lowest (0..25%) heights */
+				double sine_lower_limit = 0.5;
+				double linear_compression = 2;
+				if (fheight <= sine_lower_limit) {
+					/* Under the limit we do linear compression down */
+					fheight = fheight / linear_compression;
+				} else {
+					double m = sine_lower_limit / linear_compression;
+					/* Get sine_lower_limit..1 into -1..1 */
+					fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
+					/* Sine wave transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
+					fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
 				}
-				break;
+			}
+			break;
 
-			default:
-				NOT_REACHED();
-				break;
-		}
-		/* Transform it back into h_min..h_max space */
-		h = (Height)(fheight * (h_max - h_min) + h_min);
-		if (h < 0) h = I2H(0);
-		if (h >= h_max) h = h_max - 1;
+		default:
+			NOT_REACHED();
+			break;
 	}
+	/* Transform it back into h_min..h_max space */
+	h = (Height)(fheight * (h_max - h_min) + h_min);
+	if (h < 0) h = I2H(0);
+	if (h >= h_max) h = h_max - 1;
+	return h;
+}
+
+/** Applies sine wave redistribution onto height map */
+static void HeightMapSineTransform(Height h_min, Height h_max)
+{
+	/* The transformation only depends on the height itself, and there are far
+	 * fewer possible heights than tiles, so look the results up in a table. */
+	Height map_min, map_max, map_avg;
+	HeightMapGetMinMaxAvg(&map_min, &map_max, &map_avg);
+
+	std::vector<Height> transformed(std::max(map_max - h_min + 1, 0));
+	for (size_t i = 0; i < transformed.size(); i++) {
+		transformed[i] = SineTransformHeight(static_cast<Height>(h_min + i), h_min, h_max);
+	}
+
+	ThreadPool::ParallelFor(_height_map.h.size(), MIN_HEIGHTS_PER_BATCH, [h_min, &transformed](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			Height &h = _height_map.h[i];
+			if (h >= h_min) h = transformed[h - h_min];
+		}
+	});
 }
 
 /**
@@ -562,8 +599,6 @@ static void HeightMapCurves(uint level)
 
 	static const std::span<const ControlPoint> curve_maps[] = { curve_map_1, curve_map_2, curve_map_3, curve_map_4 };
 
-	std::array<Height, std::size(curve_maps)> ht{};
-
 	/* Set up a grid to choose curve maps based on location; attempt to get a somewhat square grid */
 	float factor = sqrt((float)_height_map.size_x / (float)_height_map.size_y);
 	uint sx = Clamp((int)(((1 << level) * factor) + 0.5), 1, 128);
@@ -574,90 +609,94 @@ static void HeightMapCurves(uint level)
 		c[i] = RandomRange(static_cast<uint32_t>(std::size(curve_maps)));
 	}
 
-	/* Apply curves */
-	for (int x = 0; x < _height_map.size_x; x++) {
-
-		/* Get our X grid positions and bi-linear ratio */
-		float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
-		uint x1 = (uint)fx;
-		uint x2 = x1;
-		float xr = 2.0f * (fx - x1) - 1.0f;
-		xr = sin(xr * M_PI_2);
-		xr = sin(xr * M_PI_2);
-		xr = 0.5f * (xr + 1.0f);
-		float xri = 1.0f - xr;
-
-		if (x1 > 0) {
-			x1--;
-			if (x2 >= sx) x2--;
-		}
-
-		for (int y = 0; y < _height_map.size_y; y++) {
-
-			/* Get our Y grid position and bi-linear ratio */
-			float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
-			uint y1 = (uint)fy;
-			uint y2 = y1;
-			float yr = 2.0f * (fy - y1) - 1.0f;
-			yr = sin(yr * M_PI_2);
-			yr = sin(yr * M_PI_2);
-			yr = 0.5f * (yr + 1.0f);
-			float yri = 1.0f - yr;
-
-			if (y1 > 0) {
-				y1--;
-				if (y2 >= sy) y2--;
+	/* Apply curves; every tile only depends on its own height, so the columns can be done in any order. */
+	ThreadPool::ParallelFor(_height_map.size_x, MIN_ROWS_PER_BATCH, [&](size_t begin, size_t end) {
+		std::array<Height, std::size(curve_maps)> ht{};
+
+		for (int x = (int)begin; x < (int)end; x++) {
+
+			/* Get our X grid positions and bi-linear ratio */
+			float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
+			uint x1 = (uint)fx;
+			uint x2 = x1;
+			float xr = 2.0f * (fx - x1) - 1.0f;
+			xr = sin(xr * M_PI_2);
+			xr = sin(xr * M_PI_2);
+			xr = 0.5f * (xr + 1.0f);
+			float xri = 1.0f - xr;
+
+			if (x1 > 0) {
+				x1--;
+				if (x2 >= sx) x2--;
 			}
 
-			uint corner_a = c[x1 + sx * y1];
-			uint corner_b = c[x1 + sx * y2];
-			uint corner_c = c[x2 + sx * y1];
-			uint corner_d = c[x2 + sx * y2];
+			for (int y = 0; y < _height_map.size_y; y++) {
+
+				/* Get our Y grid position and bi-linear ratio */
+				float fy = (float)(sy * y) / _height_map.size_y + 1.0f;
+				uint y1 = (uint)fy;
+				uint y2 = y1;
+				float yr = 2.0f * (fy - y1) - 1.0f;
+				yr = sin(yr * M_PI_2);
+				yr = sin(yr * M_PI_2);
+				yr = 0.5f * (yr + 1.0f);
+				float yri = 1.0f - yr;
+
+				if (y1 > 0) {
+					y1--;
+					if (y2 >= sy) y2--;
+				}
+
+				uint corner_a = c[x1 + sx * y1];
+				uint corner_b = c[x1 + sx * y2];
+				uint corner_c = c[x2 + sx * y1];
+				uint corner_d = c[x2 + sx * y2];
 
-			/* Bitmask of which curve maps are chosen, so that we do not bother
-			 * calculating a curve which won't be used. */
-			uint corner_bits = 0;
-			corner_bits |= 1 << corner_a;
-			corner_bits |= 1 << corner_b;
-			corner_bits |= 1 << corner_c;
-			corner_bits |= 1 << corner_d;
+				/* Bitmask of which curve maps are chosen, so that we do not bother
+				 * calculating a curve which won't be used. */
+				uint corner_bits = 0;
+				corner_bits |= 1 << corner_a;
+				corner_bits |= 1 << corner_b;
+				corner_bits |= 1 << corner_c;
+				corner_bits |= 1 << corner_d;
 
-			Height *h = &_height_map.height(x, y);
+				Height *h = &_height_map.height(x, y);
 
-			/* Do not touch sea level */
-			if (*h < I2H(1)) continue;
+				/* Do not touch sea level */
+				if (*h < I2H(1)) continue;
 
-			/* Only scale above sea level */
-			*h -= I2H(1);
+				/* Only scale above sea level */
+				*h -= I2H(1);
 
-			/* Apply all curve maps that are used on this tile. */
-			for (size_t t = 0; t < std::size(curve_maps); t++) {
-				if (!HasBit(corner_bits, static_cast<uint8_t>(t))) continue;
+				/* Apply all curve maps that are used on this tile. */
+				for (size_t t = 0; t < std::size(curve_maps); t++) {
+					if (!HasBit(corner_bits, static_cast<uint8_t>(t))) continue;
 
-				[[maybe_unused]] bool found = false;
-				auto &cm = curve_maps[t];
-				for (size_t i = 0; i < cm.size() - 1; i++) {
-					const ControlPoint &p1 = cm[i];
-					const ControlPoint &p2 = cm[i + 1];
+					[[maybe_unused]] bool found = false;
+					auto &cm = curve_maps[t];
+					for (size_t i = 0; i < cm.size() - 1; i++) {
+						const ControlPoint &p1 = cm[i];
+						const ControlPoint &p2 = cm[i + 1];
 
-					if (*h >= p1.x && *h < p2.x) {
-						ht[t] = p1.y + (*h - p1.x) * (p2.y - p1.y) / (p2.x - p1.x);
+						if (*h >= p1.x && *h < p2.x) {
+							ht[t] = p1.y + (*h - p1.x) * (p2.y - p1.y) / (p2.x - p1.x);
 #ifdef WITH_ASSERT
-						found = true;
+							found = true;
 #endif
-						break;
+							break;
+						}
 					}
+					assert(found);
 				}
-				assert(found);
-			}
 
-			/* Apply interpolation of curve map results. */
-			*h = (Height)((ht[corner_a] * yri + ht[corner_b] * yr) * xri + (ht[corner_c] * yri + ht[corner_d] * yr) * xr);
+				/* Apply interpolation of curve map results. */
+				*h = (Height)((ht[corner_a] * yri + ht[corner_b] * yr) * xri + (ht[corner_c] * yri + ht[corner_d] * yr) * xr);
 
-			/* Readd sea level */
-			*h += I2H(1);
+				/* Readd sea level */
+				*h += I2H(1);
+			}
 		}
-	}
+	});
 }
 
 /** Adjusts heights in height map to contain required amount of water tiles */
@@ -689,14 +728,24 @@ static void HeightMapAdjustWaterLevel(Amplitude water_percent, Height h_max_new)
 	 *   values from range: h_water_level..h_max are transformed into 0..h_max_new
 	 *   where h_max_new is depending on terrain type and map size.
 	 */
-	for (Height &h : _height_map.h) {
+	std::vector<Height> transformed(h_max - h_min + 1);
+	for (int h = h_min; h <= h_max; h++) {
+		Height &t = transformed[h - h_min];
 		/* Transform height from range h_water_level..h_max into 0..h_max_new range */
-		h = (Height)(((int)h_max_new) * (h - h_water_level) / (h_max - h_water_level)) + I2H(1);
+		t = (Height)(((int)h_max_new) * (h - h_water_level) / (h_max - h_water_level)) + I2H(1);
 		/* Make sure all values are in the proper range (0..h_max_new) */
-		if (h < 0) h = I2H(0);
-		if (h >= h_max_new) h = h_max_new - 1;
+		if (t < 0) t = I2H(0);
+		if (t >= h_max_new) t = h_max_new - 1;
 	}
 
+	/* All heights are within h_min..h_max, so a table lookup saves a division per tile. */
+	ThreadPool::ParallelFor(_height_map.h.size(), MIN_HEIGHTS_PER_BATCH, [h_min, &transformed](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			Height &h = _height_map.h[i];
+			h = transformed[h - h_min];
+		}
+	});
+
 	free(hist_buf);
 }
 
@@ -998,12 +1047,14 @@ void GenerateTerrainPerlin()
 
 	int max_height = H2I(TGPGetMaxHeight());
 
-	/* Transfer height map into OTTD map */
-	for (int y = 0; y < _height_map.size_y; y++) {
-		for (int x = 0; x < _height_map.size_x; x++) {
-			TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
+	/* Transfer height map into OTTD map; every row only touches its own tiles. */
+	ThreadPool::ParallelFor(_height_map.size_y, MIN_ROWS_PER_BATCH, [max_height](size_t begin, size_t end) {
+		for (int y = (int)begin; y < (int)end; y++) {
+			for (int x = 0; x < _height_map.size_x; x++) {
+				TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
+			}
 		}
-	}
+	});
 
 	IncreaseGeneratingWorldProgress(GWP_LANDSCAPE);
 
@@ -0,0 +1,171 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file thread_pool.cpp Implementation of the pool of worker threads. */
+
+#include "stdafx.h"
+#include "thread.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <condition_variable>
+
+#include "safeguards.h"
+
+/** Upper limit of worker threads, more hardly helps for the kind of work we hand out. */
+static const uint MAX_POOL_WORKERS = 15;
+
+/** State shared between the caller of a parallel section and the workers. */
+struct ThreadPoolState {
+	std::mutex lock;                          ///< Lock for the administration below.
+	std::condition_variable work_available;   ///< Signalled when a new parallel section starts or the pool shuts down.
+	std::condition_variable work_done;        ///< Signalled when the last worker finished its part of a section.
+	std::vector<std::thread> workers;         ///< The worker threads.
+	bool started = false;                     ///< Whether we (tried to) start the workers.
+	bool exit = false;                        ///< Whether the workers have to stop.
+	uint generation = 0;                      ///< Number of the current parallel section.
+	uint busy_workers = 0;                    ///< Number of workers still working on the current section.
+
+	const ThreadPool::RangeFunc *func = nullptr; ///< Function of the current section.
+	size_t count = 0;                         ///< Number of indices of the current section.
+	size_t batch = 0;                         ///< Number of indices handed out at once.
+	std::atomic<size_t> next = 0;             ///< First index that has not been handed out yet.
+};
+
+static ThreadPoolState _thread_pool;
+static std::mutex _thread_pool_caller_lock; ///< Only one thread at a time can run a parallel section.
+static thread_local bool _in_thread_pool = false; ///< Whether this thread is currently working for the pool.
+
+/** Process batches of the current section until all indices have been handed out. */
+static void RunThreadPoolBatches()
+{
+	for (;;) {
+		size_t begin = _thread_pool.next.fetch_add(_thread_pool.batch);
+		if (begin >= _thread_pool.count) return;
+
+		(*_thread_pool.func)(begin, std::min(begin + _thread_pool.batch, _thread_pool.count));
+	}
+}
+
+/**
+ * Main loop of a worker thread.
+ * @param seen_generation The section that was current when the worker got started.
+ */
+static void ThreadPoolWorker(uint seen_generation)
+{
+	_in_thread_pool = true;
+
+	std::unique_lock<std::mutex> lock(_thread_pool.lock);
+	for (;;) {
+		_thread_pool.work_available.wait(lock, [&seen_generation]() { return _thread_pool.exit || _thread_pool.generation != seen_generation; });
+		if (_thread_pool.exit) return;
+		seen_generation = _thread_pool.generation;
+
+		lock.unlock();
+		RunThreadPoolBatches();
+		lock.lock();
+
+		if (--_thread_pool.busy_workers == 0) _thread_pool.work_done.notify_one();
+	}
+}
+
+/** Start the worker threads, if that has not been tried before. */
+static void StartThreadPool()
+{
+	_thread_pool.started = true;
+
+	uint hardware = std::thread::hardware_concurrency();
+	if (hardware <= 1) return;
+
+	uint wanted = std::min(hardware - 1, MAX_POOL_WORKERS);
+	for (uint i = 0; i < wanted; i++) {
+		std::thread t;
+		if (!StartNewThread(&t, "ottd:worker", &ThreadPoolWorker, static_cast<uint>(_thread_pool.generation))) break;
+		_thread_pool.workers.push_back(std::move(t));
+	}
+
+	Debug(misc, 3, "Started {} worker threads", _thread_pool.workers.size());
+}
+
+/**
+ * Get the number of threads, including the calling one, that work on a parallel section.
+ * @return The number of threads.
+ */
+/* static */ uint ThreadPool::GetConcurrency()
+{
+	std::lock_guard<std::mutex> lock(_thread_pool_caller_lock);
+	if (!_thread_pool.started) StartThreadPool();
+	return static_cast<uint>(_thread_pool.workers.size()) + 1;
+}
+
+/**
+ * Call a function for all indices in [0, count), spread over the worker threads.
+ * When there are no workers, the work is too small, another thread is already
+ * running a parallel section or this is called from within a parallel section,
+ * everything is simply done on the calling thread.
+ * @param count Number of indices to process.
+ * @param min_batch Minimum number of indices to process in one go; handing out work has a cost too.
+ * @param func Function to call for ranges of indices.
+ */
+/* static */ void ThreadPool::ParallelFor(size_t count, size_t min_batch, const RangeFunc &func)
+{
+	if (count == 0) return;
+	min_batch = std::max<size_t>(min_batch, 1);
+
+	std::unique_lock<std::mutex> caller_lock(_thread_pool_caller_lock, std::defer_lock);
+	if (count < min_batch * 2 || _in_thread_pool || !caller_lock.try_lock()) {
+		func(0, count);
+		return;
+	}
+
+	if (!_thread_pool.started) StartThreadPool();
+	if (_thread_pool.workers.empty()) {
+		func(0, count);
+		return;
+	}
+
+	/* Make the batches small enough that every thread gets a few, so a slow batch does not stall everyone. */
+	size_t threads = _thread_pool.workers.size() + 1;
+	size_t batch = std::max(min_batch, count / (threads * 4));
+
+	{
+		std::lock_guard<std::mutex> lock(_thread_pool.lock);
+		_thread_pool.func = &func;
+		_thread_pool.count = count;
+		_thread_pool.batch = batch;
+		_thread_pool.next = 0;
+		_thread_pool.busy_workers = static_cast<uint>(_thread_pool.workers.size());
+		_thread_pool.generation++;
+	}
+	_thread_pool.work_available.notify_all();
+
+	_in_thread_pool = true;
+	RunThreadPoolBatches();
+	_in_thread_pool = false;
+
+	std::unique_lock<std::mutex> lock(_thread_pool.lock);
+	_thread_pool.work_done.wait(lock, []() { return _thread_pool.busy_workers == 0; });
+	_thread_pool.func = nullptr;
+}
+
+/** Stop all worker threads. A later parallel section will start them again. */
+/* static */ void ThreadPool::Shutdown()
+{
+	std::lock_guard<std::mutex> caller_lock(_thread_pool_caller_lock);
+
+	{
+		std::lock_guard<std::mutex> lock(_thread_pool.lock);
+		_thread_pool.exit = true;
+	}
+	_thread_pool.work_available.notify_all();
+
+	for (std::thread &t : _thread_pool.workers) {
+		if (t.joinable()) t.join();
+	}
+	_thread_pool.workers.clear();
+	_thread_pool.exit = false;
+	_thread_pool.started = false;
+}
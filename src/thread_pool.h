@@ -0,0 +1,40 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file thread_pool.h Pool of worker threads to spread independent work over multiple cores. */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+
+/**
+ * Pool of persistent worker threads. Work is handed out as ranges of indices,
+ * and the calling thread always participates in the work itself. The caller
+ * returns only after the whole range has been processed, so from the outside
+ * a parallel section behaves exactly like a serial loop.
+ *
+ * Work passed to the pool must not depend on the order in which the indices
+ * are processed, and must not touch shared game state that is not protected
+ * for concurrent access; otherwise the outcome is not deterministic and
+ * network games will desync.
+ */
+class ThreadPool {
+public:
+	/**
+	 * Function to process a range of indices.
+	 * @param begin First index to process.
+	 * @param end Index after the last one to process.
+	 */
+	using RangeFunc = std::function<void(size_t begin, size_t end)>;
+
+	static void ParallelFor(size_t count, size_t min_batch, const RangeFunc &func);
+	static uint GetConcurrency();
+	static void Shutdown();
+};
+
+#endif /* THREAD_POOL_H */
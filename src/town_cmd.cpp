@@ -629,8 +629,12 @@ static void TileLoop_Town(TileIndex tile)
 	StationFinder stations(TileArea(tile, 1, 1));
 
 	if (HasBit(hs->callback_mask, CBM_HOUSE_PRODUCE_CARGO)) {
+		/* All iterations resolve the same house, so set up the resolver only once. */
+		HouseResolverObject object(house_id, tile, t, CBID_HOUSE_PRODUCE_CARGO, 0, r);
 		for (uint i = 0; i < 256; i++) {
-			uint16_t callback = GetHouseCallback(CBID_HOUSE_PRODUCE_CARGO, i, r, house_id, t, tile);
+			object.ResetState();
+			object.callback_param1 = i;
+			uint16_t callback = object.ResolveCallback();
 
 			if (callback == CALLBACK_FAILED || callback == CALLBACK_HOUSEPRODCARGO_END) break;
 
@@ -0,0 +1,137 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file trace.cpp Implementation of the tracing of zones of the game loop. */
+
+#include "stdafx.h"
+#include "trace.h"
+#include "fileio_func.h"
+#include "console_func.h"
+#include "3rdparty/fmt/chrono.h"
+
+#include <chrono>
+#include <mutex>
+
+#include "safeguards.h"
+
+/** A zone that has been left while tracing. */
+struct TraceEvent {
+	const char *name; ///< Name of the zone.
+	uint64_t start;   ///< Time the zone was entered, in nanoseconds.
+	uint64_t end;     ///< Time the zone was left, in nanoseconds.
+	uint64_t tick;    ///< Number of the tick in which the zone was left.
+	uint thread;      ///< Number of the thread the zone ran on.
+};
+
+/* static */ std::atomic<bool> Tracer::active = false;
+
+static std::mutex _trace_lock;            ///< Lock for the recorded zones; zones can be left on several threads.
+static std::vector<TraceEvent> _trace_events; ///< Ring buffer with the recorded zones.
+static size_t _trace_next = 0;            ///< Position in the ring buffer where the next zone is recorded.
+static bool _trace_wrapped = false;       ///< Whether the ring buffer has been filled completely.
+static uint64_t _trace_tick = 0;          ///< Number of ticks since the tracer was started.
+static std::atomic<uint> _trace_threads = 0; ///< Number of threads that recorded a zone.
+static thread_local uint _trace_thread = 0; ///< Number of the current thread in the trace, or 0 when it has not recorded anything yet.
+
+/**
+ * Get the current time for the tracer.
+ * @return Time in nanoseconds since an arbitrary moment.
+ */
+/* static */ uint64_t Tracer::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Start recording zones; previously recorded zones are discarded. */
+/* static */ void Tracer::Start()
+{
+	std::lock_guard<std::mutex> lock(_trace_lock);
+	_trace_events.resize(MAX_EVENTS);
+	_trace_next = 0;
+	_trace_wrapped = false;
+	_trace_tick = 0;
+	Tracer::active = true;
+}
+
+/** Stop recording zones and discard them. */
+/* static */ void Tracer::Stop()
+{
+	std::lock_guard<std::mutex> lock(_trace_lock);
+	Tracer::active = false;
+	_trace_events.clear();
+	_trace_events.shrink_to_fit();
+}
+
+/** Mark the start of a new game tick. */
+/* static */ void Tracer::Tick()
+{
+	if (!Tracer::IsActive()) return;
+
+	std::lock_guard<std::mutex> lock(_trace_lock);
+	_trace_tick++;
+}
+
+/**
+ * Record a zone that has just been left.
+ * @param name Name of the zone.
+ * @param start Time the zone was entered.
+ */
+/* static */ void Tracer::Record(const char *name, uint64_t start)
+{
+	uint64_t end = Tracer::Now();
+	if (_trace_thread == 0) _trace_thread = ++_trace_threads;
+
+	std::lock_guard<std::mutex> lock(_trace_lock);
+	/* Tracing might have been stopped while in the zone. */
+	if (!Tracer::IsActive()) return;
+
+	_trace_events[_trace_next] = { name, start, end, _trace_tick, _trace_thread };
+	if (++_trace_next == _trace_events.size()) {
+		_trace_next = 0;
+		_trace_wrapped = true;
+	}
+}
+
+/**
+ * Write the recorded zones of the last ticks to the screenshot directory, in the Chrome trace event format.
+ * Recording continues afterwards.
+ * @param ticks Number of ticks to write, or 0 to write all that are in the ring buffer.
+ * @return True iff the trace could be written.
+ */
+/* static */ bool Tracer::Dump(uint ticks)
+{
+	std::string filename = fmt::format("{}trace-{:%Y%m%d-%H%M%S}.json", FiosGetScreenshotDir(), fmt::localtime(time(nullptr)));
+	FILE *f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (f == nullptr) {
+		IConsolePrint(CC_ERROR, "Could not write the trace to '{}'.", filename);
+		return false;
+	}
+	FileCloser closer(f);
+
+	std::lock_guard<std::mutex> lock(_trace_lock);
+	uint64_t first_tick = (ticks == 0 || ticks > _trace_tick) ? 0 : _trace_tick - ticks + 1;
+
+	/* Go through the ring buffer from the oldest zone to the newest. */
+	size_t count = _trace_wrapped ? _trace_events.size() : _trace_next;
+	size_t first = _trace_wrapped ? _trace_next : 0;
+	size_t written = 0;
+
+	fmt::print(f, "{{\"traceEvents\":[\n");
+	for (size_t i = 0; i < count; i++) {
+		const TraceEvent &ev = _trace_events[(first + i) % _trace_events.size()];
+		if (ev.tick < first_tick) continue;
+
+		uint64_t duration = ev.end - ev.start;
+		fmt::print(f, "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{}.{:03},\"dur\":{}.{:03},\"args\":{{\"tick\":{}}}}}",
+				written == 0 ? "" : ",\n", ev.name, ev.thread, ev.start / 1000, ev.start % 1000, duration / 1000, duration % 1000, ev.tick);
+		written++;
+	}
+	fmt::print(f, "\n]}}\n");
+
+	IConsolePrint(CC_DEBUG, "Wrote {} zones to '{}'.", written, filename);
+	return true;
+}
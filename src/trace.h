@@ -0,0 +1,67 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file trace.h Tracing of the time spent in zones of the game loop. */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+
+/**
+ * Tracer of the time spent in named zones of the game loop. It is always
+ * compiled in, but does nothing but check a flag until it is started. While
+ * active, every zone that is left is recorded in a ring buffer, so the buffer
+ * always holds the last ticks. On request the recorded zones are written in
+ * the Chrome trace event format, which chrome://tracing and Perfetto read.
+ */
+class Tracer {
+public:
+	/** Number of zones the ring buffer holds. */
+	static const size_t MAX_EVENTS = 1 << 18;
+
+	static void Start();
+	static void Stop();
+	static bool Dump(uint ticks);
+	static void Tick();
+	static void Record(const char *name, uint64_t start);
+	static uint64_t Now();
+
+	/**
+	 * Whether the tracer is recording zones.
+	 * @return True iff it is recording.
+	 */
+	static inline bool IsActive() { return Tracer::active.load(std::memory_order_relaxed); }
+
+private:
+	static std::atomic<bool> active; ///< Whether zones are being recorded.
+};
+
+/**
+ * Zone of the code that is recorded by the #Tracer while it is active.
+ * Create one at the start of the scope to measure.
+ */
+class TraceZone {
+public:
+	/**
+	 * Enter the zone.
+	 * @param name Name of the zone, or \c nullptr to not record this zone; it must outlive the tracer, so use a string literal.
+	 */
+	inline TraceZone(const char *name) : name(Tracer::IsActive() ? name : nullptr), start(this->name != nullptr ? Tracer::Now() : 0) {}
+
+	/** Leave the zone, and record it when tracing. */
+	inline ~TraceZone()
+	{
+		if (this->name != nullptr) Tracer::Record(this->name, this->start);
+	}
+
+private:
+	const char *name; ///< Name of the zone, or \c nullptr when the tracer was not active when entering it.
+	uint64_t start;   ///< Time the zone was entered.
+};
+
+#endif /* TRACE_H */
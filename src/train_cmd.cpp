@@ -1624,6 +1624,7 @@ static void UpdateStatusAfterSwap(Train *v)
  * @param v Consist to change.
  * @param l %Vehicle index in the consist of the first vehicle.
  * @param r %Vehicle index in the consist of the second vehicle.
+ * @note The caller has to update the slope resistance of \a v once all vehicles are swapped.
  */
 void ReverseTrainSwapVeh(Train *v, int l, int r)
 {
@@ -1682,7 +1683,7 @@ bool TrainOnCrossing(TileIndex tile)
 {
 	assert(IsLevelCrossingTile(tile));
 
-	return HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum);
+	return HasVehicleOnPos(tile, VEH_TRAIN, nullptr, &TrainOnTileEnum);
 }
 
 
@@ -1720,12 +1721,12 @@ static bool TrainApproachingCrossing(TileIndex tile)
 	DiagDirection dir = AxisToDiagDir(GetCrossingRailAxis(tile));
 	TileIndex tile_from = tile + TileOffsByDiagDir(dir);
 
-	if (HasVehicleOnPos(tile_from, &tile, &TrainApproachingCrossingEnum)) return true;
+	if (HasVehicleOnPos(tile_from, VEH_TRAIN, &tile, &TrainApproachingCrossingEnum)) return true;
 
 	dir = ReverseDiagDir(dir);
 	tile_from = tile + TileOffsByDiagDir(dir);
 
-	return HasVehicleOnPos(tile_from, &tile, &TrainApproachingCrossingEnum);
+	return HasVehicleOnPos(tile_from, VEH_TRAIN, &tile, &TrainApproachingCrossingEnum);
 }
 
 /**
@@ -1740,19 +1741,15 @@ static inline bool CheckLevelCrossing(TileIndex tile)
 }
 
 /**
- * Sets a level crossing tile to the correct state.
+ * Sets a level crossing tile to the given state.
  * @param tile Tile to update.
  * @param sound Should we play sound?
- * @param force_barred Should we set the crossing to barred?
+ * @param set_barred Should we set the crossing to barred?
  * @pre tile is a rail-road crossing.
  */
-static void UpdateLevelCrossingTile(TileIndex tile, bool sound, bool force_barred)
+static void UpdateLevelCrossingTile(TileIndex tile, bool sound, bool set_barred)
 {
 	assert(IsLevelCrossingTile(tile));
-	bool set_barred;
-
-	/* We force the crossing to be barred when an adjacent crossing is barred, otherwise let it decide for itself. */
-	set_barred = force_barred || CheckLevelCrossing(tile);
 
 	/* The state has changed */
 	if (set_barred != IsCrossingBarred(tile)) {
@@ -1772,25 +1769,26 @@ void UpdateLevelCrossing(TileIndex tile, bool sound, bool force_bar)
 {
 	if (!IsLevelCrossingTile(tile)) return;
 
-	bool forced_state = force_bar;
-
 	const Axis axis = GetCrossingRoadAxis(tile);
 	const DiagDirection dir1 = AxisToDiagDir(axis);
 	const DiagDirection dir2 = ReverseDiagDir(dir1);
 
-	/* Check if an adjacent crossing is barred. */
+	/* Check if this or an adjacent crossing is barred. All tiles of the crossing share
+	 * one state, so every tile is checked at most once and the search stops at the first
+	 * tile that needs to be barred. */
+	bool barred = force_bar || CheckLevelCrossing(tile);
 	for (DiagDirection dir : { dir1, dir2 }) {
-		for (TileIndex t = tile; !forced_state && t < Map::Size() && IsLevelCrossingTile(t) && GetCrossingRoadAxis(t) == axis; t = TileAddByDiagDir(t, dir)) {
-			forced_state |= CheckLevelCrossing(t);
+		for (TileIndex t = TileAddByDiagDir(tile, dir); !barred && t < Map::Size() && IsLevelCrossingTile(t) && GetCrossingRoadAxis(t) == axis; t = TileAddByDiagDir(t, dir)) {
+			barred = CheckLevelCrossing(t);
 		}
 	}
 
 	/* Now that we know whether all tiles in this crossing should be barred or open,
 	 * we need to update those tiles. We start with the tile itself, then look along the road axis. */
-	UpdateLevelCrossingTile(tile, sound, forced_state);
+	UpdateLevelCrossingTile(tile, sound, barred);
 	for (DiagDirection dir : { dir1, dir2 }) {
 		for (TileIndex t = TileAddByDiagDir(tile, dir); t < Map::Size() && IsLevelCrossingTile(t) && GetCrossingRoadAxis(t) == axis; t = TileAddByDiagDir(t, dir)) {
-			UpdateLevelCrossingTile(t, sound, forced_state);
+			UpdateLevelCrossingTile(t, sound, barred);
 		}
 	}
 }
@@ -1985,6 +1983,8 @@ void ReverseTrainDirection(Train *v)
 	do {
 		ReverseTrainSwapVeh(v, l++, r--);
 	} while (l <= r);
+	/* The up/down flags of the parts were swapped, so recalculate the slope resistance once for the whole consist. */
+	v->UpdateSlopeResistance();
 
 	AdvanceWagonsAfterSwap(v);
 
@@ -3213,8 +3213,8 @@ static bool CheckTrainCollision(Train *v)
 
 	/* find colliding vehicles */
 	if (v->track == TRACK_BIT_WORMHOLE) {
-		FindVehicleOnPos(v->tile, &tcc, FindTrainCollideEnum);
-		FindVehicleOnPos(GetOtherTunnelBridgeEnd(v->tile), &tcc, FindTrainCollideEnum);
+		FindVehicleOnPos(v->tile, VEH_TRAIN, &tcc, FindTrainCollideEnum);
+		FindVehicleOnPos(GetOtherTunnelBridgeEnd(v->tile), VEH_TRAIN, &tcc, FindTrainCollideEnum);
 	} else {
 		FindVehicleOnPosXY(v->x_pos, v->y_pos, &tcc, FindTrainCollideEnum);
 	}
@@ -3362,7 +3362,7 @@ bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 								exitdir = ReverseDiagDir(exitdir);
 
 								/* check if a train is waiting on the other side */
-								if (!HasVehicleOnPos(o_tile, &exitdir, &CheckTrainAtSignal)) return false;
+								if (!HasVehicleOnPos(o_tile, VEH_TRAIN, &exitdir, &CheckTrainAtSignal)) return false;
 							}
 						}
 
@@ -3595,10 +3595,10 @@ static bool IsRailStationPlatformOccupied(TileIndex tile)
 	TileIndexDiff delta = (GetRailStationAxis(tile) == AXIS_X ? TileDiffXY(1, 0) : TileDiffXY(0, 1));
 
 	for (TileIndex t = tile; IsCompatibleTrainStationTile(t, tile); t -= delta) {
-		if (HasVehicleOnPos(t, nullptr, &TrainOnTileEnum)) return true;
+		if (HasVehicleOnPos(t, VEH_TRAIN, nullptr, &TrainOnTileEnum)) return true;
 	}
 	for (TileIndex t = tile + delta; IsCompatibleTrainStationTile(t, tile); t += delta) {
-		if (HasVehicleOnPos(t, nullptr, &TrainOnTileEnum)) return true;
+		if (HasVehicleOnPos(t, VEH_TRAIN, nullptr, &TrainOnTileEnum)) return true;
 	}
 
 	return false;
@@ -3652,7 +3652,7 @@ static void DeleteLastWagon(Train *v)
 
 		/* If there are still crashed vehicles on the tile, give the track reservation to them */
 		TrackBits remaining_trackbits = TRACK_BIT_NONE;
-		FindVehicleOnPos(tile, &remaining_trackbits, CollectTrackbitsFromCrashedVehiclesEnum);
+		FindVehicleOnPos(tile, VEH_TRAIN, &remaining_trackbits, CollectTrackbitsFromCrashedVehiclesEnum);
 
 		/* It is important that these two are the first in the loop, as reservation cannot deal with every trackbit combination */
 		assert(TRACK_BEGIN == TRACK_X && TRACK_Y == TRACK_BEGIN + 1);
@@ -815,17 +815,16 @@ static void TileLoop_Trees(TileIndex tile)
  * Decrement the tree tick counter.
  * The interval is scaled by map size to allow for the same density regardless of size.
  * Adjustment for map sizes below the standard 256 * 256 are handled earlier.
- * @return true if the counter was decremented past zero
+ * @return the number of times the counter was decremented past zero
  */
-bool DecrementTreeCounter()
+uint DecrementTreeCounter()
 {
-	/* Ensure _trees_tick_ctr can be decremented past zero only once for the largest map size. */
-	static_assert(2 * (MAX_MAP_SIZE_BITS - MIN_MAP_SIZE_BITS) - 4 <= std::numeric_limits<uint8_t>::digits);
+	uint decrement = Map::ScaleBySize(1);
 
-	/* byte underflow */
+	/* byte underflow; on maps larger than 4096 * 4096 the counter passes zero more than once per tick. */
 	uint8_t old_trees_tick_ctr = _trees_tick_ctr;
-	_trees_tick_ctr -= Map::ScaleBySize(1);
-	return old_trees_tick_ctr <= _trees_tick_ctr;
+	_trees_tick_ctr -= decrement;
+	return decrement > old_trees_tick_ctr ? (decrement - old_trees_tick_ctr - 1) / 256 + 1 : 0;
 }
 
 void OnTick_Trees()
@@ -854,13 +853,16 @@ void OnTick_Trees()
 		}
 	}
 
-	if (!DecrementTreeCounter() || _settings_game.construction.extra_tree_placement == ETP_SPREAD_RAINFOREST) return;
+	uint count = DecrementTreeCounter();
+	if (_settings_game.construction.extra_tree_placement == ETP_SPREAD_RAINFOREST) return;
 
 	/* place a tree at a random spot */
-	r = Random();
-	tile = RandomTileSeed(r);
-	if (CanPlantTreesOnTile(tile, false) && (tree = GetRandomTreeType(tile, GB(r, 24, 8))) != TREE_INVALID) {
-		PlantTreesOnTile(tile, tree, 0, TreeGrowthStage::Growing1);
+	for (; count > 0; count--) {
+		r = Random();
+		tile = RandomTileSeed(r);
+		if (CanPlantTreesOnTile(tile, false) && (tree = GetRandomTreeType(tile, GB(r, 24, 8))) != TREE_INVALID) {
+			PlantTreesOnTile(tile, tree, 0, TreeGrowthStage::Growing1);
+		}
 	}
 }
 
@@ -575,6 +575,7 @@ CommandCost CmdBuildBridge(DoCommandFlag flags, TileIndex tile_end, TileIndex ti
 		Track track = AxisToTrack(direction);
 		AddSideToSignalBuffer(tile_start, INVALID_DIAGDIR, company);
 		YapfNotifyTrackLayoutChange(tile_start, track);
+		YapfNotifyTrackLayoutChange(tile_end,   track);
 	}
 
 	/* Human players that build bridges get a selection to choose from (DC_QUERY_COST)
@@ -775,6 +776,7 @@ CommandCost CmdBuildTunnel(DoCommandFlag flags, TileIndex start_tile, TransportT
 			MakeRailTunnel(end_tile,   company, ReverseDiagDir(direction), railtype);
 			AddSideToSignalBuffer(start_tile, INVALID_DIAGDIR, company);
 			YapfNotifyTrackLayoutChange(start_tile, DiagDirToDiagTrack(direction));
+			YapfNotifyTrackLayoutChange(end_tile,   DiagDirToDiagTrack(direction));
 		} else {
 			if (c != nullptr) c->infrastructure.road[roadtype] += num_pieces * 2; // A full diagonal road has two road bits.
 			RoadType road_rt = RoadTypeIsRoad(roadtype) ? roadtype : INVALID_ROADTYPE;
@@ -1867,6 +1869,8 @@ static void ChangeTileOwner_TunnelBridge(TileIndex tile, Owner old_owner, Owner
 template <typename T>
 static void PrepareToEnterBridge(T *gv)
 {
+	gv->First()->gcache.cached_total_slope_resistance -= gv->GetPartSlopeResistance();
+
 	if (HasBit(gv->gv_flags, GVF_GOINGUP_BIT)) {
 		gv->z_pos++;
 		ClrBit(gv->gv_flags, GVF_GOINGUP_BIT);
@@ -32,6 +32,7 @@
 #include "ai/ai.hpp"
 #include "depot_func.h"
 #include "network/network.h"
+#include "network/network_admin.h"
 #include "core/pool_func.hpp"
 #include "economy_base.h"
 #include "articulated_vehicles.h"
@@ -60,6 +61,7 @@
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
 #include "timer/timer_game_tick.h"
+#include "trace.h"
 
 #include "table/strings.h"
 
@@ -367,6 +369,7 @@ Vehicle::Vehicle(VehicleType type)
 	this->fill_percent_te_id = INVALID_TE_ID;
 	this->first              = this;
 	this->colourmap          = PAL_NONE;
+	this->hash_tile_current  = INVALID_VEHICLE_HASH;
 	this->cargo_age_counter  = 1;
 	this->last_station_visited = INVALID_STATION;
 	this->last_loading_station = INVALID_STATION;
@@ -384,15 +387,28 @@ const int TOTAL_HASH_MASK = TOTAL_HASH_SIZE - 1;
  * Profiling results show that 0 is fastest. */
 const int HASH_RES = 0;
 
-static Vehicle *_vehicle_tile_hash[TOTAL_HASH_SIZE];
+/**
+ * Entry of a bucket of the vehicle tile hash. It holds the data that most
+ * lookups filter on, so a bucket can be scanned as one contiguous block of
+ * memory and only the vehicles that pass the filter have to be touched.
+ */
+struct VehicleTileHashEntry {
+	Vehicle *v;       ///< The vehicle.
+	TileIndex tile;   ///< Tile of the vehicle at its last position update.
+	VehicleType type; ///< Type of the vehicle.
+};
+
+static std::vector<VehicleTileHashEntry> _vehicle_tile_hash[TOTAL_HASH_SIZE];
 
 static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
 {
 	for (int y = yl; ; y = (y + (1 << HASH_BITS)) & (HASH_MASK << HASH_BITS)) {
 		for (int x = xl; ; x = (x + 1) & HASH_MASK) {
-			Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
-			for (; v != nullptr; v = v->hash_tile_next) {
-				Vehicle *a = proc(v, data);
+			const std::vector<VehicleTileHashEntry> &bucket = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+			/* Newest first, see UpdateVehicleTileHash. Index based, as proc might change the contents of the bucket. */
+			for (size_t i = bucket.size(); i-- > 0;) {
+				if (i >= bucket.size()) continue;
+				Vehicle *a = proc(bucket[i].v, data);
 				if (find_first && a != nullptr) return a;
 			}
 			if (x == xu) break;
@@ -467,19 +483,27 @@ bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
  * Helper function for FindVehicleOnPos/HasVehicleOnPos.
  * @note Do not call this function directly!
  * @param tile The location on the map
+ * @param type The type of vehicles to pass to \a proc, or #VEH_INVALID for all types.
  * @param data Arbitrary data passed to \a proc.
  * @param proc The proc that determines whether a vehicle will be "found".
  * @param find_first Whether to return on the first found or iterate over
  *                   all vehicles
  * @return the best matching or first vehicle (depending on find_first).
  */
-static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
+static Vehicle *VehicleFromPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc, bool find_first)
 {
 	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
 	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
 
-	Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
-	for (; v != nullptr; v = v->hash_tile_next) {
+	const std::vector<VehicleTileHashEntry> &bucket = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	/* Newest first, see UpdateVehicleTileHash. Index based, as proc might change the contents of the bucket. */
+	for (size_t i = bucket.size(); i-- > 0;) {
+		if (i >= bucket.size()) continue;
+		const VehicleTileHashEntry &entry = bucket[i];
+		if (entry.tile != tile) continue;
+		if (type != VEH_INVALID && entry.type != type) continue;
+
+		Vehicle *v = entry.v;
 		if (v->tile != tile) continue;
 
 		Vehicle *a = proc(v, data);
@@ -504,7 +528,21 @@ static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *p
  */
 void FindVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
 {
-	VehicleFromPos(tile, data, proc, false);
+	VehicleFromPos(tile, VEH_INVALID, data, proc, false);
+}
+
+/**
+ * Find a vehicle of a specific type from a specific location.
+ * Like #FindVehicleOnPos, but vehicles of other types are skipped before
+ * they are passed to \a proc.
+ * @param tile The location on the map
+ * @param type The type of vehicles to pass to \a proc.
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The proc that determines whether a vehicle will be "found".
+ */
+void FindVehicleOnPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc)
+{
+	VehicleFromPos(tile, type, data, proc, false);
 }
 
 /**
@@ -519,7 +557,22 @@ void FindVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
  */
 bool HasVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
 {
-	return VehicleFromPos(tile, data, proc, true) != nullptr;
+	return VehicleFromPos(tile, VEH_INVALID, data, proc, true) != nullptr;
+}
+
+/**
+ * Checks whether a vehicle of a specific type is on a specific location.
+ * Like #HasVehicleOnPos, but vehicles of other types are skipped before
+ * they are passed to \a proc.
+ * @param tile The location on the map
+ * @param type The type of vehicles to pass to \a proc.
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The \a proc that determines whether a vehicle will be "found".
+ * @return True if proc returned non-nullptr.
+ */
+bool HasVehicleOnPos(TileIndex tile, VehicleType type, void *data, VehicleFromPosProc *proc)
+{
+	return VehicleFromPos(tile, type, data, proc, true) != nullptr;
 }
 
 /**
@@ -551,7 +604,7 @@ CommandCost EnsureNoVehicleOnGround(TileIndex tile)
 	 * error message only (which may be different for different machines).
 	 * Such a message does not affect MP synchronisation.
 	 */
-	Vehicle *v = VehicleFromPos(tile, &z, &EnsureNoVehicleProcZ, true);
+	Vehicle *v = VehicleFromPos(tile, VEH_INVALID, &z, &EnsureNoVehicleProcZ, true);
 	if (v != nullptr) return_cmd_error(STR_ERROR_TRAIN_IN_THE_WAY + v->type);
 	return CommandCost();
 }
@@ -578,8 +631,8 @@ CommandCost TunnelBridgeIsFree(TileIndex tile, TileIndex endtile, const Vehicle
 	 * error message only (which may be different for different machines).
 	 * Such a message does not affect MP synchronisation.
 	 */
-	Vehicle *v = VehicleFromPos(tile, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
-	if (v == nullptr) v = VehicleFromPos(endtile, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
+	Vehicle *v = VehicleFromPos(tile, VEH_INVALID, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
+	if (v == nullptr) v = VehicleFromPos(endtile, VEH_INVALID, const_cast<Vehicle *>(ignore), &GetVehicleTunnelBridgeProc, true);
 
 	if (v != nullptr) return_cmd_error(STR_ERROR_TRAIN_IN_THE_WAY + v->type);
 	return CommandCost();
@@ -611,38 +664,45 @@ CommandCost EnsureNoTrainOnTrackBits(TileIndex tile, TrackBits track_bits)
 	 * error message only (which may be different for different machines).
 	 * Such a message does not affect MP synchronisation.
 	 */
-	Vehicle *v = VehicleFromPos(tile, &track_bits, &EnsureNoTrainOnTrackProc, true);
+	Vehicle *v = VehicleFromPos(tile, VEH_TRAIN, &track_bits, &EnsureNoTrainOnTrackProc, true);
 	if (v != nullptr) return_cmd_error(STR_ERROR_TRAIN_IN_THE_WAY + v->type);
 	return CommandCost();
 }
 
 static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 {
-	Vehicle **old_hash = v->hash_tile_current;
-	Vehicle **new_hash;
+	uint old_hash = v->hash_tile_current;
+	uint new_hash;
 
 	if (remove) {
-		new_hash = nullptr;
+		new_hash = INVALID_VEHICLE_HASH;
 	} else {
 		int x = GB(TileX(v->tile), HASH_RES, HASH_BITS);
 		int y = GB(TileY(v->tile), HASH_RES, HASH_BITS) << HASH_BITS;
-		new_hash = &_vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+		new_hash = (x + y) & TOTAL_HASH_MASK;
 	}
 
-	if (old_hash == new_hash) return;
+	if (old_hash == new_hash) {
+		/* Same bucket, but the tile might still have changed. */
+		if (new_hash != INVALID_VEHICLE_HASH) _vehicle_tile_hash[new_hash][v->hash_tile_slot].tile = v->tile;
+		return;
+	}
 
-	/* Remove from the old position in the hash table */
-	if (old_hash != nullptr) {
-		if (v->hash_tile_next != nullptr) v->hash_tile_next->hash_tile_prev = v->hash_tile_prev;
-		*v->hash_tile_prev = v->hash_tile_next;
+	/* Remove from the old position in the hash table. The order of the other entries must stay the
+	 * same, as the order in which the lookups visit vehicles can change the outcome of the game. */
+	if (old_hash != INVALID_VEHICLE_HASH) {
+		std::vector<VehicleTileHashEntry> &bucket = _vehicle_tile_hash[old_hash];
+		assert(bucket[v->hash_tile_slot].v == v);
+		bucket.erase(bucket.begin() + v->hash_tile_slot);
+		for (uint i = v->hash_tile_slot; i < bucket.size(); i++) bucket[i].v->hash_tile_slot = i;
 	}
 
-	/* Insert vehicle at beginning of the new position in the hash table */
-	if (new_hash != nullptr) {
-		v->hash_tile_next = *new_hash;
-		if (v->hash_tile_next != nullptr) v->hash_tile_next->hash_tile_prev = &v->hash_tile_next;
-		v->hash_tile_prev = new_hash;
-		*new_hash = v;
+	/* Insert vehicle at the end of the new position in the hash table; lookups go from the end to the
+	 * start, so they visit the vehicles in the same order as when they were inserted at the start. */
+	if (new_hash != INVALID_VEHICLE_HASH) {
+		std::vector<VehicleTileHashEntry> &bucket = _vehicle_tile_hash[new_hash];
+		v->hash_tile_slot = static_cast<uint>(bucket.size());
+		bucket.push_back({v, v->tile, v->type});
 	}
 
 	/* Remember current hash position */
@@ -677,9 +737,9 @@ static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int o
 
 void ResetVehicleHash()
 {
-	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
+	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = INVALID_VEHICLE_HASH; }
 	memset(_vehicle_viewport_hash, 0, sizeof(_vehicle_viewport_hash));
-	memset(_vehicle_tile_hash, 0, sizeof(_vehicle_tile_hash));
+	for (auto &bucket : _vehicle_tile_hash) bucket.clear();
 }
 
 void ResetVehicleColourMap()
@@ -827,6 +887,8 @@ void Vehicle::PreDestructor()
 {
 	if (CleaningPool()) return;
 
+	if (this->IsPrimaryVehicle()) NetworkAdminVehicleRemove(this->index);
+
 	if (Station::IsValidID(this->last_station_visited)) {
 		Station *st = Station::Get(this->last_station_visited);
 		st->loading_vehicles.remove(this);
@@ -983,6 +1045,8 @@ static void RunEconomyVehicleDayProc()
 
 void CallVehicleTicks()
 {
+	TraceZone trace("CallVehicleTicks");
+
 	_vehicles_to_autoreplace.clear();
 
 	RunEconomyVehicleDayProc();
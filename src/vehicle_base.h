@@ -28,6 +28,9 @@
 const uint TILE_AXIAL_DISTANCE = 192;  // Logical length of the tile in any DiagDirection used in vehicle movement.
 const uint TILE_CORNER_DISTANCE = 128;  // Logical length of the tile corner crossing in any non-diagonal direction used in vehicle movement.
 
+/** Sentinel for a vehicle that is not in the tile location hash. */
+static const uint INVALID_VEHICLE_HASH = UINT_MAX;
+
 /** Vehicle status bits in #Vehicle::vehstatus. */
 enum VehStatus {
 	VS_HIDDEN          = 0x01, ///< Vehicle is not visible.
@@ -281,9 +284,8 @@ public:
 	Vehicle *hash_viewport_next;        ///< NOSAVE: Next vehicle in the visual location hash.
 	Vehicle **hash_viewport_prev;       ///< NOSAVE: Previous vehicle in the visual location hash.
 
-	Vehicle *hash_tile_next;            ///< NOSAVE: Next vehicle in the tile location hash.
-	Vehicle **hash_tile_prev;           ///< NOSAVE: Previous vehicle in the tile location hash.
-	Vehicle **hash_tile_current;        ///< NOSAVE: Cache of the current hash chain.
+	uint hash_tile_current;             ///< NOSAVE: Bucket of the tile location hash the vehicle is in, or #INVALID_VEHICLE_HASH.
+	uint hash_tile_slot;                ///< NOSAVE: Position of the vehicle within its bucket of the tile location hash.
 
 	SpriteID colourmap;                 ///< NOSAVE: cached colour mapping
 
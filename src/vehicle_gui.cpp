@@ -473,15 +473,15 @@ DropDownList BaseVehicleListWindow::BuildActionDropdownList(bool show_autoreplac
 	return list;
 }
 
-/* cached values for VehicleNameSorter to spare many GetString() calls */
-static const Vehicle *_last_vehicle[2] = { nullptr, nullptr };
+/* Names of the vehicles formatted during the current sort by VehicleNameSorter, to format every name only once. */
+static std::unordered_map<VehicleID, std::string> _vehicle_sort_names;
 
 void BaseVehicleListWindow::SortVehicleList()
 {
-	if (this->vehgroups.Sort()) return;
+	this->vehgroups.Sort();
 
-	/* invalidate cached values for name sorter - vehicle names could change */
-	_last_vehicle[0] = _last_vehicle[1] = nullptr;
+	/* Vehicle names could change before the next sort. */
+	_vehicle_sort_names.clear();
 }
 
 void DepotSortList(VehicleList *list)
@@ -1381,21 +1381,16 @@ static bool VehicleNumberSorter(const Vehicle * const &a, const Vehicle * const
 /** Sort vehicles by their name */
 static bool VehicleNameSorter(const Vehicle * const &a, const Vehicle * const &b)
 {
-	static std::string last_name[2] = { {}, {} };
-
-	if (a != _last_vehicle[0]) {
-		_last_vehicle[0] = a;
-		SetDParam(0, a->index);
-		last_name[0] = GetString(STR_VEHICLE_NAME);
-	}
-
-	if (b != _last_vehicle[1]) {
-		_last_vehicle[1] = b;
-		SetDParam(0, b->index);
-		last_name[1] = GetString(STR_VEHICLE_NAME);
-	}
+	auto get_name = [](const Vehicle *v) -> const std::string & {
+		auto [it, inserted] = _vehicle_sort_names.try_emplace(v->index);
+		if (inserted) {
+			SetDParam(0, v->index);
+			it->second = GetString(STR_VEHICLE_NAME);
+		}
+		return it->second;
+	};
 
-	int r = StrNaturalCompare(last_name[0], last_name[1]); // Sort by name (natural sorting).
+	int r = StrNaturalCompare(get_name(a), get_name(b)); // Sort by name (natural sorting).
 	return (r != 0) ? r < 0: VehicleNumberSorter(a, b);
 }
 
@@ -16,6 +16,7 @@
 class VideoDriver_Null : public VideoDriver {
 private:
 	uint ticks; ///< Amount of ticks to run.
+	bool benchmark; ///< Whether to print the timings of the run when done.
 
 public:
 	std::optional<std::string_view> Start(const StringList &param) override;
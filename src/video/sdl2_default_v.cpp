@@ -91,6 +91,14 @@ void VideoDriver_SDL_Default::MakePalette()
 	}
 }
 
+void VideoDriver_SDL_Default::MakeDirty(int left, int top, int width, int height)
+{
+	this->VideoDriver_SDL_Base::MakeDirty(left, top, width, height);
+
+	/* Keep one more than the maximum, so Paint knows there were too many. */
+	if (this->dirty_rects.size() <= MAX_DIRTY_RECTS) this->dirty_rects.push_back({left, top, left + width, top + height});
+}
+
 void VideoDriver_SDL_Default::Paint()
 {
 	PerformanceMeasurer framerate(PFE_VIDEO);
@@ -119,14 +127,24 @@ void VideoDriver_SDL_Default::Paint()
 		this->local_palette.count_dirty = 0;
 	}
 
-	SDL_Rect r = { this->dirty_rect.left, this->dirty_rect.top, this->dirty_rect.right - this->dirty_rect.left, this->dirty_rect.bottom - this->dirty_rect.top };
-
-	if (_sdl_surface != _sdl_real_surface) {
-		SDL_BlitSurface(_sdl_surface, &r, _sdl_real_surface, &r);
+	/* Update the separate dirty areas, so distant small changes do not cause the whole area between them to be updated. */
+	std::vector<SDL_Rect> rects;
+	if (this->dirty_rects.size() > MAX_DIRTY_RECTS) {
+		rects.push_back({ this->dirty_rect.left, this->dirty_rect.top, this->dirty_rect.right - this->dirty_rect.left, this->dirty_rect.bottom - this->dirty_rect.top });
+	} else {
+		for (const Rect &dr : this->dirty_rects) rects.push_back({ dr.left, dr.top, dr.right - dr.left, dr.bottom - dr.top });
 	}
-	SDL_UpdateWindowSurfaceRects(this->sdl_window, &r, 1);
 
 	this->dirty_rect = {};
+	this->dirty_rects.clear();
+
+	/* Only the palette changed, which needs no update of the window surface. */
+	if (rects.empty()) return;
+
+	if (_sdl_surface != _sdl_real_surface) {
+		for (SDL_Rect &r : rects) SDL_BlitSurface(_sdl_surface, &r, _sdl_real_surface, &r);
+	}
+	SDL_UpdateWindowSurfaceRects(this->sdl_window, rects.data(), static_cast<int>(rects.size()));
 }
 
 bool VideoDriver_SDL_Default::AllocateBackingStore(int w, int h, bool force)
@@ -159,6 +177,7 @@ bool VideoDriver_SDL_Default::AllocateBackingStore(int w, int h, bool force)
 	 * will mark the whole screen dirty again anyway, but this time with the
 	 * new dimensions. */
 	this->dirty_rect = {};
+	this->dirty_rects.clear();
 
 	_screen.width = _sdl_surface->w;
 	_screen.height = _sdl_surface->h;
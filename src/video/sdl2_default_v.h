@@ -15,6 +15,8 @@
 /** The SDL video driver using default SDL backend. */
 class VideoDriver_SDL_Default : public VideoDriver_SDL_Base {
 public:
+	void MakeDirty(int left, int top, int width, int height) override;
+
 	std::string_view GetName() const override { return "sdl"; }
 
 protected:
@@ -25,6 +27,10 @@ protected:
 	void ReleaseVideoPointer() override {}
 
 private:
+	static const size_t MAX_DIRTY_RECTS = 64; ///< Number of dirty rectangles from which on only their bounding rectangle is updated.
+
+	std::vector<Rect> dirty_rects; ///< Separate dirty areas of the video buffer, as long as there are at most #MAX_DIRTY_RECTS.
+
 	void UpdatePalette();
 	void MakePalette();
 };
@@ -171,6 +171,17 @@ void VideoDriver_SDL_OpenGL::ReleaseVideoPointer()
 	this->anim_buffer = nullptr;
 }
 
+void VideoDriver_SDL_OpenGL::CheckPaletteAnim()
+{
+	if (BlitterFactory::GetCurrentBlitter()->UsePaletteAnimation() != Blitter::PALETTE_ANIMATION_VIDEO_BACKEND) {
+		this->VideoDriver_SDL_Base::CheckPaletteAnim();
+		return;
+	}
+
+	/* The palette is applied by the shader, so only the palette texture has to change; nothing on screen is dirty. */
+	CopyPalette(this->local_palette);
+}
+
 void VideoDriver_SDL_OpenGL::Paint()
 {
 	PerformanceMeasurer framerate(PFE_VIDEO);
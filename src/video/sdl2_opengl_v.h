@@ -38,6 +38,7 @@ protected:
 	void *GetVideoPointer() override;
 	void ReleaseVideoPointer() override;
 	void Paint() override;
+	void CheckPaletteAnim() override;
 	bool CreateMainWindow(uint w, uint h, uint flags) override;
 
 private:
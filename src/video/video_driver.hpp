@@ -226,6 +226,7 @@ public:
 
 protected:
 	const uint ALLOWED_DRIFT = 5; ///< How many times videodriver can miss deadlines without it being overly compensated.
+	const uint IDLE_LOW_COST_SLOWDOWN = 8; ///< How many times slower the game runs on an idle dedicated server in the low-cost idle mode.
 
 	/**
 	 * Get the resolution of the main screen.
@@ -320,6 +321,12 @@ protected:
 
 		/* If we are paused, run on normal speed. */
 		if (_pause_mode) return std::chrono::milliseconds(MILLISECONDS_PER_TICK);
+
+		/* Nobody sees how fast a dedicated server without clients runs, so let the admin decide. */
+		if (_settings_client.network.idle_mode != SERVER_IDLE_MODE_NORMAL && NetworkServerIsIdle()) {
+			if (_settings_client.network.idle_mode == SERVER_IDLE_MODE_FAST_FORWARD) return std::chrono::microseconds(0);
+			return std::chrono::milliseconds(MILLISECONDS_PER_TICK * IDLE_LOW_COST_SLOWDOWN);
+		}
 		/* Infinite speed, as quickly as you can. */
 		if (_game_speed == 0) return std::chrono::microseconds(0);
 
@@ -1496,6 +1496,17 @@ void VideoDriver_Win32OpenGL::ReleaseVideoPointer()
 	this->anim_buffer = nullptr;
 }
 
+void VideoDriver_Win32OpenGL::CheckPaletteAnim()
+{
+	if (BlitterFactory::GetCurrentBlitter()->UsePaletteAnimation() != Blitter::PALETTE_ANIMATION_VIDEO_BACKEND) {
+		this->VideoDriver_Win32Base::CheckPaletteAnim();
+		return;
+	}
+
+	/* The palette is applied by the shader, so only the palette texture has to change; nothing on screen is dirty. */
+	CopyPalette(_local_palette);
+}
+
 void VideoDriver_Win32OpenGL::Paint()
 {
 	PerformanceMeasurer framerate(PFE_VIDEO);
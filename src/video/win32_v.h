@@ -154,6 +154,7 @@ protected:
 	uint8_t GetFullscreenBpp() override { return 32; } // OpenGL is always 32 bpp.
 
 	void Paint() override;
+	void CheckPaletteAnim() override;
 
 	bool AllocateBackingStore(int w, int h, bool force = false) override;
 	void *GetVideoPointer() override;
@@ -70,8 +70,6 @@ void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom
 bool ScrollWindowToTile(TileIndex tile, Window *w, bool instant = false);
 bool ScrollWindowTo(int x, int y, int z, Window *w, bool instant = false);
 
-void RebuildViewportOverlay(Window *w);
-
 bool ScrollMainWindowToTile(TileIndex tile, bool instant = false);
 bool ScrollMainWindowTo(int x, int y, int z = -1, bool instant = false);
 
@@ -93,7 +91,8 @@ inline void MarkTileDirtyByTile(TileIndex tile, int bridge_level_offset = 0)
 	MarkTileDirtyByTile(tile, bridge_level_offset, TileHeight(tile));
 }
 
-Point GetViewportStationMiddle(const Viewport *vp, const Station *st);
+Point GetViewportStationPosition(const Station *st);
+Point GetViewportStationMiddle(const Viewport *vp, Point pos);
 
 struct Station;
 struct Waypoint;
@@ -45,6 +45,11 @@ typedef bool (*VpSorterChecker)();
 /** Type for the actual viewport sprite sorter. */
 typedef void (*VpSpriteSorter)(ParentSpriteToSortVector *psd);
 
+bool ViewportSortParentSpritesChecker();
+void ViewportSortParentSprites(ParentSpriteToSortVector *psdv);
+bool ViewportSortParentSpritesBucketedChecker();
+void ViewportSortParentSpritesBucketed(ParentSpriteToSortVector *psdv);
+
 #ifdef WITH_SSE
 bool ViewportSortParentSpritesSSE41Checker();
 void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv);
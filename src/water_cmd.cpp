@@ -33,6 +33,7 @@
 #include "core/random_func.hpp"
 #include "core/backup_type.hpp"
 #include "timer/timer_game_calendar.h"
+#include "timer/timer_game_tick.h"
 #include "company_base.h"
 #include "company_gui.h"
 #include "newgrf_generic.h"
@@ -1185,6 +1186,9 @@ static void DoDryUp(TileIndex tile)
 {
 	Backup<CompanyID> cur_company(_current_company, OWNER_WATER);
 
+	/* The dry land could be flooded by another neighbour. */
+	ClearNeighbourNonFloodingStates(tile);
+
 	switch (GetTileType(tile)) {
 		case MP_RAILWAY:
 			assert(IsPlainRail(tile));
@@ -1230,10 +1234,18 @@ static void DoDryUp(TileIndex tile)
  */
 void TileLoop_Water(TileIndex tile)
 {
-	if (IsTileType(tile, MP_WATER)) AmbientSoundEffect(tile);
+	if (IsTileType(tile, MP_WATER)) {
+		AmbientSoundEffect(tile);
+		if (IsNonFloodingWaterTile(tile)) {
+			/* Not every change to a neighbour clears the mark, so do a full check every 16th tile loop. */
+			if (GB(TimerGameTick::counter, 8, 4) != GB(tile.base(), 0, 4)) return;
+			SetNonFloodingWaterTile(tile, false);
+		}
+	}
 
 	switch (GetFloodingBehaviour(tile)) {
-		case FLOOD_ACTIVE:
+		case FLOOD_ACTIVE: {
+			bool continue_flooding = false;
 			for (Direction dir = DIR_BEGIN; dir < DIR_END; dir++) {
 				TileIndex dest = tile + TileOffsByDir(dir);
 				if (!IsValidTile(dest)) continue;
@@ -1248,9 +1260,14 @@ void TileLoop_Water(TileIndex tile)
 
 				if (!HasBit(_flood_from_dirs[slope_dest & ~SLOPE_HALFTILE_MASK & ~SLOPE_STEEP], ReverseDir(dir))) continue;
 
+				/* The neighbour might not be flooded right away, so try again next time. */
+				continue_flooding = true;
 				DoFloodTile(dest);
 			}
+			/* Nothing around can be flooded; until a neighbour changes there is no need to check again. */
+			if (!continue_flooding && IsTileType(tile, MP_WATER)) SetNonFloodingWaterTile(tile, true);
 			break;
+		}
 
 		case FLOOD_DRYUP: {
 			Slope slope_here = std::get<0>(GetFoundationSlope(tile)) & ~SLOPE_HALFTILE_MASK & ~SLOPE_STEEP;
@@ -1269,6 +1286,18 @@ void TileLoop_Water(TileIndex tile)
 	}
 }
 
+/**
+ * Make the water tiles around a tile check for flooding again, as the tile has changed.
+ * @param tile The tile that has changed.
+ */
+void ClearNeighbourNonFloodingStates(TileIndex tile)
+{
+	for (Direction dir = DIR_BEGIN; dir != DIR_END; dir++) {
+		TileIndex dest = tile + TileOffsByDir(dir);
+		if (IsValidTile(dest) && IsTileType(dest, MP_WATER)) SetNonFloodingWaterTile(dest, false);
+	}
+}
+
 void ConvertGroundTilesIntoWaterTiles()
 {
 	for (TileIndex tile = 0; tile < Map::Size(); ++tile) {
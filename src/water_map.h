@@ -367,6 +367,31 @@ inline void SetDockingTile(Tile t, bool b)
 	SB(t.m1(), 7, 1, b ? 1 : 0);
 }
 
+/**
+ * Checks whether a water tile is known to have nothing left to flood around it.
+ * Such a tile is skipped by the flooding in the tile loop, until one of its neighbours changes.
+ * @param t the tile
+ * @pre IsTileType(t, MP_WATER)
+ * @return true iff the tile does not need to be checked for flooding.
+ */
+inline bool IsNonFloodingWaterTile(Tile t)
+{
+	assert(IsTileType(t, MP_WATER));
+	return HasBit(t.m3(), 0);
+}
+
+/**
+ * Set whether a water tile is known to have nothing left to flood around it.
+ * @param t the tile
+ * @param b whether the tile does not need to be checked for flooding
+ * @pre IsTileType(t, MP_WATER)
+ */
+inline void SetNonFloodingWaterTile(Tile t, bool b)
+{
+	assert(IsTileType(t, MP_WATER));
+	SB(t.m3(), 0, 1, b ? 1 : 0);
+}
+
 /**
  * Checks whether the tile is marked as a dockling tile.
  * @return true iff the tile is marked as a docking tile.
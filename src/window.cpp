@@ -56,6 +56,19 @@ static Window *_last_scroll_window = nullptr; ///< Window of the last scroll eve
 /** List of windows opened at the screen sorted from the front to back. */
 WindowList _z_windows;
 
+/** Number of open windows per window class, so looking for windows of a class that is not open costs nothing. */
+static std::array<uint, WC_END> _open_windows_per_class{};
+
+/**
+ * Check whether any window of the given class may be open.
+ * @param cls Window class.
+ * @return False when there is certainly no open window of the class.
+ */
+static inline bool HasOpenWindowOfClass(WindowClass cls)
+{
+	return cls >= WC_END || _open_windows_per_class[cls] != 0;
+}
+
 /** List of closed windows to delete. */
 /* static */ std::vector<Window *> Window::closed_windows;
 
@@ -1050,6 +1063,7 @@ void Window::Close([[maybe_unused]] int data)
 	if (*this->z_position == nullptr) return;
 
 	*this->z_position = nullptr;
+	if (this->window_class < WC_END) _open_windows_per_class[this->window_class]--;
 
 	if (_thd.window_class == this->window_class &&
 			_thd.window_number == this->window_number) {
@@ -1097,6 +1111,8 @@ Window::~Window()
  */
 Window *FindWindowById(WindowClass cls, WindowNumber number)
 {
+	if (!HasOpenWindowOfClass(cls)) return nullptr;
+
 	for (Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) return w;
 	}
@@ -1112,6 +1128,8 @@ Window *FindWindowById(WindowClass cls, WindowNumber number)
  */
 Window *FindWindowByClass(WindowClass cls)
 {
+	if (!HasOpenWindowOfClass(cls)) return nullptr;
+
 	for (Window *w : Window::Iterate()) {
 		if (w->window_class == cls) return w;
 	}
@@ -1365,6 +1383,7 @@ void Window::InitializeData(WindowNumber window_number)
 {
 	/* Set up window properties; some of them are needed to set up smallest size below */
 	this->window_class = this->window_desc.cls;
+	if (this->window_class < WC_END) _open_windows_per_class[this->window_class]++;
 	this->SetWhiteBorder();
 	if (this->window_desc.default_pos == WDP_CENTER) this->flags |= WF_CENTERED;
 	this->owner = INVALID_OWNER;
@@ -3089,6 +3108,8 @@ void UpdateWindows()
  */
 void SetWindowDirty(WindowClass cls, WindowNumber number)
 {
+	if (!HasOpenWindowOfClass(cls)) return;
+
 	for (const Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) w->SetDirty();
 	}
@@ -3102,6 +3123,8 @@ void SetWindowDirty(WindowClass cls, WindowNumber number)
  */
 void SetWindowWidgetDirty(WindowClass cls, WindowNumber number, WidgetID widget_index)
 {
+	if (!HasOpenWindowOfClass(cls)) return;
+
 	for (const Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) {
 			w->SetWidgetDirty(widget_index);
@@ -3115,6 +3138,8 @@ void SetWindowWidgetDirty(WindowClass cls, WindowNumber number, WidgetID widget_
  */
 void SetWindowClassesDirty(WindowClass cls)
 {
+	if (!HasOpenWindowOfClass(cls)) return;
+
 	for (const Window *w : Window::Iterate()) {
 		if (w->window_class == cls) w->SetDirty();
 	}
@@ -3149,8 +3174,10 @@ void Window::InvalidateData(int data, bool gui_scope)
 {
 	this->SetDirty();
 	if (!gui_scope) {
-		/* Schedule GUI-scope invalidation for next redraw. */
-		this->scheduled_invalidation_data.push_back(data);
+		/* Schedule GUI-scope invalidation for next redraw; the same data only needs to be handled once. */
+		if (std::ranges::find(this->scheduled_invalidation_data, data) == this->scheduled_invalidation_data.end()) {
+			this->scheduled_invalidation_data.push_back(data);
+		}
 	}
 	this->OnInvalidateData(data, gui_scope);
 }
@@ -3207,6 +3234,8 @@ void Window::ProcessHighlightedInvalidations()
  */
 void InvalidateWindowData(WindowClass cls, WindowNumber number, int data, bool gui_scope)
 {
+	if (!HasOpenWindowOfClass(cls)) return;
+
 	for (Window *w : Window::Iterate()) {
 		if (w->window_class == cls && w->window_number == number) {
 			w->InvalidateData(data, gui_scope);
@@ -3224,6 +3253,8 @@ void InvalidateWindowData(WindowClass cls, WindowNumber number, int data, bool g
  */
 void InvalidateWindowClassesData(WindowClass cls, int data, bool gui_scope)
 {
+	if (!HasOpenWindowOfClass(cls)) return;
+
 	for (Window *w : Window::Iterate()) {
 		if (w->window_class == cls) {
 			w->InvalidateData(data, gui_scope);
@@ -301,7 +301,7 @@ public:
 
 	WindowDesc &window_desc;    ///< Window description
 	WindowFlags flags;          ///< Window flags
-	WindowClass window_class;   ///< Window class
+	WindowClass window_class = WC_INVALID; ///< Window class
 	WindowNumber window_number; ///< Window number within the window class
 
 	int scale; ///< Scale of this window -- used to determine how to resize.
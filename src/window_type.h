@@ -715,6 +715,8 @@ enum WindowClass {
 	 */
 	WC_HELPWIN,
 
+	WC_END, ///< End marker of the window classes.
+
 	WC_INVALID = 0xFFFF, ///< Invalid window.
 };
 